@@ -0,0 +1,97 @@
+#include "measure.hpp"
+#include <simdee/algorithm.hpp>
+#include <simdee/simdee.hpp>
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+// Compares the algorithms of <algorithm> and <numeric> with their counterparts in sd::. The array
+// of 1K floats fits into L1 cache, 1M floats into L2 or L3 cache and 100M floats only into DRAM.
+// find_if searches for a value that is not present, so that the whole array is scanned.
+
+#if SIMDEE_AVX512
+using vec = sd::vec16f;
+#elif SIMDEE_AVX || SIMDEE_NEON
+using vec = sd::vec8f;
+#else
+using vec = sd::vec4f;
+#endif
+
+volatile double sink;
+
+void bench(std::size_t n, int repeats) {
+    std::vector<float> in(n), out(n);
+    for (std::size_t i = 0; i < n; i++) in[i] = float(i % 1000) * 0.001f;
+    const float* first = in.data();
+    const float* last = in.data() + n;
+
+    char title[64];
+    std::snprintf(title, sizeof(title), "%d floats", int(n));
+    print_header(title);
+
+    double ns = measure_ns(
+        [&]() {
+            std::transform(first, last, out.begin(), [](float x) { return x * 2.f + 1.f; });
+        },
+        repeats);
+    print_row("std::transform", double(n) / ns);
+    ns = measure_ns(
+        [&]() {
+            sd::transform<vec>(first, last, out.data(),
+                               [](const vec& x) { return x * vec(2.f) + vec(1.f); });
+        },
+        repeats);
+    print_row("sd::transform", double(n) / ns);
+    sink = double(out[n - 1]);
+
+    ns = measure_ns([&]() { sink = double(std::inner_product(first, last, first, 0.f)); },
+                    repeats);
+    print_row("std::inner_product", double(n) / ns);
+    ns = measure_ns(
+        [&]() {
+            sink = double(sd::transform_reduce<vec>(
+                first, last, 0.f, [](const vec& a, const vec& b) { return a + b; },
+                [](const vec& x) { return x * x; }));
+        },
+        repeats);
+    print_row("sd::transform_reduce", double(n) / ns);
+
+    ns = measure_ns(
+        [&]() { sink = double(std::count_if(first, last, [](float x) { return x > 0.5f; })); },
+        repeats);
+    print_row("std::count_if", double(n) / ns);
+    ns = measure_ns(
+        [&]() {
+            sink = double(
+                sd::count_if<vec>(first, last, [](const vec& x) { return x > vec(0.5f); }));
+        },
+        repeats);
+    print_row("sd::count_if", double(n) / ns);
+
+    ns = measure_ns(
+        [&]() {
+            sink = double(std::find_if(first, last, [](float x) { return x < 0.f; }) - first);
+        },
+        repeats);
+    print_row("std::find_if", double(n) / ns);
+    ns = measure_ns(
+        [&]() {
+            sink = double(
+                sd::find_if<vec>(first, last, [](const vec& x) { return x < vec(0.f); }) - first);
+        },
+        repeats);
+    print_row("sd::find_if", double(n) / ns);
+
+    ns = measure_ns([&]() { sink = double(*std::minmax_element(first, last).second); }, repeats);
+    print_row("std::minmax_element", double(n) / ns);
+    ns = measure_ns([&]() { sink = double(*sd::minmax_element<vec>(first, last).second); },
+                    repeats);
+    print_row("sd::minmax_element", double(n) / ns);
+}
+
+int main() {
+    std::printf("vector width: %d\n", int(vec::width));
+    bench(std::size_t(1) << 10, 10000);
+    bench(std::size_t(1) << 20, 100);
+    bench(std::size_t(100) << 20, 3);
+}
@@ -0,0 +1,104 @@
+#include "measure.hpp"
+#include <simdee/simdee.hpp>
+#include <simdee/util/allocator.hpp>
+#include <simdee/util/arena.hpp>
+#include <vector>
+
+// Compares sd::allocator with sd::arena_allocator on allocation-heavy work. A request allocates
+// eight temporary arrays of 64 to 2048 floats, fills them, combines them and sums the result, all
+// of which is released at the end of the request (by reset() in the case of the arena). The
+// latency is the time per request. The bare allocation test allocates and frees one block at a
+// time; its throughput is in blocks rather than scalars.
+
+#if SIMDEE_AVX512
+using vec = sd::vec16f;
+#elif SIMDEE_AVX || SIMDEE_NEON
+using vec = sd::vec8f;
+#else
+using vec = sd::vec4f;
+#endif
+
+const std::size_t width = vec::width;
+const int requests = 1 << 12;
+const int blocks = 1 << 16;
+volatile float sink;
+
+template <typename Alloc>
+float request(int seed, const Alloc& alloc) {
+    using array_t = std::vector<float, Alloc>;
+    std::vector<array_t> temps;
+    temps.reserve(8);
+    std::size_t n = std::size_t(64) << (seed % 6);
+    for (int k = 0; k < 8; k++) {
+        temps.emplace_back(n, float(k), alloc);
+    }
+    array_t result(n, 0.f, alloc);
+    for (const array_t& t : temps) {
+        for (std::size_t i = 0; i < n; i += width) {
+            sd::aligned(&result[i]) = vec(sd::aligned(&result[i])) + vec(sd::aligned(&t[i]));
+        }
+    }
+    vec acc(0.f);
+    for (std::size_t i = 0; i < n; i += width) acc = acc + vec(sd::aligned(&result[i]));
+    return hsum(acc);
+}
+
+// the number of floats that a sequence of requests touches, for the throughput
+double request_scalars() {
+    double res = 0;
+    for (int r = 0; r < requests; r++) res += 9. * double(std::size_t(64) << (r % 6));
+    return res;
+}
+
+int main() {
+    std::printf("vector width: %d\n", int(width));
+    const double scalars = request_scalars();
+
+    print_header("requests");
+    double alloc_ns = measure_ns(
+        [&]() {
+            sd::allocator<float, sd::aligned_memory<64>> alloc;
+            float acc = 0.f;
+            for (int r = 0; r < requests; r++) acc += request(r, alloc);
+            sink = acc;
+        },
+        20);
+    print_row("sd::allocator", scalars / alloc_ns, alloc_ns / requests);
+
+    sd::arena arena;
+    double arena_ns = measure_ns(
+        [&]() {
+            sd::arena_allocator<float> alloc(arena);
+            float acc = 0.f;
+            for (int r = 0; r < requests; r++) {
+                acc += request(r, alloc);
+                arena.reset();
+            }
+            sink = acc;
+        },
+        20);
+    print_row("sd::arena_allocator", scalars / arena_ns, arena_ns / requests);
+
+    print_header("bare allocation of 256 bytes");
+    alloc_ns = measure_ns([&]() {
+        sd::allocator<vec::storage_t> alloc;
+        for (int i = 0; i < blocks; i++) {
+            vec::storage_t* ptr = alloc.allocate(256 / sizeof(vec::storage_t));
+            (*ptr)[0] = float(i);
+            sink = (*ptr)[0];
+            alloc.deallocate(ptr, 256 / sizeof(vec::storage_t));
+        }
+    });
+    print_row("sd::allocator", blocks / alloc_ns, alloc_ns / blocks);
+
+    arena_ns = measure_ns([&]() {
+        sd::arena_allocator<vec::storage_t> alloc(arena);
+        for (int i = 0; i < blocks; i++) {
+            vec::storage_t* ptr = alloc.allocate(256 / sizeof(vec::storage_t));
+            (*ptr)[0] = float(i);
+            sink = (*ptr)[0];
+            alloc.deallocate(ptr, 256 / sizeof(vec::storage_t));
+        }
+    });
+    print_row("sd::arena_allocator", blocks / arena_ns, arena_ns / blocks);
+}
@@ -0,0 +1,78 @@
+#include "measure.hpp"
+#include <simdee/simdee.hpp>
+#include <random>
+#include <vector>
+
+// Copies the elements of an array that are less than a threshold (stream compaction), with the
+// threshold chosen to select a given fraction of uniformly distributed random values. Scalar loops
+// with and without a branch and a loop over the set bits of mask() are compared against
+// compress_store().
+
+#if SIMDEE_AVX512
+using vec = sd::vec16f;
+#elif SIMDEE_AVX || SIMDEE_NEON
+using vec = sd::vec8f;
+#else
+using vec = sd::vec4f;
+#endif
+
+const std::size_t width = vec::width;
+const std::size_t count = std::size_t(1) << 16; // fits into L2 cache
+volatile std::size_t sink;
+
+void bench(const std::vector<float>& in, std::vector<float>& out, float selectivity) {
+    const float threshold = selectivity;
+    std::size_t selected = 0;
+
+    char title[64];
+    std::snprintf(title, sizeof(title), "%g%% selected", double(selectivity) * 100.);
+    print_header(title);
+
+    double branch_ns = measure_ns([&]() {
+        selected = 0;
+        for (std::size_t i = 0; i < count; i++) {
+            if (in[i] < threshold) out[selected++] = in[i];
+        }
+    });
+    print_row("scalar, branch", double(count) / branch_ns);
+
+    double branchless_ns = measure_ns([&]() {
+        selected = 0;
+        for (std::size_t i = 0; i < count; i++) {
+            out[selected] = in[i];
+            selected += in[i] < threshold ? 1U : 0U;
+        }
+    });
+    print_row("scalar, no branch", double(count) / branchless_ns);
+
+    double bits_ns = measure_ns([&]() {
+        selected = 0;
+        for (std::size_t i = 0; i < count; i += width) {
+            vec v(sd::unaligned(&in[i]));
+            for (auto k : mask(v < vec(threshold))) out[selected++] = in[i + k];
+        }
+    });
+    print_row("mask() bit_iterator", double(count) / bits_ns);
+
+    double compress_ns = measure_ns([&]() {
+        selected = 0;
+        for (std::size_t i = 0; i < count; i += width) {
+            vec v(sd::unaligned(&in[i]));
+            selected += sd::compress_store(&out[selected], v, v < vec(threshold));
+        }
+    });
+    print_row("compress_store", double(count) / compress_ns);
+
+    sink = selected;
+}
+
+int main() {
+    std::mt19937 rng(12345);
+    std::uniform_real_distribution<float> random_value(0.f, 1.f);
+    std::vector<float> in(count), out(count);
+    for (auto& x : in) x = random_value(rng);
+
+    std::printf("vector width: %d\n", int(width));
+    std::printf("throughput in filtered scalars/ns\n");
+    for (float selectivity : {0.01f, 0.1f, 0.5f, 0.9f, 0.99f}) bench(in, out, selectivity);
+}
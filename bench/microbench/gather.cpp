@@ -0,0 +1,108 @@
+#include "measure.hpp"
+#include <simdee/simdee.hpp>
+#include <random>
+#include <vector>
+
+// Compares gather() and scatter() against scalar indexed loads and stores, using random indices
+// into tables that fit into L1 cache, into L2 cache, and only into DRAM. Latency is measured on a
+// chain of dependent loads that follows a random cyclic permutation of the table.
+
+#if SIMDEE_AVX512
+using vec = sd::vec16f;
+#elif SIMDEE_AVX || SIMDEE_NEON
+using vec = sd::vec8f;
+#else
+using vec = sd::vec4f;
+#endif
+
+using ivec = vec::vec_s;
+using index_t = ivec::scalar_t;
+
+const std::size_t access_count = std::size_t(1) << 20;
+const int chain_length = 100000;
+volatile float sink;
+
+void bench(const char* title, std::size_t table_size, int repeats) {
+    std::mt19937 rng(12345);
+    std::uniform_int_distribution<index_t> random_index(0, index_t(table_size - 1));
+    std::vector<float> table(table_size), values(access_count), out(access_count);
+    std::vector<index_t> idx(access_count), next(table_size);
+    for (std::size_t i = 0; i < table_size; i++) table[i] = float(i);
+    for (std::size_t i = 0; i < access_count; i++) {
+        idx[i] = random_index(rng);
+        values[i] = float(i);
+    }
+
+    // Sattolo's algorithm produces a single cycle through all of the table
+    for (std::size_t i = 0; i < table_size; i++) next[i] = index_t(i);
+    for (std::size_t i = table_size - 1; i > 0; i--) {
+        std::uniform_int_distribution<std::size_t> below(0, i - 1);
+        std::swap(next[i], next[below(rng)]);
+    }
+
+    print_header(title);
+
+    // volatile reads of the indices keep the compiler from turning the scalar loops into gathers
+    const volatile index_t* scalar_idx = idx.data();
+    double load_ns = measure_ns(
+        [&]() {
+            for (std::size_t i = 0; i < access_count; i++) {
+                out[i] = table[std::size_t(scalar_idx[i])];
+            }
+        },
+        repeats);
+    index_t at = 0;
+    double chase_ns = measure_ns(
+        [&]() {
+            for (int i = 0; i < chain_length; i++) at = next[std::size_t(at)];
+        },
+        repeats);
+    print_row("scalar load", double(access_count) / load_ns, chase_ns / double(chain_length));
+
+    double gather_ns = measure_ns(
+        [&]() {
+            for (std::size_t i = 0; i < access_count; i += vec::width) {
+                ivec pos(sd::unaligned(&idx[i]));
+                sd::unaligned(&out[i]) = sd::gather(table.data(), pos);
+            }
+        },
+        repeats);
+    ivec::storage_t start;
+    for (std::size_t i = 0; i < vec::width; i++) start[i] = idx[i];
+    ivec chain(start);
+    double gather_chase_ns = measure_ns(
+        [&]() {
+            for (int i = 0; i < chain_length; i++) chain = sd::gather(next.data(), chain);
+        },
+        repeats);
+    print_row("gather", double(access_count) / gather_ns, gather_chase_ns / double(chain_length));
+
+    double store_ns = measure_ns(
+        [&]() {
+            for (std::size_t i = 0; i < access_count; i++) {
+                table[std::size_t(scalar_idx[i])] = values[i];
+            }
+        },
+        repeats);
+    print_row("scalar store", double(access_count) / store_ns);
+
+    double scatter_ns = measure_ns(
+        [&]() {
+            for (std::size_t i = 0; i < access_count; i += vec::width) {
+                ivec pos(sd::unaligned(&idx[i]));
+                sd::scatter(table.data(), pos, vec(sd::unaligned(&values[i])));
+            }
+        },
+        repeats);
+    print_row("scatter", double(access_count) / scatter_ns);
+
+    sink = out[access_count / 2] + table[table_size / 2] + float(at + first_scalar(chain));
+}
+
+int main() {
+    std::printf("vector width: %d\n", int(vec::width));
+    std::printf("throughput in accessed scalars/ns, latency in ns per dependent load\n");
+    bench("table of 16 KiB (L1)", std::size_t(1) << 12, 20);
+    bench("table of 1 MiB (L2)", std::size_t(1) << 18, 20);
+    bench("table of 256 MiB (DRAM)", std::size_t(1) << 26, 5);
+}
@@ -0,0 +1,101 @@
+#include "measure.hpp"
+#include <simdee/simdee.hpp>
+#include <vector>
+
+// Reduces vectors to a scalar, comparing hsum(), hprod(), hmin(), hmax() and dot() against
+// first_scalar(reduce()). The throughput reduces an array with four independent accumulators, the
+// latency is measured on a chain in which every result is broadcast into the next input.
+
+#if SIMDEE_AVX512
+using vec = sd::vec16f;
+#elif SIMDEE_AVX || SIMDEE_NEON
+using vec = sd::vec8f;
+#else
+using vec = sd::vec4f;
+#endif
+
+const std::size_t width = vec::width;
+const std::size_t count = std::size_t(1) << 12; // fits into L1 cache
+const int chain = 1 << 16;
+volatile float sink;
+
+struct sum_reduce {
+    float operator()(const vec& v) const { return first_scalar(reduce(v, sd::op_add{})); }
+};
+struct sum_h {
+    float operator()(const vec& v) const { return hsum(v); }
+};
+struct prod_reduce {
+    float operator()(const vec& v) const { return first_scalar(reduce(v, sd::op_mul{})); }
+};
+struct prod_h {
+    float operator()(const vec& v) const { return hprod(v); }
+};
+struct min_reduce {
+    float operator()(const vec& v) const { return first_scalar(reduce(v, sd::op_min{})); }
+};
+struct min_h {
+    float operator()(const vec& v) const { return hmin(v); }
+};
+struct max_reduce {
+    float operator()(const vec& v) const { return first_scalar(reduce(v, sd::op_max{})); }
+};
+struct max_h {
+    float operator()(const vec& v) const { return hmax(v); }
+};
+struct dot_reduce {
+    vec w;
+    float operator()(const vec& v) const { return first_scalar(reduce(v * w, sd::op_add{})); }
+};
+struct dot_h {
+    vec w;
+    float operator()(const vec& v) const { return dot(v, w); }
+};
+
+// scale keeps the chain at a fixed point, so that it neither overflows nor reaches denormals
+template <typename Kernel>
+void bench(const char* name, const std::vector<float>& in, Kernel kernel, float scale) {
+    double throughput_ns = measure_ns([&]() {
+        float acc[4] = {};
+        for (std::size_t i = 0; i < count; i += 4 * width) {
+            for (std::size_t k = 0; k < 4; k++) {
+                acc[k] += kernel(vec(sd::unaligned(&in[i + k * width])));
+            }
+        }
+        sink = acc[0] + acc[1] + acc[2] + acc[3];
+    });
+
+    double latency_ns = measure_ns(
+        [&]() {
+            vec x(1.f);
+            for (int i = 0; i < chain; i++) x = vec(kernel(x)) * vec(scale);
+            sink = first_scalar(x);
+        },
+        10);
+
+    print_row(name, double(count) / throughput_ns, latency_ns / chain);
+}
+
+int main() {
+    std::printf("vector width: %d\n", int(width));
+    std::vector<float> in(count);
+    for (std::size_t i = 0; i < count; i++) in[i] = 1.f + float(i % 7) * 0.001f;
+    const float inv_width = 1.f / float(width);
+    const vec w(inv_width);
+
+    print_header("sum");
+    bench("first_scalar(reduce())", in, sum_reduce(), inv_width);
+    bench("hsum()", in, sum_h(), inv_width);
+    print_header("product");
+    bench("first_scalar(reduce())", in, prod_reduce(), 1.f);
+    bench("hprod()", in, prod_h(), 1.f);
+    print_header("minimum");
+    bench("first_scalar(reduce())", in, min_reduce(), 1.f);
+    bench("hmin()", in, min_h(), 1.f);
+    print_header("maximum");
+    bench("first_scalar(reduce())", in, max_reduce(), 1.f);
+    bench("hmax()", in, max_h(), 1.f);
+    print_header("dot product");
+    bench("first_scalar(reduce())", in, dot_reduce{w}, 1.f);
+    bench("dot()", in, dot_h{w}, 1.f);
+}
@@ -0,0 +1,88 @@
+#include "measure.hpp"
+#include <simdee/simdee.hpp>
+#include <simdee/util/allocator.hpp>
+#include <cstring>
+#include <random>
+#include <vector>
+
+// Allocates a 512 MB array of floats with page alignment and with huge_page_memory, then measures
+// the first touch (page faults), a streaming sum and reads at random positions (TLB misses). On
+// Linux, the amount of memory backed by transparent huge pages is printed as well.
+
+#if SIMDEE_AVX512
+using vec = sd::vec16f;
+#elif SIMDEE_AVX || SIMDEE_NEON
+using vec = sd::vec8f;
+#else
+using vec = sd::vec4f;
+#endif
+
+const std::size_t width = vec::width;
+const std::size_t count = std::size_t(128) << 20;
+const std::size_t reads = std::size_t(1) << 22;
+volatile float sink;
+
+#if defined(__linux__)
+void print_huge_pages() {
+    std::FILE* file = std::fopen("/proc/self/smaps_rollup", "r");
+    if (file == nullptr) return;
+    char line[256];
+    while (std::fgets(line, sizeof(line), file) != nullptr) {
+        if (std::strncmp(line, "AnonHugePages:", 14) == 0) std::printf("  %s", line);
+    }
+    std::fclose(file);
+}
+#else
+void print_huge_pages() {}
+#endif
+
+template <typename Policy>
+void bench(const char* title, const std::vector<uint32_t>& positions) {
+    print_header(title);
+    sd::allocator<float, Policy> alloc;
+    float* data = alloc.allocate(count);
+
+    // measure_ns() would fault the pages in during its warm-up run
+    using clk = std::chrono::steady_clock;
+    clk::time_point started_tp = clk::now();
+    std::memset(data, 0, count * sizeof(float));
+    std::chrono::duration<double, std::nano> touch_ns = clk::now() - started_tp;
+    print_row("first touch", double(count) / touch_ns.count());
+    for (std::size_t i = 0; i < count; i++) data[i] = float(i % 3);
+    print_huge_pages();
+
+    double stream_ns = measure_ns(
+        [&]() {
+            vec acc[4] = {vec(0.f), vec(0.f), vec(0.f), vec(0.f)};
+            for (std::size_t i = 0; i < count; i += 4 * width) {
+                for (std::size_t k = 0; k < 4; k++) {
+                    acc[k] = acc[k] + vec(sd::aligned(data + i + k * width));
+                }
+            }
+            sink = hsum(vec(acc[0] + acc[1] + acc[2] + acc[3]));
+        },
+        5);
+    print_row("streaming sum", double(count) / stream_ns);
+
+    double random_ns = measure_ns(
+        [&]() {
+            float acc = 0.f;
+            for (uint32_t pos : positions) acc += data[pos];
+            sink = acc;
+        },
+        5);
+    print_row("random reads", double(reads) / random_ns, random_ns / double(reads));
+
+    alloc.deallocate(data, count);
+}
+
+int main() {
+    std::printf("vector width: %d\n", int(width));
+    std::vector<uint32_t> positions(reads);
+    std::minstd_rand re(0x5eed);
+    std::uniform_int_distribution<uint32_t> dist(0, uint32_t(count - 1));
+    for (auto& pos : positions) pos = dist(re);
+
+    bench<sd::aligned_memory<sd::page_size>>("aligned_memory<page_size>", positions);
+    bench<sd::huge_page_memory>("huge_page_memory", positions);
+}
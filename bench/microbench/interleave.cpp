@@ -0,0 +1,94 @@
+#include "measure.hpp"
+#include <simdee/simdee.hpp>
+#include <simdee/util/allocator.hpp>
+#include <vector>
+
+// Compares load_interleaved() and store_interleaved() against scalar copy loops that convert
+// records of 2, 3 and 4 floats (e.g. xy, xyz, rgba) between an array of structures and blocks of
+// width records with one vector per field (as in the ray-box benchmark).
+
+#if SIMDEE_AVX512
+using vec = sd::vec16f;
+#elif SIMDEE_AVX || SIMDEE_NEON
+using vec = sd::vec8f;
+#else
+using vec = sd::vec4f;
+#endif
+
+using storage_t = vec::storage_t;
+using blocks_t = std::vector<storage_t, sd::allocator<storage_t>>;
+const std::size_t width = vec::width;
+volatile float sink;
+
+void load(const float* ptr, vec (&v)[2]) { sd::load_interleaved<2>(ptr, v[0], v[1]); }
+void load(const float* ptr, vec (&v)[3]) { sd::load_interleaved<3>(ptr, v[0], v[1], v[2]); }
+void load(const float* ptr, vec (&v)[4]) { sd::load_interleaved<4>(ptr, v[0], v[1], v[2], v[3]); }
+void store(float* ptr, const vec (&v)[2]) { sd::store_interleaved<2>(ptr, v[0], v[1]); }
+void store(float* ptr, const vec (&v)[3]) { sd::store_interleaved<3>(ptr, v[0], v[1], v[2]); }
+void store(float* ptr, const vec (&v)[4]) {
+    sd::store_interleaved<4>(ptr, v[0], v[1], v[2], v[3]);
+}
+
+template <std::size_t N>
+void bench(std::size_t records) {
+    const std::size_t blocks = records / width;
+    std::vector<float> aos(records * N);
+    blocks_t soa(blocks * N);
+    for (std::size_t i = 0; i < aos.size(); i++) aos[i] = float(i);
+
+    char title[64];
+    std::snprintf(title, sizeof(title), "%d fields, %d records", int(N), int(records));
+    print_header(title);
+
+    double to_soa_ns = measure_ns([&]() {
+        for (std::size_t b = 0; b < blocks; b++) {
+            const float* in = &aos[b * width * N];
+            for (std::size_t j = 0; j < width; j++) {
+                for (std::size_t f = 0; f < N; f++) soa[b * N + f][j] = in[j * N + f];
+            }
+        }
+    });
+    print_row("scalar AoS to SoA", double(aos.size()) / to_soa_ns);
+
+    double load_ns = measure_ns([&]() {
+        for (std::size_t b = 0; b < blocks; b++) {
+            vec v[N];
+            load(&aos[b * width * N], v);
+            for (std::size_t f = 0; f < N; f++) soa[b * N + f] = v[f];
+        }
+    });
+    print_row("load_interleaved", double(aos.size()) / load_ns);
+
+    double to_aos_ns = measure_ns([&]() {
+        for (std::size_t b = 0; b < blocks; b++) {
+            float* out = &aos[b * width * N];
+            for (std::size_t j = 0; j < width; j++) {
+                for (std::size_t f = 0; f < N; f++) out[j * N + f] = soa[b * N + f][j];
+            }
+        }
+    });
+    print_row("scalar SoA to AoS", double(aos.size()) / to_aos_ns);
+
+    double store_ns = measure_ns([&]() {
+        for (std::size_t b = 0; b < blocks; b++) {
+            vec v[N];
+            for (std::size_t f = 0; f < N; f++) v[f] = vec(soa[b * N + f]);
+            store(&aos[b * width * N], v);
+        }
+    });
+    print_row("store_interleaved", double(aos.size()) / store_ns);
+
+    sink = aos[records / 2] + soa[blocks / 2][0];
+}
+
+int main() {
+    std::printf("vector width: %d\n", int(width));
+    std::printf("throughput in copied scalars/ns\n");
+    const std::size_t l1 = 1024, l2 = 32 * 1024; // records; both layouts fit into L1 and L2
+    bench<2>(l1);
+    bench<3>(l1);
+    bench<4>(l1);
+    bench<2>(l2);
+    bench<3>(l2);
+    bench<4>(l2);
+}
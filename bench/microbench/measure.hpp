@@ -0,0 +1,34 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+// runs func repeatedly, returns the shortest observed duration of a single run in nanoseconds
+template <typename Func>
+double measure_ns(Func func, int repeats = 100) {
+    using clk = std::chrono::steady_clock;
+    func(); // warm-up
+    double best = 1e300;
+    for (int i = 0; i < repeats; i++) {
+        clk::time_point started_tp = clk::now();
+        func();
+        clk::time_point finished_tp = clk::now();
+        std::chrono::duration<double, std::nano> duration = finished_tp - started_tp;
+        best = std::min(best, duration.count());
+    }
+    return best;
+}
+
+// prints a table row with a throughput (scalars per nanosecond) and a latency (ns per operation)
+inline void print_row(const char* name, double throughput, double latency) {
+    std::printf("  %-28s %10.3f %12.3f\n", name, throughput, latency);
+}
+
+// prints a table row with a throughput only
+inline void print_row(const char* name, double throughput) {
+    std::printf("  %-28s %10.3f %12s\n", name, throughput, "-");
+}
+
+inline void print_header(const char* title) {
+    std::printf("%s\n  %-28s %10s %12s\n", title, "variant", "scalars/ns", "latency [ns]");
+}
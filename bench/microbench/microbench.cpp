@@ -51,7 +51,7 @@ __m128 initializer() {
     return r;
 }
 
-void finalizer(const __m128&) {
+void finalizer(const __m128& x) {
     float f = 0.f;
     f += _mm_cvtss_f32(x);
     f += _mm_cvtss_f32(_mm_shuffle_ps(x, x, _MM_SHUFFLE(1, 1, 1, 1)));
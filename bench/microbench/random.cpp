@@ -0,0 +1,68 @@
+// work around a STL bug in normal_distribution, where a double-to-float conversion produces a
+// warning
+#if defined(_MSC_VER)
+#pragma warning(disable : 4244)
+#endif
+
+#include "measure.hpp"
+#include <simdee/random.hpp>
+#include <simdee/simd_vectors/dum.hpp>
+#include <simdee/simdee.hpp>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+// Fills an array of 1M floats with uniform and normal deviates, with std::minstd_rand and the
+// distributions of <random> (as bench/raybox does to fill its data), with scalar xoshiro128+ and
+// with sd::xoshiro128p, which runs one generator per lane. The throughput is in floats per ns.
+
+#if SIMDEE_AVX512
+using vu = sd::vec16u;
+#elif SIMDEE_AVX || SIMDEE_NEON
+using vu = sd::vec8u;
+#else
+using vu = sd::vec4u;
+#endif
+
+const std::size_t count = std::size_t(1) << 20;
+volatile float sink;
+
+template <typename Func>
+void bench(const char* name, Func func) {
+    std::vector<float> out(count);
+    double ns = measure_ns([&]() {
+        func(out.data());
+        sink = out[count / 2];
+    });
+    print_row(name, double(count) / ns);
+}
+
+int main() {
+    std::minstd_rand re(0x8a7ac012);
+    std::mt19937 mt(0x8a7ac012);
+    std::uniform_real_distribution<float> uniform(0.f, 1.f);
+    std::normal_distribution<float> normal(0.f, 1.f);
+    sd::xoshiro128p<sd::dumu> scalar(0x8a7ac012);
+    sd::xoshiro128p<vu> vector(0x8a7ac012);
+
+    std::printf("vector width: %d scalars\n", int(vu::width));
+    print_header("uniform floats in [0, 1), 1M floats");
+    bench("std::minstd_rand", [&](float* out) {
+        for (std::size_t i = 0; i < count; i++) out[i] = uniform(re);
+    });
+    bench("std::mt19937", [&](float* out) {
+        for (std::size_t i = 0; i < count; i++) out[i] = uniform(mt);
+    });
+    bench("sd::xoshiro128p, scalar", [&](float* out) { scalar.fill_uniform(out, count); });
+    bench("sd::xoshiro128p, vector", [&](float* out) { vector.fill_uniform(out, count); });
+
+    print_header("normal floats, 1M floats");
+    bench("std::minstd_rand", [&](float* out) {
+        for (std::size_t i = 0; i < count; i++) out[i] = normal(re);
+    });
+    bench("std::mt19937", [&](float* out) {
+        for (std::size_t i = 0; i < count; i++) out[i] = normal(mt);
+    });
+    bench("sd::xoshiro128p, scalar", [&](float* out) { scalar.fill_normal(out, count); });
+    bench("sd::xoshiro128p, vector", [&](float* out) { vector.fill_normal(out, count); });
+}
@@ -0,0 +1,56 @@
+#include "measure.hpp"
+#include <simdee/simdee.hpp>
+#include <vector>
+
+// Measures throughput and latency of rcp() and rsqrt() at each accuracy tier, using the widest
+// vector type that the target instruction set supports natively.
+
+#if SIMDEE_AVX512
+using vec = sd::vec16f;
+#elif SIMDEE_AVX || SIMDEE_NEON
+using vec = sd::vec8f;
+#else
+using vec = sd::vec4f;
+#endif
+
+const std::size_t array_size = 4096; // fits into L1 cache
+const int chain_length = 100000;
+
+template <typename Func>
+void bench(const char* name, Func func) {
+    std::vector<float> in(array_size), out(array_size);
+    for (std::size_t i = 0; i < array_size; i++) in[i] = 1.f + float(i) / float(array_size);
+
+    double throughput_ns = measure_ns([&]() {
+        for (std::size_t i = 0; i < array_size; i += vec::width) {
+            func(vec(sd::unaligned(&in[i]))).unaligned_store(&out[i]);
+        }
+    });
+
+    vec x(sd::unaligned(&in[0]));
+    double latency_ns = measure_ns(
+        [&]() {
+            for (int i = 0; i < chain_length; i++) x = func(x);
+        },
+        10);
+    x.unaligned_store(&out[0]);
+
+    float sum = 0.f;
+    for (float v : out) sum += v;
+    print_row(name, double(array_size) / throughput_ns, latency_ns / double(chain_length));
+    if (sum != sum) std::printf("unexpected NaN\n");
+}
+
+int main() {
+    std::printf("vector width: %d\n", int(vec::width));
+
+    print_header("rcp");
+    bench("accuracy::estimate", [](const vec& x) { return sd::rcp<sd::accuracy::estimate>(x); });
+    bench("accuracy::newton", [](const vec& x) { return sd::rcp<sd::accuracy::newton>(x); });
+    bench("accuracy::full", [](const vec& x) { return sd::rcp<sd::accuracy::full>(x); });
+
+    print_header("rsqrt");
+    bench("accuracy::estimate", [](const vec& x) { return sd::rsqrt<sd::accuracy::estimate>(x); });
+    bench("accuracy::newton", [](const vec& x) { return sd::rsqrt<sd::accuracy::newton>(x); });
+    bench("accuracy::full", [](const vec& x) { return sd::rsqrt<sd::accuracy::full>(x); });
+}
@@ -0,0 +1,47 @@
+#include "measure.hpp"
+#include <simdee/scan.hpp>
+#include <simdee/simdee.hpp>
+#include <numeric>
+#include <vector>
+
+// Computes the prefix sums of an array with std::partial_sum and with sd::inclusive_scan(). The
+// small array fits into L1 cache, the large one only into DRAM.
+
+#if SIMDEE_AVX512
+using vec = sd::vec16f;
+#elif SIMDEE_AVX || SIMDEE_NEON
+using vec = sd::vec8f;
+#else
+using vec = sd::vec4f;
+#endif
+
+volatile double sink;
+
+template <typename Simd_t>
+void bench(const char* type, std::size_t n, int repeats) {
+    using scalar_t = typename Simd_t::scalar_t;
+    std::vector<scalar_t> in(n), out(n);
+    for (std::size_t i = 0; i < n; i++) in[i] = scalar_t(i % 5);
+
+    char title[64];
+    std::snprintf(title, sizeof(title), "%d %ss", int(n), type);
+    print_header(title);
+
+    double partial_sum_ns =
+        measure_ns([&]() { std::partial_sum(in.begin(), in.end(), out.begin()); }, repeats);
+    print_row("std::partial_sum", double(n) / partial_sum_ns);
+
+    double scan_ns = measure_ns(
+        [&]() { sd::inclusive_scan<Simd_t>(in.data(), in.data() + n, out.data()); }, repeats);
+    print_row("sd::inclusive_scan", double(n) / scan_ns);
+
+    sink = double(out[n - 1]);
+}
+
+int main() {
+    std::printf("vector width: %d\n", int(vec::width));
+    bench<vec>("float", 4096, 1000);
+    bench<vec::vec_s>("int32", 4096, 1000);
+    bench<vec>("float", std::size_t(1) << 24, 10);
+    bench<vec::vec_s>("int32", std::size_t(1) << 24, 10);
+}
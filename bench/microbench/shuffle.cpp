@@ -0,0 +1,95 @@
+#include "measure.hpp"
+#include <simdee/simdee.hpp>
+#include <vector>
+
+// Reverses an array and maps an array of small indices through a table of width values. Scalar
+// loops and a round trip through storage_t are compared against shuffle() and permute().
+
+#if SIMDEE_AVX512
+using vec = sd::vec16f;
+#elif SIMDEE_AVX || SIMDEE_NEON
+using vec = sd::vec8f;
+#else
+using vec = sd::vec4f;
+#endif
+
+using vec_s = vec::vec_s;
+using storage_t = vec::storage_t;
+const std::size_t width = vec::width;
+const std::size_t count = std::size_t(1) << 14; // fits into L1 cache
+volatile float sink;
+
+template <typename T>
+T reverse(const T& v, std::integral_constant<std::size_t, 4>) {
+    return sd::shuffle<3, 2, 1, 0>(v);
+}
+template <typename T>
+T reverse(const T& v, std::integral_constant<std::size_t, 8>) {
+    return sd::shuffle<7, 6, 5, 4, 3, 2, 1, 0>(v);
+}
+template <typename T>
+T reverse(const T& v, std::integral_constant<std::size_t, 16>) {
+    return sd::shuffle<15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0>(v);
+}
+
+void bench_reverse(const std::vector<float>& in, std::vector<float>& out) {
+    print_header("reverse an array");
+
+    double scalar_ns = measure_ns([&]() {
+        for (std::size_t i = 0; i < count; i++) out[count - 1 - i] = in[i];
+    });
+    print_row("scalar", double(count) / scalar_ns);
+
+    double reload_ns = measure_ns([&]() {
+        for (std::size_t i = 0; i < count; i += width) {
+            storage_t a, b;
+            a = vec(sd::unaligned(&in[i]));
+            for (std::size_t k = 0; k < width; k++) b[k] = a[width - 1 - k];
+            sd::unaligned(&out[count - width - i]) = vec(b);
+        }
+    });
+    print_row("store and reload", double(count) / reload_ns);
+
+    double shuffle_ns = measure_ns([&]() {
+        for (std::size_t i = 0; i < count; i += width) {
+            vec v(sd::unaligned(&in[i]));
+            sd::unaligned(&out[count - width - i]) =
+                reverse(v, std::integral_constant<std::size_t, width>());
+        }
+    });
+    print_row("shuffle()", double(count) / shuffle_ns);
+
+    sink = out[1];
+}
+
+void bench_lookup(const std::vector<float>& table, const std::vector<int>& in,
+                  std::vector<float>& out) {
+    print_header("table lookup");
+
+    double scalar_ns = measure_ns([&]() {
+        for (std::size_t i = 0; i < count; i++) out[i] = table[std::size_t(in[i])];
+    });
+    print_row("scalar", double(count) / scalar_ns);
+
+    double permute_ns = measure_ns([&]() {
+        vec t(sd::unaligned(table.data()));
+        for (std::size_t i = 0; i < count; i += width) {
+            vec_s idx(sd::unaligned(&in[i]));
+            sd::unaligned(&out[i]) = sd::permute(t, idx);
+        }
+    });
+    print_row("permute()", double(count) / permute_ns);
+
+    sink = out[1];
+}
+
+int main() {
+    std::printf("vector width: %d\n", int(width));
+    std::vector<float> in(count), out(count), table(width);
+    std::vector<int> indices(count);
+    for (std::size_t i = 0; i < count; i++) in[i] = float(i);
+    for (std::size_t i = 0; i < width; i++) table[i] = float(i * i);
+    for (std::size_t i = 0; i < count; i++) indices[i] = int((i * 7 + i / 3) % width);
+    bench_reverse(in, out);
+    bench_lookup(table, indices, out);
+}
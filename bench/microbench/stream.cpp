@@ -0,0 +1,128 @@
+#include "measure.hpp"
+#include <simdee/simdee.hpp>
+#include <simdee/util/allocator.hpp>
+#include <random>
+#include <vector>
+
+// Compares aligned stores with streaming (non-temporal) stores when filling an array and when
+// scaling one array into another, once with arrays that fit into L2 and once with 256 MB arrays,
+// larger than the last-level cache. Then measures a sum of a large array read at random positions,
+// without and with sd::prefetch() of the position that is read a few iterations later.
+
+#if SIMDEE_AVX512
+using vec = sd::vec16f;
+#elif SIMDEE_AVX || SIMDEE_NEON
+using vec = sd::vec8f;
+#else
+using vec = sd::vec4f;
+#endif
+
+const std::size_t width = vec::width;
+const std::size_t small_count = std::size_t(256) << 10;
+const std::size_t large_count = std::size_t(64) << 20;
+const std::size_t reads = std::size_t(1) << 22;
+const std::size_t distance = 16;
+volatile float sink;
+
+using array_t = std::vector<float, sd::allocator<float, sd::aligned_memory<sd::page_size>>>;
+
+void bench_stores(const char* title, std::size_t count, int repeats) {
+    print_header(title);
+    array_t in(count, 1.f), out(count, 0.f);
+    const vec factor(3.f);
+
+    double ns = measure_ns(
+        [&]() {
+            const float value = sink;
+            const vec x(value);
+            for (std::size_t i = 0; i < count; i += width) sd::aligned(&out[i]) = x;
+            sink = out[count / 2];
+        },
+        repeats);
+    print_row("fill, aligned", double(count) / ns);
+
+    ns = measure_ns(
+        [&]() {
+            const float value = sink;
+            const vec x(value);
+            for (std::size_t i = 0; i < count; i += width) sd::streaming(&out[i]) = x;
+            sd::stream_fence();
+            sink = out[count / 2];
+        },
+        repeats);
+    print_row("fill, streaming", double(count) / ns);
+
+    ns = measure_ns(
+        [&]() {
+            for (std::size_t i = 0; i < count; i += width) {
+                sd::aligned(&out[i]) = factor * vec(sd::aligned(&in[i]));
+            }
+            sink = out[count / 2];
+        },
+        repeats);
+    print_row("scale, aligned", double(count) / ns);
+
+    ns = measure_ns(
+        [&]() {
+            for (std::size_t i = 0; i < count; i += width) {
+                sd::streaming(&out[i]) = factor * vec(sd::aligned(&in[i]));
+            }
+            sd::stream_fence();
+            sink = out[count / 2];
+        },
+        repeats);
+    print_row("scale, streaming", double(count) / ns);
+}
+
+void bench_prefetch(const std::vector<uint32_t>& positions) {
+    print_header("random reads of a 256 MB array");
+    array_t data(large_count);
+    for (std::size_t i = 0; i < large_count; i++) data[i] = float(i % 3);
+    const std::size_t n = positions.size() - distance;
+
+    double ns = measure_ns(
+        [&]() {
+            float acc = 0.f;
+            for (std::size_t i = 0; i < n; i++) acc += data[positions[i]];
+            sink = acc;
+        },
+        5);
+    print_row("plain", double(n) / ns, ns / double(n));
+
+    ns = measure_ns(
+        [&]() {
+            float acc = 0.f;
+            for (std::size_t i = 0; i < n; i++) {
+                sd::prefetch(&data[positions[i + distance]]);
+                acc += data[positions[i]];
+            }
+            sink = acc;
+        },
+        5);
+    print_row("prefetch<t0>", double(n) / ns, ns / double(n));
+
+    ns = measure_ns(
+        [&]() {
+            float acc = 0.f;
+            for (std::size_t i = 0; i < n; i++) {
+                sd::prefetch<sd::prefetch_hint::nta>(&data[positions[i + distance]]);
+                acc += data[positions[i]];
+            }
+            sink = acc;
+        },
+        5);
+    print_row("prefetch<nta>", double(n) / ns, ns / double(n));
+}
+
+int main() {
+    std::printf("vector width: %d\n", int(width));
+    sink = 1.f;
+    bench_stores("1 MB arrays", small_count, 200);
+    bench_stores("256 MB arrays", large_count, 5);
+
+    std::vector<uint32_t> positions(reads);
+    std::minstd_rand re(0x5eed);
+    std::uniform_int_distribution<uint32_t> dist(0, uint32_t(large_count - 1));
+    for (auto& pos : positions) pos = dist(re);
+    bench_prefetch(positions);
+}
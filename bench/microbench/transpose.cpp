@@ -0,0 +1,97 @@
+#include "measure.hpp"
+#include <simdee/simdee.hpp>
+#include <vector>
+
+// Transposes a square matrix in tiles of width x width scalars. Each tile is transposed either by
+// scalar code, by storing its rows into storage_t and reloading the columns, or in registers with
+// transpose(). The small matrix fits into L1 cache, the large one only into DRAM.
+
+#if SIMDEE_AVX512
+using vec = sd::vec16f;
+#elif SIMDEE_AVX || SIMDEE_NEON
+using vec = sd::vec8f;
+#else
+using vec = sd::vec4f;
+#endif
+
+using storage_t = vec::storage_t;
+const std::size_t width = vec::width;
+volatile float sink;
+
+template <typename T>
+void transpose_rows(T (&r)[4]) {
+    sd::transpose(r[0], r[1], r[2], r[3]);
+}
+template <typename T>
+void transpose_rows(T (&r)[8]) {
+    sd::transpose(r[0], r[1], r[2], r[3], r[4], r[5], r[6], r[7]);
+}
+template <typename T>
+void transpose_rows(T (&r)[16]) {
+    sd::transpose(r[0], r[1], r[2], r[3], r[4], r[5], r[6], r[7], r[8], r[9], r[10], r[11], r[12],
+                  r[13], r[14], r[15]);
+}
+
+// calls tile(in, out) with the top left corners of all tiles in the source and the destination
+template <typename Tile>
+void for_each_tile(const std::vector<float>& in, std::vector<float>& out, std::size_t n,
+                   Tile tile) {
+    for (std::size_t bi = 0; bi < n; bi += width) {
+        for (std::size_t bj = 0; bj < n; bj += width) tile(&in[bi * n + bj], &out[bj * n + bi]);
+    }
+}
+
+void bench(std::size_t n, int repeats) {
+    std::vector<float> in(n * n), out(n * n);
+    for (std::size_t i = 0; i < in.size(); i++) in[i] = float(i);
+
+    char title[64];
+    std::snprintf(title, sizeof(title), "%d x %d matrix", int(n), int(n));
+    print_header(title);
+
+    double scalar_ns = measure_ns(
+        [&]() {
+            for_each_tile(in, out, n, [n](const float* src, float* dst) {
+                for (std::size_t i = 0; i < width; i++) {
+                    for (std::size_t j = 0; j < width; j++) dst[j * n + i] = src[i * n + j];
+                }
+            });
+        },
+        repeats);
+    print_row("scalar", double(in.size()) / scalar_ns);
+
+    double reload_ns = measure_ns(
+        [&]() {
+            for_each_tile(in, out, n, [n](const float* src, float* dst) {
+                storage_t rows[width], cols[width];
+                for (std::size_t i = 0; i < width; i++) rows[i] = vec(sd::unaligned(src + i * n));
+                for (std::size_t i = 0; i < width; i++) {
+                    for (std::size_t j = 0; j < width; j++) cols[i][j] = rows[j][i];
+                }
+                for (std::size_t i = 0; i < width; i++) sd::unaligned(dst + i * n) = vec(cols[i]);
+            });
+        },
+        repeats);
+    print_row("store and reload", double(in.size()) / reload_ns);
+
+    double transpose_ns = measure_ns(
+        [&]() {
+            for_each_tile(in, out, n, [n](const float* src, float* dst) {
+                vec rows[width];
+                for (std::size_t i = 0; i < width; i++) rows[i] = vec(sd::unaligned(src + i * n));
+                transpose_rows(rows);
+                for (std::size_t i = 0; i < width; i++) sd::unaligned(dst + i * n) = rows[i];
+            });
+        },
+        repeats);
+    print_row("transpose()", double(in.size()) / transpose_ns);
+
+    sink = out[n + 1];
+}
+
+int main() {
+    std::printf("vector width: %d\n", int(width));
+    std::printf("throughput in transposed scalars/ns\n");
+    bench(64, 1000);
+    bench(4096, 10);
+}
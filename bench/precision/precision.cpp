@@ -1,14 +1,26 @@
 #include "run.hpp"
+#include <simdee/math.hpp>
 #include <simdee/simdee.hpp>
 
 float gt_recp(float x) { return 1 / x; }
 float gt_rsqrt(float x) { return float(1 / std::sqrt(double(x))); }
 float gt_sqrt(float x) { return std::sqrt(x); }
+double gt_exp(float x) { return std::exp(double(x)); }
+double gt_log(float x) { return std::log(double(x)); }
+double gt_sin(float x) { return std::sin(double(x)); }
+double gt_cos(float x) { return std::cos(double(x)); }
+double gt_tanh(float x) { return std::tanh(double(x)); }
+
+// evaluates an sd::math function with a SIMD vector of identical values
+template <typename Fn>
+float math_routine(Fn fn, float x) {
+    return first_scalar(fn(sd::vec4f(x)));
+}
 
 int main(int argc, char** argv) {
     run_opts opts = {};
     struct {
-        bool recp, rsqrt, sqrt;
+        bool recp, rsqrt, sqrt, math;
     } algos = {};
     bool abort = argc < 2;
 
@@ -21,10 +33,13 @@ int main(int argc, char** argv) {
             algos.rsqrt = true;
         } else if (0 == std::strcmp(argv[i], "--sqrt")) {
             algos.sqrt = true;
+        } else if (0 == std::strcmp(argv[i], "--math")) {
+            algos.math = true;
         } else if (0 == std::strcmp(argv[i], "--all")) {
             algos.recp = true;
             algos.rsqrt = true;
             algos.sqrt = true;
+            algos.math = true;
         } else {
             abort = true;
             break;
@@ -33,13 +48,16 @@ int main(int argc, char** argv) {
 
     if (abort) {
         std::printf(
-            "Usage: simdee-precision [--exhaustive] [--recp] [--rsqrt] [--sqrt]\n"
+            "Usage: simdee-precision [--exhaustive] [--recp] [--rsqrt] [--sqrt] [--math]\n"
             "Options:\n"
             "  --exhaustive\n"
             "    Performs the operation with all possible inputs, as opposed to a number of\n"
             "    randomly-selected inputs.\n"
             "  --recp / --rsqrt / --sqrt\n"
             "    Include certain tests (reciprocal, reciprocal square root, square root).\n"
+            "  --math\n"
+            "    Include the transcendental functions from sd::math (exp, log, sin, cos, tanh,\n"
+            "    pow).\n"
             "  --all\n"
             "    Include all tests.\n");
         return -1;
@@ -118,4 +136,52 @@ int main(int argc, char** argv) {
         });
     }
 #endif
+
+    if (algos.recp) {
+        using vec = sd::vec4f;
+        run(opts, "recp sd::accuracy::estimate", false, gt_recp,
+            [](float x) { return first_scalar(sd::rcp<sd::accuracy::estimate>(vec(x))); });
+        run(opts, "recp sd::accuracy::newton", false, gt_recp,
+            [](float x) { return first_scalar(sd::rcp<sd::accuracy::newton>(vec(x))); });
+        run(opts, "recp sd::accuracy::full", false, gt_recp,
+            [](float x) { return first_scalar(sd::rcp<sd::accuracy::full>(vec(x))); });
+    }
+    if (algos.rsqrt) {
+        using vec = sd::vec4f;
+        run(opts, "rsqrt sd::accuracy::estimate", true, gt_rsqrt,
+            [](float x) { return first_scalar(sd::rsqrt<sd::accuracy::estimate>(vec(x))); });
+        run(opts, "rsqrt sd::accuracy::newton", true, gt_rsqrt,
+            [](float x) { return first_scalar(sd::rsqrt<sd::accuracy::newton>(vec(x))); });
+        run(opts, "rsqrt sd::accuracy::full", true, gt_rsqrt,
+            [](float x) { return first_scalar(sd::rsqrt<sd::accuracy::full>(vec(x))); });
+    }
+    if (algos.math) {
+        const float max = std::numeric_limits<float>::max();
+        const float pi = 3.14159265f;
+        using vec = sd::vec4f;
+
+        run(opts, "exp sd::math", -max, max, gt_exp,
+            [](float x) { return math_routine(sd::math::exp<vec>, x); });
+        run(opts, "log sd::math", true, gt_log,
+            [](float x) { return math_routine(sd::math::log<vec>, x); });
+        run(opts, "sin sd::math |x| <= pi", -pi, pi, gt_sin,
+            [](float x) { return math_routine(sd::math::sin<vec>, x); });
+        run(opts, "sin sd::math |x| <= 8192", -8192.f, 8192.f, gt_sin,
+            [](float x) { return math_routine(sd::math::sin<vec>, x); });
+        run(opts, "cos sd::math |x| <= pi", -pi, pi, gt_cos,
+            [](float x) { return math_routine(sd::math::cos<vec>, x); });
+        run(opts, "cos sd::math |x| <= 8192", -8192.f, 8192.f, gt_cos,
+            [](float x) { return math_routine(sd::math::cos<vec>, x); });
+        run(opts, "tanh sd::math", -max, max, gt_tanh,
+            [](float x) { return math_routine(sd::math::tanh<vec>, x); });
+        run(opts, "pow sd::math x^2.5", true,
+            [](float x) { return std::pow(double(x), 2.5); },
+            [](float x) { return first_scalar(sd::math::pow(vec(x), vec(2.5f))); });
+        run(opts, "pow sd::math x^-3", false,
+            [](float x) { return std::pow(double(x), -3.); },
+            [](float x) { return first_scalar(sd::math::pow(vec(x), vec(-3.f))); });
+        run(opts, "pow sd::math 0.7^y", -max, max,
+            [](float y) { return std::pow(double(0.7f), double(y)); },
+            [](float y) { return first_scalar(sd::math::pow(vec(0.7f), vec(y))); });
+    }
 }
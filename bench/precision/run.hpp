@@ -1,6 +1,7 @@
 #pragma once
 #include "stats_printer.hpp"
 #include <cstring>
+#include <limits>
 #include <random>
 
 const int g_non_exhaustive_retries = 10000000;
@@ -9,23 +10,30 @@ struct run_opts {
     bool exhaustive;
 };
 
+// evaluates routine with inputs from [lo, hi] and compares the results with gt_routine
 template <typename GtRoutine, typename Routine>
-void run(const run_opts& opts, const char* name, bool positive_only, GtRoutine gt_routine,
+void run(const run_opts& opts, const char* name, float lo, float hi, GtRoutine gt_routine,
          Routine routine) {
     stats_printer sp(name);
-    auto process = [gt_routine, routine, &sp](uint32_t ux) {
+    auto process = [lo, hi, gt_routine, routine, &sp](uint32_t ux) {
         float x;
         std::memcpy(&x, &ux, sizeof(float));
         if (std::isnan(x) || std::isinf(x)) { return; }
-        float value = routine(x);
-        float gt = gt_routine(x);
-        sp.update(value, gt);
+        if (x < lo || x > hi) { return; }
+        sp.update(routine(x), gt_routine(x));
     };
-    uint32_t mask = positive_only ? 0x7fffffff : 0xffffffff;
     if (opts.exhaustive) {
-        for (uint32_t i = 0; i < mask; i++) { process(i); }
+        uint32_t i = 0;
+        do { process(i); } while (++i != 0);
     } else {
-        std::minstd_rand rand(0x0f15aa32);
-        for (int i = 0; i < g_non_exhaustive_retries; i++) { process(uint32_t(rand()) & mask); }
+        std::mt19937 rand(0x0f15aa32);
+        for (int i = 0; i < g_non_exhaustive_retries; i++) { process(uint32_t(rand())); }
     }
 }
+
+template <typename GtRoutine, typename Routine>
+void run(const run_opts& opts, const char* name, bool positive_only, GtRoutine gt_routine,
+         Routine routine) {
+    const float max = std::numeric_limits<float>::max();
+    run(opts, name, positive_only ? 0.f : -max, max, gt_routine, routine);
+}
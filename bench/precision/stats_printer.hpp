@@ -4,15 +4,25 @@
 #include <cinttypes>
 #include <cmath>
 #include <cstdio>
+#include <limits>
 #include <string>
 
 class stats_printer {
 private:
     std::string m_name;
     double m_max_rel_err = 0.;
+    double m_max_abs_err = 0.;
+    double m_max_ulp_err = 0.;
     uint64_t m_retry_count = 0;
     uint64_t m_correct_count = 0;
 
+    // size of a unit in the last place of the float closest to x
+    static double ulp(float x) {
+        int exp;
+        std::frexp(x, &exp);
+        return std::ldexp(1., std::max(exp, -125) - 24);
+    }
+
 public:
     stats_printer(const char* name) : m_name(name) {}
 
@@ -23,17 +33,34 @@ public:
         std::printf("%s\n"
                     "  total          %" PRIu64 "\n"
                     "  correct        %" PRIu64 " (%.1f%%)\n"
-                    "  max rel error  %f * 2^%d\n",
+                    "  max rel error  %f * 2^%d\n"
+                    "  max abs error  %g\n"
+                    "  max ulp error  %.3f\n",
                     m_name.c_str(), m_retry_count, m_correct_count, correct_percent,
-                    max_rel_err_fract, max_rel_err_exp);
+                    max_rel_err_fract, max_rel_err_exp, m_max_abs_err, m_max_ulp_err);
     }
 
-    void update(double value, double gt) {
+    // gt is the exact result, or its approximation that is more precise than a float
+    void update(float value, double gt) {
+        const float gt_rounded = float(gt);
         m_retry_count++;
-        if (value == gt) { m_correct_count++; }
+        if (value == gt_rounded) { m_correct_count++; }
         if ((gt != 0) && (value != 0) && !std::isinf(value)) {
-            double rel_err = std::abs((value - gt) / gt);
+            double rel_err = std::abs((double(value) - gt) / gt);
             m_max_rel_err = std::max(m_max_rel_err, rel_err);
         }
+        if (std::isnan(value) || std::isnan(gt_rounded)) {
+            if (std::isnan(value) != std::isnan(gt_rounded)) {
+                m_max_abs_err = m_max_ulp_err = std::numeric_limits<double>::infinity();
+            }
+        } else if (std::isinf(value) || std::isinf(gt_rounded)) {
+            if (value != gt_rounded) {
+                m_max_abs_err = m_max_ulp_err = std::numeric_limits<double>::infinity();
+            }
+        } else {
+            double abs_err = std::abs(double(value) - gt);
+            m_max_abs_err = std::max(m_max_abs_err, abs_err);
+            m_max_ulp_err = std::max(m_max_ulp_err, abs_err / ulp(gt_rounded));
+        }
     }
 };
@@ -6,6 +6,7 @@
 
 #define SIMDEE_NEED_INT 0
 #include <simdee/simd_vectors/avx.hpp>
+#include <simdee/soa_vector.hpp>
 #include <simdee/util/allocator.hpp>
 
 #include <chrono>
@@ -63,6 +64,7 @@ int main() {
     std::vector<Result> resultsNonSimd(dataSize1);
     std::vector<Result> resultsHandSimd(dataSize1);
     std::vector<Result> resultsSimdee(dataSize1);
+    std::vector<Result> resultsSoa(dataSize1);
 
     // fill data
     std::minstd_rand re(0x8a7ac012);
@@ -89,6 +91,14 @@ int main() {
         }
     }
 
+    // the same data in an sd::soa_vector
+    enum Field { MinX, MinY, MinZ, MaxX, MaxY, MaxZ };
+    sd::soa_vector<sd::avxf, float, float, float, float, float, float> dataSoa;
+    dataSoa.reserve(dataSize1);
+    for (const auto& el : data1) {
+        dataSoa.push_back(el.minx, el.miny, el.minz, el.maxx, el.maxy, el.maxz);
+    }
+
     // common pre-calculations
     auto gamma = [](int n) {
         double eps2 = 0.5 * static_cast<double>(std::numeric_limits<float>::epsilon());
@@ -260,12 +270,57 @@ int main() {
         }
     };
 
+    // implementation using Simdee and sd::soa_vector
+    auto soa = [&]() {
+        auto resIt = resultsSoa.begin();
+
+        for (std::size_t b = 0; b < dataSoa.num_blocks(); ++b) {
+            sd::avxf minx = dataSoa.load<MinX>(b), maxx = dataSoa.load<MaxX>(b);
+            sd::avxf miny = dataSoa.load<MinY>(b), maxy = dataSoa.load<MaxY>(b);
+            auto tmin = ((dirIsNeg[0] ? maxx : minx) - rayOrigin.x) * invDir.x;
+            auto tmax = ((dirIsNeg[0] ? minx : maxx) - rayOrigin.x) * invDir.x;
+            auto tminy = ((dirIsNeg[1] ? maxy : miny) - rayOrigin.y) * invDir.y;
+            auto tmaxy = ((dirIsNeg[1] ? miny : maxy) - rayOrigin.y) * invDir.y;
+
+            sd::avxf factor(robustFactor);
+            tmax *= factor;
+            tmaxy *= factor;
+            auto fail = mask((tmin > tmaxy) || (tminy > tmax));
+
+            if (all(fail)) {
+                for (int i = 0; i < 8; ++i) { *(resIt++) = Result::fail; }
+                continue;
+            }
+
+            tmin = cond(tminy > tmin, tminy, tmin);
+            tmax = cond(tmaxy < tmax, tmaxy, tmax);
+            sd::avxf minz = dataSoa.load<MinZ>(b), maxz = dataSoa.load<MaxZ>(b);
+            auto tminz = ((dirIsNeg[2] ? maxz : minz) - rayOrigin.z) * invDir.z;
+            auto tmaxz = ((dirIsNeg[2] ? minz : maxz) - rayOrigin.z) * invDir.z;
+            tmaxz *= factor;
+            fail |= mask((tmin > tmaxz) || (tminz > tmax));
+
+            if (all(fail)) {
+                for (int i = 0; i < 8; ++i) { *(resIt++) = Result::fail; }
+                continue;
+            }
+
+            tmin = cond(tminz > tmin, tminz, tmin);
+            tmax = cond(tmaxz < tmax, tmaxz, tmax);
+            auto win = ~fail & mask((tmin < rayTMax) && (tmax > sd::zero()));
+
+            for (int i = 0; i < 8; ++i) { *(resIt++) = win[i] ? Result::win : Result::fail; }
+        }
+    };
+
     // check performance
     std::cout << "non-SIMD: " << benchmark_ms(nonSimd) << " ms\n";
     std::cout << "hand SIMD: " << benchmark_ms(handSimd) << " ms\n";
     std::cout << "Simdee: " << benchmark_ms(simdee) << " ms\n";
+    std::cout << "Simdee soa_vector: " << benchmark_ms(soa) << " ms\n";
 
     // check correctness
     if (resultsNonSimd != resultsHandSimd) std::cerr << "hand SIMD results incorrect\n";
     if (resultsNonSimd != resultsSimdee) std::cerr << "Simdee results incorrect\n";
+    if (resultsNonSimd != resultsSoa) std::cerr << "Simdee soa_vector results incorrect\n";
 }
@@ -0,0 +1,163 @@
+#include "raybox_dispatch.hpp"
+#include <simdee/util/allocator.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <vector>
+
+const char* const hline =
+    "===============================================================================\n";
+
+auto now = []() { return std::chrono::high_resolution_clock::now(); };
+
+template <typename Duration>
+double to_ms(Duration dur) {
+    using nanoseconds = std::chrono::nanoseconds;
+    return static_cast<double>(std::chrono::duration_cast<nanoseconds>(dur).count()) / 1.e6;
+}
+
+double benchmark_ms(std::function<void()> func) {
+    double best = std::numeric_limits<double>::infinity();
+    for (int i = 0; i < 24; i++) {
+        auto tp1 = now();
+        func();
+        auto tp2 = now();
+        double time = to_ms(tp2 - tp1);
+        best = std::min(best, time);
+    }
+    return best;
+}
+
+using dispatcher = sd::dispatcher<raybox::intersect_fn>;
+
+dispatcher make_dispatcher(sd::isa limit) {
+    return dispatcher(
+        {
+            {sd::isa::sse2, &raybox::intersect<sd::isa::sse2>},
+            {sd::isa::avx, &raybox::intersect<sd::isa::avx>},
+            {sd::isa::avx2, &raybox::intersect<sd::isa::avx2>},
+            {sd::isa::avx512, &raybox::intersect<sd::isa::avx512>},
+        },
+        limit);
+}
+
+// bound to the best variant once at startup
+const dispatcher intersect = make_dispatcher(sd::supported_isa());
+
+int main() {
+    using raybox::Block;
+    using raybox::Result;
+    using raybox::blockWidth;
+    std::cout << hline << "Benchmark: Ray-box intersection (runtime dispatch)\n";
+    std::cout << "detected: " << sd::isa_name(sd::supported_isa()) << "\n";
+    std::cout << "selected: " << sd::isa_name(intersect.target()) << "\n";
+
+    // allocate data
+    struct RayBoxData1 {
+        float minx, miny, minz, maxx, maxy, maxz;
+    };
+    const std::size_t numBlocks = 1024 * 512;
+    const std::size_t dataSize1 = blockWidth * numBlocks;
+    std::vector<Block, sd::allocator<Block>> blocks(numBlocks);
+    std::vector<RayBoxData1> data1(dataSize1);
+    std::vector<Result> resultsNonSimd(dataSize1);
+    std::vector<Result> resultsDispatch(dataSize1);
+
+    // fill data
+    std::minstd_rand re(0x8a7ac012);
+    std::normal_distribution<float> dist(0, 1);
+    for (auto& block : blocks) {
+        float* arrays[] = {block.minx, block.miny, block.minz, block.maxx, block.maxy, block.maxz};
+        for (float* arr : arrays) {
+            for (std::size_t j = 0; j < blockWidth; ++j) { arr[j] = dist(re); }
+        }
+    }
+
+    {
+        RayBoxData1* ptr = data1.data();
+        for (const auto& el : blocks) {
+            for (std::size_t j = 0; j < blockWidth; ++j) {
+                ptr->minx = el.minx[j];
+                ptr->miny = el.miny[j];
+                ptr->minz = el.minz[j];
+                ptr->maxx = el.maxx[j];
+                ptr->maxy = el.maxy[j];
+                ptr->maxz = el.maxz[j];
+                ptr++;
+            }
+        }
+    }
+
+    // common pre-calculations
+    auto gamma = [](int n) {
+        double eps2 = 0.5 * static_cast<double>(std::numeric_limits<float>::epsilon());
+        return static_cast<float>((n * eps2) / (1 - n * eps2));
+    };
+    raybox::Query query;
+    query.robustFactor = 1 + 2 * gamma(3);
+    for (auto& v : query.invDir) { v = dist(re); }
+    for (auto& v : query.rayOrigin) { v = dist(re); }
+    query.rayTMax = 100.f;
+    for (auto& v : query.dirIsNeg) { v = (dist(re) > 0) ? 1 : 0; }
+
+    // non-SIMD implementation (for correctness checking)
+    auto nonSimd = [&]() {
+        auto resIt = resultsNonSimd.begin();
+        const float* invDir = query.invDir;
+        const float* rayOrigin = query.rayOrigin;
+        const int* dirIsNeg = query.dirIsNeg;
+        const float robustFactor = query.robustFactor;
+
+        for (const auto& elem : data1) {
+            float tmin = ((dirIsNeg[0] ? elem.maxx : elem.minx) - rayOrigin[0]) * invDir[0];
+            float tmax = ((dirIsNeg[0] ? elem.minx : elem.maxx) - rayOrigin[0]) * invDir[0];
+            float tminy = ((dirIsNeg[1] ? elem.maxy : elem.miny) - rayOrigin[1]) * invDir[1];
+            float tmaxy = ((dirIsNeg[1] ? elem.miny : elem.maxy) - rayOrigin[1]) * invDir[1];
+            tmax *= robustFactor;
+            tmaxy *= robustFactor;
+            if (tmin > tmaxy || tminy > tmax) {
+                *(resIt++) = Result::fail;
+                continue;
+            }
+            if (tminy > tmin) tmin = tminy;
+            if (tmaxy < tmax) tmax = tmaxy;
+            float tminz = ((dirIsNeg[2] ? elem.maxz : elem.minz) - rayOrigin[2]) * invDir[2];
+            float tmaxz = ((dirIsNeg[2] ? elem.minz : elem.maxz) - rayOrigin[2]) * invDir[2];
+            tmaxz *= robustFactor;
+            if (tmin > tmaxz || tminz > tmax) {
+                *(resIt++) = Result::fail;
+                continue;
+            }
+            if (tminz > tmin) tmin = tminz;
+            if (tmaxz < tmax) tmax = tmaxz;
+            *(resIt++) = ((tmin < query.rayTMax) && (tmax > 0)) ? Result::win : Result::fail;
+        }
+    };
+
+    // check performance of the selected variant, then of all variants that the CPU supports
+    auto run = [&](dispatcher func) {
+        return [&, func]() { func(query, blocks.data(), numBlocks, resultsDispatch.data()); };
+    };
+    const double nonSimdMs = benchmark_ms(nonSimd);
+    const double selectedMs = benchmark_ms(run(intersect));
+    const double numRays = static_cast<double>(dataSize1);
+    std::cout << "non-SIMD: " << nonSimdMs << " ms\n";
+    std::cout << "dispatched (" << sd::isa_name(intersect.target()) << "): " << selectedMs
+              << " ms, " << numRays / (selectedMs * 1e3) << " Mboxes/s\n";
+    if (resultsNonSimd != resultsDispatch) std::cerr << "dispatched results incorrect\n";
+
+    const sd::isa variants[] = {sd::isa::sse2, sd::isa::avx, sd::isa::avx2, sd::isa::avx512};
+    for (sd::isa limit : variants) {
+        if (int(limit) > int(sd::supported_isa())) break;
+        std::fill(resultsDispatch.begin(), resultsDispatch.end(), Result{});
+        const double ms = benchmark_ms(run(make_dispatcher(limit)));
+        std::cout << sd::isa_name(limit) << ": " << ms << " ms\n";
+        if (resultsNonSimd != resultsDispatch) {
+            std::cerr << sd::isa_name(limit) << " results incorrect\n";
+        }
+    }
+}
@@ -0,0 +1,35 @@
+#ifndef SIMDEE_BENCH_RAYBOX_DISPATCH_HPP
+#define SIMDEE_BENCH_RAYBOX_DISPATCH_HPP
+
+#include <simdee/dispatch.hpp>
+
+#include <cstddef>
+
+namespace raybox {
+
+    const std::size_t blockWidth = 16;
+
+    struct alignas(64) Block {
+        float minx[blockWidth], miny[blockWidth], minz[blockWidth];
+        float maxx[blockWidth], maxy[blockWidth], maxz[blockWidth];
+    };
+
+    struct Query {
+        float invDir[3];
+        float rayOrigin[3];
+        float rayTMax;
+        float robustFactor;
+        int dirIsNeg[3];
+    };
+
+    enum class Result : char { fail = 13, win = 42 };
+
+    // compiled once per instruction set by simdee_add_dispatch_variants()
+    template <sd::isa Isa>
+    void intersect(const Query& query, const Block* blocks, std::size_t numBlocks, Result* results);
+
+    using intersect_fn = void(const Query&, const Block*, std::size_t, Result*);
+
+} // namespace raybox
+
+#endif // SIMDEE_BENCH_RAYBOX_DISPATCH_HPP
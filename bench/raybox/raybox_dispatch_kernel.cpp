@@ -0,0 +1,65 @@
+// This file is compiled once per instruction set, see simdee_add_dispatch_variants().
+#define SIMDEE_NEED_INT 0
+#include "raybox_dispatch.hpp"
+#include <simdee/vec16.hpp>
+
+namespace raybox {
+
+    template <sd::isa Isa>
+    void intersect(const Query& query, const Block* blocks, std::size_t numBlocks,
+                   Result* results) {
+        using vec = sd::vec16f;
+        static_assert(vec::width == blockWidth, "unexpected vector width");
+
+        const int* dirIsNeg = query.dirIsNeg;
+        const vec invDirX(query.invDir[0]), invDirY(query.invDir[1]), invDirZ(query.invDir[2]);
+        const vec rayOrigX(query.rayOrigin[0]), rayOrigY(query.rayOrigin[1]),
+            rayOrigZ(query.rayOrigin[2]);
+        const vec factor(query.robustFactor);
+        const vec rayTMax(query.rayTMax);
+
+        for (std::size_t b = 0; b < numBlocks; ++b) {
+            const Block& elem = blocks[b];
+            const vec minx(sd::aligned(&elem.minx[0])), maxx(sd::aligned(&elem.maxx[0]));
+            const vec miny(sd::aligned(&elem.miny[0])), maxy(sd::aligned(&elem.maxy[0]));
+
+            vec tmin = ((dirIsNeg[0] ? maxx : minx) - rayOrigX) * invDirX;
+            vec tmax = ((dirIsNeg[0] ? minx : maxx) - rayOrigX) * invDirX;
+            vec tminy = ((dirIsNeg[1] ? maxy : miny) - rayOrigY) * invDirY;
+            vec tmaxy = ((dirIsNeg[1] ? miny : maxy) - rayOrigY) * invDirY;
+
+            tmax *= factor;
+            tmaxy *= factor;
+            auto fail = mask((tmin > tmaxy) || (tminy > tmax));
+
+            if (all(fail)) {
+                for (std::size_t i = 0; i < blockWidth; ++i) { *(results++) = Result::fail; }
+                continue;
+            }
+
+            tmin = cond(tminy > tmin, tminy, tmin);
+            tmax = cond(tmaxy < tmax, tmaxy, tmax);
+            const vec minz(sd::aligned(&elem.minz[0])), maxz(sd::aligned(&elem.maxz[0]));
+            vec tminz = ((dirIsNeg[2] ? maxz : minz) - rayOrigZ) * invDirZ;
+            vec tmaxz = ((dirIsNeg[2] ? minz : maxz) - rayOrigZ) * invDirZ;
+            tmaxz *= factor;
+            fail |= mask((tmin > tmaxz) || (tminz > tmax));
+
+            if (all(fail)) {
+                for (std::size_t i = 0; i < blockWidth; ++i) { *(results++) = Result::fail; }
+                continue;
+            }
+
+            tmin = cond(tminz > tmin, tminz, tmin);
+            tmax = cond(tmaxz < tmax, tmaxz, tmax);
+            auto win = ~fail & mask((tmin < rayTMax) && (tmax > sd::zero()));
+
+            for (int i = 0; i < int(blockWidth); ++i) {
+                *(results++) = win[i] ? Result::win : Result::fail;
+            }
+        }
+    }
+
+    template void intersect<sd::compiled_isa>(const Query&, const Block*, std::size_t, Result*);
+
+} // namespace raybox
@@ -0,0 +1,265 @@
+#define SIMDEE_NEED_INT 0
+#include <simdee/simd_vectors/avx.hpp>
+#include <simdee/util/allocator.hpp>
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <vector>
+
+const char* const hline =
+    "===============================================================================\n";
+
+auto now = []() { return std::chrono::high_resolution_clock::now(); };
+
+template <typename Duration>
+double to_ms(Duration dur) {
+    using nanoseconds = std::chrono::nanoseconds;
+    return static_cast<double>(std::chrono::duration_cast<nanoseconds>(dur).count()) / 1.e6;
+}
+
+double benchmark_ms(std::function<void()> func) {
+    double best = std::numeric_limits<double>::infinity();
+    for (int i = 0; i < 24; i++) {
+        auto tp1 = now();
+        func();
+        auto tp2 = now();
+        double time = to_ms(tp2 - tp1);
+        best = std::min(best, time);
+    }
+    return best;
+}
+
+int main() {
+    std::cout << hline << "Benchmark: Ray-box intersection (double precision)\n";
+
+    // allocate data
+    struct RayBoxData1 {
+        double minx, miny, minz, maxx, maxy, maxz;
+    };
+    struct alignas(__m256d) RayBoxData4 {
+        double minx[4], miny[4], minz[4], maxx[4], maxy[4], maxz[4];
+    };
+    struct alignas(__m256d) RayBoxData4S {
+        sd::avxd::storage_t minx, miny, minz, maxx, maxy, maxz;
+    };
+    const std::size_t dataSize4 = 1024 * 1024;
+    const std::size_t dataSize1 = 4 * dataSize4;
+    using vec4 = std::vector<RayBoxData4, sd::allocator<RayBoxData4>>;
+    using vec1 = std::vector<RayBoxData1>;
+    using vec4S = std::vector<RayBoxData4S, sd::allocator<RayBoxData4S>>;
+    vec4 data4(dataSize4);
+    vec1 data1(dataSize1);
+    const vec4S& data4S = reinterpret_cast<const vec4S&>(data4);
+    enum class Result : char { fail = 13, win = 42 };
+    std::vector<Result> resultsNonSimd(dataSize1);
+    std::vector<Result> resultsHandSimd(dataSize1);
+    std::vector<Result> resultsSimdee(dataSize1);
+
+    // fill data
+    std::minstd_rand re(0x8a7ac012);
+    std::normal_distribution<double> dist(0, 1);
+    auto fill = [&dist, &re](double* data, std::size_t num) {
+        for (size_t i = 0; i < num; ++i) { *(data++) = dist(re); }
+    };
+    const std::size_t numDoubles = (sizeof(RayBoxData1) / sizeof(double)) * dataSize1;
+    fill(reinterpret_cast<double*>(data4.data()), numDoubles);
+
+    {
+        RayBoxData1* ptr = data1.data();
+        for (auto i = 0U; i < dataSize4; ++i) {
+            const auto& el = data4[i];
+            for (int j = 0; j < 4; ++j) {
+                ptr->minx = el.minx[j];
+                ptr->miny = el.miny[j];
+                ptr->minz = el.minz[j];
+                ptr->maxx = el.maxx[j];
+                ptr->maxy = el.maxy[j];
+                ptr->maxz = el.maxz[j];
+                ptr++;
+            }
+        }
+    }
+
+    // common pre-calculations
+    auto gamma = [](int n) {
+        double eps2 = 0.5 * std::numeric_limits<double>::epsilon();
+        return (n * eps2) / (1 - n * eps2);
+    };
+    struct Vec3d {
+        double x, y, z;
+    };
+    const double robustFactor = 1 + 2 * gamma(3);
+    const Vec3d invDir = {dist(re), dist(re), dist(re)};
+    const Vec3d rayOrigin = {dist(re), dist(re), dist(re)};
+    const double rayTMax = 100.;
+    const int dirIsNeg[3] = {(dist(re) > 0) ? 1 : 0, (dist(re) > 0) ? 1 : 0,
+                             (dist(re) > 0) ? 1 : 0};
+
+    // non-SIMD implementation (for correctness checking)
+    auto nonSimd = [&]() {
+        auto resIt = resultsNonSimd.begin();
+
+        for (const auto& elem : data1) {
+            double tmin = ((dirIsNeg[0] ? elem.maxx : elem.minx) - rayOrigin.x) * invDir.x;
+            double tmax = ((dirIsNeg[0] ? elem.minx : elem.maxx) - rayOrigin.x) * invDir.x;
+            double tminy = ((dirIsNeg[1] ? elem.maxy : elem.miny) - rayOrigin.y) * invDir.y;
+            double tmaxy = ((dirIsNeg[1] ? elem.miny : elem.maxy) - rayOrigin.y) * invDir.y;
+            tmax *= robustFactor;
+            tmaxy *= robustFactor;
+            if (tmin > tmaxy || tminy > tmax) {
+                *(resIt++) = Result::fail;
+                continue;
+            }
+            if (tminy > tmin) tmin = tminy;
+            if (tmaxy < tmax) tmax = tmaxy;
+            double tminz = ((dirIsNeg[2] ? elem.maxz : elem.minz) - rayOrigin.z) * invDir.z;
+            double tmaxz = ((dirIsNeg[2] ? elem.minz : elem.maxz) - rayOrigin.z) * invDir.z;
+            tmaxz *= robustFactor;
+            if (tmin > tmaxz || tminz > tmax) {
+                *(resIt++) = Result::fail;
+                continue;
+            }
+            if (tminz > tmin) tmin = tminz;
+            if (tmaxz < tmax) tmax = tmaxz;
+            *(resIt++) = ((tmin < rayTMax) && (tmax > 0)) ? Result::win : Result::fail;
+        }
+    };
+
+    // SIMD implementation by hand
+    auto handSimd = [&]() {
+        auto resIt = resultsHandSimd.begin();
+
+        for (const auto& elem : data4) {
+            uint32_t fail;
+            __m256d tmin, tmax;
+            {
+                __m256d minx = _mm256_load_pd(elem.minx);
+                __m256d maxx = _mm256_load_pd(elem.maxx);
+                __m256d idirx = _mm256_broadcast_sd(&invDir.x);
+                __m256d rayox = _mm256_broadcast_sd(&rayOrigin.x);
+                tmin = _mm256_mul_pd(_mm256_sub_pd(dirIsNeg[0] ? maxx : minx, rayox), idirx);
+                tmax = _mm256_mul_pd(_mm256_sub_pd(dirIsNeg[0] ? minx : maxx, rayox), idirx);
+            }
+
+            {
+                __m256d tminy, tmaxy;
+                {
+                    __m256d miny = _mm256_load_pd(elem.miny);
+                    __m256d maxy = _mm256_load_pd(elem.maxy);
+                    __m256d idiry = _mm256_broadcast_sd(&invDir.y);
+                    __m256d rayoy = _mm256_broadcast_sd(&rayOrigin.y);
+                    tminy = _mm256_mul_pd(_mm256_sub_pd(dirIsNeg[1] ? maxy : miny, rayoy), idiry);
+                    tmaxy = _mm256_mul_pd(_mm256_sub_pd(dirIsNeg[1] ? miny : maxy, rayoy), idiry);
+                }
+
+                __m256d factor = _mm256_broadcast_sd(&robustFactor);
+                tmax = _mm256_mul_pd(tmax, factor);
+                tmaxy = _mm256_mul_pd(tmaxy, factor);
+
+                {
+                    __m256d failcond = _mm256_or_pd(_mm256_cmp_pd(tmin, tmaxy, _CMP_GT_OQ),
+                                                   _mm256_cmp_pd(tminy, tmax, _CMP_GT_OQ));
+                    fail = uint32_t(_mm256_movemask_pd(failcond));
+
+                    if (fail == 0xF) {
+                        for (int i = 0; i < 4; ++i) { *(resIt++) = Result::fail; }
+                        continue;
+                    }
+                }
+
+                tmin = _mm256_blendv_pd(tmin, tminy, _mm256_cmp_pd(tminy, tmin, _CMP_GT_OQ));
+                tmax = _mm256_blendv_pd(tmax, tmaxy, _mm256_cmp_pd(tmaxy, tmax, _CMP_LT_OQ));
+            }
+
+            {
+                __m256d tminz, tmaxz;
+                {
+                    __m256d minz = _mm256_load_pd(elem.minz);
+                    __m256d maxz = _mm256_load_pd(elem.maxz);
+                    __m256d idirz = _mm256_broadcast_sd(&invDir.z);
+                    __m256d rayoz = _mm256_broadcast_sd(&rayOrigin.z);
+                    tminz = _mm256_mul_pd(_mm256_sub_pd(dirIsNeg[2] ? maxz : minz, rayoz), idirz);
+                    tmaxz = _mm256_mul_pd(_mm256_sub_pd(dirIsNeg[2] ? minz : maxz, rayoz), idirz);
+                }
+
+                __m256d factor = _mm256_broadcast_sd(&robustFactor);
+                tmaxz = _mm256_mul_pd(tmaxz, factor);
+
+                {
+                    __m256d failcond = _mm256_or_pd(_mm256_cmp_pd(tmin, tmaxz, _CMP_GT_OQ),
+                                                   _mm256_cmp_pd(tminz, tmax, _CMP_GT_OQ));
+                    fail = fail | uint32_t(_mm256_movemask_pd(failcond));
+
+                    if (fail == 0xF) {
+                        for (int i = 0; i < 4; ++i) { *(resIt++) = Result::fail; }
+                        continue;
+                    }
+                }
+
+                tmin = _mm256_blendv_pd(tmin, tminz, _mm256_cmp_pd(tminz, tmin, _CMP_GT_OQ));
+                tmax = _mm256_blendv_pd(tmax, tmaxz, _mm256_cmp_pd(tmaxz, tmax, _CMP_LT_OQ));
+            }
+
+            __m256d wincond =
+                _mm256_and_pd(_mm256_cmp_pd(tmin, _mm256_broadcast_sd(&rayTMax), _CMP_LT_OQ),
+                              _mm256_cmp_pd(tmax, _mm256_setzero_pd(), _CMP_GT_OQ));
+            uint32_t win = ~fail & uint32_t(_mm256_movemask_pd(wincond));
+
+            for (int i = 0; i < 4; ++i) {
+                *(resIt++) = ((win >> i) & 1) ? Result::win : Result::fail;
+            }
+        }
+    };
+
+    // implementation using Simdee
+    auto simdee = [&]() {
+        auto resIt = resultsSimdee.begin();
+
+        for (const auto& elem : data4S) {
+            auto tmin = ((dirIsNeg[0] ? elem.maxx : elem.minx) - rayOrigin.x) * invDir.x;
+            auto tmax = ((dirIsNeg[0] ? elem.minx : elem.maxx) - rayOrigin.x) * invDir.x;
+            auto tminy = ((dirIsNeg[1] ? elem.maxy : elem.miny) - rayOrigin.y) * invDir.y;
+            auto tmaxy = ((dirIsNeg[1] ? elem.miny : elem.maxy) - rayOrigin.y) * invDir.y;
+
+            sd::avxd factor(robustFactor);
+            tmax *= factor;
+            tmaxy *= factor;
+            auto fail = mask((tmin > tmaxy) || (tminy > tmax));
+
+            if (all(fail)) {
+                for (int i = 0; i < 4; ++i) { *(resIt++) = Result::fail; }
+                continue;
+            }
+
+            tmin = cond(tminy > tmin, tminy, tmin);
+            tmax = cond(tmaxy < tmax, tmaxy, tmax);
+            auto tminz = ((dirIsNeg[2] ? elem.maxz : elem.minz) - rayOrigin.z) * invDir.z;
+            auto tmaxz = ((dirIsNeg[2] ? elem.minz : elem.maxz) - rayOrigin.z) * invDir.z;
+            tmaxz *= factor;
+            fail |= mask((tmin > tmaxz) || (tminz > tmax));
+
+            if (all(fail)) {
+                for (int i = 0; i < 4; ++i) { *(resIt++) = Result::fail; }
+                continue;
+            }
+
+            tmin = cond(tminz > tmin, tminz, tmin);
+            tmax = cond(tmaxz < tmax, tmaxz, tmax);
+            auto win = ~fail & mask((tmin < rayTMax) && (tmax > sd::zero()));
+
+            for (int i = 0; i < 4; ++i) { *(resIt++) = win[i] ? Result::win : Result::fail; }
+        }
+    };
+
+    // check performance
+    std::cout << "non-SIMD: " << benchmark_ms(nonSimd) << " ms\n";
+    std::cout << "hand SIMD: " << benchmark_ms(handSimd) << " ms\n";
+    std::cout << "Simdee: " << benchmark_ms(simdee) << " ms\n";
+
+    // check correctness
+    if (resultsNonSimd != resultsHandSimd) std::cerr << "hand SIMD results incorrect\n";
+    if (resultsNonSimd != resultsSimdee) std::cerr << "Simdee results incorrect\n";
+}
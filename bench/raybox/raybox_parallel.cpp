@@ -0,0 +1,148 @@
+// work around a STL bug in normal_distribution, where a double-to-float conversion produces a
+// warning
+#if defined(_MSC_VER)
+#pragma warning(disable : 4244)
+#endif
+
+#define SIMDEE_NEED_INT 0
+#include <simdee/parallel.hpp>
+#include <simdee/simd_vectors/avx.hpp>
+#include <simdee/util/allocator.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <vector>
+
+// Scaling of the ray-box intersection kernel over 1 to N threads, with sd::parallel_for writing
+// one hit mask per block of 8 boxes and sd::parallel_reduce counting the hits in per-thread vector
+// accumulators. N is the number of hardware threads, or the first command line argument.
+
+const char* const hline =
+    "===============================================================================\n";
+
+auto now = []() { return std::chrono::high_resolution_clock::now(); };
+
+template <typename Duration>
+double to_ms(Duration dur) {
+    using nanoseconds = std::chrono::nanoseconds;
+    return static_cast<double>(std::chrono::duration_cast<nanoseconds>(dur).count()) / 1.e6;
+}
+
+double benchmark_ms(std::function<void()> func) {
+    double best = std::numeric_limits<double>::infinity();
+    for (int i = 0; i < 10; i++) {
+        auto tp1 = now();
+        func();
+        auto tp2 = now();
+        double time = to_ms(tp2 - tp1);
+        best = std::min(best, time);
+    }
+    return best;
+}
+
+struct alignas(__m256) RayBoxData8S {
+    sd::avxf::storage_t minx, miny, minz, maxx, maxy, maxz;
+};
+
+struct Ray {
+    sd::avxf invDirX, invDirY, invDirZ, originX, originY, originZ, factor, tMax;
+    bool dirIsNeg[3];
+
+    // the hit mask of 8 boxes
+    sd::avxf::vec_b intersect(const RayBoxData8S& elem) const {
+        sd::avxf tmin = ((dirIsNeg[0] ? elem.maxx : elem.minx) - originX) * invDirX;
+        sd::avxf tmax = ((dirIsNeg[0] ? elem.minx : elem.maxx) - originX) * invDirX;
+        sd::avxf tminy = ((dirIsNeg[1] ? elem.maxy : elem.miny) - originY) * invDirY;
+        sd::avxf tmaxy = ((dirIsNeg[1] ? elem.miny : elem.maxy) - originY) * invDirY;
+        tmax *= factor;
+        tmaxy *= factor;
+        sd::avxf::vec_b fail = (tmin > tmaxy) || (tminy > tmax);
+        tmin = cond(tminy > tmin, tminy, tmin);
+        tmax = cond(tmaxy < tmax, tmaxy, tmax);
+        sd::avxf tminz = ((dirIsNeg[2] ? elem.maxz : elem.minz) - originZ) * invDirZ;
+        sd::avxf tmaxz = ((dirIsNeg[2] ? elem.minz : elem.maxz) - originZ) * invDirZ;
+        tmaxz *= factor;
+        fail = fail || (tmin > tmaxz) || (tminz > tmax);
+        tmin = cond(tminz > tmin, tminz, tmin);
+        tmax = cond(tmaxz < tmax, tmaxz, tmax);
+        return !fail && (tmin < tMax) && (tmax > sd::avxf(0.f));
+    }
+};
+
+int main(int argc, char** argv) {
+    std::cout << hline << "Benchmark: Ray-box intersection, parallel scaling\n";
+
+    const std::size_t dataSize8 = 8 * 1024 * 1024; // 8M boxes, 192 MB
+    using vec8S = std::vector<RayBoxData8S, sd::allocator<RayBoxData8S>>;
+    vec8S data(dataSize8 / 8);
+    std::vector<uint8_t> hits(data.size());
+
+    std::minstd_rand re(0x8a7ac012);
+    std::normal_distribution<float> dist(0, 1);
+    float* floats = reinterpret_cast<float*>(data.data());
+    for (std::size_t i = 0; i < data.size() * 48; ++i) floats[i] = dist(re);
+
+    auto gamma = [](int n) {
+        double eps2 = 0.5 * static_cast<double>(std::numeric_limits<float>::epsilon());
+        return static_cast<float>((n * eps2) / (1 - n * eps2));
+    };
+    Ray ray;
+    ray.invDirX = sd::avxf(dist(re));
+    ray.invDirY = sd::avxf(dist(re));
+    ray.invDirZ = sd::avxf(dist(re));
+    ray.originX = sd::avxf(dist(re));
+    ray.originY = sd::avxf(dist(re));
+    ray.originZ = sd::avxf(dist(re));
+    ray.factor = sd::avxf(1 + 2 * gamma(3));
+    ray.tMax = sd::avxf(100.f);
+    for (bool& neg : ray.dirIsNeg) neg = dist(re) > 0;
+
+    std::size_t maxThreads = sd::thread_pool::default_size();
+    if (argc > 1) maxThreads = std::strtoul(argv[1], nullptr, 10);
+    const std::size_t grain = 1024; // blocks per chunk
+
+    const RayBoxData8S* first = data.data();
+    const RayBoxData8S* last = first + data.size();
+    long long expected = -1;
+    double baseMs = 0;
+
+    std::cout << "threads  parallel_for [ms]  parallel_reduce [ms]  speedup\n";
+    for (std::size_t threads = 1; threads <= maxThreads; ++threads) {
+        sd::thread_pool pool(threads);
+
+        double forMs = benchmark_ms([&]() {
+            sd::parallel_for(pool, first, last, grain,
+                             [&](const RayBoxData8S* f, const RayBoxData8S* l) {
+                                 uint8_t* out = &hits[std::size_t(f - first)];
+                                 for (; f != l; ++f) {
+                                     *out++ = uint8_t(mask(ray.intersect(*f)).value);
+                                 }
+                             });
+        });
+
+        long long count = 0;
+        double reduceMs = benchmark_ms([&]() {
+            // hit counts per lane stay far below 2^24, so that they are exact in floats
+            sd::avxf acc = sd::parallel_reduce(
+                pool, first, last, grain, sd::avxf(0.f),
+                [&](const RayBoxData8S* f, const RayBoxData8S* l) {
+                    sd::avxf n(0.f);
+                    const sd::avxf one(1.f), zero(0.f);
+                    for (; f != l; ++f) n = n + cond(ray.intersect(*f), one, zero);
+                    return n;
+                },
+                [](const sd::avxf& a, const sd::avxf& b) { return a + b; });
+            count = static_cast<long long>(hsum(acc));
+        });
+
+        if (threads == 1) baseMs = reduceMs;
+        std::cout << threads << "\t " << forMs << "\t\t    " << reduceMs << "\t\t  "
+                  << baseMs / reduceMs << "\n";
+        if (expected >= 0 && count != expected) std::cerr << "parallel_reduce results differ\n";
+        expected = count;
+    }
+}
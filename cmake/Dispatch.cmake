@@ -0,0 +1,48 @@
+# Runtime dispatch support: compiles a source file once per x86 instruction set, so that a single
+# binary can choose the best variant at startup (see docs/guides/dispatch.md).
+#
+# simdee_add_dispatch_variants(<target> <source> [<isa>...])
+#
+# Each listed instruction set (SSE2, AVX, AVX2, AVX512; all four if none are listed) produces one
+# translation unit that includes <source> and is compiled with the matching compiler flags. The
+# target should not link against flags that raise the baseline instruction set of these variants,
+# i.e. SIMDEE_INSTRUCTION_SET should be "default" or "SSE2".
+
+set(SIMDEE_DISPATCH_TEMPLATE "${CMAKE_CURRENT_LIST_DIR}/dispatch_variant.cpp.in")
+
+function(simdee_add_dispatch_variants target source)
+  set(isa_list ${ARGN})
+  if(NOT isa_list)
+    set(isa_list SSE2 AVX AVX2 AVX512)
+  endif()
+  get_filename_component(SIMDEE_DISPATCH_SOURCE "${source}" ABSOLUTE)
+
+  foreach(isa ${isa_list})
+    if(MSVC)
+      if(isa STREQUAL "SSE2")
+        set(flags "")
+      else()
+        set(flags "/arch:${isa}")
+      endif()
+    else()
+      if(isa STREQUAL "SSE2")
+        set(flags "-msse2")
+      elseif(isa STREQUAL "AVX")
+        set(flags "-mavx")
+      elseif(isa STREQUAL "AVX2")
+        set(flags "-mavx2 -mfma")
+      elseif(isa STREQUAL "AVX512")
+        set(flags "-mavx512f -mavx512cd -mavx512bw -mavx512dq -mavx512vl -mfma")
+      else()
+        message(FATAL_ERROR "simdee_add_dispatch_variants: unexpected instruction set ${isa}")
+      endif()
+    endif()
+
+    get_filename_component(name "${source}" NAME_WE)
+    string(TOLOWER "${isa}" isa_lower)
+    set(variant "${CMAKE_CURRENT_BINARY_DIR}/${target}_${name}_${isa_lower}.cpp")
+    configure_file("${SIMDEE_DISPATCH_TEMPLATE}" "${variant}" @ONLY)
+    set_source_files_properties("${variant}" PROPERTIES COMPILE_FLAGS "${flags}")
+    target_sources(${target} PRIVATE "${variant}")
+  endforeach()
+endfunction()
@@ -0,0 +1,269 @@
+// This file is a part of Simdee, see homepage at http://github.com/hrabalik/simdee
+// This file is distributed under the MIT license.
+
+#ifndef SIMDEE_ALGORITHM_HPP
+#define SIMDEE_ALGORITHM_HPP
+
+#include "simd_vectors/common.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+// Algorithms over contiguous arrays, written in terms of a vector type Simd_t and function objects
+// that take vectors, e.g. sd::transform<sd::vec8f>(first, last, out, [](sd::vec8f x) { ... }). The
+// array is processed in three parts: a head that brings one of the pointers to the alignment of
+// Simd_t, the aligned body and a tail shorter than Simd_t::width. Where the function object cannot
+// be applied to partial vectors (reductions), the head and the tail are processed one scalar at a
+// time, broadcast to a vector.
+
+namespace sd {
+    namespace impl {
+
+        // the number of scalars in front of ptr that precede the alignment of Simd_t, at most n
+        template <typename Simd_t, typename T>
+        SIMDEE_INL std::size_t head_size(const T* ptr, std::size_t n) {
+            const std::size_t misalignment = std::uintptr_t(ptr) % alignof(Simd_t);
+            if (misalignment == 0 || misalignment % sizeof(T) != 0) return 0;
+            const std::size_t head = (alignof(Simd_t) - misalignment) / sizeof(T);
+            return head < n ? head : n;
+        }
+
+        // the bits of the first count lanes
+        SIMDEE_INL uint32_t lane_bits(std::size_t count) { return (1U << count) - 1U; }
+
+        template <typename Simd_t, typename Transform>
+        using transform_result_t = typename std::decay<decltype(
+            std::declval<Transform&>()(std::declval<const Simd_t&>()))>::type;
+
+    }
+
+    namespace detail {
+        // the lanes of pred that are true; mask() is found by ADL only outside of sd::impl
+        template <typename Simd_t, typename Pred>
+        SIMDEE_INL uint32_t true_bits(Pred& pred, const Simd_t& v) {
+            return mask(typename Simd_t::vec_b(pred(v))).value;
+        }
+
+        // pointer to the first scalar for which pred is Expected, or last
+        template <typename Simd_t, bool Expected, typename Pred>
+        const typename Simd_t::scalar_t* find_first(const typename Simd_t::scalar_t* first,
+                                                    const typename Simd_t::scalar_t* last,
+                                                    Pred& pred) {
+            const uint32_t flip = Expected ? 0U : impl::lane_bits(Simd_t::width);
+            const std::size_t n = std::size_t(last - first);
+            std::size_t i = impl::head_size<Simd_t>(first, n);
+            if (i != 0) {
+                uint32_t bits = true_bits(pred, Simd_t(masked(first, i))) ^ flip;
+                bits &= impl::lane_bits(i);
+                if (bits != 0) return first + lsb(bits);
+            }
+            for (; i + Simd_t::width <= n; i += Simd_t::width) {
+                uint32_t bits = true_bits(pred, Simd_t(aligned(first + i))) ^ flip;
+                if (bits != 0) return first + i + lsb(bits);
+            }
+            if (i != n) {
+                uint32_t bits = true_bits(pred, Simd_t(masked(first + i, n - i))) ^ flip;
+                bits &= impl::lane_bits(n - i);
+                if (bits != 0) return first + i + lsb(bits);
+            }
+            return last;
+        }
+    }
+
+    // writes f(x) to out for the vectors x of [first, last), returns the end of the output; out
+    // may be equal to first; f returns the vector related to Simd_t that holds Out_t
+    template <typename Simd_t, typename Out_t, typename Func>
+    Out_t* transform(const typename Simd_t::scalar_t* first,
+                     const typename Simd_t::scalar_t* last, Out_t* out, Func f) {
+        using out_vec = typename impl::related_vector<Simd_t, Out_t>::type;
+        const std::size_t n = std::size_t(last - first);
+        std::size_t i = impl::head_size<out_vec>(out, n);
+        if (i != 0) masked(out, i) = out_vec(f(Simd_t(masked(first, i))));
+        for (; i + Simd_t::width <= n; i += Simd_t::width) {
+            aligned(out + i) = out_vec(f(Simd_t(unaligned(first + i))));
+        }
+        if (i != n) masked(out + i, n - i) = out_vec(f(Simd_t(masked(first + i, n - i))));
+        return out + n;
+    }
+
+    // writes f(x, y) to out for the vectors x of [first1, last1) and y of [first2, ...), returns
+    // the end of the output
+    template <typename Simd_t, typename Out_t, typename Func>
+    Out_t* transform(const typename Simd_t::scalar_t* first1,
+                     const typename Simd_t::scalar_t* last1,
+                     const typename Simd_t::scalar_t* first2, Out_t* out, Func f) {
+        using out_vec = typename impl::related_vector<Simd_t, Out_t>::type;
+        const std::size_t n = std::size_t(last1 - first1);
+        std::size_t i = impl::head_size<out_vec>(out, n);
+        if (i != 0) {
+            masked(out, i) = out_vec(f(Simd_t(masked(first1, i)), Simd_t(masked(first2, i))));
+        }
+        for (; i + Simd_t::width <= n; i += Simd_t::width) {
+            aligned(out + i) =
+                out_vec(f(Simd_t(unaligned(first1 + i)), Simd_t(unaligned(first2 + i))));
+        }
+        if (i != n) {
+            masked(out + i, n - i) = out_vec(
+                f(Simd_t(masked(first1 + i, n - i)), Simd_t(masked(first2 + i, n - i))));
+        }
+        return out + n;
+    }
+
+    // reduces transform(x) for the vectors x of [first, last) and init with reduce, which must be
+    // associative and commutative; the body is reduced with four independent accumulators
+    template <typename Simd_t, typename Reduce, typename Transform>
+    typename impl::transform_result_t<Simd_t, Transform>::scalar_t
+    transform_reduce(const typename Simd_t::scalar_t* first, const typename Simd_t::scalar_t* last,
+                     typename impl::transform_result_t<Simd_t, Transform>::scalar_t init,
+                     Reduce reduce, Transform transform) {
+        using result_t = impl::transform_result_t<Simd_t, Transform>;
+        const std::size_t width = Simd_t::width;
+        const std::size_t n = std::size_t(last - first);
+
+        // the head and the tail are reduced as broadcast scalars, all lanes of res are equal
+        result_t res(init);
+        std::size_t i = 0;
+        const std::size_t head = impl::head_size<Simd_t>(first, n);
+        for (; i < head; ++i) res = reduce(res, transform(Simd_t(first[i])));
+
+        const std::size_t body = (n - head) / width;
+        if (body != 0) {
+            const std::size_t used = body < 4 ? body : 4;
+            result_t acc[4];
+            for (std::size_t k = 0; k < used; ++k, i += width) {
+                acc[k] = transform(Simd_t(aligned(first + i)));
+            }
+            for (; i + 4 * width <= n; i += 4 * width) {
+                acc[0] = reduce(acc[0], transform(Simd_t(aligned(first + i))));
+                acc[1] = reduce(acc[1], transform(Simd_t(aligned(first + i + width))));
+                acc[2] = reduce(acc[2], transform(Simd_t(aligned(first + i + 2 * width))));
+                acc[3] = reduce(acc[3], transform(Simd_t(aligned(first + i + 3 * width))));
+            }
+            for (; i + width <= n; i += width) {
+                acc[0] = reduce(acc[0], transform(Simd_t(aligned(first + i))));
+            }
+            for (std::size_t k = 1; k < used; ++k) acc[0] = reduce(acc[0], acc[k]);
+            const typename result_t::storage_t lanes(acc[0]);
+            for (std::size_t k = 0; k < width; ++k) res = reduce(res, result_t(lanes[k]));
+        }
+
+        for (; i < n; ++i) res = reduce(res, transform(Simd_t(first[i])));
+        return first_scalar(res);
+    }
+
+    // the number of scalars of [first, last) for which pred returns true
+    template <typename Simd_t, typename Pred>
+    std::size_t count_if(const typename Simd_t::scalar_t* first,
+                         const typename Simd_t::scalar_t* last, Pred pred) {
+        const std::size_t n = std::size_t(last - first);
+        std::size_t count = 0;
+        std::size_t i = impl::head_size<Simd_t>(first, n);
+        if (i != 0) {
+            uint32_t bits = detail::true_bits(pred, Simd_t(masked(first, i)));
+            count += detail::popcount(bits & impl::lane_bits(i));
+        }
+        for (; i + Simd_t::width <= n; i += Simd_t::width) {
+            count += detail::popcount(detail::true_bits(pred, Simd_t(aligned(first + i))));
+        }
+        if (i != n) {
+            uint32_t bits = detail::true_bits(pred, Simd_t(masked(first + i, n - i)));
+            count += detail::popcount(bits & impl::lane_bits(n - i));
+        }
+        return count;
+    }
+
+    // pointer to the first scalar of [first, last) for which pred returns true, or last
+    template <typename Simd_t, typename Pred>
+    const typename Simd_t::scalar_t* find_if(const typename Simd_t::scalar_t* first,
+                                             const typename Simd_t::scalar_t* last, Pred pred) {
+        return detail::find_first<Simd_t, true>(first, last, pred);
+    }
+
+    // pointer to the first scalar of [first, last) for which pred returns false, or last
+    template <typename Simd_t, typename Pred>
+    const typename Simd_t::scalar_t* find_if_not(const typename Simd_t::scalar_t* first,
+                                                 const typename Simd_t::scalar_t* last,
+                                                 Pred pred) {
+        return detail::find_first<Simd_t, false>(first, last, pred);
+    }
+
+    template <typename Simd_t, typename Pred>
+    bool any_of(const typename Simd_t::scalar_t* first, const typename Simd_t::scalar_t* last,
+                Pred pred) {
+        return detail::find_first<Simd_t, true>(first, last, pred) != last;
+    }
+
+    template <typename Simd_t, typename Pred>
+    bool all_of(const typename Simd_t::scalar_t* first, const typename Simd_t::scalar_t* last,
+                Pred pred) {
+        return detail::find_first<Simd_t, false>(first, last, pred) == last;
+    }
+
+    template <typename Simd_t, typename Pred>
+    bool none_of(const typename Simd_t::scalar_t* first, const typename Simd_t::scalar_t* last,
+                 Pred pred) {
+        return detail::find_first<Simd_t, true>(first, last, pred) == last;
+    }
+
+    // pointers to the first smallest and the last largest scalar of [first, last), as with
+    // std::minmax_element; each lane tracks its own minimum and maximum along with their indices
+    // (a vec_s, which limits the size of the array to its largest value)
+    template <typename Simd_t>
+    std::pair<const typename Simd_t::scalar_t*, const typename Simd_t::scalar_t*>
+    minmax_element(const typename Simd_t::scalar_t* first, const typename Simd_t::scalar_t* last) {
+        using vec_s = typename Simd_t::vec_s;
+        using index_t = typename vec_s::scalar_t;
+        const std::size_t width = Simd_t::width;
+        const std::size_t n = std::size_t(last - first);
+        if (n == 0) return {last, last};
+
+        std::size_t min_at = 0, max_at = 0;
+        auto scalar_step = [&](std::size_t at) {
+            if (first[at] < first[min_at]) min_at = at;
+            if (!(first[at] < first[max_at])) max_at = at;
+        };
+        const std::size_t head = impl::head_size<Simd_t>(first, n);
+        for (std::size_t k = 1; k < head; ++k) scalar_step(k);
+        std::size_t i = head;
+
+        if (i + width <= n) {
+            Simd_t min_v(aligned(first + i)), max_v = min_v;
+            typename vec_s::storage_t lane_indices;
+            for (std::size_t k = 0; k < width; ++k) lane_indices[k] = index_t(i + k);
+            vec_s at(lane_indices), min_i = at, max_i = at;
+            const vec_s step = vec_s(index_t(width));
+            for (i += width; i + width <= n; i += width) {
+                Simd_t v(aligned(first + i));
+                at = at + step;
+                typename Simd_t::vec_b lt = v < min_v, ge = v >= max_v;
+                min_v = cond(lt, v, min_v);
+                min_i = cond(lt, at, min_i);
+                max_v = cond(ge, v, max_v);
+                max_i = cond(ge, at, max_i);
+            }
+
+            // each lane holds its first minimum and its last maximum; between lanes and the head,
+            // ties go to the lower (minimum) or the higher (maximum) index
+            const typename Simd_t::storage_t min_s(min_v), max_s(max_v);
+            const typename vec_s::storage_t min_is(min_i), max_is(max_i);
+            for (std::size_t k = 0; k < width; ++k) {
+                std::size_t lane_min = std::size_t(min_is[k]), lane_max = std::size_t(max_is[k]);
+                if (min_s[k] < first[min_at] ||
+                    (!(first[min_at] < min_s[k]) && lane_min < min_at)) {
+                    min_at = lane_min;
+                }
+                if (first[max_at] < max_s[k] ||
+                    (!(max_s[k] < first[max_at]) && lane_max > max_at)) {
+                    max_at = lane_max;
+                }
+            }
+        }
+
+        for (; i < n; ++i) scalar_step(i);
+        return {first + min_at, first + max_at};
+    }
+}
+
+#endif // SIMDEE_ALGORITHM_HPP
@@ -23,7 +23,7 @@ namespace sd {
             using source_t = typename std::decay<T>::type;
             using target_t = select_bool_t<sizeof(source_t)>;
             static_assert(is_extended_arithmetic_type<source_t>::value,
-                          "as_f(): source isn't arithmetic");
+                          "as_b(): source isn't arithmetic");
         };
 
         template <typename T>
@@ -80,7 +80,8 @@ namespace sd {
                           "dirty::cast(): the types aren't the same size");
 
             To result;
-            std::memcpy(&result, &source, sizeof(From));
+            std::memcpy(static_cast<void*>(&result), static_cast<const void*>(&source),
+                        sizeof(From));
             return result;
         }
 
@@ -67,6 +67,11 @@ namespace sd {
                 pos.aligned_store(r);
             }
 
+            SIMDEE_INL void stream_store(scalar_t* r) const {
+                T pos(~neg);
+                pos.stream_store(r);
+            }
+
             template <typename Rhs>
             void unaligned_load(const Rhs&) {
                 dont_change_deferred_not<Rhs> fail;
@@ -179,6 +184,11 @@ namespace sd {
                 pos.aligned_store(r);
             }
 
+            SIMDEE_INL void stream_store(scalar_t* r) const {
+                T pos(!neg);
+                pos.stream_store(r);
+            }
+
             template <typename Rhs>
             void unaligned_load(const Rhs&) {
                 dont_change_deferred_not<Rhs> fail;
@@ -5,7 +5,9 @@
 #define SIMDEE_COMMON_EXPR_HPP
 
 #include "../common/casts.hpp"
+#include <cstddef>
 #include <limits>
+#include <type_traits>
 
 namespace sd {
     namespace expr {
@@ -35,6 +37,35 @@ namespace sd {
             T* ptr;
         };
 
+        // an aligned location written with a non-temporal store that bypasses the cache
+        template <typename T>
+        struct streaming {
+            SIMDEE_INL constexpr explicit streaming(T* r) : ptr(r) {}
+
+            template <typename Simd_t>
+            SIMDEE_INL void operator=(const Simd_t& r) const {
+                r.stream_store(ptr);
+            }
+
+            // data
+            T* ptr;
+        };
+
+        // the first Sel_t scalars (if Sel_t is std::size_t), or those selected by a Sel_t predicate
+        template <typename T, typename Sel_t>
+        struct masked {
+            SIMDEE_INL constexpr masked(T* r, const Sel_t& s) : ptr(r), sel(s) {}
+
+            template <typename Simd_t>
+            SIMDEE_INL void operator=(const Simd_t& r) const {
+                r.masked_store(ptr, sel);
+            }
+
+            // data
+            T* ptr;
+            Sel_t sel;
+        };
+
         template <typename Crtp>
         struct init {
             SIMDEE_INL constexpr const Crtp& self() const {
@@ -114,6 +145,20 @@ namespace sd {
     SIMDEE_INL constexpr expr::unaligned<T> unaligned(T* const& r) {
         return expr::unaligned<T>(r);
     }
+    template <typename T>
+    SIMDEE_INL constexpr expr::streaming<T> streaming(T* const& r) {
+        return expr::streaming<T>(r);
+    }
+
+    template <typename T>
+    SIMDEE_INL constexpr expr::masked<T, std::size_t> masked(T* const& r, std::size_t count) {
+        return expr::masked<T, std::size_t>(r, count);
+    }
+    template <typename T, typename Pred_t,
+              typename = typename std::enable_if<!std::is_arithmetic<Pred_t>::value>::type>
+    SIMDEE_INL constexpr expr::masked<T, Pred_t> masked(T* const& r, const Pred_t& pred) {
+        return expr::masked<T, Pred_t>(r, pred);
+    }
 
     SIMDEE_INL constexpr expr::zero zero() { return expr::zero{}; }
     SIMDEE_INL constexpr expr::all_bits all_bits() { return expr::all_bits{}; }
@@ -59,6 +59,24 @@
 #endif
 #endif
 
+//
+// enforce instruction sets implied by AVX-512
+//
+#if defined(__AVX512F__)
+#if !defined(__AVX2__)
+#define __AVX2__
+#endif
+#endif
+
+//
+// MSVC does not define __FMA__, but /arch:AVX2 enables FMA3 instructions
+//
+#if defined(_MSC_VER) && defined(__AVX2__)
+#if !defined(__FMA__)
+#define __FMA__
+#endif
+#endif
+
 //
 // enforce instruction sets implied by AVX2
 //
@@ -116,6 +134,11 @@
 #else
 #define SIMDEE_SSE41 0
 #endif
+#if defined(__SSE4_2__)
+#define SIMDEE_SSE42 1
+#else
+#define SIMDEE_SSE42 0
+#endif
 #if defined(__AVX__)
 #define SIMDEE_AVX 1
 #else
@@ -126,6 +149,17 @@
 #else
 #define SIMDEE_AVX2 0
 #endif
+#if defined(__AVX512F__) && defined(__AVX512CD__) && defined(__AVX512BW__) &&                   \
+    defined(__AVX512DQ__) && defined(__AVX512VL__)
+#define SIMDEE_AVX512 1
+#else
+#define SIMDEE_AVX512 0
+#endif
+#if defined(__FMA__)
+#define SIMDEE_FMA 1
+#else
+#define SIMDEE_FMA 0
+#endif
 #if defined(__ARM_NEON)
 #define SIMDEE_NEON 1
 #else
@@ -0,0 +1,75 @@
+// This file is a part of Simdee, see homepage at http://github.com/hrabalik/simdee
+// This file is distributed under the MIT license.
+
+#ifndef SIMDEE_DISPATCH_HPP
+#define SIMDEE_DISPATCH_HPP
+
+#include "common/init.hpp"
+#include "util/cpuid.hpp"
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+
+namespace sd {
+
+    // instruction set that the current translation unit is compiled for
+#if SIMDEE_AVX512
+    constexpr isa compiled_isa = isa::avx512;
+#elif SIMDEE_AVX2
+    constexpr isa compiled_isa = isa::avx2;
+#elif SIMDEE_AVX
+    constexpr isa compiled_isa = isa::avx;
+#elif SIMDEE_SSE2
+    constexpr isa compiled_isa = isa::sse2;
+#else
+    constexpr isa compiled_isa = isa::none;
+#endif
+
+    // the most capable instruction set supported by the CPU, detected once per process
+    inline isa supported_isa() {
+        static const isa result = detect_isa();
+        return result;
+    }
+
+    template <typename Fn>
+    struct dispatch_entry {
+        isa target;
+        Fn* func;
+    };
+
+    template <typename Fn>
+    class dispatcher {
+    public:
+        // binds the most capable variant that the CPU supports
+        dispatcher(std::initializer_list<dispatch_entry<Fn>> variants)
+            : dispatcher(variants, supported_isa()) {}
+
+        // binds the most capable variant whose instruction set does not exceed limit
+        dispatcher(std::initializer_list<dispatch_entry<Fn>> variants, isa limit) {
+            for (const auto& v : variants) {
+                if (v.func == nullptr || int(v.target) > int(limit)) continue;
+                if (m_func == nullptr || int(v.target) > int(m_target)) {
+                    m_func = v.func;
+                    m_target = v.target;
+                }
+            }
+            if (m_func == nullptr) throw std::runtime_error("sd::dispatcher: no suitable variant");
+        }
+
+        Fn* get() const { return m_func; }
+        isa target() const { return m_target; }
+
+        template <typename... Args>
+        auto operator()(Args&&... args) const
+            -> decltype(std::declval<Fn*>()(std::forward<Args>(args)...)) {
+            return m_func(std::forward<Args>(args)...);
+        }
+
+    private:
+        Fn* m_func = nullptr;
+        isa m_target = isa::none;
+    };
+
+} // namespace sd
+
+#endif // SIMDEE_DISPATCH_HPP
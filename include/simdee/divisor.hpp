@@ -0,0 +1,105 @@
+// This file is a part of Simdee, see homepage at http://github.com/hrabalik/simdee
+// This file is distributed under the MIT license.
+
+#ifndef SIMDEE_DIVISOR_HPP
+#define SIMDEE_DIVISOR_HPP
+
+#include "simd_vectors/common.hpp"
+
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+
+#if !SIMDEE_NEED_INT
+#error "sd::divisor requires integer arithmetic. Please check the value of SIMDEE_NEED_INT."
+#endif
+
+// Division of 32-bit integral vectors by a divisor that is only known at run time, but stays the
+// same for many divisions. The constructor computes a magic multiplier and shift counts, each
+// division then takes a mulhi() and a few additions and shifts instead of a division instruction,
+// which SIMD instruction sets lack. The algorithms are those of T. Granlund and P. L. Montgomery,
+// "Division by Invariant Integers using Multiplication" (1994), figures 4.1 and 5.2.
+
+namespace sd {
+
+    template <typename Scalar_t>
+    class divisor;
+
+    template <>
+    class divisor<uint32_t> {
+    public:
+        explicit divisor(uint32_t d) : m_value(d) {
+            if (d == 0) throw std::domain_error("sd::divisor: division by zero");
+            int l = 0; // ceil(log2(d))
+            while ((uint64_t(1) << l) < d) ++l;
+            m_magic = uint32_t((((uint64_t(1) << l) - d) << 32) / d + 1);
+            m_shift1 = l < 1 ? l : 1;
+            m_shift2 = l < 1 ? 0 : l - 1;
+        }
+
+        uint32_t value() const { return m_value; }
+
+        friend uint32_t operator/(uint32_t n, const divisor& d) {
+            uint32_t q = uint32_t((uint64_t(n) * d.m_magic) >> 32);
+            return (q + ((n - q) >> d.m_shift1)) >> d.m_shift2;
+        }
+
+        template <typename Simd_t,
+                  typename = typename std::enable_if<is_simd_vector<Simd_t>::value>::type>
+        friend const Simd_t operator/(const Simd_t& n, const divisor& d) {
+            static_assert(std::is_same<typename Simd_t::scalar_t, uint32_t>::value,
+                          "sd::divisor<uint32_t>: the vector must have uint32_t scalars");
+            const Simd_t q = mulhi(n, Simd_t(d.m_magic));
+            return (q + ((n - q) >> d.m_shift1)) >> d.m_shift2;
+        }
+
+    private:
+        uint32_t m_value;
+        uint32_t m_magic;
+        int m_shift1;
+        int m_shift2;
+    };
+
+    // quotients are truncated towards zero, as with the built-in operator; INT32_MIN / -1 wraps
+    // around to INT32_MIN
+    template <>
+    class divisor<int32_t> {
+    public:
+        explicit divisor(int32_t d) : m_value(d) {
+            if (d == 0) throw std::domain_error("sd::divisor: division by zero");
+            const uint32_t abs_d = d < 0 ? 0U - uint32_t(d) : uint32_t(d);
+            int l = 1; // max(ceil(log2(abs_d)), 1)
+            while ((uint64_t(1) << l) < abs_d) ++l;
+            m_magic = int32_t(uint32_t((uint64_t(1) << (31 + l)) / abs_d + 1));
+            m_shift = l - 1;
+            m_sign = d < 0 ? -1 : 0;
+        }
+
+        int32_t value() const { return m_value; }
+
+        friend int32_t operator/(int32_t n, const divisor& d) {
+            uint32_t q = uint32_t(n) + uint32_t((int64_t(n) * d.m_magic) >> 32);
+            q = uint32_t(int32_t(q) >> d.m_shift) - uint32_t(n >> 31);
+            return int32_t((q ^ uint32_t(d.m_sign)) - uint32_t(d.m_sign));
+        }
+
+        template <typename Simd_t,
+                  typename = typename std::enable_if<is_simd_vector<Simd_t>::value>::type>
+        friend const Simd_t operator/(const Simd_t& n, const divisor& d) {
+            static_assert(std::is_same<typename Simd_t::scalar_t, int32_t>::value,
+                          "sd::divisor<int32_t>: the vector must have int32_t scalars");
+            const Simd_t sign(d.m_sign);
+            const Simd_t q = ((n + mulhi(n, Simd_t(d.m_magic))) >> d.m_shift) - (n >> 31);
+            return (q ^ sign) - sign;
+        }
+
+    private:
+        int32_t m_value;
+        int32_t m_magic;
+        int m_shift;
+        int32_t m_sign;
+    };
+
+} // namespace sd
+
+#endif // SIMDEE_DIVISOR_HPP
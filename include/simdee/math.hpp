@@ -0,0 +1,334 @@
+// This file is a part of Simdee, see homepage at http://github.com/hrabalik/simdee
+// This file is distributed under the MIT license.
+
+#ifndef SIMDEE_MATH_HPP
+#define SIMDEE_MATH_HPP
+
+#include "simd_vectors/common.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#if !SIMDEE_NEED_INT
+#error "sd::math requires integer arithmetic. Please check the value of SIMDEE_NEED_INT."
+#endif
+
+// Single-precision transcendental functions for any SIMDVectorF type. The algorithms follow the
+// Cephes library: range reduction followed by a minimax polynomial. Maximum errors, as measured by
+// bench/precision (see docs/reference/math.md):
+//
+//   exp    0.99 ulp, results below FLT_MIN are subnormal
+//   log    0.89 ulp
+//   sin    1.38 ulp for |x| <= pi, absolute error below 7.8e-8 for |x| <= 8192, NaN for |x| >= 2^30
+//   cos    1.48 ulp for |x| <= pi, absolute error below 7.9e-8 for |x| <= 8192, NaN for |x| >= 2^30
+//   tanh   1.33 ulp
+//   pow    1.18 ulp for results in the normal range
+
+namespace sd {
+    namespace math {
+        namespace impl {
+
+            template <typename T>
+            struct check_float {
+                static_assert(std::is_same<typename simd_vector_traits<T>::scalar_t, float>::value,
+                              "sd::math: only single-precision vectors are supported");
+                using vec_s = typename simd_vector_traits<T>::vec_s;
+            };
+
+            template <typename T>
+            SIMDEE_INL typename T::vec_s as_s(const T& r) {
+                return dirty::cast<T, typename T::vec_s>(r);
+            }
+            template <typename S>
+            SIMDEE_INL typename S::vec_f as_f(const S& r) {
+                return dirty::cast<S, typename S::vec_f>(r);
+            }
+
+            // rounds to the nearest integer, valid for |x| < 2^22
+            template <typename T>
+            SIMDEE_INL T round(const T& x) {
+                const T magic(12582912.f); // 1.5 * 2^23
+                return (x + magic) - magic;
+            }
+
+            // 2^n for integral n in [-126, 127]
+            template <typename T>
+            SIMDEE_INL T pow2(const T& n) {
+                using vec_s = typename T::vec_s;
+                return as_f(vec_s((n + T(127.f)) * T(8388608.f)));
+            }
+
+            // y * 2^n for integral n in [-150, 128], rounded once
+            template <typename T>
+            SIMDEE_INL T ldexp(const T& y, const T& n) {
+                T n_hi = min(max(n, T(-126.f)), T(127.f));
+                return (y * pow2(n - n_hi)) * pow2(n_hi);
+            }
+
+            // s + err == a + b exactly
+            template <typename T>
+            SIMDEE_INL T two_sum(const T& a, const T& b, T& err) {
+                T s = a + b;
+                T bb = s - a;
+                err = (a - (s - bb)) + (b - bb);
+                return s;
+            }
+
+            // rounding error of p = a * b; a fused multiply-subtract computes it exactly
+            template <typename T>
+            SIMDEE_INL T prod_err(const T& a, const T& b, const T& p, std::true_type) {
+                return fms(a, b, p);
+            }
+
+            // rounding error of p = a * b by Veltkamp splitting; the compiler must not contract it
+            template <typename T>
+            SIMDEE_INL T prod_err(const T& a, const T& b, const T& p, std::false_type) {
+                const T split(4097.f); // 2^12 + 1
+                T ac = a * split;
+                T a_hi = ac - (ac - a);
+                T a_lo = a - a_hi;
+                T bc = b * split;
+                T b_hi = bc - (bc - b);
+                T b_lo = b - b_hi;
+                return (((a_hi * b_hi - p) + a_hi * b_lo) + a_lo * b_hi) + a_lo * b_lo;
+            }
+
+            // p + err == a * b exactly, as long as nothing overflows
+            template <typename T>
+            SIMDEE_INL T two_prod(const T& a, const T& b, T& err) {
+                T p = a * b;
+                err = prod_err(a, b, p, typename sd::impl::fused<T>::native{});
+                return p;
+            }
+
+            // exp(hi + lo) for hi in [-104, 89] and |lo| much smaller than 1
+            template <typename T>
+            SIMDEE_INL T exp_core(const T& hi, const T& lo) {
+                T n = round(hi * T(1.44269504088896341f));
+                T r = (hi - n * T(0.693359375f)) - n * T(-2.12194440e-4f) + lo;
+                T p = T(1.9875691500e-4f);
+                p = fma(p, r, T(1.3981999507e-3f));
+                p = fma(p, r, T(8.3334519073e-3f));
+                p = fma(p, r, T(4.1665795894e-2f));
+                p = fma(p, r, T(1.6666665459e-1f));
+                p = fma(p, r, T(5.0000001201e-1f));
+                T y = p * (r * r) + r + T(1.f);
+                return ldexp(y, n);
+            }
+
+            // splits finite x >= 0 into (1 + r) * 2^e, where 1 + r is in [sqrt(1/2), sqrt(2))
+            template <typename T>
+            SIMDEE_INL T log_reduce(const T& x, T& e) {
+                using vec_s = typename T::vec_s;
+                auto subnormal = x < T(std::numeric_limits<float>::min());
+                vec_s bits = as_s(cond(subnormal, x * T(8388608.f), x));
+                T bias = cond(subnormal, T(149.f), T(126.f));
+                e = T(bits & vec_s(0x7f800000)) * T(1.f / 8388608.f) - bias;
+                T m = as_f((bits & vec_s(0x007fffff)) | vec_s(0x3f000000));
+                auto low = m < T(0.707106781186547524f);
+                e = cond(low, e - T(1.f), e);
+                return cond(low, m + m, m) - T(1.f);
+            }
+
+            // log(1 + r) - r
+            template <typename T>
+            SIMDEE_INL T log_poly(const T& r, const T& z) {
+                T p = T(7.0376836292e-2f);
+                p = fma(p, r, T(-1.1514610310e-1f));
+                p = fma(p, r, T(1.1676998740e-1f));
+                p = fma(p, r, T(-1.2420140846e-1f));
+                p = fma(p, r, T(1.4249322787e-1f));
+                p = fma(p, r, T(-1.6668057665e-1f));
+                p = fma(p, r, T(2.0000714765e-1f));
+                p = fma(p, r, T(-2.4999993993e-1f));
+                p = fma(p, r, T(3.3333331174e-1f));
+                return p * r * z - T(0.5f) * z;
+            }
+
+            // log(x) for finite x > 0 as an unevaluated sum hi + lo, precise enough for pow()
+            template <typename T>
+            SIMDEE_INL T log_df(const T& x, T& lo) {
+                T e;
+                T r = log_reduce(x, e);
+
+                // log(1 + r) = 2 * atanh(s), where s = r / (2 + r) = s_hi + s_lo
+                T d_hi = T(2.f) + r;
+                T d_lo = (T(2.f) - d_hi) + r;
+                T s_hi = r / d_hi;
+                T p_err;
+                T p = two_prod(s_hi, d_hi, p_err);
+                T s_lo = (((r - p) - p_err) - s_hi * d_lo) / d_hi;
+
+                // the first two terms of the series, 2 * s + 2/3 * s^3, need to be exact
+                T s2_err;
+                T s2 = two_prod(s_hi, s_hi, s2_err);
+                T s3_err;
+                T s3 = two_prod(s2, s_hi, s3_err);
+                s3_err = s3_err + s2_err * s_hi + T(3.f) * s2 * s_lo;
+                const T c_hi(0.666666686534881591796875f); // 2/3 = c_hi + c_lo
+                const T c_lo(-1.98682149e-8f);
+                T t3_err;
+                T t3 = two_prod(s3, c_hi, t3_err);
+                t3_err = t3_err + s3 * c_lo + s3_err * c_hi;
+                T q = T(2.f / 13.f);
+                q = fma(q, s2, T(2.f / 11.f));
+                q = fma(q, s2, T(2.f / 9.f));
+                q = fma(q, s2, T(2.f / 7.f));
+                q = fma(q, s2, T(2.f / 5.f));
+                T tail = q * s2 * s3;
+
+                T h1_err, h2_err;
+                T h1 = two_sum(e * T(0.693359375f), s_hi + s_hi, h1_err);
+                T h = two_sum(h1, t3, h2_err);
+                T l = (((h1_err + h2_err) + (s_lo + s_lo)) + (t3_err + tail)) +
+                      e * T(-2.12194440e-4f);
+                T hi = h + l;
+                lo = l - (hi - h);
+                return hi;
+            }
+
+            // reduces x >= 0 to [-pi/4, pi/4], j receives the (even) octant
+            template <typename T>
+            SIMDEE_INL T trig_reduce(const T& x, typename T::vec_s& j) {
+                using vec_s = typename T::vec_s;
+                j = vec_s(x * T(1.27323954473516f));
+                j = (j + vec_s(1)) & vec_s(~1);
+                T y(j);
+                return ((x - y * T(0.78515625f)) - y * T(2.4187564849853515625e-4f)) -
+                       y * T(3.77489497744594108e-8f);
+            }
+
+            template <typename T>
+            SIMDEE_INL T sin_poly(const T& x, const T& z) {
+                T p = T(-1.9515295891e-4f);
+                p = fma(p, z, T(8.3321608736e-3f));
+                p = fma(p, z, T(-1.6666654611e-1f));
+                return p * z * x + x;
+            }
+
+            template <typename T>
+            SIMDEE_INL T cos_poly(const T& z) {
+                T p = T(2.443315711809948e-5f);
+                p = fma(p, z, T(-1.388731625493765e-3f));
+                p = fma(p, z, T(4.166664568298827e-2f));
+                return p * z * z - T(0.5f) * z + T(1.f);
+            }
+
+        } // namespace impl
+
+        template <typename T>
+        SIMDEE_INL T exp(const simd_base<T>& arg) {
+            impl::check_float<T>();
+            const T x = arg.self();
+            T xc = cond(x > T(-104.f), x, T(-104.f));
+            xc = cond(xc < T(89.f), xc, T(89.f));
+            T res = impl::exp_core(xc, T(0.f));
+            return cond(x == x, res, x);
+        }
+
+        template <typename T>
+        SIMDEE_INL T log(const simd_base<T>& arg) {
+            impl::check_float<T>();
+            const T x = arg.self();
+            const T inf(std::numeric_limits<float>::infinity());
+            T e;
+            T r = impl::log_reduce(x, e);
+            T y = impl::log_poly(r, r * r) + e * T(-2.12194440e-4f);
+            T res = r + y + e * T(0.693359375f);
+            res = cond(x == T(0.f), -inf, res);
+            res = cond(x == inf, inf, res);
+            return cond(x >= T(0.f), res, T(std::numeric_limits<float>::quiet_NaN()));
+        }
+
+        template <typename T>
+        SIMDEE_INL T sin(const simd_base<T>& arg) {
+            using vec_s = typename impl::check_float<T>::vec_s;
+            const T x = arg.self();
+            T ax = abs(x);
+            auto valid = ax < T(1073741824.f);
+            vec_s j;
+            T r = impl::trig_reduce(cond(valid, ax, T(0.f)), j);
+            T z = r * r;
+            T res = cond((j & vec_s(2)) == vec_s(2), impl::cos_poly(z), impl::sin_poly(r, z));
+            auto flip = ((j & vec_s(4)) == vec_s(4)) != (impl::as_s(x) < vec_s(0));
+            res = cond(flip, -res, res);
+            return cond(valid, res, T(std::numeric_limits<float>::quiet_NaN()));
+        }
+
+        template <typename T>
+        SIMDEE_INL T cos(const simd_base<T>& arg) {
+            using vec_s = typename impl::check_float<T>::vec_s;
+            const T x = arg.self();
+            T ax = abs(x);
+            auto valid = ax < T(1073741824.f);
+            vec_s j;
+            T r = impl::trig_reduce(cond(valid, ax, T(0.f)), j);
+            T z = r * r;
+            T res = cond((j & vec_s(2)) == vec_s(2), impl::sin_poly(r, z), impl::cos_poly(z));
+            res = cond(((j - vec_s(2)) & vec_s(4)) == vec_s(0), -res, res);
+            return cond(valid, res, T(std::numeric_limits<float>::quiet_NaN()));
+        }
+
+        template <typename T>
+        SIMDEE_INL T tanh(const simd_base<T>& arg) {
+            impl::check_float<T>();
+            const T x = arg.self();
+            T ax = abs(x);
+            T big = T(1.f) - T(2.f) / (exp(ax + ax) + T(1.f));
+            big = cond(x < T(0.f), -big, big);
+            T z = x * x;
+            T p = T(-5.70498872745e-3f);
+            p = fma(p, z, T(2.06390887954e-2f));
+            p = fma(p, z, T(-5.37397155531e-2f));
+            p = fma(p, z, T(1.33314422036e-1f));
+            p = fma(p, z, T(-3.33332819422e-1f));
+            T small = p * z * x + x;
+            return cond(ax > T(0.625f), big, small);
+        }
+
+        template <typename T>
+        SIMDEE_INL T pow(const simd_base<T>& base, const simd_base<T>& exponent) {
+            using vec_s = typename impl::check_float<T>::vec_s;
+            const T x = base.self();
+            const T y = exponent.self();
+            const T inf(std::numeric_limits<float>::infinity());
+            const T nan(std::numeric_limits<float>::quiet_NaN());
+            T ax = abs(x);
+
+            // log(|x|) as an unevaluated sum l_hi + l_lo
+            T l_lo;
+            T l_hi = impl::log_df(ax, l_lo);
+            auto finite = (ax > T(0.f)) && (ax < inf);
+            l_hi = cond(finite, l_hi, cond(ax == T(0.f), -inf, ax));
+            l_lo = cond(finite, l_lo, T(0.f));
+
+            // y * log(|x|) as an unevaluated sum p_hi + p_lo, then exponentiated
+            T p_lo;
+            T p_hi = impl::two_prod(y, l_hi, p_lo);
+            p_lo = p_lo + y * l_lo;
+            T q = cond(p_hi > T(-104.f), p_hi, T(-104.f));
+            q = cond(q < T(89.f), q, T(89.f));
+            T res = impl::exp_core(q, cond(q == p_hi, p_lo, T(0.f)));
+            res = cond(p_hi == p_hi, res, p_hi);
+
+            // negative bases: odd integral exponents flip the sign, non-integral ones give NaN
+            T ay = abs(y);
+            auto y_conv = ay < T(1073741824.f);
+            T yc = cond(y_conv, y, T(0.f));
+            vec_s yi(yc);
+            auto y_int = T(yi) == yc;
+            auto y_odd = ((yi & vec_s(1)) == vec_s(1)) && y_int;
+            auto y_frac = y_conv && (T(yi) != yc);
+            res = cond((impl::as_s(x) < vec_s(0)) && y_odd, -res, res);
+            res = cond((x < T(0.f)) && (x > -inf) && y_frac, nan, res);
+
+            // pow(-1, +-inf) == 1, pow(1, y) == 1, pow(x, +-0) == 1
+            res = cond((x == T(-1.f)) && (ay == inf), T(1.f), res);
+            return cond((x == T(1.f)) || (y == T(0.f)), T(1.f), res);
+        }
+
+    } // namespace math
+} // namespace sd
+
+#endif // SIMDEE_MATH_HPP
@@ -0,0 +1,328 @@
+// This file is a part of Simdee, see homepage at http://github.com/hrabalik/simdee
+// This file is distributed under the MIT license.
+
+#ifndef SIMDEE_PARALLEL_HPP
+#define SIMDEE_PARALLEL_HPP
+
+#include "util/allocator.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Parallel loops over contiguous arrays. The array is cut into chunks whose boundaries lie on cache
+// line boundaries, so that aligned loads remain valid within each chunk and no two threads write
+// to the same cache line. Each thread of a thread_pool starts with a contiguous share of the
+// chunks; a thread that runs out of chunks steals half of the remaining chunks of another thread.
+
+namespace sd {
+
+    class thread_pool {
+    public:
+        // a pool of threads - 1 workers, the thread that calls run() takes part as well
+        explicit thread_pool(std::size_t threads = default_size()) {
+            if (threads == 0) threads = 1;
+            m_workers.reserve(threads - 1);
+            for (std::size_t t = 1; t < threads; ++t) {
+                m_workers.emplace_back(&thread_pool::work, this, t);
+            }
+        }
+
+        ~thread_pool() {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stop = true;
+            }
+            m_wake.notify_all();
+            for (auto& worker : m_workers) worker.join();
+        }
+
+        thread_pool(const thread_pool&) = delete;
+        thread_pool& operator=(const thread_pool&) = delete;
+
+        std::size_t size() const { return m_workers.size() + 1; }
+
+        static std::size_t default_size() {
+            const unsigned threads = std::thread::hardware_concurrency();
+            return threads == 0 ? 1 : std::size_t(threads);
+        }
+
+        // calls func(t) for each t in [0, size()) concurrently, func(0) on the calling thread;
+        // returns when all calls have returned and rethrows the first exception thrown by any of
+        // them; calls from different threads are serialized, calls from within func deadlock
+        template <typename Func>
+        void run(Func& func) {
+            std::lock_guard<std::mutex> serial(m_run_mutex);
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_job = static_cast<void*>(&func);
+                m_call = &invoke<Func>;
+                m_pending = m_workers.size();
+                m_failure = nullptr;
+                ++m_generation;
+            }
+            m_wake.notify_all();
+
+            std::exception_ptr failure;
+            try {
+                func(std::size_t(0));
+            } catch (...) { failure = std::current_exception(); }
+
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_done.wait(lock, [this]() { return m_pending == 0; });
+            if (!failure) failure = m_failure;
+            lock.unlock();
+            if (failure) std::rethrow_exception(failure);
+        }
+
+    private:
+        template <typename Func>
+        static void invoke(void* func, std::size_t t) {
+            (*static_cast<Func*>(func))(t);
+        }
+
+        void work(std::size_t t) {
+            uint64_t seen = 0;
+            std::unique_lock<std::mutex> lock(m_mutex);
+            for (;;) {
+                m_wake.wait(lock, [&]() { return m_stop || m_generation != seen; });
+                if (m_stop) return;
+                seen = m_generation;
+                lock.unlock();
+
+                std::exception_ptr failure;
+                try {
+                    m_call(m_job, t);
+                } catch (...) { failure = std::current_exception(); }
+
+                lock.lock();
+                if (failure && !m_failure) m_failure = failure;
+                if (--m_pending == 0) m_done.notify_one();
+            }
+        }
+
+        std::vector<std::thread> m_workers;
+        std::mutex m_run_mutex;
+        std::mutex m_mutex;
+        std::condition_variable m_wake;
+        std::condition_variable m_done;
+        void (*m_call)(void*, std::size_t) = nullptr;
+        void* m_job = nullptr;
+        uint64_t m_generation = 0;
+        std::size_t m_pending = 0;
+        std::exception_ptr m_failure;
+        bool m_stop = false;
+    };
+
+    // the pool used by the overloads of parallel_for() and parallel_reduce() that take no pool,
+    // created on first use with one thread per hardware thread
+    inline thread_pool& default_thread_pool() {
+        static thread_pool pool;
+        return pool;
+    }
+
+    namespace impl {
+
+        constexpr std::size_t cache_line = 64;
+
+        constexpr std::size_t gcd(std::size_t a, std::size_t b) {
+            return b == 0 ? a : gcd(b, a % b);
+        }
+
+        // cuts [first, first + n) into chunks; the boundaries between chunks lie on cache line
+        // boundaries (if the alignment of first allows it), all chunks except for the first and
+        // the last one hold exactly grain elements
+        template <typename T>
+        struct chunking {
+            chunking(const T* first, std::size_t size, std::size_t min_grain) : n(size) {
+                // the number of elements after which the alignment of an address repeats
+                const std::size_t period = cache_line / gcd(cache_line, sizeof(T));
+                const std::size_t misalignment = std::uintptr_t(first) % cache_line;
+                head = 0;
+                while (head < period && (misalignment + head * sizeof(T)) % cache_line != 0) {
+                    ++head;
+                }
+                if (head == period) head = 0;
+
+                // chunk indices must fit into 32 bits
+                const std::size_t max_chunks = std::size_t(1) << 31;
+                if (min_grain < n / max_chunks + 1) min_grain = n / max_chunks + 1;
+                grain = (min_grain + period - 1) / period * period;
+                count = n == 0 ? 0 : uint32_t(1 + (n > head ? (n - head - 1) / grain : 0));
+            }
+
+            std::size_t begin(uint32_t chunk) const {
+                return chunk == 0 ? 0 : head + std::size_t(chunk) * grain;
+            }
+
+            std::size_t end(uint32_t chunk) const {
+                const std::size_t last = head + (std::size_t(chunk) + 1) * grain;
+                return last < n ? last : n;
+            }
+
+            std::size_t n, head, grain;
+            uint32_t count;
+        };
+
+        // the chunks [begin, end) owned by one thread, packed into 64 bits so that the owner and
+        // the thieves can claim them with a single compare-and-swap; padded to a cache line
+        struct chunk_range {
+            std::atomic<uint64_t> bounds;
+            char padding[cache_line - sizeof(std::atomic<uint64_t>)];
+        };
+
+        class chunk_scheduler {
+        public:
+            chunk_scheduler(std::size_t threads, uint32_t chunks)
+                : m_ranges(new chunk_range[threads]), m_threads(threads) {
+                for (std::size_t t = 0; t < threads; ++t) {
+                    const uint32_t begin = uint32_t(uint64_t(chunks) * t / threads);
+                    const uint32_t end = uint32_t(uint64_t(chunks) * (t + 1) / threads);
+                    m_ranges[t].bounds.store(pack(begin, end), std::memory_order_relaxed);
+                }
+            }
+
+            // claims the next chunk of thread t, steals from the other threads when t has none
+            bool next(std::size_t t, uint32_t& chunk) {
+                if (pop(t, chunk)) return true;
+                for (std::size_t k = 1; k < m_threads; ++k) {
+                    if (steal((t + k) % m_threads, t, chunk)) return true;
+                }
+                return false;
+            }
+
+        private:
+            static uint64_t pack(uint32_t begin, uint32_t end) {
+                return (uint64_t(begin) << 32) | end;
+            }
+
+            // the owner takes chunks from the front
+            bool pop(std::size_t t, uint32_t& chunk) {
+                std::atomic<uint64_t>& bounds = m_ranges[t].bounds;
+                uint64_t old = bounds.load(std::memory_order_acquire);
+                for (;;) {
+                    const uint32_t begin = uint32_t(old >> 32), end = uint32_t(old);
+                    if (begin >= end) return false;
+                    if (bounds.compare_exchange_weak(old, pack(begin + 1, end),
+                                                     std::memory_order_acq_rel)) {
+                        chunk = begin;
+                        return true;
+                    }
+                }
+            }
+
+            // a thief takes the back half of the chunks of the victim, keeps the first of them
+            // and makes the rest its own; the range of the thief is empty at this point, and as
+            // every chunk is claimed only once, a range never returns to an earlier value
+            bool steal(std::size_t victim, std::size_t t, uint32_t& chunk) {
+                std::atomic<uint64_t>& bounds = m_ranges[victim].bounds;
+                uint64_t old = bounds.load(std::memory_order_acquire);
+                for (;;) {
+                    const uint32_t begin = uint32_t(old >> 32), end = uint32_t(old);
+                    if (begin >= end) return false;
+                    const uint32_t split = end - (end - begin + 1) / 2;
+                    if (bounds.compare_exchange_weak(old, pack(begin, split),
+                                                     std::memory_order_acq_rel)) {
+                        chunk = split;
+                        m_ranges[t].bounds.store(pack(split + 1, end), std::memory_order_release);
+                        return true;
+                    }
+                }
+            }
+
+            std::unique_ptr<chunk_range[]> m_ranges;
+            std::size_t m_threads;
+        };
+
+    }
+
+    // calls kernel(chunk_first, chunk_last) for disjoint chunks that cover [first, last), in
+    // parallel on the threads of pool; chunks hold at least grain elements (save for the last
+    // one) and, except for the first one, start on a cache line boundary
+    template <typename T, typename Kernel>
+    void parallel_for(thread_pool& pool, T* first, T* last, std::size_t grain, Kernel kernel) {
+        const impl::chunking<T> chunks(first, std::size_t(last - first), grain);
+        if (chunks.count == 0) return;
+        impl::chunk_scheduler scheduler(pool.size(), chunks.count);
+        auto job = [&](std::size_t t) {
+            uint32_t chunk;
+            while (scheduler.next(t, chunk)) {
+                kernel(first + chunks.begin(chunk), first + chunks.end(chunk));
+            }
+        };
+        pool.run(job);
+    }
+
+    template <typename T, typename Kernel>
+    void parallel_for(T* first, T* last, std::size_t grain, Kernel kernel) {
+        parallel_for(default_thread_pool(), first, last, grain, kernel);
+    }
+
+    // reduces kernel(chunk_first, chunk_last) over the chunks of [first, last) (see parallel_for)
+    // with combine, starting from identity; each thread accumulates its chunks in its own R, for
+    // instance a vector, then the accumulators are combined in the order of the threads. Which
+    // thread processes which chunk varies between calls, so combine must be associative and
+    // commutative, and the results may differ in rounding between calls.
+    template <typename T, typename R, typename Kernel, typename Combine>
+    R parallel_reduce(thread_pool& pool, T* first, T* last, std::size_t grain, R identity,
+                      Kernel kernel, Combine combine) {
+        const impl::chunking<T> chunks(first, std::size_t(last - first), grain);
+        if (chunks.count == 0) return identity;
+        impl::chunk_scheduler scheduler(pool.size(), chunks.count);
+
+        // accumulators of different threads are kept in different cache lines
+        struct alignas(impl::cache_line) padded {
+            R value;
+        };
+        std::vector<padded, allocator<padded>> partial(pool.size(), padded{identity});
+        auto job = [&](std::size_t t) {
+            R acc = identity;
+            uint32_t chunk;
+            while (scheduler.next(t, chunk)) {
+                acc = combine(acc, kernel(first + chunks.begin(chunk), first + chunks.end(chunk)));
+            }
+            partial[t].value = acc;
+        };
+        pool.run(job);
+
+        R result = partial[0].value;
+        for (std::size_t t = 1; t < partial.size(); ++t) result = combine(result, partial[t].value);
+        return result;
+    }
+
+    template <typename T, typename R, typename Kernel, typename Combine>
+    R parallel_reduce(T* first, T* last, std::size_t grain, R identity, Kernel kernel,
+                      Combine combine) {
+        return parallel_reduce(default_thread_pool(), first, last, grain, identity, kernel,
+                               combine);
+    }
+
+    // zeroes [first, last) in the chunks of parallel_for() on the threads of pool; where the OS
+    // places pages on the NUMA node of the thread that touches them first, a newly allocated
+    // array ends up close to the threads that will process it in later parallel_for() calls with
+    // the same pool and grain (work stealing aside); T must be trivially copyable
+    template <typename T>
+    void first_touch(thread_pool& pool, T* first, T* last, std::size_t grain) {
+        static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable");
+        parallel_for(pool, first, last, grain, [](T* chunk_first, T* chunk_last) {
+            std::memset(static_cast<void*>(chunk_first), 0,
+                        std::size_t(chunk_last - chunk_first) * sizeof(T));
+        });
+    }
+
+    template <typename T>
+    void first_touch(T* first, T* last, std::size_t grain) {
+        first_touch(default_thread_pool(), first, last, grain);
+    }
+
+} // namespace sd
+
+#endif // SIMDEE_PARALLEL_HPP
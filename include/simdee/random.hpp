@@ -0,0 +1,165 @@
+// This file is a part of Simdee, see homepage at http://github.com/hrabalik/simdee
+// This file is distributed under the MIT license.
+
+#ifndef SIMDEE_RANDOM_HPP
+#define SIMDEE_RANDOM_HPP
+
+#include "math.hpp"
+#include "simd_vectors/common.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// Pseudo-random number generation with one independent xoshiro128+ generator (D. Blackman and S.
+// Vigna, "Scrambled Linear Pseudorandom Number Generators", 2018) in each lane. The state of lane 0
+// is seeded with SplitMix64, each following lane starts 2^64 steps after the previous one, so that
+// the lanes never overlap in practice. A step takes two shifts, a rotation, an addition and a few
+// xors, all of them lane-wise. Normal deviates are produced in pairs by the Box-Muller transform.
+
+namespace sd {
+    namespace impl {
+
+        // scalar xoshiro128+, used for seeding and jumping
+        struct xoshiro128p_state {
+            uint32_t s[4];
+
+            uint32_t next() {
+                const uint32_t res = s[0] + s[3];
+                const uint32_t t = s[1] << 9;
+                s[2] ^= s[0];
+                s[3] ^= s[1];
+                s[1] ^= s[2];
+                s[0] ^= s[3];
+                s[2] ^= t;
+                s[3] = (s[3] << 11) | (s[3] >> 21);
+                return res;
+            }
+
+            // advances the state by 2^64 steps
+            void jump() {
+                static const uint32_t poly[4] = {0x8764000b, 0xf542d2d3, 0x6fa035c3, 0x77f2db5b};
+                uint32_t acc[4] = {0, 0, 0, 0};
+                for (uint32_t word : poly) {
+                    for (int b = 0; b < 32; ++b) {
+                        if (word & (uint32_t(1) << b)) {
+                            for (int i = 0; i < 4; ++i) acc[i] ^= s[i];
+                        }
+                        next();
+                    }
+                }
+                for (int i = 0; i < 4; ++i) s[i] = acc[i];
+            }
+        };
+
+        inline uint64_t splitmix64(uint64_t& x) {
+            uint64_t z = (x += 0x9e3779b97f4a7c15ULL);
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            return z ^ (z >> 31);
+        }
+
+    } // namespace impl
+
+    // generates vectors of pseudo-random numbers; Simd_t is a SIMDVectorU with 32-bit scalars
+    template <typename Simd_t>
+    class xoshiro128p {
+    public:
+        using vec_u = Simd_t;
+        using vec_s = typename Simd_t::vec_s;
+        using vec_f = typename Simd_t::vec_f;
+        static_assert(std::is_same<typename Simd_t::scalar_t, uint32_t>::value,
+                      "sd::xoshiro128p: the vector must have uint32_t scalars");
+
+        explicit xoshiro128p(uint64_t seed) { this->seed(seed); }
+
+        // resets the state of all lanes, as if the generator was constructed from seed
+        void seed(uint64_t seed) {
+            impl::xoshiro128p_state lane;
+            const uint64_t lo = impl::splitmix64(seed), hi = impl::splitmix64(seed);
+            lane.s[0] = uint32_t(lo);
+            lane.s[1] = uint32_t(lo >> 32);
+            lane.s[2] = uint32_t(hi);
+            lane.s[3] = uint32_t(hi >> 32);
+            typename Simd_t::storage_t s[4];
+            for (std::size_t i = 0; i < Simd_t::width; ++i) {
+                for (int j = 0; j < 4; ++j) s[j][i] = lane.s[j];
+                lane.jump();
+            }
+            for (int j = 0; j < 4; ++j) m_s[j] = Simd_t(s[j]);
+            m_has_spare = false;
+        }
+
+        // advances each lane by 2^64 * width steps, e.g. to give each thread its own generators
+        void jump() {
+            typename Simd_t::storage_t s[4];
+            for (int j = 0; j < 4; ++j) s[j] = m_s[j];
+            for (std::size_t i = 0; i < Simd_t::width; ++i) {
+                impl::xoshiro128p_state lane = {{s[0][i], s[1][i], s[2][i], s[3][i]}};
+                for (std::size_t k = 0; k < Simd_t::width; ++k) lane.jump();
+                for (int j = 0; j < 4; ++j) s[j][i] = lane.s[j];
+            }
+            for (int j = 0; j < 4; ++j) m_s[j] = Simd_t(s[j]);
+            m_has_spare = false;
+        }
+
+        // uniformly distributed 32-bit integers; the lowest bits are of lower quality
+        SIMDEE_INL Simd_t operator()() {
+            const Simd_t res = m_s[0] + m_s[3];
+            const Simd_t t = m_s[1] << 9;
+            m_s[2] ^= m_s[0];
+            m_s[3] ^= m_s[1];
+            m_s[1] ^= m_s[2];
+            m_s[0] ^= m_s[3];
+            m_s[2] ^= t;
+            m_s[3] = rotl(m_s[3], 11);
+            return res;
+        }
+
+        // uniformly distributed floats in [0, 1), multiples of 2^-24
+        SIMDEE_INL vec_f uniform() {
+            return vec_f(vec_s((*this)() >> 8)) * vec_f(5.96046448e-8f);
+        }
+
+        // normally distributed floats with zero mean and unit variance
+        SIMDEE_INL vec_f normal() {
+            if (m_has_spare) {
+                m_has_spare = false;
+                return m_spare;
+            }
+            const vec_f u1 = vec_f(1.f) - uniform(); // in (0, 1]
+            const vec_f angle = uniform() * vec_f(6.28318531f) - vec_f(3.14159265f);
+            const vec_f r = sqrt(vec_f(-2.f) * math::log(u1));
+            m_spare = r * math::sin(angle);
+            m_has_spare = true;
+            return r * math::cos(angle);
+        }
+
+        // writes n values of operator()(), uniform() or normal() to out; any tail is written with
+        // a masked store
+        void fill(uint32_t* out, std::size_t n) {
+            fill_impl(out, n, [this]() { return (*this)(); });
+        }
+        void fill_uniform(float* out, std::size_t n) {
+            fill_impl(out, n, [this]() { return uniform(); });
+        }
+        void fill_normal(float* out, std::size_t n) {
+            fill_impl(out, n, [this]() { return normal(); });
+        }
+
+    private:
+        template <typename T, typename Func>
+        SIMDEE_INL void fill_impl(T* out, std::size_t n, Func gen) {
+            std::size_t i = 0;
+            for (; i + Simd_t::width <= n; i += Simd_t::width) unaligned(out + i) = gen();
+            if (i != n) masked(out + i, n - i) = gen();
+        }
+
+        Simd_t m_s[4];
+        vec_f m_spare;
+        bool m_has_spare;
+    };
+
+} // namespace sd
+
+#endif // SIMDEE_RANDOM_HPP
@@ -0,0 +1,72 @@
+// This file is a part of Simdee, see homepage at http://github.com/hrabalik/simdee
+// This file is distributed under the MIT license.
+
+#ifndef SIMDEE_SCAN_HPP
+#define SIMDEE_SCAN_HPP
+
+#include "simd_vectors/common.hpp"
+
+#include <cstddef>
+
+// Prefix sums over arrays. Each vector is scanned in registers (see inclusive_scan(v)), then the
+// running total of the preceding vectors, kept broadcast in a vector, is added to it. The loop
+// therefore carries a dependency of one addition and one broadcast per vector rather than one
+// addition per scalar. The last, partial vector is accessed with masked loads and stores.
+
+namespace sd {
+    namespace impl {
+
+        template <typename Simd_t>
+        SIMDEE_INL Simd_t broadcast_last(Simd_t v) {
+            return v.template broadcast<Simd_t::width - 1>();
+        }
+
+    }
+
+    // writes first[0] + first[1] + ... + first[i] to out[i] for each i in [0, last - first), returns
+    // the end of the output; out may be equal to first
+    template <typename Simd_t>
+    typename Simd_t::scalar_t* inclusive_scan(const typename Simd_t::scalar_t* first,
+                                              const typename Simd_t::scalar_t* last,
+                                              typename Simd_t::scalar_t* out) {
+        using scalar_t = typename Simd_t::scalar_t;
+        const std::size_t n = std::size_t(last - first);
+        Simd_t carry(scalar_t(0));
+        std::size_t i = 0;
+        for (; i + Simd_t::width <= n; i += Simd_t::width) {
+            Simd_t x = inclusive_scan(Simd_t(unaligned(first + i))) + carry;
+            unaligned(out + i) = x;
+            carry = impl::broadcast_last(x);
+        }
+        if (i != n) {
+            Simd_t x = inclusive_scan(Simd_t(masked(first + i, n - i))) + carry;
+            masked(out + i, n - i) = x;
+        }
+        return out + n;
+    }
+
+    // writes init + first[0] + first[1] + ... + first[i - 1] to out[i] for each i in
+    // [0, last - first), returns the end of the output; out may be equal to first
+    template <typename Simd_t>
+    typename Simd_t::scalar_t* exclusive_scan(const typename Simd_t::scalar_t* first,
+                                              const typename Simd_t::scalar_t* last,
+                                              typename Simd_t::scalar_t* out,
+                                              typename Simd_t::scalar_t init) {
+        const std::size_t n = std::size_t(last - first);
+        Simd_t carry(init);
+        std::size_t i = 0;
+        for (; i + Simd_t::width <= n; i += Simd_t::width) {
+            Simd_t v(unaligned(first + i));
+            Simd_t x = exclusive_scan(v) + carry;
+            unaligned(out + i) = x;
+            carry = impl::broadcast_last(Simd_t(x + v));
+        }
+        if (i != n) {
+            Simd_t x = exclusive_scan(Simd_t(masked(first + i, n - i))) + carry;
+            masked(out + i, n - i) = x;
+        }
+        return out + n;
+    }
+}
+
+#endif // SIMDEE_SCAN_HPP
@@ -5,6 +5,7 @@
 #define SIMDEE_SIMD_TYPES_AVX_HPP
 
 #include "common.hpp"
+#include "sse.hpp"
 
 #if !SIMDEE_AVX
 #error "AVX intrinsics are required to use the AVX SIMD type. Please check your build options."
@@ -55,6 +56,37 @@ namespace sd {
     template <>
     struct simd_vector_traits<avxs> : avx_traits<avxs, int32_t> {};
 
+    namespace impl {
+        // the first count lanes set to all ones, as expected by maskload and maskstore
+        template <std::size_t Width, typename Scalar_t>
+        SIMDEE_INL __m256i avx_lane_mask(std::size_t count) {
+            return _mm256_loadu_si256(
+                reinterpret_cast<const __m256i*>(lane_mask<Width, Scalar_t>(count)));
+        }
+
+#if SIMDEE_NEED_INT
+        // the upper halves of the 64-bit products of the even and of the odd lanes
+        SIMDEE_INL __m256i avx_merge_hi(__m256i even, __m256i odd) {
+            return _mm256_blend_epi32(_mm256_srli_epi64(even, 32), odd, 0xaa);
+        }
+        // the lower or the upper four lanes, moved to the even lanes
+        SIMDEE_INL __m256i avx_spread_lo(__m256 x) {
+            return _mm256_cvtepu32_epi64(_mm256_castsi256_si128(_mm256_castps_si256(x)));
+        }
+        SIMDEE_INL __m256i avx_spread_hi(__m256 x) {
+            return _mm256_cvtepu32_epi64(_mm256_extracti128_si256(_mm256_castps_si256(x), 1));
+        }
+        SIMDEE_INL __m256i avx_mulhi_epu32(__m256i l, __m256i r) {
+            __m256i odd = _mm256_mul_epu32(_mm256_srli_epi64(l, 32), _mm256_srli_epi64(r, 32));
+            return avx_merge_hi(_mm256_mul_epu32(l, r), odd);
+        }
+        SIMDEE_INL __m256i avx_mulhi_epi32(__m256i l, __m256i r) {
+            __m256i odd = _mm256_mul_epi32(_mm256_srli_epi64(l, 32), _mm256_srli_epi64(r, 32));
+            return avx_merge_hi(_mm256_mul_epi32(l, r), odd);
+        }
+#endif
+    } // namespace impl
+
     template <typename Crtp>
     struct avx_base : simd_base<Crtp> {
     protected:
@@ -65,6 +97,8 @@ namespace sd {
         using vector_t = typename simd_base<Crtp>::vector_t;
         using scalar_t = typename simd_base<Crtp>::scalar_t;
         using storage_t = typename simd_base<Crtp>::storage_t;
+        using vec_b = typename simd_base<Crtp>::vec_b;
+        using vec_s = typename simd_base<Crtp>::vec_s;
         using simd_base<Crtp>::width;
         using simd_base<Crtp>::self;
 
@@ -76,6 +110,7 @@ namespace sd {
         SIMDEE_BASE_CTOR_FLAG(avx_base, expr::zero, mm = _mm256_setzero_ps())
         SIMDEE_BASE_CTOR_TPL(avx_base, expr::aligned<T>, aligned_load(r.ptr))
         SIMDEE_BASE_CTOR_TPL(avx_base, expr::unaligned<T>, unaligned_load(r.ptr))
+        SIMDEE_BASE_CTOR_TPL2(avx_base, expr::masked, masked_load(r.ptr, r.sel))
         SIMDEE_BASE_CTOR_TPL(avx_base, expr::init<T>, *this = r.template to<scalar_t>())
         SIMDEE_BASE_CTOR(avx_base, storage_t, aligned_load(r.data()))
 
@@ -85,12 +120,55 @@ namespace sd {
         SIMDEE_INL void aligned_store(scalar_t* r) const {
             _mm256_store_ps(reinterpret_cast<float*>(r), mm);
         }
+        SIMDEE_INL void stream_store(scalar_t* r) const {
+            _mm256_stream_ps(reinterpret_cast<float*>(r), mm);
+        }
         SIMDEE_INL void unaligned_load(const scalar_t* r) {
             mm = _mm256_loadu_ps(reinterpret_cast<const float*>(r));
         }
         SIMDEE_INL void unaligned_store(scalar_t* r) const {
             _mm256_storeu_ps(reinterpret_cast<float*>(r), mm);
         }
+        SIMDEE_INL void masked_load(const scalar_t* r, std::size_t count) {
+            mm = _mm256_maskload_ps(reinterpret_cast<const float*>(r),
+                                    impl::avx_lane_mask<8, int32_t>(count));
+        }
+        SIMDEE_INL void masked_load(const scalar_t* r, const vec_b& pred) {
+            mm = _mm256_maskload_ps(reinterpret_cast<const float*>(r),
+                                    _mm256_castps_si256(pred.data()));
+        }
+        SIMDEE_INL void masked_store(scalar_t* r, std::size_t count) const {
+            _mm256_maskstore_ps(reinterpret_cast<float*>(r),
+                                impl::avx_lane_mask<8, int32_t>(count), mm);
+        }
+        SIMDEE_INL void masked_store(scalar_t* r, const vec_b& pred) const {
+            _mm256_maskstore_ps(reinterpret_cast<float*>(r), _mm256_castps_si256(pred.data()), mm);
+        }
+
+#if SIMDEE_AVX2
+        SIMDEE_INL void gather(const scalar_t* r, const vec_s& idx) {
+            auto base = reinterpret_cast<const float*>(r);
+            mm = _mm256_i32gather_ps(base, _mm256_castps_si256(idx.data()), 4);
+        }
+        SIMDEE_INL void gather(const scalar_t* r, const vec_s& idx, const vec_b& pred) {
+            auto base = reinterpret_cast<const float*>(r);
+            auto at = _mm256_castps_si256(idx.data());
+            mm = _mm256_mask_i32gather_ps(_mm256_setzero_ps(), base, at, pred.data(), 4);
+        }
+#else
+        SIMDEE_INL void gather(const scalar_t* r, const vec_s& idx) {
+            self() = impl::gather_emulation<Crtp>::gather(r, idx);
+        }
+        SIMDEE_INL void gather(const scalar_t* r, const vec_s& idx, const vec_b& pred) {
+            self() = impl::gather_emulation<Crtp>::gather(r, idx, pred);
+        }
+#endif
+        SIMDEE_INL void scatter(scalar_t* r, const vec_s& idx) const {
+            impl::gather_emulation<Crtp>::scatter(self(), r, idx);
+        }
+        SIMDEE_INL void scatter(scalar_t* r, const vec_s& idx, const vec_b& pred) const {
+            impl::gather_emulation<Crtp>::scatter(self(), r, idx, pred);
+        }
 
         template <unsigned int Lane>
         const Crtp broadcast() {
@@ -229,6 +307,31 @@ namespace sd {
         SIMDEE_BINOP(avxu, avxu, operator*, _mm256_mullo_epi32(l.mmi(), r.mmi()))
         SIMDEE_BINOP(avxu, avxu, min, _mm256_min_epu32(l.mmi(), r.mmi()))
         SIMDEE_BINOP(avxu, avxu, max, _mm256_max_epu32(l.mmi(), r.mmi()))
+        SIMDEE_BINOP(avxu, avxu, mulhi, impl::avx_mulhi_epu32(l.mmi(), r.mmi()))
+
+        SIMDEE_INL friend const avxu operator<<(const avxu& l, int r) {
+            return _mm256_sll_epi32(l.mmi(), _mm_cvtsi32_si128(r));
+        }
+        SIMDEE_INL friend const avxu operator>>(const avxu& l, int r) {
+            return _mm256_srl_epi32(l.mmi(), _mm_cvtsi32_si128(r));
+        }
+        SIMDEE_BINOP(avxu, avxu, operator<<, _mm256_sllv_epi32(l.mmi(), r.mmi()))
+        SIMDEE_BINOP(avxu, avxu, operator>>, _mm256_srlv_epi32(l.mmi(), r.mmi()))
+#if SIMDEE_AVX512
+        SIMDEE_INL friend const avxu rotl(const avxu& l, int r) {
+            return _mm256_rolv_epi32(l.mmi(), _mm256_set1_epi32(r));
+        }
+        SIMDEE_INL friend const avxu rotr(const avxu& l, int r) {
+            return _mm256_rorv_epi32(l.mmi(), _mm256_set1_epi32(r));
+        }
+#else
+        SIMDEE_INL friend const avxu rotl(const avxu& l, int r) {
+            return (l << r) | (l >> ((32 - r) & 31));
+        }
+        SIMDEE_INL friend const avxu rotr(const avxu& l, int r) {
+            return (l >> r) | (l << ((32 - r) & 31));
+        }
+#endif
 #endif
     };
 
@@ -269,6 +372,16 @@ namespace sd {
         SIMDEE_BINOP(avxs, avxs, min, _mm256_min_epi32(l.mmi(), r.mmi()))
         SIMDEE_BINOP(avxs, avxs, max, _mm256_max_epi32(l.mmi(), r.mmi()))
         SIMDEE_UNOP(avxs, avxs, abs, _mm256_abs_epi32(l.mmi()))
+        SIMDEE_BINOP(avxs, avxs, mulhi, impl::avx_mulhi_epi32(l.mmi(), r.mmi()))
+
+        SIMDEE_INL friend const avxs operator<<(const avxs& l, int r) {
+            return _mm256_sll_epi32(l.mmi(), _mm_cvtsi32_si128(r));
+        }
+        SIMDEE_INL friend const avxs operator>>(const avxs& l, int r) {
+            return _mm256_sra_epi32(l.mmi(), _mm_cvtsi32_si128(r));
+        }
+        SIMDEE_BINOP(avxs, avxs, operator<<, _mm256_sllv_epi32(l.mmi(), r.mmi()))
+        SIMDEE_BINOP(avxs, avxs, operator>>, _mm256_srav_epi32(l.mmi(), r.mmi()))
 #endif
     };
 
@@ -317,6 +430,1586 @@ namespace sd {
 
     } // namespace impl
 
+    //
+    // 64-bit scalars
+    //
+
+    namespace impl {
+#if SIMDEE_AVX2
+        SIMDEE_INL __m256i avx_cmpgt_epu64(__m256i l, __m256i r) {
+            __m256i bias = _mm256_set1_epi64x(INT64_MIN);
+            return _mm256_cmpgt_epi64(_mm256_xor_si256(l, bias), _mm256_xor_si256(r, bias));
+        }
+#endif
+
+#if SIMDEE_AVX512
+        SIMDEE_INL __m256i avx_imul64(__m256i l, __m256i r) { return _mm256_mullo_epi64(l, r); }
+        SIMDEE_INL __m256d avx_cvtepi64_pd(__m256i r) { return _mm256_cvtepi64_pd(r); }
+        SIMDEE_INL __m256i avx_cvttpd_epi64(__m256d r) { return _mm256_cvttpd_epi64(r); }
+#else
+#if SIMDEE_AVX2
+        SIMDEE_INL __m256i avx_imul64(__m256i l, __m256i r) {
+            __m256i lo = _mm256_mul_epu32(l, r);
+            __m256i cross = _mm256_add_epi64(_mm256_mul_epu32(_mm256_srli_epi64(l, 32), r),
+                                             _mm256_mul_epu32(l, _mm256_srli_epi64(r, 32)));
+            return _mm256_add_epi64(lo, _mm256_slli_epi64(cross, 32));
+        }
+
+        // see sse_cvtepi64_pd
+        SIMDEE_INL __m256d avx_cvtepi64_pd(__m256i r) {
+            __m256i hi = _mm256_and_si256(_mm256_srai_epi32(r, 16),
+                                          _mm256_setr_epi32(0, -1, 0, -1, 0, -1, 0, -1));
+            hi = _mm256_add_epi64(hi,
+                                  _mm256_castpd_si256(_mm256_set1_pd(442721857769029238784.)));
+            __m256i lo = _mm256_and_si256(r, _mm256_set1_epi64x(0x0000ffffffffffffLL));
+            lo = _mm256_or_si256(lo, _mm256_castpd_si256(_mm256_set1_pd(4503599627370496.)));
+            __m256d res =
+                _mm256_sub_pd(_mm256_castsi256_pd(hi), _mm256_set1_pd(442726361368656609280.));
+            return _mm256_add_pd(res, _mm256_castsi256_pd(lo));
+        }
+#else
+        SIMDEE_INL __m256d avx_cvtepi64_pd(__m256i r) {
+            alignas(32) int64_t in[4];
+            _mm256_store_si256(reinterpret_cast<__m256i*>(in), r);
+            return _mm256_setr_pd(double(in[0]), double(in[1]), double(in[2]), double(in[3]));
+        }
+#endif
+
+        // AVX2 has no packed double-to-int64 conversion
+        SIMDEE_INL __m256i avx_cvttpd_epi64(__m256d r) {
+            alignas(32) double in[4];
+            _mm256_store_pd(in, r);
+            return _mm256_setr_epi64x(int64_t(in[0]), int64_t(in[1]), int64_t(in[2]),
+                                      int64_t(in[3]));
+        }
+#endif
+    } // namespace impl
+
+    struct avxb64;
+    struct avxd;
+    struct avxu64;
+    struct avxs64;
+    using not_avxb64 = expr::deferred_lognot<avxb64>;
+    using not_avxu64 = expr::deferred_bitnot<avxu64>;
+    using not_avxs64 = expr::deferred_bitnot<avxs64>;
+
+    template <>
+    struct is_simd_vector<avxb64> : std::integral_constant<bool, true> {};
+    template <>
+    struct is_simd_vector<avxd> : std::integral_constant<bool, true> {};
+    template <>
+    struct is_simd_vector<avxu64> : std::integral_constant<bool, true> {};
+    template <>
+    struct is_simd_vector<avxs64> : std::integral_constant<bool, true> {};
+
+    template <typename Simd_t, typename Scalar_t>
+    struct avx64_traits {
+        using simd_t = Simd_t;
+        using vector_t = __m256d;
+        using scalar_t = Scalar_t;
+        using vec_b = avxb64;
+        using vec_f = avxd;
+        using vec_u = avxu64;
+        using vec_s = avxs64;
+        using mask_t = impl::mask<0xfU>;
+        using storage_t = impl::storage<simd_t, scalar_t, alignof(vector_t)>;
+    };
+
+    template <>
+    struct simd_vector_traits<avxb64> : avx64_traits<avxb64, bool64_t> {};
+    template <>
+    struct simd_vector_traits<avxd> : avx64_traits<avxd, double> {};
+    template <>
+    struct simd_vector_traits<avxu64> : avx64_traits<avxu64, uint64_t> {};
+    template <>
+    struct simd_vector_traits<avxs64> : avx64_traits<avxs64, int64_t> {};
+
+    template <typename Crtp>
+    struct avx64_base : simd_base<Crtp> {
+    protected:
+        using simd_base<Crtp>::mm;
+        SIMDEE_INL __m256i mmi() const { return _mm256_castpd_si256(mm); }
+
+    public:
+        using vector_t = typename simd_base<Crtp>::vector_t;
+        using scalar_t = typename simd_base<Crtp>::scalar_t;
+        using storage_t = typename simd_base<Crtp>::storage_t;
+        using vec_b = typename simd_base<Crtp>::vec_b;
+        using vec_s = typename simd_base<Crtp>::vec_s;
+        using simd_base<Crtp>::width;
+        using simd_base<Crtp>::self;
+
+        SIMDEE_TRIVIAL_TYPE(avx64_base)
+
+        SIMDEE_BASE_CTOR(avx64_base, vector_t, mm = r)
+        SIMDEE_BASE_CTOR(avx64_base, scalar_t,
+                         mm = _mm256_broadcast_sd(reinterpret_cast<const double*>(&r)))
+        SIMDEE_BASE_CTOR_FLAG(avx64_base, expr::zero, mm = _mm256_setzero_pd())
+        SIMDEE_BASE_CTOR_TPL(avx64_base, expr::aligned<T>, aligned_load(r.ptr))
+        SIMDEE_BASE_CTOR_TPL(avx64_base, expr::unaligned<T>, unaligned_load(r.ptr))
+        SIMDEE_BASE_CTOR_TPL2(avx64_base, expr::masked, masked_load(r.ptr, r.sel))
+        SIMDEE_BASE_CTOR_TPL(avx64_base, expr::init<T>, *this = r.template to<scalar_t>())
+        SIMDEE_BASE_CTOR(avx64_base, storage_t, aligned_load(r.data()))
+
+        SIMDEE_INL void aligned_load(const scalar_t* r) {
+            mm = _mm256_load_pd(reinterpret_cast<const double*>(r));
+        }
+        SIMDEE_INL void aligned_store(scalar_t* r) const {
+            _mm256_store_pd(reinterpret_cast<double*>(r), mm);
+        }
+        SIMDEE_INL void stream_store(scalar_t* r) const {
+            _mm256_stream_pd(reinterpret_cast<double*>(r), mm);
+        }
+        SIMDEE_INL void unaligned_load(const scalar_t* r) {
+            mm = _mm256_loadu_pd(reinterpret_cast<const double*>(r));
+        }
+        SIMDEE_INL void unaligned_store(scalar_t* r) const {
+            _mm256_storeu_pd(reinterpret_cast<double*>(r), mm);
+        }
+        SIMDEE_INL void masked_load(const scalar_t* r, std::size_t count) {
+            mm = _mm256_maskload_pd(reinterpret_cast<const double*>(r),
+                                    impl::avx_lane_mask<4, int64_t>(count));
+        }
+        SIMDEE_INL void masked_load(const scalar_t* r, const vec_b& pred) {
+            mm = _mm256_maskload_pd(reinterpret_cast<const double*>(r),
+                                    _mm256_castpd_si256(pred.data()));
+        }
+        SIMDEE_INL void masked_store(scalar_t* r, std::size_t count) const {
+            _mm256_maskstore_pd(reinterpret_cast<double*>(r),
+                                impl::avx_lane_mask<4, int64_t>(count), mm);
+        }
+        SIMDEE_INL void masked_store(scalar_t* r, const vec_b& pred) const {
+            _mm256_maskstore_pd(reinterpret_cast<double*>(r), _mm256_castpd_si256(pred.data()), mm);
+        }
+
+#if SIMDEE_AVX2
+        SIMDEE_INL void gather(const scalar_t* r, const vec_s& idx) {
+            auto base = reinterpret_cast<const double*>(r);
+            mm = _mm256_i64gather_pd(base, _mm256_castpd_si256(idx.data()), 8);
+        }
+        SIMDEE_INL void gather(const scalar_t* r, const vec_s& idx, const vec_b& pred) {
+            auto base = reinterpret_cast<const double*>(r);
+            auto at = _mm256_castpd_si256(idx.data());
+            mm = _mm256_mask_i64gather_pd(_mm256_setzero_pd(), base, at, pred.data(), 8);
+        }
+#else
+        SIMDEE_INL void gather(const scalar_t* r, const vec_s& idx) {
+            self() = impl::gather_emulation<Crtp>::gather(r, idx);
+        }
+        SIMDEE_INL void gather(const scalar_t* r, const vec_s& idx, const vec_b& pred) {
+            self() = impl::gather_emulation<Crtp>::gather(r, idx, pred);
+        }
+#endif
+        SIMDEE_INL void scatter(scalar_t* r, const vec_s& idx) const {
+            impl::gather_emulation<Crtp>::scatter(self(), r, idx);
+        }
+        SIMDEE_INL void scatter(scalar_t* r, const vec_s& idx, const vec_b& pred) const {
+            impl::gather_emulation<Crtp>::scatter(self(), r, idx, pred);
+        }
+
+        template <unsigned int Lane>
+        const Crtp broadcast() {
+            static_assert(Lane < 4, "");
+#if SIMDEE_AVX2
+            return _mm256_permute4x64_pd(mm, _MM_SHUFFLE(Lane, Lane, Lane, Lane));
+#else
+            auto tmp = _mm256_permute_pd(mm, (Lane & 1) * 0xf);
+            return _mm256_permute2f128_pd(tmp, tmp, (Lane >> 1) * 0x11);
+#endif
+        }
+
+        template <typename Op_t>
+        friend const Crtp reduce(const Crtp& l, Op_t f) {
+            Crtp tmp = f(l, _mm256_permute_pd(l.mm, 0x5));
+            return f(tmp, _mm256_permute2f128_pd(tmp.mm, tmp.mm, 0x01));
+        }
+
+#if SIMDEE_AVX2
+        SIMDEE_INL avx64_base(const expr::all_bits& r) { operator=(r); }
+        SIMDEE_INL avx64_base& operator=(const expr::all_bits&) {
+            mm = _mm256_castsi256_pd(
+                _mm256_cmpeq_epi64(_mm256_castpd_si256(mm), _mm256_castpd_si256(mm)));
+            return self();
+        }
+#else
+        SIMDEE_INL avx64_base(const expr::all_bits& r) { operator=(r); }
+        SIMDEE_INL avx64_base& operator=(const expr::all_bits&) {
+            mm = _mm256_castsi256_pd(_mm256_set1_epi32(-1));
+            return self();
+        }
+#endif
+    };
+
+    struct avxb64 : avx64_base<avxb64> {
+        SIMDEE_TRIVIAL_TYPE(avxb64)
+        SIMDEE_INL avxb64(bool64_t v0, bool64_t v1, bool64_t v2, bool64_t v3) {
+            mm = _mm256_castsi256_pd(
+                _mm256_setr_epi64x(int64_t(v0), int64_t(v1), int64_t(v2), int64_t(v3)));
+        }
+
+        using avx64_base::avx64_base;
+        SIMDEE_CTOR(avxb64, __m256i, mm = _mm256_castsi256_pd(r))
+
+#if SIMDEE_AVX2
+        SIMDEE_CTOR(avxb64, not_avxb64,
+                    mm = _mm256_xor_pd(r.neg.mm, _mm256_castsi256_pd(_mm256_cmpeq_epi64(
+                                                     _mm256_castpd_si256(r.neg.mm),
+                                                     _mm256_castpd_si256(r.neg.mm)))))
+#else
+        SIMDEE_CTOR(avxb64, not_avxb64, mm = _mm256_cmp_pd(r.neg.mm, r.neg.mm, _CMP_ORD_Q))
+#endif
+
+        SIMDEE_UNOP(avxb64, mask_t, mask, mask_t(cast_u(_mm256_movemask_pd(l.mm))))
+        SIMDEE_UNOP(avxb64, scalar_t, first_scalar,
+                    dirty::as_b(_mm_cvtsd_f64(_mm256_castpd256_pd128(l.mm))))
+
+#if SIMDEE_AVX2
+        SIMDEE_BINOP(avxb64, avxb64, operator==, _mm256_cmpeq_epi64(l.mmi(), r.mmi()))
+#else
+        SIMDEE_BINOP(avxb64, not_avxb64, operator==, not_avxb64(_mm256_xor_pd(l.mm, r.mm)))
+#endif
+        SIMDEE_BINOP(avxb64, avxb64, operator!=, _mm256_xor_pd(l.mm, r.mm))
+
+        SIMDEE_BINOP(avxb64, avxb64, operator&&, _mm256_and_pd(l.mm, r.mm))
+        SIMDEE_BINOP(avxb64, avxb64, operator||, _mm256_or_pd(l.mm, r.mm))
+        SIMDEE_UNOP(avxb64, not_avxb64, operator!, not_avxb64(l))
+    };
+
+    struct avxd : avx64_base<avxd> {
+        SIMDEE_TRIVIAL_TYPE(avxd)
+
+        using avx64_base::avx64_base;
+        SIMDEE_INL explicit avxd(const avxs64&);
+        SIMDEE_INL avxd(double v0, double v1, double v2, double v3) {
+            mm = _mm256_setr_pd(v0, v1, v2, v3);
+        }
+
+        SIMDEE_UNOP(avxd, scalar_t, first_scalar, _mm_cvtsd_f64(_mm256_castpd256_pd128(l.mm)))
+
+        SIMDEE_BINOP(avxd, avxb64, operator<, _mm256_cmp_pd(l.mm, r.mm, _CMP_LT_OQ))
+        SIMDEE_BINOP(avxd, avxb64, operator>, _mm256_cmp_pd(l.mm, r.mm, _CMP_GT_OQ))
+        SIMDEE_BINOP(avxd, avxb64, operator<=, _mm256_cmp_pd(l.mm, r.mm, _CMP_LE_OQ))
+        SIMDEE_BINOP(avxd, avxb64, operator>=, _mm256_cmp_pd(l.mm, r.mm, _CMP_GE_OQ))
+        SIMDEE_BINOP(avxd, avxb64, operator==, _mm256_cmp_pd(l.mm, r.mm, _CMP_EQ_OQ))
+        SIMDEE_BINOP(avxd, avxb64, operator!=, _mm256_cmp_pd(l.mm, r.mm, _CMP_NEQ_OQ))
+
+        SIMDEE_UNOP(avxd, avxd, operator-, _mm256_xor_pd(l.mm, avxd(sign_bit()).mm))
+        SIMDEE_BINOP(avxd, avxd, operator+, _mm256_add_pd(l.mm, r.mm))
+        SIMDEE_BINOP(avxd, avxd, operator-, _mm256_sub_pd(l.mm, r.mm))
+        SIMDEE_BINOP(avxd, avxd, operator*, _mm256_mul_pd(l.mm, r.mm))
+        SIMDEE_BINOP(avxd, avxd, operator/, _mm256_div_pd(l.mm, r.mm))
+
+        SIMDEE_BINOP(avxd, avxd, min, _mm256_min_pd(l.mm, r.mm))
+        SIMDEE_BINOP(avxd, avxd, max, _mm256_max_pd(l.mm, r.mm))
+        SIMDEE_UNOP(avxd, avxd, sqrt, _mm256_sqrt_pd(l.mm))
+#if SIMDEE_AVX512
+        SIMDEE_UNOP(avxd, avxd, rsqrt, _mm256_rsqrt14_pd(l.mm))
+        SIMDEE_UNOP(avxd, avxd, rcp, _mm256_rcp14_pd(l.mm))
+#else
+        SIMDEE_UNOP(avxd, avxd, rsqrt, _mm256_div_pd(_mm256_set1_pd(1.), _mm256_sqrt_pd(l.mm)))
+        SIMDEE_UNOP(avxd, avxd, rcp, _mm256_div_pd(_mm256_set1_pd(1.), l.mm))
+#endif
+        SIMDEE_UNOP(avxd, avxd, abs, _mm256_and_pd(l.mm, avxd(abs_mask()).mm))
+    };
+
+    struct avxu64 : avx64_base<avxu64> {
+        SIMDEE_TRIVIAL_TYPE(avxu64)
+
+        using avx64_base::avx64_base;
+        SIMDEE_INL explicit avxu64(const avxb64&);
+        SIMDEE_INL explicit avxu64(const avxs64&);
+        SIMDEE_INL avxu64(uint64_t v0, uint64_t v1, uint64_t v2, uint64_t v3) {
+            mm = _mm256_castsi256_pd(
+                _mm256_setr_epi64x(int64_t(v0), int64_t(v1), int64_t(v2), int64_t(v3)));
+        }
+        SIMDEE_CTOR(avxu64, __m256i, mm = _mm256_castsi256_pd(r))
+        SIMDEE_CTOR(avxu64, not_avxu64, mm = _mm256_xor_pd(r.neg.mm, avxu64(all_bits()).mm))
+
+        SIMDEE_UNOP(avxu64, scalar_t, first_scalar,
+                    dirty::as_u(_mm_cvtsd_f64(_mm256_castpd256_pd128(l.mm))))
+
+#if SIMDEE_NEED_INT
+        SIMDEE_BINOP(avxu64, avxb64, operator<, impl::avx_cmpgt_epu64(r.mmi(), l.mmi()))
+        SIMDEE_BINOP(avxu64, avxb64, operator>, impl::avx_cmpgt_epu64(l.mmi(), r.mmi()))
+        SIMDEE_BINOP(avxu64, not_avxb64, operator<=,
+                     not_avxb64(impl::avx_cmpgt_epu64(l.mmi(), r.mmi())))
+        SIMDEE_BINOP(avxu64, not_avxb64, operator>=,
+                     not_avxb64(impl::avx_cmpgt_epu64(r.mmi(), l.mmi())))
+        SIMDEE_BINOP(avxu64, avxb64, operator==, _mm256_cmpeq_epi64(l.mmi(), r.mmi()))
+        SIMDEE_BINOP(avxu64, not_avxb64, operator!=,
+                     not_avxb64(_mm256_cmpeq_epi64(l.mmi(), r.mmi())))
+        SIMDEE_BINOP(avxu64, avxu64, operator&, _mm256_and_pd(l.mm, r.mm))
+        SIMDEE_BINOP(avxu64, avxu64, operator|, _mm256_or_pd(l.mm, r.mm))
+        SIMDEE_BINOP(avxu64, avxu64, operator^, _mm256_xor_pd(l.mm, r.mm))
+        SIMDEE_UNOP(avxu64, not_avxu64, operator~, not_avxu64(l))
+        SIMDEE_UNOP(avxu64, avxu64, operator-, _mm256_sub_epi64(_mm256_setzero_si256(), l.mmi()))
+        SIMDEE_BINOP(avxu64, avxu64, operator+, _mm256_add_epi64(l.mmi(), r.mmi()))
+        SIMDEE_BINOP(avxu64, avxu64, operator-, _mm256_sub_epi64(l.mmi(), r.mmi()))
+        SIMDEE_BINOP(avxu64, avxu64, operator*, impl::avx_imul64(l.mmi(), r.mmi()))
+#if SIMDEE_AVX512
+        SIMDEE_BINOP(avxu64, avxu64, min, _mm256_min_epu64(l.mmi(), r.mmi()))
+        SIMDEE_BINOP(avxu64, avxu64, max, _mm256_max_epu64(l.mmi(), r.mmi()))
+#else
+        SIMDEE_INL friend const avxu64 min(const avxu64& l, const avxu64& r) {
+            return _mm256_blendv_pd(r.mm, l.mm, (r > l).data());
+        }
+        SIMDEE_INL friend const avxu64 max(const avxu64& l, const avxu64& r) {
+            return _mm256_blendv_pd(r.mm, l.mm, (l > r).data());
+        }
+#endif
+#endif
+    };
+
+    struct avxs64 : avx64_base<avxs64> {
+        SIMDEE_TRIVIAL_TYPE(avxs64)
+
+        using avx64_base::avx64_base;
+        SIMDEE_INL explicit avxs64(const avxd&);
+        SIMDEE_INL explicit avxs64(const avxu64&);
+        SIMDEE_INL avxs64(int64_t v0, int64_t v1, int64_t v2, int64_t v3) {
+            mm = _mm256_castsi256_pd(_mm256_setr_epi64x(v0, v1, v2, v3));
+        }
+        SIMDEE_CTOR(avxs64, __m256i, mm = _mm256_castsi256_pd(r))
+        SIMDEE_CTOR(avxs64, not_avxs64, mm = _mm256_xor_pd(r.neg.mm, avxs64(all_bits()).mm))
+
+        SIMDEE_UNOP(avxs64, scalar_t, first_scalar,
+                    dirty::as_s(_mm_cvtsd_f64(_mm256_castpd256_pd128(l.mm))))
+
+#if SIMDEE_NEED_INT
+        SIMDEE_BINOP(avxs64, avxb64, operator<, _mm256_cmpgt_epi64(r.mmi(), l.mmi()))
+        SIMDEE_BINOP(avxs64, avxb64, operator>, _mm256_cmpgt_epi64(l.mmi(), r.mmi()))
+        SIMDEE_BINOP(avxs64, not_avxb64, operator<=,
+                     not_avxb64(_mm256_cmpgt_epi64(l.mmi(), r.mmi())))
+        SIMDEE_BINOP(avxs64, not_avxb64, operator>=,
+                     not_avxb64(_mm256_cmpgt_epi64(r.mmi(), l.mmi())))
+        SIMDEE_BINOP(avxs64, avxb64, operator==, _mm256_cmpeq_epi64(l.mmi(), r.mmi()))
+        SIMDEE_BINOP(avxs64, not_avxb64, operator!=,
+                     not_avxb64(_mm256_cmpeq_epi64(l.mmi(), r.mmi())))
+
+        SIMDEE_BINOP(avxs64, avxs64, operator&, _mm256_and_pd(l.mm, r.mm))
+        SIMDEE_BINOP(avxs64, avxs64, operator|, _mm256_or_pd(l.mm, r.mm))
+        SIMDEE_BINOP(avxs64, avxs64, operator^, _mm256_xor_pd(l.mm, r.mm))
+        SIMDEE_UNOP(avxs64, not_avxs64, operator~, not_avxs64(l))
+
+        SIMDEE_UNOP(avxs64, avxs64, operator-, _mm256_sub_epi64(_mm256_setzero_si256(), l.mmi()))
+        SIMDEE_BINOP(avxs64, avxs64, operator+, _mm256_add_epi64(l.mmi(), r.mmi()))
+        SIMDEE_BINOP(avxs64, avxs64, operator-, _mm256_sub_epi64(l.mmi(), r.mmi()))
+        SIMDEE_BINOP(avxs64, avxs64, operator*, impl::avx_imul64(l.mmi(), r.mmi()))
+
+#if SIMDEE_AVX512
+        SIMDEE_BINOP(avxs64, avxs64, min, _mm256_min_epi64(l.mmi(), r.mmi()))
+        SIMDEE_BINOP(avxs64, avxs64, max, _mm256_max_epi64(l.mmi(), r.mmi()))
+        SIMDEE_UNOP(avxs64, avxs64, abs, _mm256_abs_epi64(l.mmi()))
+#else
+        SIMDEE_INL friend const avxs64 min(const avxs64& l, const avxs64& r) {
+            return _mm256_blendv_pd(r.mm, l.mm, (r > l).data());
+        }
+        SIMDEE_INL friend const avxs64 max(const avxs64& l, const avxs64& r) {
+            return _mm256_blendv_pd(r.mm, l.mm, (l > r).data());
+        }
+        SIMDEE_INL friend const avxs64 abs(const avxs64& l) {
+            __m256i sign = _mm256_cmpgt_epi64(_mm256_setzero_si256(), l.mmi());
+            return _mm256_sub_epi64(_mm256_xor_si256(l.mmi(), sign), sign);
+        }
+#endif
+#endif
+    };
+
+    SIMDEE_INL avxd::avxd(const avxs64& r) {
+        mm = impl::avx_cvtepi64_pd(_mm256_castpd_si256(r.data()));
+    }
+    SIMDEE_INL avxs64::avxs64(const avxd& r) {
+        mm = _mm256_castsi256_pd(impl::avx_cvttpd_epi64(r.data()));
+    }
+    SIMDEE_INL avxu64::avxu64(const avxb64& r) { mm = r.data(); }
+    SIMDEE_INL avxu64::avxu64(const avxs64& r) { mm = r.data(); }
+    SIMDEE_INL avxs64::avxs64(const avxu64& r) { mm = r.data(); }
+
+    SIMDEE_INL const avxb64 cond(const avxb64& pred, const avxb64& if_true,
+                                 const avxb64& if_false) {
+        return _mm256_blendv_pd(if_false.data(), if_true.data(), pred.data());
+    }
+    SIMDEE_INL const avxd cond(const avxb64& pred, const avxd& if_true, const avxd& if_false) {
+        return _mm256_blendv_pd(if_false.data(), if_true.data(), pred.data());
+    }
+    SIMDEE_INL const avxu64 cond(const avxb64& pred, const avxu64& if_true,
+                                 const avxu64& if_false) {
+        return _mm256_blendv_pd(if_false.data(), if_true.data(), pred.data());
+    }
+    SIMDEE_INL const avxs64 cond(const avxb64& pred, const avxs64& if_true,
+                                 const avxs64& if_false) {
+        return _mm256_blendv_pd(if_false.data(), if_true.data(), pred.data());
+    }
+
+#if SIMDEE_NEED_INT
+    // the full 64-bit products of the lower and of the upper half of the 32-bit scalars
+    SIMDEE_INL const avxu64 mul_wide_lo(const avxu& l, const avxu& r) {
+        return _mm256_mul_epu32(impl::avx_spread_lo(l.data()), impl::avx_spread_lo(r.data()));
+    }
+    SIMDEE_INL const avxu64 mul_wide_hi(const avxu& l, const avxu& r) {
+        return _mm256_mul_epu32(impl::avx_spread_hi(l.data()), impl::avx_spread_hi(r.data()));
+    }
+    SIMDEE_INL const avxs64 mul_wide_lo(const avxs& l, const avxs& r) {
+        return _mm256_mul_epi32(impl::avx_spread_lo(l.data()), impl::avx_spread_lo(r.data()));
+    }
+    SIMDEE_INL const avxs64 mul_wide_hi(const avxs& l, const avxs& r) {
+        return _mm256_mul_epi32(impl::avx_spread_hi(l.data()), impl::avx_spread_hi(r.data()));
+    }
+#endif
+
+    namespace impl {
+
+        template <typename T, typename NotT>
+        struct avx64_special_ops {
+            SIMDEE_INL static T andnot(const T& l, const T& r) {
+                return _mm256_andnot_pd(r.data(), l.data());
+            }
+            SIMDEE_INL static NotT ornot(const T& l, const T& r) { return NotT(andnot(r, l)); }
+        };
+
+        template <>
+        struct special_ops<avxb64> : avx64_special_ops<avxb64, not_avxb64> {};
+
+        template <>
+        struct special_ops<avxu64> : avx64_special_ops<avxu64, not_avxu64> {};
+
+        template <>
+        struct special_ops<avxs64> : avx64_special_ops<avxs64, not_avxs64> {};
+
+    } // namespace impl
+
+#if SIMDEE_AVX2
+    //
+    // 8-bit and 16-bit scalars
+    //
+
+    namespace impl {
+        SIMDEE_INL __m256i avx_not(__m256i v) { return _mm256_xor_si256(v, _mm256_set1_epi32(-1)); }
+
+        // unsigned comparison by the means of a signed one
+        SIMDEE_INL __m256i avx_cmpgt_epu8(__m256i l, __m256i r) {
+            const __m256i bias = _mm256_set1_epi8(-0x80);
+            return _mm256_cmpgt_epi8(_mm256_xor_si256(l, bias), _mm256_xor_si256(r, bias));
+        }
+        SIMDEE_INL __m256i avx_cmpgt_epu16(__m256i l, __m256i r) {
+            const __m256i bias = _mm256_set1_epi16(-0x8000);
+            return _mm256_cmpgt_epi16(_mm256_xor_si256(l, bias), _mm256_xor_si256(r, bias));
+        }
+
+        // the signed average, rounded up, by the means of the unsigned one
+        SIMDEE_INL __m256i avx_avg_epi8(__m256i l, __m256i r) {
+            const __m256i bias = _mm256_set1_epi8(-0x80);
+            return _mm256_xor_si256(
+                _mm256_avg_epu8(_mm256_xor_si256(l, bias), _mm256_xor_si256(r, bias)), bias);
+        }
+        SIMDEE_INL __m256i avx_avg_epi16(__m256i l, __m256i r) {
+            const __m256i bias = _mm256_set1_epi16(-0x8000);
+            return _mm256_xor_si256(
+                _mm256_avg_epu16(_mm256_xor_si256(l, bias), _mm256_xor_si256(r, bias)), bias);
+        }
+
+        // packs operate on each 128-bit half separately, this puts the quarters back in order
+        SIMDEE_INL __m256i avx_fix_pack(__m256i v) {
+            return _mm256_permute4x64_epi64(v, _MM_SHUFFLE(3, 1, 2, 0));
+        }
+
+        template <std::size_t Size>
+        struct avx_narrow;
+
+        template <>
+        struct avx_narrow<1> {
+            SIMDEE_INL static __m256i set1(uint8_t v) { return _mm256_set1_epi8(char(v)); }
+        };
+
+        template <>
+        struct avx_narrow<2> {
+            SIMDEE_INL static __m256i set1(uint16_t v) { return _mm256_set1_epi16(short(v)); }
+        };
+    } // namespace impl
+
+    struct avxb8;
+    struct avxu8;
+    struct avxs8;
+    struct avxb16;
+    struct avxu16;
+    struct avxs16;
+
+    template <>
+    struct is_simd_vector<avxb8> : std::integral_constant<bool, true> {};
+    template <>
+    struct is_simd_vector<avxu8> : std::integral_constant<bool, true> {};
+    template <>
+    struct is_simd_vector<avxs8> : std::integral_constant<bool, true> {};
+    template <>
+    struct is_simd_vector<avxb16> : std::integral_constant<bool, true> {};
+    template <>
+    struct is_simd_vector<avxu16> : std::integral_constant<bool, true> {};
+    template <>
+    struct is_simd_vector<avxs16> : std::integral_constant<bool, true> {};
+
+    template <typename Simd_t, typename Scalar_t>
+    struct avx8_traits {
+        using simd_t = Simd_t;
+        using vector_t = __m256i;
+        using scalar_t = Scalar_t;
+        using vec_b = avxb8;
+        using vec_f = void; // there are no 8-bit floating-point scalars
+        using vec_u = avxu8;
+        using vec_s = avxs8;
+        using mask_t = impl::mask<0xffffffffU>;
+        using storage_t = impl::storage<simd_t, scalar_t, alignof(vector_t)>;
+    };
+
+    template <typename Simd_t, typename Scalar_t>
+    struct avx16_traits {
+        using simd_t = Simd_t;
+        using vector_t = __m256i;
+        using scalar_t = Scalar_t;
+        using vec_b = avxb16;
+        using vec_f = void; // there are no 16-bit floating-point scalars
+        using vec_u = avxu16;
+        using vec_s = avxs16;
+        using mask_t = impl::mask<0xffffU>;
+        using storage_t = impl::storage<simd_t, scalar_t, alignof(vector_t)>;
+    };
+
+    template <>
+    struct simd_vector_traits<avxb8> : avx8_traits<avxb8, bool8_t> {};
+    template <>
+    struct simd_vector_traits<avxu8> : avx8_traits<avxu8, uint8_t> {};
+    template <>
+    struct simd_vector_traits<avxs8> : avx8_traits<avxs8, int8_t> {};
+    template <>
+    struct simd_vector_traits<avxb16> : avx16_traits<avxb16, bool16_t> {};
+    template <>
+    struct simd_vector_traits<avxu16> : avx16_traits<avxu16, uint16_t> {};
+    template <>
+    struct simd_vector_traits<avxs16> : avx16_traits<avxs16, int16_t> {};
+
+    template <typename Crtp>
+    struct avx_narrow_base : simd_base<Crtp> {
+    protected:
+        using simd_base<Crtp>::mm;
+        using ops = impl::avx_narrow<sizeof(typename simd_base<Crtp>::scalar_t)>;
+
+    public:
+        using vector_t = typename simd_base<Crtp>::vector_t;
+        using scalar_t = typename simd_base<Crtp>::scalar_t;
+        using storage_t = typename simd_base<Crtp>::storage_t;
+        using vec_b = typename simd_base<Crtp>::vec_b;
+        using simd_base<Crtp>::width;
+        using simd_base<Crtp>::self;
+
+        SIMDEE_TRIVIAL_TYPE(avx_narrow_base)
+
+        SIMDEE_BASE_CTOR(avx_narrow_base, vector_t, mm = r)
+        SIMDEE_BASE_CTOR(avx_narrow_base, scalar_t, mm = ops::set1(dirty::as_u(r)))
+        SIMDEE_BASE_CTOR_FLAG(avx_narrow_base, expr::zero, mm = _mm256_setzero_si256())
+        SIMDEE_BASE_CTOR_FLAG(avx_narrow_base, expr::all_bits, mm = _mm256_set1_epi32(-1))
+        SIMDEE_BASE_CTOR_TPL(avx_narrow_base, expr::aligned<T>, aligned_load(r.ptr))
+        SIMDEE_BASE_CTOR_TPL(avx_narrow_base, expr::unaligned<T>, unaligned_load(r.ptr))
+        SIMDEE_BASE_CTOR_TPL2(avx_narrow_base, expr::masked, masked_load(r.ptr, r.sel))
+        SIMDEE_BASE_CTOR_TPL(avx_narrow_base, expr::init<T>, *this = r.template to<scalar_t>())
+        SIMDEE_BASE_CTOR(avx_narrow_base, storage_t, aligned_load(r.data()))
+
+        SIMDEE_INL void aligned_load(const scalar_t* r) {
+            mm = _mm256_load_si256(reinterpret_cast<const __m256i*>(r));
+        }
+        SIMDEE_INL void aligned_store(scalar_t* r) const {
+            _mm256_store_si256(reinterpret_cast<__m256i*>(r), mm);
+        }
+        SIMDEE_INL void stream_store(scalar_t* r) const {
+            _mm256_stream_si256(reinterpret_cast<__m256i*>(r), mm);
+        }
+        SIMDEE_INL void unaligned_load(const scalar_t* r) {
+            mm = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(r));
+        }
+        SIMDEE_INL void unaligned_store(scalar_t* r) const {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(r), mm);
+        }
+        SIMDEE_INL void masked_load(const scalar_t* r, std::size_t count) {
+            self() = impl::masked_emulation<Crtp>::load(r, count);
+        }
+        SIMDEE_INL void masked_load(const scalar_t* r, const vec_b& pred) {
+            self() = impl::masked_emulation<Crtp>::load(r, pred);
+        }
+        SIMDEE_INL void masked_store(scalar_t* r, std::size_t count) const {
+            impl::masked_emulation<Crtp>::store(self(), r, count);
+        }
+        SIMDEE_INL void masked_store(scalar_t* r, const vec_b& pred) const {
+            impl::masked_emulation<Crtp>::store(self(), r, pred);
+        }
+
+        template <unsigned int Lane>
+        SIMDEE_INL const Crtp broadcast() {
+            static_assert(Lane < width, "");
+            return Crtp(storage_t(self())[Lane]);
+        }
+
+        template <typename Op_t>
+        friend const Crtp reduce(const Crtp& l, Op_t f) {
+            Crtp tmp = f(l, Crtp(_mm256_permute2x128_si256(l.mm, l.mm, 1)));
+            tmp = f(tmp, Crtp(_mm256_alignr_epi8(tmp.mm, tmp.mm, 8)));
+            tmp = f(tmp, Crtp(_mm256_alignr_epi8(tmp.mm, tmp.mm, 4)));
+            tmp = f(tmp, Crtp(_mm256_alignr_epi8(tmp.mm, tmp.mm, 2)));
+            if (width == 16) return tmp;
+            return f(tmp, Crtp(_mm256_alignr_epi8(tmp.mm, tmp.mm, 1)));
+        }
+    };
+
+    struct avxb8 : avx_narrow_base<avxb8> {
+        SIMDEE_TRIVIAL_TYPE(avxb8)
+
+        using avx_narrow_base::avx_narrow_base;
+
+        SIMDEE_UNOP(avxb8, mask_t, mask, mask_t(cast_u(_mm256_movemask_epi8(l.mm))))
+        SIMDEE_UNOP(avxb8, scalar_t, first_scalar,
+                    scalar_t(uint8_t(_mm_cvtsi128_si32(_mm256_castsi256_si128(l.mm)))))
+
+        SIMDEE_BINOP(avxb8, avxb8, operator==, _mm256_cmpeq_epi8(l.mm, r.mm))
+        SIMDEE_BINOP(avxb8, avxb8, operator!=, _mm256_xor_si256(l.mm, r.mm))
+        SIMDEE_BINOP(avxb8, avxb8, operator&&, _mm256_and_si256(l.mm, r.mm))
+        SIMDEE_BINOP(avxb8, avxb8, operator||, _mm256_or_si256(l.mm, r.mm))
+        SIMDEE_UNOP(avxb8, avxb8, operator!, impl::avx_not(l.mm))
+    };
+
+    struct avxu8 : avx_narrow_base<avxu8> {
+        SIMDEE_TRIVIAL_TYPE(avxu8)
+
+        using avx_narrow_base::avx_narrow_base;
+        SIMDEE_INL explicit avxu8(const avxb8&);
+        SIMDEE_INL explicit avxu8(const avxs8&);
+
+        SIMDEE_UNOP(avxu8, scalar_t, first_scalar,
+                    scalar_t(_mm_cvtsi128_si32(_mm256_castsi256_si128(l.mm))))
+
+#if SIMDEE_NEED_INT
+        SIMDEE_BINOP(avxu8, avxb8, operator<, impl::avx_cmpgt_epu8(r.mm, l.mm))
+        SIMDEE_BINOP(avxu8, avxb8, operator>, impl::avx_cmpgt_epu8(l.mm, r.mm))
+        SIMDEE_BINOP(avxu8, avxb8, operator<=,
+                     _mm256_cmpeq_epi8(_mm256_max_epu8(l.mm, r.mm), r.mm))
+        SIMDEE_BINOP(avxu8, avxb8, operator>=,
+                     _mm256_cmpeq_epi8(_mm256_max_epu8(l.mm, r.mm), l.mm))
+        SIMDEE_BINOP(avxu8, avxb8, operator==, _mm256_cmpeq_epi8(l.mm, r.mm))
+        SIMDEE_BINOP(avxu8, avxb8, operator!=, impl::avx_not(_mm256_cmpeq_epi8(l.mm, r.mm)))
+
+        SIMDEE_BINOP(avxu8, avxu8, operator&, _mm256_and_si256(l.mm, r.mm))
+        SIMDEE_BINOP(avxu8, avxu8, operator|, _mm256_or_si256(l.mm, r.mm))
+        SIMDEE_BINOP(avxu8, avxu8, operator^, _mm256_xor_si256(l.mm, r.mm))
+        SIMDEE_UNOP(avxu8, avxu8, operator~, impl::avx_not(l.mm))
+
+        SIMDEE_UNOP(avxu8, avxu8, operator-, _mm256_sub_epi8(_mm256_setzero_si256(), l.mm))
+        SIMDEE_BINOP(avxu8, avxu8, operator+, _mm256_add_epi8(l.mm, r.mm))
+        SIMDEE_BINOP(avxu8, avxu8, operator-, _mm256_sub_epi8(l.mm, r.mm))
+        SIMDEE_BINOP(avxu8, avxu8, add_sat, _mm256_adds_epu8(l.mm, r.mm))
+        SIMDEE_BINOP(avxu8, avxu8, sub_sat, _mm256_subs_epu8(l.mm, r.mm))
+        SIMDEE_BINOP(avxu8, avxu8, avg, _mm256_avg_epu8(l.mm, r.mm))
+        SIMDEE_BINOP(avxu8, avxu8, min, _mm256_min_epu8(l.mm, r.mm))
+        SIMDEE_BINOP(avxu8, avxu8, max, _mm256_max_epu8(l.mm, r.mm))
+#endif
+    };
+
+    struct avxs8 : avx_narrow_base<avxs8> {
+        SIMDEE_TRIVIAL_TYPE(avxs8)
+
+        using avx_narrow_base::avx_narrow_base;
+        SIMDEE_INL explicit avxs8(const avxu8&);
+
+        SIMDEE_UNOP(avxs8, scalar_t, first_scalar,
+                    scalar_t(_mm_cvtsi128_si32(_mm256_castsi256_si128(l.mm))))
+
+#if SIMDEE_NEED_INT
+        SIMDEE_BINOP(avxs8, avxb8, operator<, _mm256_cmpgt_epi8(r.mm, l.mm))
+        SIMDEE_BINOP(avxs8, avxb8, operator>, _mm256_cmpgt_epi8(l.mm, r.mm))
+        SIMDEE_BINOP(avxs8, avxb8, operator<=, impl::avx_not(_mm256_cmpgt_epi8(l.mm, r.mm)))
+        SIMDEE_BINOP(avxs8, avxb8, operator>=, impl::avx_not(_mm256_cmpgt_epi8(r.mm, l.mm)))
+        SIMDEE_BINOP(avxs8, avxb8, operator==, _mm256_cmpeq_epi8(l.mm, r.mm))
+        SIMDEE_BINOP(avxs8, avxb8, operator!=, impl::avx_not(_mm256_cmpeq_epi8(l.mm, r.mm)))
+
+        SIMDEE_BINOP(avxs8, avxs8, operator&, _mm256_and_si256(l.mm, r.mm))
+        SIMDEE_BINOP(avxs8, avxs8, operator|, _mm256_or_si256(l.mm, r.mm))
+        SIMDEE_BINOP(avxs8, avxs8, operator^, _mm256_xor_si256(l.mm, r.mm))
+        SIMDEE_UNOP(avxs8, avxs8, operator~, impl::avx_not(l.mm))
+
+        SIMDEE_UNOP(avxs8, avxs8, operator-, _mm256_sub_epi8(_mm256_setzero_si256(), l.mm))
+        SIMDEE_BINOP(avxs8, avxs8, operator+, _mm256_add_epi8(l.mm, r.mm))
+        SIMDEE_BINOP(avxs8, avxs8, operator-, _mm256_sub_epi8(l.mm, r.mm))
+        SIMDEE_BINOP(avxs8, avxs8, add_sat, _mm256_adds_epi8(l.mm, r.mm))
+        SIMDEE_BINOP(avxs8, avxs8, sub_sat, _mm256_subs_epi8(l.mm, r.mm))
+        SIMDEE_BINOP(avxs8, avxs8, avg, impl::avx_avg_epi8(l.mm, r.mm))
+        SIMDEE_BINOP(avxs8, avxs8, min, _mm256_min_epi8(l.mm, r.mm))
+        SIMDEE_BINOP(avxs8, avxs8, max, _mm256_max_epi8(l.mm, r.mm))
+        SIMDEE_UNOP(avxs8, avxs8, abs, _mm256_abs_epi8(l.mm))
+#endif
+    };
+
+    struct avxb16 : avx_narrow_base<avxb16> {
+        SIMDEE_TRIVIAL_TYPE(avxb16)
+
+        using avx_narrow_base::avx_narrow_base;
+
+        SIMDEE_UNOP(avxb16, mask_t, mask,
+                    mask_t(cast_u(_mm256_movemask_epi8(
+                        impl::avx_fix_pack(_mm256_packs_epi16(l.mm, _mm256_setzero_si256()))))))
+        SIMDEE_UNOP(avxb16, scalar_t, first_scalar,
+                    scalar_t(uint16_t(_mm_cvtsi128_si32(_mm256_castsi256_si128(l.mm)))))
+
+        SIMDEE_BINOP(avxb16, avxb16, operator==, _mm256_cmpeq_epi16(l.mm, r.mm))
+        SIMDEE_BINOP(avxb16, avxb16, operator!=, _mm256_xor_si256(l.mm, r.mm))
+        SIMDEE_BINOP(avxb16, avxb16, operator&&, _mm256_and_si256(l.mm, r.mm))
+        SIMDEE_BINOP(avxb16, avxb16, operator||, _mm256_or_si256(l.mm, r.mm))
+        SIMDEE_UNOP(avxb16, avxb16, operator!, impl::avx_not(l.mm))
+    };
+
+    struct avxu16 : avx_narrow_base<avxu16> {
+        SIMDEE_TRIVIAL_TYPE(avxu16)
+
+        using avx_narrow_base::avx_narrow_base;
+        SIMDEE_INL explicit avxu16(const avxb16&);
+        SIMDEE_INL explicit avxu16(const avxs16&);
+
+        SIMDEE_UNOP(avxu16, scalar_t, first_scalar,
+                    scalar_t(_mm_cvtsi128_si32(_mm256_castsi256_si128(l.mm))))
+
+#if SIMDEE_NEED_INT
+        SIMDEE_BINOP(avxu16, avxb16, operator<, impl::avx_cmpgt_epu16(r.mm, l.mm))
+        SIMDEE_BINOP(avxu16, avxb16, operator>, impl::avx_cmpgt_epu16(l.mm, r.mm))
+        SIMDEE_BINOP(avxu16, avxb16, operator<=,
+                     _mm256_cmpeq_epi16(_mm256_max_epu16(l.mm, r.mm), r.mm))
+        SIMDEE_BINOP(avxu16, avxb16, operator>=,
+                     _mm256_cmpeq_epi16(_mm256_max_epu16(l.mm, r.mm), l.mm))
+        SIMDEE_BINOP(avxu16, avxb16, operator==, _mm256_cmpeq_epi16(l.mm, r.mm))
+        SIMDEE_BINOP(avxu16, avxb16, operator!=, impl::avx_not(_mm256_cmpeq_epi16(l.mm, r.mm)))
+
+        SIMDEE_BINOP(avxu16, avxu16, operator&, _mm256_and_si256(l.mm, r.mm))
+        SIMDEE_BINOP(avxu16, avxu16, operator|, _mm256_or_si256(l.mm, r.mm))
+        SIMDEE_BINOP(avxu16, avxu16, operator^, _mm256_xor_si256(l.mm, r.mm))
+        SIMDEE_UNOP(avxu16, avxu16, operator~, impl::avx_not(l.mm))
+
+        SIMDEE_UNOP(avxu16, avxu16, operator-, _mm256_sub_epi16(_mm256_setzero_si256(), l.mm))
+        SIMDEE_BINOP(avxu16, avxu16, operator+, _mm256_add_epi16(l.mm, r.mm))
+        SIMDEE_BINOP(avxu16, avxu16, operator-, _mm256_sub_epi16(l.mm, r.mm))
+        SIMDEE_BINOP(avxu16, avxu16, operator*, _mm256_mullo_epi16(l.mm, r.mm))
+        SIMDEE_BINOP(avxu16, avxu16, mulhi, _mm256_mulhi_epu16(l.mm, r.mm))
+        SIMDEE_BINOP(avxu16, avxu16, add_sat, _mm256_adds_epu16(l.mm, r.mm))
+        SIMDEE_BINOP(avxu16, avxu16, sub_sat, _mm256_subs_epu16(l.mm, r.mm))
+        SIMDEE_BINOP(avxu16, avxu16, avg, _mm256_avg_epu16(l.mm, r.mm))
+        SIMDEE_BINOP(avxu16, avxu16, min, _mm256_min_epu16(l.mm, r.mm))
+        SIMDEE_BINOP(avxu16, avxu16, max, _mm256_max_epu16(l.mm, r.mm))
+#endif
+    };
+
+    struct avxs16 : avx_narrow_base<avxs16> {
+        SIMDEE_TRIVIAL_TYPE(avxs16)
+
+        using avx_narrow_base::avx_narrow_base;
+        SIMDEE_INL explicit avxs16(const avxu16&);
+
+        SIMDEE_UNOP(avxs16, scalar_t, first_scalar,
+                    scalar_t(_mm_cvtsi128_si32(_mm256_castsi256_si128(l.mm))))
+
+#if SIMDEE_NEED_INT
+        SIMDEE_BINOP(avxs16, avxb16, operator<, _mm256_cmpgt_epi16(r.mm, l.mm))
+        SIMDEE_BINOP(avxs16, avxb16, operator>, _mm256_cmpgt_epi16(l.mm, r.mm))
+        SIMDEE_BINOP(avxs16, avxb16, operator<=, impl::avx_not(_mm256_cmpgt_epi16(l.mm, r.mm)))
+        SIMDEE_BINOP(avxs16, avxb16, operator>=, impl::avx_not(_mm256_cmpgt_epi16(r.mm, l.mm)))
+        SIMDEE_BINOP(avxs16, avxb16, operator==, _mm256_cmpeq_epi16(l.mm, r.mm))
+        SIMDEE_BINOP(avxs16, avxb16, operator!=, impl::avx_not(_mm256_cmpeq_epi16(l.mm, r.mm)))
+
+        SIMDEE_BINOP(avxs16, avxs16, operator&, _mm256_and_si256(l.mm, r.mm))
+        SIMDEE_BINOP(avxs16, avxs16, operator|, _mm256_or_si256(l.mm, r.mm))
+        SIMDEE_BINOP(avxs16, avxs16, operator^, _mm256_xor_si256(l.mm, r.mm))
+        SIMDEE_UNOP(avxs16, avxs16, operator~, impl::avx_not(l.mm))
+
+        SIMDEE_UNOP(avxs16, avxs16, operator-, _mm256_sub_epi16(_mm256_setzero_si256(), l.mm))
+        SIMDEE_BINOP(avxs16, avxs16, operator+, _mm256_add_epi16(l.mm, r.mm))
+        SIMDEE_BINOP(avxs16, avxs16, operator-, _mm256_sub_epi16(l.mm, r.mm))
+        SIMDEE_BINOP(avxs16, avxs16, operator*, _mm256_mullo_epi16(l.mm, r.mm))
+        SIMDEE_BINOP(avxs16, avxs16, mulhi, _mm256_mulhi_epi16(l.mm, r.mm))
+        SIMDEE_BINOP(avxs16, avxs16, add_sat, _mm256_adds_epi16(l.mm, r.mm))
+        SIMDEE_BINOP(avxs16, avxs16, sub_sat, _mm256_subs_epi16(l.mm, r.mm))
+        SIMDEE_BINOP(avxs16, avxs16, avg, impl::avx_avg_epi16(l.mm, r.mm))
+        SIMDEE_BINOP(avxs16, avxs16, min, _mm256_min_epi16(l.mm, r.mm))
+        SIMDEE_BINOP(avxs16, avxs16, max, _mm256_max_epi16(l.mm, r.mm))
+        SIMDEE_UNOP(avxs16, avxs16, abs, _mm256_abs_epi16(l.mm))
+#endif
+    };
+
+    SIMDEE_INL avxu8::avxu8(const avxb8& r) { mm = r.data(); }
+    SIMDEE_INL avxu8::avxu8(const avxs8& r) { mm = r.data(); }
+    SIMDEE_INL avxs8::avxs8(const avxu8& r) { mm = r.data(); }
+    SIMDEE_INL avxu16::avxu16(const avxb16& r) { mm = r.data(); }
+    SIMDEE_INL avxu16::avxu16(const avxs16& r) { mm = r.data(); }
+    SIMDEE_INL avxs16::avxs16(const avxu16& r) { mm = r.data(); }
+
+    SIMDEE_INL const avxb8 cond(const avxb8& pred, const avxb8& if_true, const avxb8& if_false) {
+        return _mm256_blendv_epi8(if_false.data(), if_true.data(), pred.data());
+    }
+    SIMDEE_INL const avxu8 cond(const avxb8& pred, const avxu8& if_true, const avxu8& if_false) {
+        return _mm256_blendv_epi8(if_false.data(), if_true.data(), pred.data());
+    }
+    SIMDEE_INL const avxs8 cond(const avxb8& pred, const avxs8& if_true, const avxs8& if_false) {
+        return _mm256_blendv_epi8(if_false.data(), if_true.data(), pred.data());
+    }
+    SIMDEE_INL const avxb16 cond(const avxb16& pred, const avxb16& if_true,
+                                 const avxb16& if_false) {
+        return _mm256_blendv_epi8(if_false.data(), if_true.data(), pred.data());
+    }
+    SIMDEE_INL const avxu16 cond(const avxb16& pred, const avxu16& if_true,
+                                 const avxu16& if_false) {
+        return _mm256_blendv_epi8(if_false.data(), if_true.data(), pred.data());
+    }
+    SIMDEE_INL const avxs16 cond(const avxb16& pred, const avxs16& if_true,
+                                 const avxs16& if_false) {
+        return _mm256_blendv_epi8(if_false.data(), if_true.data(), pred.data());
+    }
+
+#if SIMDEE_NEED_INT
+    // the lower and the upper half of the scalars, zero- or sign-extended to twice the size
+    SIMDEE_INL const avxu16 widen_lo(const avxu8& v) {
+        return _mm256_cvtepu8_epi16(_mm256_castsi256_si128(v.data()));
+    }
+    SIMDEE_INL const avxu16 widen_hi(const avxu8& v) {
+        return _mm256_cvtepu8_epi16(_mm256_extracti128_si256(v.data(), 1));
+    }
+    SIMDEE_INL const avxs16 widen_lo(const avxs8& v) {
+        return _mm256_cvtepi8_epi16(_mm256_castsi256_si128(v.data()));
+    }
+    SIMDEE_INL const avxs16 widen_hi(const avxs8& v) {
+        return _mm256_cvtepi8_epi16(_mm256_extracti128_si256(v.data(), 1));
+    }
+    SIMDEE_INL const avxu widen_lo(const avxu16& v) {
+        return _mm256_cvtepu16_epi32(_mm256_castsi256_si128(v.data()));
+    }
+    SIMDEE_INL const avxu widen_hi(const avxu16& v) {
+        return _mm256_cvtepu16_epi32(_mm256_extracti128_si256(v.data(), 1));
+    }
+    SIMDEE_INL const avxs widen_lo(const avxs16& v) {
+        return _mm256_cvtepi16_epi32(_mm256_castsi256_si128(v.data()));
+    }
+    SIMDEE_INL const avxs widen_hi(const avxs16& v) {
+        return _mm256_cvtepi16_epi32(_mm256_extracti128_si256(v.data(), 1));
+    }
+
+    // the scalars of lo followed by those of hi, saturated to half the size
+    SIMDEE_INL const avxu8 narrow(const avxu16& lo, const avxu16& hi) {
+        // packus treats its input as signed
+        const avxu16 top(uint16_t(0xff));
+        return impl::avx_fix_pack(_mm256_packus_epi16(min(lo, top).data(), min(hi, top).data()));
+    }
+    SIMDEE_INL const avxs8 narrow(const avxs16& lo, const avxs16& hi) {
+        return impl::avx_fix_pack(_mm256_packs_epi16(lo.data(), hi.data()));
+    }
+    SIMDEE_INL const avxu16 narrow(const avxu& lo, const avxu& hi) {
+        const avxu top(0xffffU);
+        const __m256i l = _mm256_castps_si256(min(lo, top).data());
+        const __m256i h = _mm256_castps_si256(min(hi, top).data());
+        return impl::avx_fix_pack(_mm256_packus_epi32(l, h));
+    }
+    SIMDEE_INL const avxs16 narrow(const avxs& lo, const avxs& hi) {
+        const __m256i l = _mm256_castps_si256(lo.data());
+        const __m256i h = _mm256_castps_si256(hi.data());
+        return impl::avx_fix_pack(_mm256_packs_epi32(l, h));
+    }
+#endif
+#endif
+
+    // interleaved loads and stores, transposition; the 128-bit halves are rearranged so that each
+    // of them holds the interleaved data of four records, which is then shuffled as with SSE
+    namespace impl {
+
+        // transposes the 4x4 matrices in the lower halves and in the upper halves of a, b, c, d
+        SIMDEE_INL void avx_transpose_halves(__m256& a, __m256& b, __m256& c, __m256& d) {
+            __m256 ab_lo = _mm256_unpacklo_ps(a, b), cd_lo = _mm256_unpacklo_ps(c, d);
+            __m256 ab_hi = _mm256_unpackhi_ps(a, b), cd_hi = _mm256_unpackhi_ps(c, d);
+            a = _mm256_shuffle_ps(ab_lo, cd_lo, _MM_SHUFFLE(1, 0, 1, 0));
+            b = _mm256_shuffle_ps(ab_lo, cd_lo, _MM_SHUFFLE(3, 2, 3, 2));
+            c = _mm256_shuffle_ps(ab_hi, cd_hi, _MM_SHUFFLE(1, 0, 1, 0));
+            d = _mm256_shuffle_ps(ab_hi, cd_hi, _MM_SHUFFLE(3, 2, 3, 2));
+        }
+
+        template <typename T>
+        struct avx_interleave {
+            using scalar_t = typename simd_vector_traits<T>::scalar_t;
+
+            SIMDEE_INL static void load(const scalar_t* ptr, T& v0, T& v1) {
+                auto p = reinterpret_cast<const float*>(ptr);
+                __m256 a = _mm256_loadu_ps(p), b = _mm256_loadu_ps(p + 8);
+                __m256 lo = _mm256_permute2f128_ps(a, b, 0x20);
+                __m256 hi = _mm256_permute2f128_ps(a, b, 0x31);
+                v0 = _mm256_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0));
+                v1 = _mm256_shuffle_ps(lo, hi, _MM_SHUFFLE(3, 1, 3, 1));
+            }
+            SIMDEE_INL static void load(const scalar_t* ptr, T& v0, T& v1, T& v2) {
+                auto p = reinterpret_cast<const float*>(ptr);
+                __m256 ab = _mm256_loadu_ps(p), cd = _mm256_loadu_ps(p + 8);
+                __m256 ef = _mm256_loadu_ps(p + 16);
+                __m256 a = _mm256_permute2f128_ps(ab, cd, 0x30);
+                __m256 b = _mm256_permute2f128_ps(ab, ef, 0x21);
+                __m256 c = _mm256_permute2f128_ps(cd, ef, 0x30);
+                __m256 b2c1 = _mm256_shuffle_ps(b, c, _MM_SHUFFLE(0, 1, 0, 2));
+                __m256 a1b0 = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1));
+                __m256 b3c2 = _mm256_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3));
+                __m256 a2b1 = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2));
+                __m256 c0c3 = _mm256_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0));
+                v0 = _mm256_shuffle_ps(a, b2c1, _MM_SHUFFLE(2, 0, 3, 0));
+                v1 = _mm256_shuffle_ps(a1b0, b3c2, _MM_SHUFFLE(2, 0, 2, 0));
+                v2 = _mm256_shuffle_ps(a2b1, c0c3, _MM_SHUFFLE(2, 0, 2, 0));
+            }
+            SIMDEE_INL static void load(const scalar_t* ptr, T& v0, T& v1, T& v2, T& v3) {
+                auto p = reinterpret_cast<const float*>(ptr);
+                __m256 ab = _mm256_loadu_ps(p), cd = _mm256_loadu_ps(p + 8);
+                __m256 ef = _mm256_loadu_ps(p + 16), gh = _mm256_loadu_ps(p + 24);
+                __m256 a = _mm256_permute2f128_ps(ab, ef, 0x20);
+                __m256 b = _mm256_permute2f128_ps(ab, ef, 0x31);
+                __m256 c = _mm256_permute2f128_ps(cd, gh, 0x20);
+                __m256 d = _mm256_permute2f128_ps(cd, gh, 0x31);
+                avx_transpose_halves(a, b, c, d);
+                v0 = a;
+                v1 = b;
+                v2 = c;
+                v3 = d;
+            }
+            SIMDEE_INL static void store(scalar_t* ptr, const T& v0, const T& v1) {
+                auto p = reinterpret_cast<float*>(ptr);
+                __m256 lo = _mm256_unpacklo_ps(v0.data(), v1.data());
+                __m256 hi = _mm256_unpackhi_ps(v0.data(), v1.data());
+                _mm256_storeu_ps(p, _mm256_permute2f128_ps(lo, hi, 0x20));
+                _mm256_storeu_ps(p + 8, _mm256_permute2f128_ps(lo, hi, 0x31));
+            }
+            SIMDEE_INL static void store(scalar_t* ptr, const T& v0, const T& v1, const T& v2) {
+                auto p = reinterpret_cast<float*>(ptr);
+                __m256 x = v0.data(), y = v1.data(), z = v2.data();
+                __m256 x0y0x1y1 = _mm256_unpacklo_ps(x, y);
+                __m256 z0x1 = _mm256_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0));
+                __m256 y1z1 = _mm256_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1));
+                __m256 x2y2 = _mm256_shuffle_ps(x, y, _MM_SHUFFLE(2, 2, 2, 2));
+                __m256 z2x3 = _mm256_shuffle_ps(z, x, _MM_SHUFFLE(3, 3, 2, 2));
+                __m256 y2z2y3z3 = _mm256_unpackhi_ps(y, z);
+                __m256 a = _mm256_shuffle_ps(x0y0x1y1, z0x1, _MM_SHUFFLE(2, 0, 1, 0));
+                __m256 b = _mm256_shuffle_ps(y1z1, x2y2, _MM_SHUFFLE(2, 0, 2, 0));
+                __m256 c = _mm256_shuffle_ps(z2x3, y2z2y3z3, _MM_SHUFFLE(3, 2, 2, 0));
+                _mm256_storeu_ps(p, _mm256_permute2f128_ps(a, b, 0x20));
+                _mm256_storeu_ps(p + 8, _mm256_permute2f128_ps(c, a, 0x30));
+                _mm256_storeu_ps(p + 16, _mm256_permute2f128_ps(b, c, 0x31));
+            }
+            SIMDEE_INL static void store(scalar_t* ptr, const T& v0, const T& v1, const T& v2,
+                                         const T& v3) {
+                auto p = reinterpret_cast<float*>(ptr);
+                __m256 a = v0.data(), b = v1.data(), c = v2.data(), d = v3.data();
+                avx_transpose_halves(a, b, c, d);
+                _mm256_storeu_ps(p, _mm256_permute2f128_ps(a, b, 0x20));
+                _mm256_storeu_ps(p + 8, _mm256_permute2f128_ps(c, d, 0x20));
+                _mm256_storeu_ps(p + 16, _mm256_permute2f128_ps(a, b, 0x31));
+                _mm256_storeu_ps(p + 24, _mm256_permute2f128_ps(c, d, 0x31));
+            }
+        };
+
+        template <>
+        struct interleave<avxb> : avx_interleave<avxb> {};
+
+        template <>
+        struct interleave<avxf> : avx_interleave<avxf> {};
+
+        template <>
+        struct interleave<avxu> : avx_interleave<avxu> {};
+
+        template <>
+        struct interleave<avxs> : avx_interleave<avxs> {};
+
+        // the 8x8 matrix is transposed as four 4x4 blocks, which then swap the halves
+        template <typename T>
+        struct avx_transposition {
+            SIMDEE_INL static void apply(T* rows) {
+                __m256 a[4] = {rows[0].data(), rows[1].data(), rows[2].data(), rows[3].data()};
+                __m256 b[4] = {rows[4].data(), rows[5].data(), rows[6].data(), rows[7].data()};
+                avx_transpose_halves(a[0], a[1], a[2], a[3]);
+                avx_transpose_halves(b[0], b[1], b[2], b[3]);
+                for (int i = 0; i < 4; ++i) {
+                    rows[i] = _mm256_permute2f128_ps(a[i], b[i], 0x20);
+                    rows[i + 4] = _mm256_permute2f128_ps(a[i], b[i], 0x31);
+                }
+            }
+        };
+
+        template <>
+        struct transposition<avxb> : avx_transposition<avxb> {};
+
+        template <>
+        struct transposition<avxf> : avx_transposition<avxf> {};
+
+        template <>
+        struct transposition<avxu> : avx_transposition<avxu> {};
+
+        template <>
+        struct transposition<avxs> : avx_transposition<avxs> {};
+
+        template <typename T>
+        struct avx64_transposition {
+            SIMDEE_INL static void apply(T* rows) {
+                __m256d ab_lo = _mm256_unpacklo_pd(rows[0].data(), rows[1].data());
+                __m256d ab_hi = _mm256_unpackhi_pd(rows[0].data(), rows[1].data());
+                __m256d cd_lo = _mm256_unpacklo_pd(rows[2].data(), rows[3].data());
+                __m256d cd_hi = _mm256_unpackhi_pd(rows[2].data(), rows[3].data());
+                rows[0] = _mm256_permute2f128_pd(ab_lo, cd_lo, 0x20);
+                rows[1] = _mm256_permute2f128_pd(ab_hi, cd_hi, 0x20);
+                rows[2] = _mm256_permute2f128_pd(ab_lo, cd_lo, 0x31);
+                rows[3] = _mm256_permute2f128_pd(ab_hi, cd_hi, 0x31);
+            }
+        };
+
+        template <>
+        struct transposition<avxb64> : avx64_transposition<avxb64> {};
+
+        template <>
+        struct transposition<avxd> : avx64_transposition<avxd> {};
+
+        template <>
+        struct transposition<avxu64> : avx64_transposition<avxu64> {};
+
+        template <>
+        struct transposition<avxs64> : avx64_transposition<avxs64> {};
+
+    } // namespace impl
+
+    // stream compaction
+    namespace impl {
+
+        SIMDEE_INL __m256 avx_as_ps(__m256 vec) { return vec; }
+        SIMDEE_INL __m256 avx_as_ps(__m256d vec) { return _mm256_castpd_ps(vec); }
+        SIMDEE_INL void avx_from_ps(__m256 vec, __m256& res) { res = vec; }
+        SIMDEE_INL void avx_from_ps(__m256 vec, __m256d& res) { res = _mm256_castps_pd(vec); }
+
+#if SIMDEE_AVX512
+        // stores the 32-bit lanes selected by the bits of sel to ptr[0], ptr[1], ...
+        SIMDEE_INL void avx_compress_store(float* ptr, __m256 vec, uint32_t sel) {
+            _mm256_storeu_ps(ptr, _mm256_maskz_compress_ps(__mmask8(sel), vec));
+        }
+        // loads ptr[0], ptr[1], ... into the 32-bit lanes selected by the bits of sel
+        SIMDEE_INL __m256 avx_expand_load(const float* ptr, uint32_t sel) {
+            return _mm256_maskz_expandloadu_ps(__mmask8(sel), ptr);
+        }
+#elif SIMDEE_AVX2
+        // permutevar8x32 indices packed into nibbles; row sel moves the lanes selected by the bits
+        // of sel to the front
+        SIMDEE_INL const uint32_t* avx_compress_table() {
+            static const uint32_t table[256] = {
+                0x00000000, 0x00000000, 0x00000001, 0x00000010, 0x00000002, 0x00000020, 0x00000021,
+                0x00000210, 0x00000003, 0x00000030, 0x00000031, 0x00000310, 0x00000032, 0x00000320,
+                0x00000321, 0x00003210, 0x00000004, 0x00000040, 0x00000041, 0x00000410, 0x00000042,
+                0x00000420, 0x00000421, 0x00004210, 0x00000043, 0x00000430, 0x00000431, 0x00004310,
+                0x00000432, 0x00004320, 0x00004321, 0x00043210, 0x00000005, 0x00000050, 0x00000051,
+                0x00000510, 0x00000052, 0x00000520, 0x00000521, 0x00005210, 0x00000053, 0x00000530,
+                0x00000531, 0x00005310, 0x00000532, 0x00005320, 0x00005321, 0x00053210, 0x00000054,
+                0x00000540, 0x00000541, 0x00005410, 0x00000542, 0x00005420, 0x00005421, 0x00054210,
+                0x00000543, 0x00005430, 0x00005431, 0x00054310, 0x00005432, 0x00054320, 0x00054321,
+                0x00543210, 0x00000006, 0x00000060, 0x00000061, 0x00000610, 0x00000062, 0x00000620,
+                0x00000621, 0x00006210, 0x00000063, 0x00000630, 0x00000631, 0x00006310, 0x00000632,
+                0x00006320, 0x00006321, 0x00063210, 0x00000064, 0x00000640, 0x00000641, 0x00006410,
+                0x00000642, 0x00006420, 0x00006421, 0x00064210, 0x00000643, 0x00006430, 0x00006431,
+                0x00064310, 0x00006432, 0x00064320, 0x00064321, 0x00643210, 0x00000065, 0x00000650,
+                0x00000651, 0x00006510, 0x00000652, 0x00006520, 0x00006521, 0x00065210, 0x00000653,
+                0x00006530, 0x00006531, 0x00065310, 0x00006532, 0x00065320, 0x00065321, 0x00653210,
+                0x00000654, 0x00006540, 0x00006541, 0x00065410, 0x00006542, 0x00065420, 0x00065421,
+                0x00654210, 0x00006543, 0x00065430, 0x00065431, 0x00654310, 0x00065432, 0x00654320,
+                0x00654321, 0x06543210, 0x00000007, 0x00000070, 0x00000071, 0x00000710, 0x00000072,
+                0x00000720, 0x00000721, 0x00007210, 0x00000073, 0x00000730, 0x00000731, 0x00007310,
+                0x00000732, 0x00007320, 0x00007321, 0x00073210, 0x00000074, 0x00000740, 0x00000741,
+                0x00007410, 0x00000742, 0x00007420, 0x00007421, 0x00074210, 0x00000743, 0x00007430,
+                0x00007431, 0x00074310, 0x00007432, 0x00074320, 0x00074321, 0x00743210, 0x00000075,
+                0x00000750, 0x00000751, 0x00007510, 0x00000752, 0x00007520, 0x00007521, 0x00075210,
+                0x00000753, 0x00007530, 0x00007531, 0x00075310, 0x00007532, 0x00075320, 0x00075321,
+                0x00753210, 0x00000754, 0x00007540, 0x00007541, 0x00075410, 0x00007542, 0x00075420,
+                0x00075421, 0x00754210, 0x00007543, 0x00075430, 0x00075431, 0x00754310, 0x00075432,
+                0x00754320, 0x00754321, 0x07543210, 0x00000076, 0x00000760, 0x00000761, 0x00007610,
+                0x00000762, 0x00007620, 0x00007621, 0x00076210, 0x00000763, 0x00007630, 0x00007631,
+                0x00076310, 0x00007632, 0x00076320, 0x00076321, 0x00763210, 0x00000764, 0x00007640,
+                0x00007641, 0x00076410, 0x00007642, 0x00076420, 0x00076421, 0x00764210, 0x00007643,
+                0x00076430, 0x00076431, 0x00764310, 0x00076432, 0x00764320, 0x00764321, 0x07643210,
+                0x00000765, 0x00007650, 0x00007651, 0x00076510, 0x00007652, 0x00076520, 0x00076521,
+                0x00765210, 0x00007653, 0x00076530, 0x00076531, 0x00765310, 0x00076532, 0x00765320,
+                0x00765321, 0x07653210, 0x00007654, 0x00076540, 0x00076541, 0x00765410, 0x00076542,
+                0x00765420, 0x00765421, 0x07654210, 0x00076543, 0x00765430, 0x00765431, 0x07654310,
+                0x00765432, 0x07654320, 0x07654321, 0x76543210,
+            };
+            return table;
+        }
+
+        // the inverse of avx_compress_table(); lanes that are not selected have the index 8
+        SIMDEE_INL const uint32_t* avx_expand_table() {
+            static const uint32_t table[256] = {
+                0x88888888, 0x88888880, 0x88888808, 0x88888810, 0x88888088, 0x88888180, 0x88888108,
+                0x88888210, 0x88880888, 0x88881880, 0x88881808, 0x88882810, 0x88881088, 0x88882180,
+                0x88882108, 0x88883210, 0x88808888, 0x88818880, 0x88818808, 0x88828810, 0x88818088,
+                0x88828180, 0x88828108, 0x88838210, 0x88810888, 0x88821880, 0x88821808, 0x88832810,
+                0x88821088, 0x88832180, 0x88832108, 0x88843210, 0x88088888, 0x88188880, 0x88188808,
+                0x88288810, 0x88188088, 0x88288180, 0x88288108, 0x88388210, 0x88180888, 0x88281880,
+                0x88281808, 0x88382810, 0x88281088, 0x88382180, 0x88382108, 0x88483210, 0x88108888,
+                0x88218880, 0x88218808, 0x88328810, 0x88218088, 0x88328180, 0x88328108, 0x88438210,
+                0x88210888, 0x88321880, 0x88321808, 0x88432810, 0x88321088, 0x88432180, 0x88432108,
+                0x88543210, 0x80888888, 0x81888880, 0x81888808, 0x82888810, 0x81888088, 0x82888180,
+                0x82888108, 0x83888210, 0x81880888, 0x82881880, 0x82881808, 0x83882810, 0x82881088,
+                0x83882180, 0x83882108, 0x84883210, 0x81808888, 0x82818880, 0x82818808, 0x83828810,
+                0x82818088, 0x83828180, 0x83828108, 0x84838210, 0x82810888, 0x83821880, 0x83821808,
+                0x84832810, 0x83821088, 0x84832180, 0x84832108, 0x85843210, 0x81088888, 0x82188880,
+                0x82188808, 0x83288810, 0x82188088, 0x83288180, 0x83288108, 0x84388210, 0x82180888,
+                0x83281880, 0x83281808, 0x84382810, 0x83281088, 0x84382180, 0x84382108, 0x85483210,
+                0x82108888, 0x83218880, 0x83218808, 0x84328810, 0x83218088, 0x84328180, 0x84328108,
+                0x85438210, 0x83210888, 0x84321880, 0x84321808, 0x85432810, 0x84321088, 0x85432180,
+                0x85432108, 0x86543210, 0x08888888, 0x18888880, 0x18888808, 0x28888810, 0x18888088,
+                0x28888180, 0x28888108, 0x38888210, 0x18880888, 0x28881880, 0x28881808, 0x38882810,
+                0x28881088, 0x38882180, 0x38882108, 0x48883210, 0x18808888, 0x28818880, 0x28818808,
+                0x38828810, 0x28818088, 0x38828180, 0x38828108, 0x48838210, 0x28810888, 0x38821880,
+                0x38821808, 0x48832810, 0x38821088, 0x48832180, 0x48832108, 0x58843210, 0x18088888,
+                0x28188880, 0x28188808, 0x38288810, 0x28188088, 0x38288180, 0x38288108, 0x48388210,
+                0x28180888, 0x38281880, 0x38281808, 0x48382810, 0x38281088, 0x48382180, 0x48382108,
+                0x58483210, 0x28108888, 0x38218880, 0x38218808, 0x48328810, 0x38218088, 0x48328180,
+                0x48328108, 0x58438210, 0x38210888, 0x48321880, 0x48321808, 0x58432810, 0x48321088,
+                0x58432180, 0x58432108, 0x68543210, 0x10888888, 0x21888880, 0x21888808, 0x32888810,
+                0x21888088, 0x32888180, 0x32888108, 0x43888210, 0x21880888, 0x32881880, 0x32881808,
+                0x43882810, 0x32881088, 0x43882180, 0x43882108, 0x54883210, 0x21808888, 0x32818880,
+                0x32818808, 0x43828810, 0x32818088, 0x43828180, 0x43828108, 0x54838210, 0x32810888,
+                0x43821880, 0x43821808, 0x54832810, 0x43821088, 0x54832180, 0x54832108, 0x65843210,
+                0x21088888, 0x32188880, 0x32188808, 0x43288810, 0x32188088, 0x43288180, 0x43288108,
+                0x54388210, 0x32180888, 0x43281880, 0x43281808, 0x54382810, 0x43281088, 0x54382180,
+                0x54382108, 0x65483210, 0x32108888, 0x43218880, 0x43218808, 0x54328810, 0x43218088,
+                0x54328180, 0x54328108, 0x65438210, 0x43210888, 0x54321880, 0x54321808, 0x65432810,
+                0x54321088, 0x65432180, 0x65432108, 0x76543210,
+            };
+            return table;
+        }
+
+        // unpacks the nibbles of row, so that the k-th lane holds row >> (4 * k)
+        SIMDEE_INL __m256i avx_unpack_nibbles(uint32_t row) {
+            return _mm256_srlv_epi32(_mm256_set1_epi32(int32_t(row)),
+                                     _mm256_setr_epi32(0, 4, 8, 12, 16, 20, 24, 28));
+        }
+        SIMDEE_INL void avx_compress_store(float* ptr, __m256 vec, uint32_t sel) {
+            __m256i idx = avx_unpack_nibbles(avx_compress_table()[sel]);
+            _mm256_storeu_ps(ptr, _mm256_permutevar8x32_ps(vec, idx));
+        }
+        SIMDEE_INL __m256 avx_expand_load(const float* ptr, uint32_t sel) {
+            __m256i idx = avx_unpack_nibbles(avx_expand_table()[sel]);
+            __m256 res = _mm256_permutevar8x32_ps(_mm256_loadu_ps(ptr), idx);
+            __m256 unused = _mm256_castsi256_ps(_mm256_slli_epi32(idx, 28)); // bit 3 to the sign
+            return _mm256_blendv_ps(res, _mm256_setzero_ps(), unused);
+        }
+#else
+        // without AVX2, the 128-bit halves are shuffled separately, as with SSE
+        SIMDEE_INL __m128 avx_shuffle_bytes(__m128 vec, const uint32_t* row) {
+            __m128i ctrl = _mm_load_si128(reinterpret_cast<const __m128i*>(row));
+            return _mm_castsi128_ps(_mm_shuffle_epi8(_mm_castps_si128(vec), ctrl));
+        }
+        SIMDEE_INL void avx_compress_store(float* ptr, __m256 vec, uint32_t sel) {
+            uint32_t lo = sel & 0xfU, hi = sel >> 4;
+            __m128 lo_vec = _mm256_castps256_ps128(vec), hi_vec = _mm256_extractf128_ps(vec, 1);
+            _mm_storeu_ps(ptr, avx_shuffle_bytes(lo_vec, compress4_table() + 4 * lo));
+            _mm_storeu_ps(ptr + popcount4(lo),
+                          avx_shuffle_bytes(hi_vec, compress4_table() + 4 * hi));
+        }
+        SIMDEE_INL __m256 avx_expand_load(const float* ptr, uint32_t sel) {
+            uint32_t lo = sel & 0xfU, hi = sel >> 4;
+            __m128 lo_vec = _mm_loadu_ps(ptr), hi_vec = _mm_loadu_ps(ptr + popcount4(lo));
+            lo_vec = avx_shuffle_bytes(lo_vec, expand4_table() + 4 * lo);
+            hi_vec = avx_shuffle_bytes(hi_vec, expand4_table() + 4 * hi);
+            return _mm256_insertf128_ps(_mm256_castps128_ps256(lo_vec), hi_vec, 1);
+        }
+#endif
+
+        // handles 64-bit scalars as pairs of 32-bit lanes
+        template <typename T>
+        struct avx_compression {
+            using scalar_t = typename simd_vector_traits<T>::scalar_t;
+            using vec_b = typename simd_vector_traits<T>::vec_b;
+            enum : uint32_t { lanes = 8 / T::width };
+
+            SIMDEE_INL static std::size_t compress_store(scalar_t* ptr, const T& v,
+                                                         const vec_b& pred) {
+                uint32_t sel = uint32_t(_mm256_movemask_ps(avx_as_ps(pred.data())));
+                avx_compress_store(reinterpret_cast<float*>(ptr), avx_as_ps(v.data()), sel);
+                return detail::popcount(sel) / lanes;
+            }
+            SIMDEE_INL static T expand_load(const scalar_t* ptr, const vec_b& pred) {
+                uint32_t sel = uint32_t(_mm256_movemask_ps(avx_as_ps(pred.data())));
+                T res;
+                avx_from_ps(avx_expand_load(reinterpret_cast<const float*>(ptr), sel), res.data());
+                return res;
+            }
+        };
+
+        template <>
+        struct compression<avxb> : avx_compression<avxb> {};
+
+        template <>
+        struct compression<avxf> : avx_compression<avxf> {};
+
+        template <>
+        struct compression<avxu> : avx_compression<avxu> {};
+
+        template <>
+        struct compression<avxs> : avx_compression<avxs> {};
+
+        template <>
+        struct compression<avxb64> : avx_compression<avxb64> {};
+
+        template <>
+        struct compression<avxd> : avx_compression<avxd> {};
+
+        template <>
+        struct compression<avxu64> : avx_compression<avxu64> {};
+
+        template <>
+        struct compression<avxs64> : avx_compression<avxs64> {};
+
+    } // namespace impl
+
+    // shuffles and permutes; most instructions shuffle the 128-bit halves separately, crossing
+    // them takes vperm2f128, vpermps or vpermpd
+    namespace impl {
+
+        // the lanes of L as a vector of 32-bit indices
+        template <typename L>
+        SIMDEE_INL __m256i avx_index() {
+            return _mm256_setr_epi32(L::lane(0), L::lane(1), L::lane(2), L::lane(3), L::lane(4),
+                                     L::lane(5), L::lane(6), L::lane(7));
+        }
+
+        template <typename T>
+        struct avx_shuffling {
+            using vec_s = typename simd_vector_traits<T>::vec_s;
+
+            template <int... Idx>
+            SIMDEE_INL static T apply(const T& v) {
+                using L = lane_list<Idx...>;
+                constexpr int imm = L::imm(2, 4, 0, 4);
+                constexpr int halves = L::lane(0) / 4 | L::lane(4) / 4 << 4;
+                __m256 x = v.data();
+                if (L::blend(8)) return v;
+                if (L::within(4, 8) && L::repeats(4, 8)) return _mm256_permute_ps(x, imm);
+                if (L::blocks(4)) return _mm256_permute2f128_ps(x, x, halves);
+#if SIMDEE_AVX2
+                return _mm256_permutevar8x32_ps(x, avx_index<L>());
+#else
+                // the lanes that cross the halves are shuffled out of a copy with swapped halves
+                constexpr int crossing = L::crossing(4, 8);
+                __m256 swapped = _mm256_permute2f128_ps(x, x, 0x01);
+                __m256i ctrl = avx_index<L>();
+                return _mm256_blend_ps(_mm256_permutevar_ps(x, ctrl),
+                                       _mm256_permutevar_ps(swapped, ctrl), crossing);
+#endif
+            }
+            template <int... Idx>
+            SIMDEE_INL static T apply(const T& a, const T& b) {
+                using L = lane_list<Idx...>;
+                constexpr int imm = L::imm(2, 4, 0, 4);
+                constexpr int halves = L::lane(0) / 4 | L::lane(4) / 4 << 4;
+                constexpr int upper = L::upper(8);
+                __m256 x = a.data(), y = b.data();
+                if (L::from(0, 8, 0, 8)) return apply<Idx...>(a);
+                if (L::from(1, 8, 0, 8)) return apply<(Idx & 7)...>(b);
+                if (L::blend(8)) return _mm256_blend_ps(x, y, upper);
+                if (L::blocks(4)) return _mm256_permute2f128_ps(x, y, halves);
+                if (std::is_same<L, lane_list<0, 8, 1, 9, 4, 12, 5, 13>>::value) {
+                    return _mm256_unpacklo_ps(x, y);
+                }
+                if (std::is_same<L, lane_list<8, 0, 9, 1, 12, 4, 13, 5>>::value) {
+                    return _mm256_unpacklo_ps(y, x);
+                }
+                if (std::is_same<L, lane_list<2, 10, 3, 11, 6, 14, 7, 15>>::value) {
+                    return _mm256_unpackhi_ps(x, y);
+                }
+                if (std::is_same<L, lane_list<10, 2, 11, 3, 14, 6, 15, 7>>::value) {
+                    return _mm256_unpackhi_ps(y, x);
+                }
+                // in each half, two scalars of one vector followed by two scalars of the other one
+                if (L::within(4, 8) && L::repeats(4, 8)) {
+                    if (L::from(0, 8, 0, 2) && L::from(1, 8, 2, 4)) {
+                        return _mm256_shuffle_ps(x, y, imm);
+                    }
+                    if (L::from(1, 8, 0, 2) && L::from(0, 8, 2, 4)) {
+                        return _mm256_shuffle_ps(y, x, imm);
+                    }
+                }
+#if SIMDEE_AVX512
+                return _mm256_permutex2var_ps(x, avx_index<L>(), y);
+#else
+                return _mm256_blend_ps(apply<(Idx & 7)...>(a).data(),
+                                       apply<(Idx & 7)...>(b).data(), upper);
+#endif
+            }
+            SIMDEE_INL static T permute(const T& v, const vec_s& idx) {
+                __m256i at = _mm256_castps_si256(idx.data());
+#if SIMDEE_AVX2
+                return _mm256_permutevar8x32_ps(v.data(), at);
+#else
+                // as above, with bit 2 of the indices moved to the sign to select the crossing
+                // lanes; there are no 256-bit integer shifts, so the halves are shifted apart
+                __m256 swapped = _mm256_permute2f128_ps(v.data(), v.data(), 0x01);
+                __m128i lo = _mm_slli_epi32(_mm256_castsi256_si128(at), 29);
+                __m128i hi = _mm_slli_epi32(_mm256_extractf128_si256(at, 1), 29);
+                hi = _mm_xor_si128(hi, _mm_set1_epi32(int32_t(0x80000000U)));
+                __m256 crossing = _mm256_castsi256_ps(
+                    _mm256_insertf128_si256(_mm256_castsi128_si256(lo), hi, 1));
+                return _mm256_blendv_ps(_mm256_permutevar_ps(v.data(), at),
+                                        _mm256_permutevar_ps(swapped, at), crossing);
+#endif
+            }
+        };
+
+        template <>
+        struct shuffling<avxb> : avx_shuffling<avxb> {};
+
+        template <>
+        struct shuffling<avxf> : avx_shuffling<avxf> {};
+
+        template <>
+        struct shuffling<avxu> : avx_shuffling<avxu> {};
+
+        template <>
+        struct shuffling<avxs> : avx_shuffling<avxs> {};
+
+        template <typename T>
+        struct avx64_shuffling {
+            using vec_s = typename simd_vector_traits<T>::vec_s;
+
+            template <int... Idx>
+            SIMDEE_INL static T apply(const T& v) {
+                using L = lane_list<Idx...>;
+                constexpr int imm = L::imm(1, 2, 0, 4);
+                constexpr int halves = L::lane(0) / 2 | L::lane(2) / 2 << 4;
+                __m256d x = v.data();
+                if (L::blend(4)) return v;
+                if (L::within(2, 4)) return _mm256_permute_pd(x, imm);
+                if (L::blocks(2)) return _mm256_permute2f128_pd(x, x, halves);
+#if SIMDEE_AVX2
+                constexpr int lanes = L::imm(2, 4, 0, 4);
+                return _mm256_permute4x64_pd(x, lanes);
+#else
+                constexpr int crossing = L::crossing(2, 4);
+                __m256d swapped = _mm256_permute2f128_pd(x, x, 0x01);
+                return _mm256_blend_pd(_mm256_permute_pd(x, imm), _mm256_permute_pd(swapped, imm),
+                                       crossing);
+#endif
+            }
+            template <int... Idx>
+            SIMDEE_INL static T apply(const T& a, const T& b) {
+                using L = lane_list<Idx...>;
+                constexpr int imm = L::imm(1, 2, 0, 4);
+                constexpr int halves = L::lane(0) / 2 | L::lane(2) / 2 << 4;
+                constexpr int upper = L::upper(4);
+                __m256d x = a.data(), y = b.data();
+                if (L::from(0, 4, 0, 4)) return apply<Idx...>(a);
+                if (L::from(1, 4, 0, 4)) return apply<(Idx & 3)...>(b);
+                if (L::blend(4)) return _mm256_blend_pd(x, y, upper);
+                if (L::blocks(2)) return _mm256_permute2f128_pd(x, y, halves);
+                // in each half, a scalar of one vector followed by a scalar of the other one
+                if (L::within(2, 4)) {
+                    if (L::from(0, 4, 0, 4, 2) && L::from(1, 4, 1, 4, 2)) {
+                        return _mm256_shuffle_pd(x, y, imm);
+                    }
+                    if (L::from(1, 4, 0, 4, 2) && L::from(0, 4, 1, 4, 2)) {
+                        return _mm256_shuffle_pd(y, x, imm);
+                    }
+                }
+#if SIMDEE_AVX512
+                __m256i at = _mm256_setr_epi64x(L::lane(0), L::lane(1), L::lane(2), L::lane(3));
+                return _mm256_permutex2var_pd(x, at, y);
+#else
+                return _mm256_blend_pd(apply<(Idx & 3)...>(a).data(),
+                                       apply<(Idx & 3)...>(b).data(), upper);
+#endif
+            }
+            SIMDEE_INL static T permute(const T& v, const vec_s& idx) {
+#if SIMDEE_AVX512
+                return _mm256_permutexvar_pd(_mm256_castpd_si256(idx.data()), v.data());
+#elif SIMDEE_AVX2
+                // the 64-bit index k becomes the pair of 32-bit indices 2 * k, 2 * k + 1
+                __m256i at = _mm256_castpd_si256(idx.data());
+                at = _mm256_or_si256(_mm256_slli_epi64(at, 1), _mm256_slli_epi64(at, 33));
+                at = _mm256_add_epi32(at, _mm256_setr_epi32(0, 1, 0, 1, 0, 1, 0, 1));
+                return _mm256_castps_pd(
+                    _mm256_permutevar8x32_ps(_mm256_castpd_ps(v.data()), at));
+#else
+                return shuffle_emulation<T>::permute(v, idx);
+#endif
+            }
+        };
+
+        template <>
+        struct shuffling<avxb64> : avx64_shuffling<avxb64> {};
+
+        template <>
+        struct shuffling<avxd> : avx64_shuffling<avxd> {};
+
+        template <>
+        struct shuffling<avxu64> : avx64_shuffling<avxu64> {};
+
+        template <>
+        struct shuffling<avxs64> : avx64_shuffling<avxs64> {};
+
+    } // namespace impl
+
+    // horizontal operations; the upper 128-bit half is folded onto the lower one, which continues as
+    // an SSE vector
+    namespace impl {
+
+        SIMDEE_INL __m128 avx_lower(const __m256& v) { return _mm256_castps256_ps128(v); }
+        SIMDEE_INL __m128 avx_upper(const __m256& v) { return _mm256_extractf128_ps(v, 1); }
+        SIMDEE_INL __m128d avx_lower(const __m256d& v) { return _mm256_castpd256_pd128(v); }
+        SIMDEE_INL __m128d avx_upper(const __m256d& v) { return _mm256_extractf128_pd(v, 1); }
+
+        template <typename T, typename Half>
+        struct avx_horizontal {
+            using scalar_t = typename simd_vector_traits<T>::scalar_t;
+
+            template <typename Op_t>
+            SIMDEE_INL static scalar_t apply(const T& v, Op_t f) {
+                Half x = f(Half(avx_lower(v.data())), Half(avx_upper(v.data())));
+                return horizontal<Half>::apply(x, f);
+            }
+        };
+
+        template <>
+        struct horizontal<avxf> : avx_horizontal<avxf, ssef> {};
+
+        template <>
+        struct horizontal<avxu> : avx_horizontal<avxu, sseu> {};
+
+        template <>
+        struct horizontal<avxs> : avx_horizontal<avxs, sses> {};
+
+        template <>
+        struct horizontal<avxd> : avx_horizontal<avxd, ssed> {};
+
+        template <>
+        struct horizontal<avxu64> : avx_horizontal<avxu64, sseu64> {};
+
+        template <>
+        struct horizontal<avxs64> : avx_horizontal<avxs64, sses64> {};
+
+    } // namespace impl
+
+    // prefix sums; the 128-bit halves are scanned separately, then the last scalar of the lower
+    // half is added to the upper one
+    namespace impl {
+
+        // the scalars of each 128-bit half of v moved up by Lanes, zeros shifted in
+        template <int Lanes>
+        SIMDEE_INL __m256 avx_shift_up_halves(const __m256& v) {
+#if SIMDEE_AVX2
+            return _mm256_castsi256_ps(_mm256_slli_si256(_mm256_castps_si256(v), 4 * Lanes));
+#else
+            constexpr int lanes = Lanes == 1 ? _MM_SHUFFLE(2, 1, 0, 0) : _MM_SHUFFLE(1, 0, 0, 0);
+            constexpr int zeros = Lanes == 1 ? 0x11 : 0x33;
+            return _mm256_blend_ps(_mm256_permute_ps(v, lanes), _mm256_setzero_ps(), zeros);
+#endif
+        }
+        SIMDEE_INL __m256d avx_shift_up_halves(const __m256d& v) {
+            return _mm256_shuffle_pd(_mm256_setzero_pd(), v, 0);
+        }
+
+        // the last scalar of the lower half broadcast into the upper half, zeros in the lower half
+        SIMDEE_INL __m256 avx_carry(const __m256& v) {
+            __m256 lower = _mm256_permute2f128_ps(v, v, 0x08);
+            return _mm256_permute_ps(lower, _MM_SHUFFLE(3, 3, 3, 3));
+        }
+        SIMDEE_INL __m256d avx_carry(const __m256d& v) {
+            __m256d lower = _mm256_permute2f128_pd(v, v, 0x08);
+            return _mm256_permute_pd(lower, 0xc);
+        }
+
+        // v shifted up by one scalar, zero shifted in
+        SIMDEE_INL __m256 avx_shift_up(const __m256& v) {
+            __m256 rotated = _mm256_permute_ps(v, _MM_SHUFFLE(2, 1, 0, 3));
+            return _mm256_blend_ps(rotated, _mm256_permute2f128_ps(rotated, rotated, 0x08), 0x11);
+        }
+        SIMDEE_INL __m256d avx_shift_up(const __m256d& v) {
+            __m256d rotated = _mm256_permute_pd(v, 0x5);
+            return _mm256_blend_pd(rotated, _mm256_permute2f128_pd(rotated, rotated, 0x08), 0x5);
+        }
+
+        template <typename T>
+        struct avx_scanning {
+            SIMDEE_INL static T inclusive(const T& v) {
+                T x = v + T(avx_shift_up_halves<1>(v.data()));
+                x = x + T(avx_shift_up_halves<2>(x.data()));
+                return x + T(avx_carry(x.data()));
+            }
+            SIMDEE_INL static T exclusive(const T& v) { return inclusive(T(avx_shift_up(v.data()))); }
+        };
+
+        template <typename T>
+        struct avx64_scanning {
+            SIMDEE_INL static T inclusive(const T& v) {
+                T x = v + T(avx_shift_up_halves(v.data()));
+                return x + T(avx_carry(x.data()));
+            }
+            SIMDEE_INL static T exclusive(const T& v) { return inclusive(T(avx_shift_up(v.data()))); }
+        };
+
+        template <>
+        struct scanning<avxf> : avx_scanning<avxf> {};
+
+        template <>
+        struct scanning<avxu> : avx_scanning<avxu> {};
+
+        template <>
+        struct scanning<avxs> : avx_scanning<avxs> {};
+
+        template <>
+        struct scanning<avxd> : avx64_scanning<avxd> {};
+
+        template <>
+        struct scanning<avxu64> : avx64_scanning<avxu64> {};
+
+        template <>
+        struct scanning<avxs64> : avx64_scanning<avxs64> {};
+
+    } // namespace impl
+
+#if SIMDEE_FMA
+    // fused multiply-add
+    namespace impl {
+
+        template <>
+        struct fused<avxf> {
+            using native = std::true_type;
+
+            SIMDEE_INL static avxf fma(const avxf& a, const avxf& b, const avxf& c) {
+                return _mm256_fmadd_ps(a.data(), b.data(), c.data());
+            }
+            SIMDEE_INL static avxf fms(const avxf& a, const avxf& b, const avxf& c) {
+                return _mm256_fmsub_ps(a.data(), b.data(), c.data());
+            }
+            SIMDEE_INL static avxf fnma(const avxf& a, const avxf& b, const avxf& c) {
+                return _mm256_fnmadd_ps(a.data(), b.data(), c.data());
+            }
+            SIMDEE_INL static avxf fnms(const avxf& a, const avxf& b, const avxf& c) {
+                return _mm256_fnmsub_ps(a.data(), b.data(), c.data());
+            }
+        };
+
+        template <>
+        struct fused<avxd> {
+            using native = std::true_type;
+
+            SIMDEE_INL static avxd fma(const avxd& a, const avxd& b, const avxd& c) {
+                return _mm256_fmadd_pd(a.data(), b.data(), c.data());
+            }
+            SIMDEE_INL static avxd fms(const avxd& a, const avxd& b, const avxd& c) {
+                return _mm256_fmsub_pd(a.data(), b.data(), c.data());
+            }
+            SIMDEE_INL static avxd fnma(const avxd& a, const avxd& b, const avxd& c) {
+                return _mm256_fnmadd_pd(a.data(), b.data(), c.data());
+            }
+            SIMDEE_INL static avxd fnms(const avxd& a, const avxd& b, const avxd& c) {
+                return _mm256_fnmsub_pd(a.data(), b.data(), c.data());
+            }
+        };
+
+    } // namespace impl
+#endif
+
 } // namespace sd
 
 #endif // SIMDEE_SIMD_TYPES_AVX_HPP
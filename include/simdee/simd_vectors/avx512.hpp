@@ -0,0 +1,1394 @@
+// This file is a part of Simdee, see homepage at http://github.com/hrabalik/simdee
+// This file is distributed under the MIT license.
+
+#ifndef SIMDEE_SIMD_TYPES_AVX512_HPP
+#define SIMDEE_SIMD_TYPES_AVX512_HPP
+
+#include "avx.hpp"
+#include "common.hpp"
+
+#if !SIMDEE_AVX512
+#error "AVX-512 intrinsics are required to use the AVX-512 SIMD type. Please check your build options."
+#endif
+
+#include <immintrin.h>
+
+// GCC 12 reports _mm512_undefined_ps() in its own intrinsics as (maybe-)uninitialized (bug 105593)
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ == 12
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#define SIMDEE_AVX512_DIAGNOSTIC_PUSHED
+#endif
+
+// unoptimized GCC builds implement the gather and scatter intrinsics as macros, which convert the
+// mask to the signed integer expected by the builtins
+#if defined(__GNUC__) && !defined(__clang__) && !defined(__OPTIMIZE__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wsign-conversion"
+#define SIMDEE_AVX512_GATHER_DIAGNOSTIC_PUSHED
+#endif
+
+namespace sd {
+    struct avx512b;
+    struct avx512f;
+    struct avx512u;
+    struct avx512s;
+
+    template <>
+    struct is_simd_vector<avx512b> : std::integral_constant<bool, true> {};
+    template <>
+    struct is_simd_vector<avx512f> : std::integral_constant<bool, true> {};
+    template <>
+    struct is_simd_vector<avx512u> : std::integral_constant<bool, true> {};
+    template <>
+    struct is_simd_vector<avx512s> : std::integral_constant<bool, true> {};
+
+    template <typename Simd_t, typename Scalar_t>
+    struct avx512_traits {
+        using simd_t = Simd_t;
+        using vector_t = __m512;
+        using scalar_t = Scalar_t;
+        using vec_b = avx512b;
+        using vec_f = avx512f;
+        using vec_u = avx512u;
+        using vec_s = avx512s;
+        using mask_t = impl::mask<0xffffU>;
+        using storage_t = impl::storage<simd_t, scalar_t, alignof(__m512)>;
+    };
+
+    // boolean vector lives in a mask register, so its width can't be deduced from its size
+    template <>
+    struct simd_vector_traits<avx512b> : avx512_traits<avx512b, bool32_t> {
+        using vector_t = __mmask16;
+        enum : std::size_t { width = 16 };
+    };
+    template <>
+    struct simd_vector_traits<avx512f> : avx512_traits<avx512f, float> {};
+    template <>
+    struct simd_vector_traits<avx512u> : avx512_traits<avx512u, uint32_t> {};
+    template <>
+    struct simd_vector_traits<avx512s> : avx512_traits<avx512s, int32_t> {};
+
+    namespace impl {
+        SIMDEE_INL __mmask16 avx512_kmask(bool value) { return value ? 0xffff : 0x0000; }
+
+        SIMDEE_INL __mmask16 avx512_kmask(uint32_t bits) { return __mmask16(bits & 0xffffU); }
+
+        // selects the first count lanes
+        SIMDEE_INL __mmask16 avx512_first(std::size_t count) {
+            return avx512_kmask(count >= 16 ? 0xffffU : (1U << count) - 1U);
+        }
+
+        SIMDEE_INL __m512 avx512_expand(__mmask16 k) {
+            return _mm512_castsi512_ps(_mm512_maskz_set1_epi32(k, -1));
+        }
+
+        // the upper halves of the 64-bit products of the even and of the odd lanes
+        SIMDEE_INL __m512i avx512_merge_hi(__m512i even, __m512i odd) {
+            return _mm512_mask_blend_epi32(0xaaaa, _mm512_srli_epi64(even, 32), odd);
+        }
+        SIMDEE_INL __m512i avx512_mulhi_epu32(__m512i l, __m512i r) {
+            __m512i odd = _mm512_mul_epu32(_mm512_srli_epi64(l, 32), _mm512_srli_epi64(r, 32));
+            return avx512_merge_hi(_mm512_mul_epu32(l, r), odd);
+        }
+        SIMDEE_INL __m512i avx512_mulhi_epi32(__m512i l, __m512i r) {
+            __m512i odd = _mm512_mul_epi32(_mm512_srli_epi64(l, 32), _mm512_srli_epi64(r, 32));
+            return avx512_merge_hi(_mm512_mul_epi32(l, r), odd);
+        }
+
+        // the lower or the upper eight lanes, moved to the even lanes
+        SIMDEE_INL __m512i avx512_spread_lo(__m512 x) {
+            return _mm512_cvtepu32_epi64(_mm512_castsi512_si256(_mm512_castps_si512(x)));
+        }
+        SIMDEE_INL __m512i avx512_spread_hi(__m512 x) {
+            return _mm512_cvtepu32_epi64(_mm512_extracti64x4_epi64(_mm512_castps_si512(x), 1));
+        }
+    } // namespace impl
+
+    struct avx512b : simd_base<avx512b> {
+        SIMDEE_TRIVIAL_TYPE(avx512b)
+
+        SIMDEE_CTOR(avx512b, vector_t, mm = r)
+        SIMDEE_CTOR(avx512b, scalar_t, mm = impl::avx512_kmask(bool(r)))
+        SIMDEE_CTOR(avx512b, bool, mm = impl::avx512_kmask(r))
+        SIMDEE_CTOR_FLAG(avx512b, expr::zero, mm = impl::avx512_kmask(false))
+        SIMDEE_CTOR_FLAG(avx512b, expr::all_bits, mm = impl::avx512_kmask(true))
+        SIMDEE_CTOR_TPL(avx512b, expr::aligned<T>, aligned_load(r.ptr))
+        SIMDEE_CTOR_TPL(avx512b, expr::unaligned<T>, unaligned_load(r.ptr))
+        SIMDEE_CTOR_TPL2(avx512b, expr::masked, masked_load(r.ptr, r.sel))
+        SIMDEE_CTOR_TPL(avx512b, expr::init<T>,
+                        mm = impl::avx512_kmask(bool(r.template to<scalar_t>())))
+        SIMDEE_CTOR(avx512b, storage_t, aligned_load(r.data()))
+
+        SIMDEE_INL avx512b(bool32_t v0, bool32_t v1, bool32_t v2, bool32_t v3, bool32_t v4,
+                           bool32_t v5, bool32_t v6, bool32_t v7, bool32_t v8, bool32_t v9,
+                           bool32_t v10, bool32_t v11, bool32_t v12, bool32_t v13,
+                           bool32_t v14, bool32_t v15) {
+            const bool32_t v[16] = {v0, v1, v2,  v3,  v4,  v5,  v6,  v7,
+                                    v8, v9, v10, v11, v12, v13, v14, v15};
+            uint32_t bits = 0;
+            for (uint32_t i = 0; i < 16; ++i) { bits |= uint32_t(bool(v[i])) << i; }
+            mm = impl::avx512_kmask(bits);
+        }
+
+        SIMDEE_INL void aligned_load(const scalar_t* r) {
+            __m512i v = _mm512_load_si512(reinterpret_cast<const void*>(r));
+            mm = _mm512_test_epi32_mask(v, v);
+        }
+        SIMDEE_INL void aligned_store(scalar_t* r) const {
+            _mm512_store_ps(reinterpret_cast<float*>(r), impl::avx512_expand(mm));
+        }
+        SIMDEE_INL void stream_store(scalar_t* r) const {
+            _mm512_stream_ps(reinterpret_cast<float*>(r), impl::avx512_expand(mm));
+        }
+        SIMDEE_INL void unaligned_load(const scalar_t* r) {
+            __m512i v = _mm512_loadu_si512(reinterpret_cast<const void*>(r));
+            mm = _mm512_test_epi32_mask(v, v);
+        }
+        SIMDEE_INL void unaligned_store(scalar_t* r) const {
+            _mm512_storeu_ps(reinterpret_cast<float*>(r), impl::avx512_expand(mm));
+        }
+        SIMDEE_INL void masked_load(const scalar_t* r, std::size_t count) {
+            masked_load(r, avx512b(impl::avx512_first(count)));
+        }
+        SIMDEE_INL void masked_load(const scalar_t* r, const avx512b& pred) {
+            __m512i v = _mm512_maskz_loadu_epi32(pred.mm, reinterpret_cast<const void*>(r));
+            mm = _mm512_test_epi32_mask(v, v);
+        }
+        SIMDEE_INL void masked_store(scalar_t* r, std::size_t count) const {
+            masked_store(r, avx512b(impl::avx512_first(count)));
+        }
+        SIMDEE_INL void masked_store(scalar_t* r, const avx512b& pred) const {
+            _mm512_mask_storeu_ps(reinterpret_cast<float*>(r), pred.mm, impl::avx512_expand(mm));
+        }
+        SIMDEE_INL void gather(const scalar_t* r, const vec_s& idx);
+        SIMDEE_INL void gather(const scalar_t* r, const vec_s& idx, const avx512b& pred);
+        SIMDEE_INL void scatter(scalar_t* r, const vec_s& idx) const;
+        SIMDEE_INL void scatter(scalar_t* r, const vec_s& idx, const avx512b& pred) const;
+
+        template <unsigned int Lane>
+        SIMDEE_INL const avx512b broadcast() {
+            static_assert(Lane < 16, "");
+            return impl::avx512_kmask(((uint32_t(mm) >> Lane) & 1U) != 0);
+        }
+
+        // lanes are permuted by shuffling bits of the mask in a general-purpose register
+        template <typename Op_t>
+        friend const avx512b reduce(const avx512b& l, Op_t f) {
+            auto swap = [](const avx512b& v, uint32_t shift, uint32_t lo) {
+                uint32_t bits = uint32_t(v.mm);
+                return avx512b(impl::avx512_kmask(((bits & lo) << shift) | ((bits >> shift) & lo)));
+            };
+            avx512b tmp = f(l, swap(l, 1, 0x5555U));
+            tmp = f(tmp, swap(tmp, 2, 0x3333U));
+            tmp = f(tmp, swap(tmp, 4, 0x0f0fU));
+            return f(tmp, swap(tmp, 8, 0x00ffU));
+        }
+
+        SIMDEE_UNOP(avx512b, mask_t, mask, mask_t(uint32_t(l.mm)))
+        SIMDEE_UNOP(avx512b, scalar_t, first_scalar, scalar_t((uint32_t(l.mm) & 1U) != 0))
+
+        SIMDEE_BINOP(avx512b, avx512b, operator==, _mm512_kxnor(l.mm, r.mm))
+        SIMDEE_BINOP(avx512b, avx512b, operator!=, _mm512_kxor(l.mm, r.mm))
+        SIMDEE_BINOP(avx512b, avx512b, operator&&, _mm512_kand(l.mm, r.mm))
+        SIMDEE_BINOP(avx512b, avx512b, operator||, _mm512_kor(l.mm, r.mm))
+        SIMDEE_UNOP(avx512b, avx512b, operator!, _mm512_knot(l.mm))
+    };
+
+    template <typename Crtp>
+    struct avx512_base : simd_base<Crtp> {
+    protected:
+        using simd_base<Crtp>::mm;
+        SIMDEE_INL __m512i mmi() const { return _mm512_castps_si512(mm); }
+
+    public:
+        using vector_t = typename simd_base<Crtp>::vector_t;
+        using scalar_t = typename simd_base<Crtp>::scalar_t;
+        using storage_t = typename simd_base<Crtp>::storage_t;
+        using vec_b = typename simd_base<Crtp>::vec_b;
+        using vec_s = typename simd_base<Crtp>::vec_s;
+        using simd_base<Crtp>::width;
+        using simd_base<Crtp>::self;
+
+        SIMDEE_TRIVIAL_TYPE(avx512_base)
+
+        SIMDEE_BASE_CTOR(avx512_base, vector_t, mm = r)
+        SIMDEE_BASE_CTOR(avx512_base, scalar_t,
+                         mm = _mm512_set1_ps(reinterpret_cast<const float&>(r)))
+        SIMDEE_BASE_CTOR_FLAG(avx512_base, expr::zero, mm = _mm512_setzero_ps())
+        SIMDEE_BASE_CTOR_FLAG(avx512_base, expr::all_bits,
+                              mm = _mm512_castsi512_ps(_mm512_set1_epi32(-1)))
+        SIMDEE_BASE_CTOR_TPL(avx512_base, expr::aligned<T>, aligned_load(r.ptr))
+        SIMDEE_BASE_CTOR_TPL(avx512_base, expr::unaligned<T>, unaligned_load(r.ptr))
+        SIMDEE_BASE_CTOR_TPL2(avx512_base, expr::masked, masked_load(r.ptr, r.sel))
+        SIMDEE_BASE_CTOR_TPL(avx512_base, expr::init<T>, *this = r.template to<scalar_t>())
+        SIMDEE_BASE_CTOR(avx512_base, storage_t, aligned_load(r.data()))
+
+        SIMDEE_INL void aligned_load(const scalar_t* r) {
+            mm = _mm512_load_ps(reinterpret_cast<const float*>(r));
+        }
+        SIMDEE_INL void aligned_store(scalar_t* r) const {
+            _mm512_store_ps(reinterpret_cast<float*>(r), mm);
+        }
+        SIMDEE_INL void stream_store(scalar_t* r) const {
+            _mm512_stream_ps(reinterpret_cast<float*>(r), mm);
+        }
+        SIMDEE_INL void unaligned_load(const scalar_t* r) {
+            mm = _mm512_loadu_ps(reinterpret_cast<const float*>(r));
+        }
+        SIMDEE_INL void unaligned_store(scalar_t* r) const {
+            _mm512_storeu_ps(reinterpret_cast<float*>(r), mm);
+        }
+        SIMDEE_INL void masked_load(const scalar_t* r, std::size_t count) {
+            mm = _mm512_maskz_loadu_ps(impl::avx512_first(count),
+                                       reinterpret_cast<const float*>(r));
+        }
+        SIMDEE_INL void masked_load(const scalar_t* r, const vec_b& pred) {
+            mm = _mm512_maskz_loadu_ps(pred.data(), reinterpret_cast<const float*>(r));
+        }
+        SIMDEE_INL void masked_store(scalar_t* r, std::size_t count) const {
+            _mm512_mask_storeu_ps(reinterpret_cast<float*>(r), impl::avx512_first(count), mm);
+        }
+        SIMDEE_INL void masked_store(scalar_t* r, const vec_b& pred) const {
+            _mm512_mask_storeu_ps(reinterpret_cast<float*>(r), pred.data(), mm);
+        }
+        SIMDEE_INL void gather(const scalar_t* r, const vec_s& idx) {
+            mm = _mm512_i32gather_ps(_mm512_castps_si512(idx.data()), r, 4);
+        }
+        SIMDEE_INL void gather(const scalar_t* r, const vec_s& idx, const vec_b& pred) {
+            auto at = _mm512_castps_si512(idx.data());
+            mm = _mm512_mask_i32gather_ps(_mm512_setzero_ps(), pred.data(), at, r, 4);
+        }
+        SIMDEE_INL void scatter(scalar_t* r, const vec_s& idx) const {
+            _mm512_i32scatter_ps(r, _mm512_castps_si512(idx.data()), mm, 4);
+        }
+        SIMDEE_INL void scatter(scalar_t* r, const vec_s& idx, const vec_b& pred) const {
+            _mm512_mask_i32scatter_ps(r, pred.data(), _mm512_castps_si512(idx.data()), mm, 4);
+        }
+
+        template <unsigned int Lane>
+        SIMDEE_INL const Crtp broadcast() {
+            static_assert(Lane < 16, "");
+            return _mm512_permutexvar_ps(_mm512_set1_epi32(int(Lane)), mm);
+        }
+
+        template <typename Op_t>
+        friend const Crtp reduce(const Crtp& l, Op_t f) {
+            Crtp tmp = f(l, _mm512_permute_ps(l.mm, _MM_SHUFFLE(2, 3, 0, 1)));
+            tmp = f(tmp, _mm512_permute_ps(tmp.mm, _MM_SHUFFLE(1, 0, 3, 2)));
+            tmp = f(tmp, _mm512_shuffle_f32x4(tmp.mm, tmp.mm, _MM_SHUFFLE(2, 3, 0, 1)));
+            return f(tmp, _mm512_shuffle_f32x4(tmp.mm, tmp.mm, _MM_SHUFFLE(1, 0, 3, 2)));
+        }
+    };
+
+    struct avx512f : avx512_base<avx512f> {
+        SIMDEE_TRIVIAL_TYPE(avx512f)
+
+        using avx512_base::avx512_base;
+        SIMDEE_INL explicit avx512f(const avx512s&);
+        SIMDEE_INL avx512f(float v0, float v1, float v2, float v3, float v4, float v5, float v6,
+                           float v7, float v8, float v9, float v10, float v11, float v12,
+                           float v13, float v14, float v15) {
+            mm = _mm512_setr_ps(v0, v1, v2, v3, v4, v5, v6, v7, v8, v9, v10, v11, v12, v13, v14,
+                                v15);
+        }
+
+        SIMDEE_UNOP(avx512f, scalar_t, first_scalar, _mm_cvtss_f32(_mm512_castps512_ps128(l.mm)))
+
+        SIMDEE_BINOP(avx512f, avx512b, operator<, _mm512_cmp_ps_mask(l.mm, r.mm, _CMP_LT_OQ))
+        SIMDEE_BINOP(avx512f, avx512b, operator>, _mm512_cmp_ps_mask(l.mm, r.mm, _CMP_GT_OQ))
+        SIMDEE_BINOP(avx512f, avx512b, operator<=, _mm512_cmp_ps_mask(l.mm, r.mm, _CMP_LE_OQ))
+        SIMDEE_BINOP(avx512f, avx512b, operator>=, _mm512_cmp_ps_mask(l.mm, r.mm, _CMP_GE_OQ))
+        SIMDEE_BINOP(avx512f, avx512b, operator==, _mm512_cmp_ps_mask(l.mm, r.mm, _CMP_EQ_OQ))
+        SIMDEE_BINOP(avx512f, avx512b, operator!=, _mm512_cmp_ps_mask(l.mm, r.mm, _CMP_NEQ_OQ))
+
+        SIMDEE_UNOP(avx512f, avx512f, operator-,
+                    _mm512_castsi512_ps(_mm512_xor_si512(l.mmi(), avx512f(sign_bit()).mmi())))
+        SIMDEE_BINOP(avx512f, avx512f, operator+, _mm512_add_ps(l.mm, r.mm))
+        SIMDEE_BINOP(avx512f, avx512f, operator-, _mm512_sub_ps(l.mm, r.mm))
+        SIMDEE_BINOP(avx512f, avx512f, operator*, _mm512_mul_ps(l.mm, r.mm))
+        SIMDEE_BINOP(avx512f, avx512f, operator/, _mm512_div_ps(l.mm, r.mm))
+
+        SIMDEE_BINOP(avx512f, avx512f, min, _mm512_min_ps(l.mm, r.mm))
+        SIMDEE_BINOP(avx512f, avx512f, max, _mm512_max_ps(l.mm, r.mm))
+        SIMDEE_UNOP(avx512f, avx512f, sqrt, _mm512_sqrt_ps(l.mm))
+        SIMDEE_UNOP(avx512f, avx512f, rsqrt, _mm512_rsqrt14_ps(l.mm))
+        SIMDEE_UNOP(avx512f, avx512f, rcp, _mm512_rcp14_ps(l.mm))
+        SIMDEE_UNOP(avx512f, avx512f, abs, _mm512_abs_ps(l.mm))
+    };
+
+    struct avx512u : avx512_base<avx512u> {
+        SIMDEE_TRIVIAL_TYPE(avx512u)
+
+        using avx512_base::avx512_base;
+        SIMDEE_INL explicit avx512u(const avx512b&);
+        SIMDEE_INL explicit avx512u(const avx512s&);
+        SIMDEE_INL avx512u(uint32_t v0, uint32_t v1, uint32_t v2, uint32_t v3, uint32_t v4,
+                           uint32_t v5, uint32_t v6, uint32_t v7, uint32_t v8, uint32_t v9,
+                           uint32_t v10, uint32_t v11, uint32_t v12, uint32_t v13, uint32_t v14,
+                           uint32_t v15) {
+            mm = _mm512_castsi512_ps(_mm512_setr_epi32(
+                int32_t(v0), int32_t(v1), int32_t(v2), int32_t(v3), int32_t(v4), int32_t(v5),
+                int32_t(v6), int32_t(v7), int32_t(v8), int32_t(v9), int32_t(v10), int32_t(v11),
+                int32_t(v12), int32_t(v13), int32_t(v14), int32_t(v15)));
+        }
+        SIMDEE_CTOR(avx512u, __m512i, mm = _mm512_castsi512_ps(r))
+
+        SIMDEE_UNOP(avx512u, scalar_t, first_scalar,
+                    uint32_t(_mm_cvtsi128_si32(_mm512_castsi512_si128(l.mmi()))))
+
+#if SIMDEE_NEED_INT
+        SIMDEE_BINOP(avx512u, avx512b, operator<, _mm512_cmplt_epu32_mask(l.mmi(), r.mmi()))
+        SIMDEE_BINOP(avx512u, avx512b, operator>, _mm512_cmpgt_epu32_mask(l.mmi(), r.mmi()))
+        SIMDEE_BINOP(avx512u, avx512b, operator<=, _mm512_cmple_epu32_mask(l.mmi(), r.mmi()))
+        SIMDEE_BINOP(avx512u, avx512b, operator>=, _mm512_cmpge_epu32_mask(l.mmi(), r.mmi()))
+        SIMDEE_BINOP(avx512u, avx512b, operator==, _mm512_cmpeq_epu32_mask(l.mmi(), r.mmi()))
+        SIMDEE_BINOP(avx512u, avx512b, operator!=, _mm512_cmpneq_epu32_mask(l.mmi(), r.mmi()))
+        SIMDEE_BINOP(avx512u, avx512u, operator&, _mm512_and_si512(l.mmi(), r.mmi()))
+        SIMDEE_BINOP(avx512u, avx512u, operator|, _mm512_or_si512(l.mmi(), r.mmi()))
+        SIMDEE_BINOP(avx512u, avx512u, operator^, _mm512_xor_si512(l.mmi(), r.mmi()))
+        SIMDEE_UNOP(avx512u, avx512u, operator~,
+                    _mm512_ternarylogic_epi32(l.mmi(), l.mmi(), l.mmi(), 0x55))
+        SIMDEE_UNOP(avx512u, avx512u, operator-,
+                    _mm512_sub_epi32(_mm512_setzero_si512(), l.mmi()))
+        SIMDEE_BINOP(avx512u, avx512u, operator+, _mm512_add_epi32(l.mmi(), r.mmi()))
+        SIMDEE_BINOP(avx512u, avx512u, operator-, _mm512_sub_epi32(l.mmi(), r.mmi()))
+        SIMDEE_BINOP(avx512u, avx512u, operator*, _mm512_mullo_epi32(l.mmi(), r.mmi()))
+        SIMDEE_BINOP(avx512u, avx512u, min, _mm512_min_epu32(l.mmi(), r.mmi()))
+        SIMDEE_BINOP(avx512u, avx512u, max, _mm512_max_epu32(l.mmi(), r.mmi()))
+        SIMDEE_BINOP(avx512u, avx512u, mulhi, impl::avx512_mulhi_epu32(l.mmi(), r.mmi()))
+
+        SIMDEE_INL friend const avx512u operator<<(const avx512u& l, int r) {
+            return _mm512_sll_epi32(l.mmi(), _mm_cvtsi32_si128(r));
+        }
+        SIMDEE_INL friend const avx512u operator>>(const avx512u& l, int r) {
+            return _mm512_srl_epi32(l.mmi(), _mm_cvtsi32_si128(r));
+        }
+        SIMDEE_BINOP(avx512u, avx512u, operator<<, _mm512_sllv_epi32(l.mmi(), r.mmi()))
+        SIMDEE_BINOP(avx512u, avx512u, operator>>, _mm512_srlv_epi32(l.mmi(), r.mmi()))
+        SIMDEE_INL friend const avx512u rotl(const avx512u& l, int r) {
+            return _mm512_rolv_epi32(l.mmi(), _mm512_set1_epi32(r));
+        }
+        SIMDEE_INL friend const avx512u rotr(const avx512u& l, int r) {
+            return _mm512_rorv_epi32(l.mmi(), _mm512_set1_epi32(r));
+        }
+#endif
+    };
+
+    struct avx512s : avx512_base<avx512s> {
+        SIMDEE_TRIVIAL_TYPE(avx512s)
+
+        using avx512_base::avx512_base;
+        SIMDEE_INL explicit avx512s(const avx512f&);
+        SIMDEE_INL explicit avx512s(const avx512u&);
+        SIMDEE_INL avx512s(int32_t v0, int32_t v1, int32_t v2, int32_t v3, int32_t v4, int32_t v5,
+                           int32_t v6, int32_t v7, int32_t v8, int32_t v9, int32_t v10,
+                           int32_t v11, int32_t v12, int32_t v13, int32_t v14, int32_t v15) {
+            mm = _mm512_castsi512_ps(_mm512_setr_epi32(v0, v1, v2, v3, v4, v5, v6, v7, v8, v9,
+                                                       v10, v11, v12, v13, v14, v15));
+        }
+        SIMDEE_CTOR(avx512s, __m512i, mm = _mm512_castsi512_ps(r))
+
+        SIMDEE_UNOP(avx512s, scalar_t, first_scalar,
+                    _mm_cvtsi128_si32(_mm512_castsi512_si128(l.mmi())))
+
+#if SIMDEE_NEED_INT
+        SIMDEE_BINOP(avx512s, avx512b, operator<, _mm512_cmplt_epi32_mask(l.mmi(), r.mmi()))
+        SIMDEE_BINOP(avx512s, avx512b, operator>, _mm512_cmpgt_epi32_mask(l.mmi(), r.mmi()))
+        SIMDEE_BINOP(avx512s, avx512b, operator<=, _mm512_cmple_epi32_mask(l.mmi(), r.mmi()))
+        SIMDEE_BINOP(avx512s, avx512b, operator>=, _mm512_cmpge_epi32_mask(l.mmi(), r.mmi()))
+        SIMDEE_BINOP(avx512s, avx512b, operator==, _mm512_cmpeq_epi32_mask(l.mmi(), r.mmi()))
+        SIMDEE_BINOP(avx512s, avx512b, operator!=, _mm512_cmpneq_epi32_mask(l.mmi(), r.mmi()))
+
+        SIMDEE_BINOP(avx512s, avx512s, operator&, _mm512_and_si512(l.mmi(), r.mmi()))
+        SIMDEE_BINOP(avx512s, avx512s, operator|, _mm512_or_si512(l.mmi(), r.mmi()))
+        SIMDEE_BINOP(avx512s, avx512s, operator^, _mm512_xor_si512(l.mmi(), r.mmi()))
+        SIMDEE_UNOP(avx512s, avx512s, operator~,
+                    _mm512_ternarylogic_epi32(l.mmi(), l.mmi(), l.mmi(), 0x55))
+
+        SIMDEE_UNOP(avx512s, avx512s, operator-,
+                    _mm512_sub_epi32(_mm512_setzero_si512(), l.mmi()))
+        SIMDEE_BINOP(avx512s, avx512s, operator+, _mm512_add_epi32(l.mmi(), r.mmi()))
+        SIMDEE_BINOP(avx512s, avx512s, operator-, _mm512_sub_epi32(l.mmi(), r.mmi()))
+        SIMDEE_BINOP(avx512s, avx512s, operator*, _mm512_mullo_epi32(l.mmi(), r.mmi()))
+
+        SIMDEE_BINOP(avx512s, avx512s, min, _mm512_min_epi32(l.mmi(), r.mmi()))
+        SIMDEE_BINOP(avx512s, avx512s, max, _mm512_max_epi32(l.mmi(), r.mmi()))
+        SIMDEE_UNOP(avx512s, avx512s, abs, _mm512_abs_epi32(l.mmi()))
+        SIMDEE_BINOP(avx512s, avx512s, mulhi, impl::avx512_mulhi_epi32(l.mmi(), r.mmi()))
+
+        SIMDEE_INL friend const avx512s operator<<(const avx512s& l, int r) {
+            return _mm512_sll_epi32(l.mmi(), _mm_cvtsi32_si128(r));
+        }
+        SIMDEE_INL friend const avx512s operator>>(const avx512s& l, int r) {
+            return _mm512_sra_epi32(l.mmi(), _mm_cvtsi32_si128(r));
+        }
+        SIMDEE_BINOP(avx512s, avx512s, operator<<, _mm512_sllv_epi32(l.mmi(), r.mmi()))
+        SIMDEE_BINOP(avx512s, avx512s, operator>>, _mm512_srav_epi32(l.mmi(), r.mmi()))
+#endif
+    };
+
+    SIMDEE_INL avx512f::avx512f(const avx512s& r) {
+        mm = _mm512_cvtepi32_ps(_mm512_castps_si512(r.data()));
+    }
+    SIMDEE_INL avx512s::avx512s(const avx512f& r) {
+        mm = _mm512_castsi512_ps(_mm512_cvttps_epi32(r.data()));
+    }
+    SIMDEE_INL avx512u::avx512u(const avx512b& r) { mm = impl::avx512_expand(r.data()); }
+    SIMDEE_INL avx512u::avx512u(const avx512s& r) { mm = r.data(); }
+    SIMDEE_INL avx512s::avx512s(const avx512u& r) { mm = r.data(); }
+
+    SIMDEE_INL void avx512b::gather(const scalar_t* r, const vec_s& idx) {
+        __m512i v = _mm512_i32gather_epi32(_mm512_castps_si512(idx.data()), r, 4);
+        mm = _mm512_test_epi32_mask(v, v);
+    }
+    SIMDEE_INL void avx512b::gather(const scalar_t* r, const vec_s& idx, const avx512b& pred) {
+        auto at = _mm512_castps_si512(idx.data());
+        __m512i v = _mm512_mask_i32gather_epi32(_mm512_setzero_si512(), pred.mm, at, r, 4);
+        mm = _mm512_test_epi32_mask(v, v);
+    }
+    SIMDEE_INL void avx512b::scatter(scalar_t* r, const vec_s& idx) const {
+        auto v = _mm512_castps_si512(impl::avx512_expand(mm));
+        _mm512_i32scatter_epi32(r, _mm512_castps_si512(idx.data()), v, 4);
+    }
+    SIMDEE_INL void avx512b::scatter(scalar_t* r, const vec_s& idx, const avx512b& pred) const {
+        auto v = _mm512_castps_si512(impl::avx512_expand(mm));
+        _mm512_mask_i32scatter_epi32(r, pred.mm, _mm512_castps_si512(idx.data()), v, 4);
+    }
+
+    SIMDEE_INL const avx512b cond(const avx512b& pred, const avx512b& if_true,
+                                  const avx512b& if_false) {
+        return _mm512_kor(_mm512_kand(pred.data(), if_true.data()),
+                          _mm512_kandn(pred.data(), if_false.data()));
+    }
+    SIMDEE_INL const avx512f cond(const avx512b& pred, const avx512f& if_true,
+                                  const avx512f& if_false) {
+        return _mm512_mask_blend_ps(pred.data(), if_false.data(), if_true.data());
+    }
+    SIMDEE_INL const avx512u cond(const avx512b& pred, const avx512u& if_true,
+                                  const avx512u& if_false) {
+        return _mm512_mask_blend_ps(pred.data(), if_false.data(), if_true.data());
+    }
+    SIMDEE_INL const avx512s cond(const avx512b& pred, const avx512s& if_true,
+                                  const avx512s& if_false) {
+        return _mm512_mask_blend_ps(pred.data(), if_false.data(), if_true.data());
+    }
+
+    //
+    // 64-bit scalars
+    //
+
+    struct avx512b64;
+    struct avx512d;
+    struct avx512u64;
+    struct avx512s64;
+
+    template <>
+    struct is_simd_vector<avx512b64> : std::integral_constant<bool, true> {};
+    template <>
+    struct is_simd_vector<avx512d> : std::integral_constant<bool, true> {};
+    template <>
+    struct is_simd_vector<avx512u64> : std::integral_constant<bool, true> {};
+    template <>
+    struct is_simd_vector<avx512s64> : std::integral_constant<bool, true> {};
+
+    template <typename Simd_t, typename Scalar_t>
+    struct avx512_64_traits {
+        using simd_t = Simd_t;
+        using vector_t = __m512d;
+        using scalar_t = Scalar_t;
+        using vec_b = avx512b64;
+        using vec_f = avx512d;
+        using vec_u = avx512u64;
+        using vec_s = avx512s64;
+        using mask_t = impl::mask<0xffU>;
+        using storage_t = impl::storage<simd_t, scalar_t, alignof(__m512d)>;
+    };
+
+    template <>
+    struct simd_vector_traits<avx512b64> : avx512_64_traits<avx512b64, bool64_t> {
+        using vector_t = __mmask8;
+        enum : std::size_t { width = 8 };
+    };
+    template <>
+    struct simd_vector_traits<avx512d> : avx512_64_traits<avx512d, double> {};
+    template <>
+    struct simd_vector_traits<avx512u64> : avx512_64_traits<avx512u64, uint64_t> {};
+    template <>
+    struct simd_vector_traits<avx512s64> : avx512_64_traits<avx512s64, int64_t> {};
+
+    namespace impl {
+        SIMDEE_INL __mmask8 avx512_kmask8(bool value) { return value ? 0xff : 0x00; }
+
+        SIMDEE_INL __mmask8 avx512_kmask8(uint32_t bits) { return __mmask8(bits & 0xffU); }
+
+        // selects the first count lanes
+        SIMDEE_INL __mmask8 avx512_first8(std::size_t count) {
+            return avx512_kmask8(count >= 8 ? 0xffU : (1U << count) - 1U);
+        }
+
+        SIMDEE_INL __m512d avx512_expand(__mmask8 k) {
+            return _mm512_castsi512_pd(_mm512_maskz_set1_epi64(k, -1));
+        }
+    } // namespace impl
+
+    struct avx512b64 : simd_base<avx512b64> {
+        SIMDEE_TRIVIAL_TYPE(avx512b64)
+
+        SIMDEE_CTOR(avx512b64, vector_t, mm = r)
+        SIMDEE_CTOR(avx512b64, scalar_t, mm = impl::avx512_kmask8(bool(r)))
+        SIMDEE_CTOR(avx512b64, bool, mm = impl::avx512_kmask8(r))
+        SIMDEE_CTOR_FLAG(avx512b64, expr::zero, mm = impl::avx512_kmask8(false))
+        SIMDEE_CTOR_FLAG(avx512b64, expr::all_bits, mm = impl::avx512_kmask8(true))
+        SIMDEE_CTOR_TPL(avx512b64, expr::aligned<T>, aligned_load(r.ptr))
+        SIMDEE_CTOR_TPL(avx512b64, expr::unaligned<T>, unaligned_load(r.ptr))
+        SIMDEE_CTOR_TPL2(avx512b64, expr::masked, masked_load(r.ptr, r.sel))
+        SIMDEE_CTOR_TPL(avx512b64, expr::init<T>,
+                        mm = impl::avx512_kmask8(bool(r.template to<scalar_t>())))
+        SIMDEE_CTOR(avx512b64, storage_t, aligned_load(r.data()))
+
+        SIMDEE_INL avx512b64(bool64_t v0, bool64_t v1, bool64_t v2, bool64_t v3, bool64_t v4,
+                             bool64_t v5, bool64_t v6, bool64_t v7) {
+            const bool64_t v[8] = {v0, v1, v2, v3, v4, v5, v6, v7};
+            uint32_t bits = 0;
+            for (uint32_t i = 0; i < 8; ++i) { bits |= uint32_t(bool(v[i])) << i; }
+            mm = impl::avx512_kmask8(bits);
+        }
+
+        SIMDEE_INL void aligned_load(const scalar_t* r) {
+            __m512i v = _mm512_load_si512(reinterpret_cast<const void*>(r));
+            mm = _mm512_test_epi64_mask(v, v);
+        }
+        SIMDEE_INL void aligned_store(scalar_t* r) const {
+            _mm512_store_pd(reinterpret_cast<double*>(r), impl::avx512_expand(mm));
+        }
+        SIMDEE_INL void stream_store(scalar_t* r) const {
+            _mm512_stream_pd(reinterpret_cast<double*>(r), impl::avx512_expand(mm));
+        }
+        SIMDEE_INL void unaligned_load(const scalar_t* r) {
+            __m512i v = _mm512_loadu_si512(reinterpret_cast<const void*>(r));
+            mm = _mm512_test_epi64_mask(v, v);
+        }
+        SIMDEE_INL void unaligned_store(scalar_t* r) const {
+            _mm512_storeu_pd(reinterpret_cast<double*>(r), impl::avx512_expand(mm));
+        }
+        SIMDEE_INL void masked_load(const scalar_t* r, std::size_t count) {
+            masked_load(r, avx512b64(impl::avx512_first8(count)));
+        }
+        SIMDEE_INL void masked_load(const scalar_t* r, const avx512b64& pred) {
+            __m512i v = _mm512_maskz_loadu_epi64(pred.mm, reinterpret_cast<const void*>(r));
+            mm = _mm512_test_epi64_mask(v, v);
+        }
+        SIMDEE_INL void masked_store(scalar_t* r, std::size_t count) const {
+            masked_store(r, avx512b64(impl::avx512_first8(count)));
+        }
+        SIMDEE_INL void masked_store(scalar_t* r, const avx512b64& pred) const {
+            _mm512_mask_storeu_pd(reinterpret_cast<double*>(r), pred.mm, impl::avx512_expand(mm));
+        }
+        SIMDEE_INL void gather(const scalar_t* r, const vec_s& idx);
+        SIMDEE_INL void gather(const scalar_t* r, const vec_s& idx, const avx512b64& pred);
+        SIMDEE_INL void scatter(scalar_t* r, const vec_s& idx) const;
+        SIMDEE_INL void scatter(scalar_t* r, const vec_s& idx, const avx512b64& pred) const;
+
+        template <unsigned int Lane>
+        SIMDEE_INL const avx512b64 broadcast() {
+            static_assert(Lane < 8, "");
+            return impl::avx512_kmask8(((uint32_t(mm) >> Lane) & 1U) != 0);
+        }
+
+        template <typename Op_t>
+        friend const avx512b64 reduce(const avx512b64& l, Op_t f) {
+            auto swap = [](const avx512b64& v, uint32_t shift, uint32_t lo) {
+                uint32_t bits = uint32_t(v.mm);
+                return avx512b64(
+                    impl::avx512_kmask8(((bits & lo) << shift) | ((bits >> shift) & lo)));
+            };
+            avx512b64 tmp = f(l, swap(l, 1, 0x55U));
+            tmp = f(tmp, swap(tmp, 2, 0x33U));
+            return f(tmp, swap(tmp, 4, 0x0fU));
+        }
+
+        SIMDEE_UNOP(avx512b64, mask_t, mask, mask_t(uint32_t(l.mm)))
+        SIMDEE_UNOP(avx512b64, scalar_t, first_scalar, scalar_t((uint32_t(l.mm) & 1U) != 0))
+
+        SIMDEE_BINOP(avx512b64, avx512b64, operator==, _kxnor_mask8(l.mm, r.mm))
+        SIMDEE_BINOP(avx512b64, avx512b64, operator!=, _kxor_mask8(l.mm, r.mm))
+        SIMDEE_BINOP(avx512b64, avx512b64, operator&&, _kand_mask8(l.mm, r.mm))
+        SIMDEE_BINOP(avx512b64, avx512b64, operator||, _kor_mask8(l.mm, r.mm))
+        SIMDEE_UNOP(avx512b64, avx512b64, operator!, _knot_mask8(l.mm))
+    };
+
+    template <typename Crtp>
+    struct avx512_64_base : simd_base<Crtp> {
+    protected:
+        using simd_base<Crtp>::mm;
+        SIMDEE_INL __m512i mmi() const { return _mm512_castpd_si512(mm); }
+
+    public:
+        using vector_t = typename simd_base<Crtp>::vector_t;
+        using scalar_t = typename simd_base<Crtp>::scalar_t;
+        using storage_t = typename simd_base<Crtp>::storage_t;
+        using vec_b = typename simd_base<Crtp>::vec_b;
+        using vec_s = typename simd_base<Crtp>::vec_s;
+        using simd_base<Crtp>::width;
+        using simd_base<Crtp>::self;
+
+        SIMDEE_TRIVIAL_TYPE(avx512_64_base)
+
+        SIMDEE_BASE_CTOR(avx512_64_base, vector_t, mm = r)
+        SIMDEE_BASE_CTOR(avx512_64_base, scalar_t,
+                         mm = _mm512_set1_pd(reinterpret_cast<const double&>(r)))
+        SIMDEE_BASE_CTOR_FLAG(avx512_64_base, expr::zero, mm = _mm512_setzero_pd())
+        SIMDEE_BASE_CTOR_FLAG(avx512_64_base, expr::all_bits,
+                              mm = _mm512_castsi512_pd(_mm512_set1_epi64(-1)))
+        SIMDEE_BASE_CTOR_TPL(avx512_64_base, expr::aligned<T>, aligned_load(r.ptr))
+        SIMDEE_BASE_CTOR_TPL(avx512_64_base, expr::unaligned<T>, unaligned_load(r.ptr))
+        SIMDEE_BASE_CTOR_TPL2(avx512_64_base, expr::masked, masked_load(r.ptr, r.sel))
+        SIMDEE_BASE_CTOR_TPL(avx512_64_base, expr::init<T>, *this = r.template to<scalar_t>())
+        SIMDEE_BASE_CTOR(avx512_64_base, storage_t, aligned_load(r.data()))
+
+        SIMDEE_INL void aligned_load(const scalar_t* r) {
+            mm = _mm512_load_pd(reinterpret_cast<const double*>(r));
+        }
+        SIMDEE_INL void aligned_store(scalar_t* r) const {
+            _mm512_store_pd(reinterpret_cast<double*>(r), mm);
+        }
+        SIMDEE_INL void stream_store(scalar_t* r) const {
+            _mm512_stream_pd(reinterpret_cast<double*>(r), mm);
+        }
+        SIMDEE_INL void unaligned_load(const scalar_t* r) {
+            mm = _mm512_loadu_pd(reinterpret_cast<const double*>(r));
+        }
+        SIMDEE_INL void unaligned_store(scalar_t* r) const {
+            _mm512_storeu_pd(reinterpret_cast<double*>(r), mm);
+        }
+        SIMDEE_INL void masked_load(const scalar_t* r, std::size_t count) {
+            mm = _mm512_maskz_loadu_pd(impl::avx512_first8(count),
+                                       reinterpret_cast<const double*>(r));
+        }
+        SIMDEE_INL void masked_load(const scalar_t* r, const vec_b& pred) {
+            mm = _mm512_maskz_loadu_pd(pred.data(), reinterpret_cast<const double*>(r));
+        }
+        SIMDEE_INL void masked_store(scalar_t* r, std::size_t count) const {
+            _mm512_mask_storeu_pd(reinterpret_cast<double*>(r), impl::avx512_first8(count), mm);
+        }
+        SIMDEE_INL void masked_store(scalar_t* r, const vec_b& pred) const {
+            _mm512_mask_storeu_pd(reinterpret_cast<double*>(r), pred.data(), mm);
+        }
+        SIMDEE_INL void gather(const scalar_t* r, const vec_s& idx) {
+            mm = _mm512_i64gather_pd(_mm512_castpd_si512(idx.data()), r, 8);
+        }
+        SIMDEE_INL void gather(const scalar_t* r, const vec_s& idx, const vec_b& pred) {
+            auto at = _mm512_castpd_si512(idx.data());
+            mm = _mm512_mask_i64gather_pd(_mm512_setzero_pd(), pred.data(), at, r, 8);
+        }
+        SIMDEE_INL void scatter(scalar_t* r, const vec_s& idx) const {
+            _mm512_i64scatter_pd(r, _mm512_castpd_si512(idx.data()), mm, 8);
+        }
+        SIMDEE_INL void scatter(scalar_t* r, const vec_s& idx, const vec_b& pred) const {
+            _mm512_mask_i64scatter_pd(r, pred.data(), _mm512_castpd_si512(idx.data()), mm, 8);
+        }
+
+        template <unsigned int Lane>
+        SIMDEE_INL const Crtp broadcast() {
+            static_assert(Lane < 8, "");
+            return _mm512_permutexvar_pd(_mm512_set1_epi64(int64_t(Lane)), mm);
+        }
+
+        template <typename Op_t>
+        friend const Crtp reduce(const Crtp& l, Op_t f) {
+            Crtp tmp = f(l, _mm512_permute_pd(l.mm, 0x55));
+            tmp = f(tmp, _mm512_shuffle_f64x2(tmp.mm, tmp.mm, _MM_SHUFFLE(2, 3, 0, 1)));
+            return f(tmp, _mm512_shuffle_f64x2(tmp.mm, tmp.mm, _MM_SHUFFLE(1, 0, 3, 2)));
+        }
+    };
+
+    struct avx512d : avx512_64_base<avx512d> {
+        SIMDEE_TRIVIAL_TYPE(avx512d)
+
+        using avx512_64_base::avx512_64_base;
+        SIMDEE_INL explicit avx512d(const avx512s64&);
+        SIMDEE_INL avx512d(double v0, double v1, double v2, double v3, double v4, double v5,
+                           double v6, double v7) {
+            mm = _mm512_setr_pd(v0, v1, v2, v3, v4, v5, v6, v7);
+        }
+
+        SIMDEE_UNOP(avx512d, scalar_t, first_scalar, _mm_cvtsd_f64(_mm512_castpd512_pd128(l.mm)))
+
+        SIMDEE_BINOP(avx512d, avx512b64, operator<, _mm512_cmp_pd_mask(l.mm, r.mm, _CMP_LT_OQ))
+        SIMDEE_BINOP(avx512d, avx512b64, operator>, _mm512_cmp_pd_mask(l.mm, r.mm, _CMP_GT_OQ))
+        SIMDEE_BINOP(avx512d, avx512b64, operator<=, _mm512_cmp_pd_mask(l.mm, r.mm, _CMP_LE_OQ))
+        SIMDEE_BINOP(avx512d, avx512b64, operator>=, _mm512_cmp_pd_mask(l.mm, r.mm, _CMP_GE_OQ))
+        SIMDEE_BINOP(avx512d, avx512b64, operator==, _mm512_cmp_pd_mask(l.mm, r.mm, _CMP_EQ_OQ))
+        SIMDEE_BINOP(avx512d, avx512b64, operator!=,
+                     _mm512_cmp_pd_mask(l.mm, r.mm, _CMP_NEQ_OQ))
+
+        SIMDEE_UNOP(avx512d, avx512d, operator-,
+                    _mm512_castsi512_pd(_mm512_xor_si512(l.mmi(), avx512d(sign_bit()).mmi())))
+        SIMDEE_BINOP(avx512d, avx512d, operator+, _mm512_add_pd(l.mm, r.mm))
+        SIMDEE_BINOP(avx512d, avx512d, operator-, _mm512_sub_pd(l.mm, r.mm))
+        SIMDEE_BINOP(avx512d, avx512d, operator*, _mm512_mul_pd(l.mm, r.mm))
+        SIMDEE_BINOP(avx512d, avx512d, operator/, _mm512_div_pd(l.mm, r.mm))
+
+        SIMDEE_BINOP(avx512d, avx512d, min, _mm512_min_pd(l.mm, r.mm))
+        SIMDEE_BINOP(avx512d, avx512d, max, _mm512_max_pd(l.mm, r.mm))
+        SIMDEE_UNOP(avx512d, avx512d, sqrt, _mm512_sqrt_pd(l.mm))
+        SIMDEE_UNOP(avx512d, avx512d, rsqrt, _mm512_rsqrt14_pd(l.mm))
+        SIMDEE_UNOP(avx512d, avx512d, rcp, _mm512_rcp14_pd(l.mm))
+        SIMDEE_UNOP(avx512d, avx512d, abs, _mm512_abs_pd(l.mm))
+    };
+
+    struct avx512u64 : avx512_64_base<avx512u64> {
+        SIMDEE_TRIVIAL_TYPE(avx512u64)
+
+        using avx512_64_base::avx512_64_base;
+        SIMDEE_INL explicit avx512u64(const avx512b64&);
+        SIMDEE_INL explicit avx512u64(const avx512s64&);
+        SIMDEE_INL avx512u64(uint64_t v0, uint64_t v1, uint64_t v2, uint64_t v3, uint64_t v4,
+                             uint64_t v5, uint64_t v6, uint64_t v7) {
+            mm = _mm512_castsi512_pd(_mm512_setr_epi64(int64_t(v0), int64_t(v1), int64_t(v2),
+                                                       int64_t(v3), int64_t(v4), int64_t(v5),
+                                                       int64_t(v6), int64_t(v7)));
+        }
+        SIMDEE_CTOR(avx512u64, __m512i, mm = _mm512_castsi512_pd(r))
+
+        SIMDEE_UNOP(avx512u64, scalar_t, first_scalar,
+                    uint64_t(_mm_cvtsi128_si64(_mm512_castsi512_si128(l.mmi()))))
+
+#if SIMDEE_NEED_INT
+        SIMDEE_BINOP(avx512u64, avx512b64, operator<, _mm512_cmplt_epu64_mask(l.mmi(), r.mmi()))
+        SIMDEE_BINOP(avx512u64, avx512b64, operator>, _mm512_cmpgt_epu64_mask(l.mmi(), r.mmi()))
+        SIMDEE_BINOP(avx512u64, avx512b64, operator<=, _mm512_cmple_epu64_mask(l.mmi(), r.mmi()))
+        SIMDEE_BINOP(avx512u64, avx512b64, operator>=, _mm512_cmpge_epu64_mask(l.mmi(), r.mmi()))
+        SIMDEE_BINOP(avx512u64, avx512b64, operator==, _mm512_cmpeq_epu64_mask(l.mmi(), r.mmi()))
+        SIMDEE_BINOP(avx512u64, avx512b64, operator!=,
+                     _mm512_cmpneq_epu64_mask(l.mmi(), r.mmi()))
+        SIMDEE_BINOP(avx512u64, avx512u64, operator&, _mm512_and_si512(l.mmi(), r.mmi()))
+        SIMDEE_BINOP(avx512u64, avx512u64, operator|, _mm512_or_si512(l.mmi(), r.mmi()))
+        SIMDEE_BINOP(avx512u64, avx512u64, operator^, _mm512_xor_si512(l.mmi(), r.mmi()))
+        SIMDEE_UNOP(avx512u64, avx512u64, operator~,
+                    _mm512_ternarylogic_epi64(l.mmi(), l.mmi(), l.mmi(), 0x55))
+        SIMDEE_UNOP(avx512u64, avx512u64, operator-,
+                    _mm512_sub_epi64(_mm512_setzero_si512(), l.mmi()))
+        SIMDEE_BINOP(avx512u64, avx512u64, operator+, _mm512_add_epi64(l.mmi(), r.mmi()))
+        SIMDEE_BINOP(avx512u64, avx512u64, operator-, _mm512_sub_epi64(l.mmi(), r.mmi()))
+        SIMDEE_BINOP(avx512u64, avx512u64, operator*, _mm512_mullo_epi64(l.mmi(), r.mmi()))
+        SIMDEE_BINOP(avx512u64, avx512u64, min, _mm512_min_epu64(l.mmi(), r.mmi()))
+        SIMDEE_BINOP(avx512u64, avx512u64, max, _mm512_max_epu64(l.mmi(), r.mmi()))
+#endif
+    };
+
+    struct avx512s64 : avx512_64_base<avx512s64> {
+        SIMDEE_TRIVIAL_TYPE(avx512s64)
+
+        using avx512_64_base::avx512_64_base;
+        SIMDEE_INL explicit avx512s64(const avx512d&);
+        SIMDEE_INL explicit avx512s64(const avx512u64&);
+        SIMDEE_INL avx512s64(int64_t v0, int64_t v1, int64_t v2, int64_t v3, int64_t v4,
+                             int64_t v5, int64_t v6, int64_t v7) {
+            mm = _mm512_castsi512_pd(_mm512_setr_epi64(v0, v1, v2, v3, v4, v5, v6, v7));
+        }
+        SIMDEE_CTOR(avx512s64, __m512i, mm = _mm512_castsi512_pd(r))
+
+        SIMDEE_UNOP(avx512s64, scalar_t, first_scalar,
+                    int64_t(_mm_cvtsi128_si64(_mm512_castsi512_si128(l.mmi()))))
+
+#if SIMDEE_NEED_INT
+        SIMDEE_BINOP(avx512s64, avx512b64, operator<, _mm512_cmplt_epi64_mask(l.mmi(), r.mmi()))
+        SIMDEE_BINOP(avx512s64, avx512b64, operator>, _mm512_cmpgt_epi64_mask(l.mmi(), r.mmi()))
+        SIMDEE_BINOP(avx512s64, avx512b64, operator<=, _mm512_cmple_epi64_mask(l.mmi(), r.mmi()))
+        SIMDEE_BINOP(avx512s64, avx512b64, operator>=, _mm512_cmpge_epi64_mask(l.mmi(), r.mmi()))
+        SIMDEE_BINOP(avx512s64, avx512b64, operator==, _mm512_cmpeq_epi64_mask(l.mmi(), r.mmi()))
+        SIMDEE_BINOP(avx512s64, avx512b64, operator!=,
+                     _mm512_cmpneq_epi64_mask(l.mmi(), r.mmi()))
+
+        SIMDEE_BINOP(avx512s64, avx512s64, operator&, _mm512_and_si512(l.mmi(), r.mmi()))
+        SIMDEE_BINOP(avx512s64, avx512s64, operator|, _mm512_or_si512(l.mmi(), r.mmi()))
+        SIMDEE_BINOP(avx512s64, avx512s64, operator^, _mm512_xor_si512(l.mmi(), r.mmi()))
+        SIMDEE_UNOP(avx512s64, avx512s64, operator~,
+                    _mm512_ternarylogic_epi64(l.mmi(), l.mmi(), l.mmi(), 0x55))
+
+        SIMDEE_UNOP(avx512s64, avx512s64, operator-,
+                    _mm512_sub_epi64(_mm512_setzero_si512(), l.mmi()))
+        SIMDEE_BINOP(avx512s64, avx512s64, operator+, _mm512_add_epi64(l.mmi(), r.mmi()))
+        SIMDEE_BINOP(avx512s64, avx512s64, operator-, _mm512_sub_epi64(l.mmi(), r.mmi()))
+        SIMDEE_BINOP(avx512s64, avx512s64, operator*, _mm512_mullo_epi64(l.mmi(), r.mmi()))
+
+        SIMDEE_BINOP(avx512s64, avx512s64, min, _mm512_min_epi64(l.mmi(), r.mmi()))
+        SIMDEE_BINOP(avx512s64, avx512s64, max, _mm512_max_epi64(l.mmi(), r.mmi()))
+        SIMDEE_UNOP(avx512s64, avx512s64, abs, _mm512_abs_epi64(l.mmi()))
+#endif
+    };
+
+    SIMDEE_INL avx512d::avx512d(const avx512s64& r) {
+        mm = _mm512_cvtepi64_pd(_mm512_castpd_si512(r.data()));
+    }
+    SIMDEE_INL avx512s64::avx512s64(const avx512d& r) {
+        mm = _mm512_castsi512_pd(_mm512_cvttpd_epi64(r.data()));
+    }
+    SIMDEE_INL avx512u64::avx512u64(const avx512b64& r) { mm = impl::avx512_expand(r.data()); }
+    SIMDEE_INL avx512u64::avx512u64(const avx512s64& r) { mm = r.data(); }
+    SIMDEE_INL avx512s64::avx512s64(const avx512u64& r) { mm = r.data(); }
+
+    SIMDEE_INL void avx512b64::gather(const scalar_t* r, const vec_s& idx) {
+        __m512i v = _mm512_i64gather_epi64(_mm512_castpd_si512(idx.data()), r, 8);
+        mm = _mm512_test_epi64_mask(v, v);
+    }
+    SIMDEE_INL void avx512b64::gather(const scalar_t* r, const vec_s& idx, const avx512b64& pred) {
+        auto at = _mm512_castpd_si512(idx.data());
+        __m512i v = _mm512_mask_i64gather_epi64(_mm512_setzero_si512(), pred.mm, at, r, 8);
+        mm = _mm512_test_epi64_mask(v, v);
+    }
+    SIMDEE_INL void avx512b64::scatter(scalar_t* r, const vec_s& idx) const {
+        auto v = _mm512_castpd_si512(impl::avx512_expand(mm));
+        _mm512_i64scatter_epi64(r, _mm512_castpd_si512(idx.data()), v, 8);
+    }
+    SIMDEE_INL void avx512b64::scatter(scalar_t* r, const vec_s& idx, const avx512b64& pred) const {
+        auto v = _mm512_castpd_si512(impl::avx512_expand(mm));
+        _mm512_mask_i64scatter_epi64(r, pred.mm, _mm512_castpd_si512(idx.data()), v, 8);
+    }
+
+    SIMDEE_INL const avx512b64 cond(const avx512b64& pred, const avx512b64& if_true,
+                                    const avx512b64& if_false) {
+        return _kor_mask8(_kand_mask8(pred.data(), if_true.data()),
+                          _kandn_mask8(pred.data(), if_false.data()));
+    }
+    SIMDEE_INL const avx512d cond(const avx512b64& pred, const avx512d& if_true,
+                                  const avx512d& if_false) {
+        return _mm512_mask_blend_pd(pred.data(), if_false.data(), if_true.data());
+    }
+    SIMDEE_INL const avx512u64 cond(const avx512b64& pred, const avx512u64& if_true,
+                                    const avx512u64& if_false) {
+        return _mm512_mask_blend_pd(pred.data(), if_false.data(), if_true.data());
+    }
+    SIMDEE_INL const avx512s64 cond(const avx512b64& pred, const avx512s64& if_true,
+                                    const avx512s64& if_false) {
+        return _mm512_mask_blend_pd(pred.data(), if_false.data(), if_true.data());
+    }
+
+#if SIMDEE_NEED_INT
+    // the full 64-bit products of the lower and of the upper half of the 32-bit scalars
+    SIMDEE_INL const avx512u64 mul_wide_lo(const avx512u& l, const avx512u& r) {
+        return _mm512_mul_epu32(impl::avx512_spread_lo(l.data()), impl::avx512_spread_lo(r.data()));
+    }
+    SIMDEE_INL const avx512u64 mul_wide_hi(const avx512u& l, const avx512u& r) {
+        return _mm512_mul_epu32(impl::avx512_spread_hi(l.data()), impl::avx512_spread_hi(r.data()));
+    }
+    SIMDEE_INL const avx512s64 mul_wide_lo(const avx512s& l, const avx512s& r) {
+        return _mm512_mul_epi32(impl::avx512_spread_lo(l.data()), impl::avx512_spread_lo(r.data()));
+    }
+    SIMDEE_INL const avx512s64 mul_wide_hi(const avx512s& l, const avx512s& r) {
+        return _mm512_mul_epi32(impl::avx512_spread_hi(l.data()), impl::avx512_spread_hi(r.data()));
+    }
+#endif
+
+    // interleaved loads and stores, each output vector is permuted out of up to four inputs;
+    // transposition
+    namespace impl {
+
+        // the permute index vector with F::lane(i) in the i-th lane
+        template <typename F>
+        SIMDEE_INL __m512i avx512_index() {
+            return _mm512_set_epi32(F::lane(15), F::lane(14), F::lane(13), F::lane(12),
+                                    F::lane(11), F::lane(10), F::lane(9), F::lane(8), F::lane(7),
+                                    F::lane(6), F::lane(5), F::lane(4), F::lane(3), F::lane(2),
+                                    F::lane(1), F::lane(0));
+        }
+
+        // the J-th of N vectors is loaded from the scalars lane(i) of the interleaved input;
+        // scalars 32 and higher come from the third and fourth input vector
+        template <int N, int J>
+        struct avx512_deinterleave_index {
+            static constexpr int lane(int i) { return i * N + J; }
+            static constexpr uint32_t upper(int i = 15) {
+                return i < 0 ? 0U : (lane(i) >= 32 ? 1U << i : 0U) | upper(i - 1);
+            }
+        };
+
+        // the O-th output vector stores the record k / N of the vector k % N, k = 16 * O + e;
+        // vectors 0 and 1 are selected by bit 4 of the index, vectors 2 and 3 are upper
+        template <int N, int O>
+        struct avx512_interleave_index {
+            static constexpr int lane(int e) {
+                return (16 * O + e) / N + 16 * (((16 * O + e) % N) & 1);
+            }
+            static constexpr uint32_t upper(int e = 15) {
+                return e < 0 ? 0U : ((16 * O + e) % N >= 2 ? 1U << e : 0U) | upper(e - 1);
+            }
+        };
+
+        template <typename T>
+        struct avx512_interleave {
+            using scalar_t = typename simd_vector_traits<T>::scalar_t;
+
+            SIMDEE_INL static void load(const scalar_t* ptr, T& v0, T& v1) {
+                auto p = reinterpret_cast<const float*>(ptr);
+                __m512 a = _mm512_loadu_ps(p), b = _mm512_loadu_ps(p + 16);
+                v0 = _mm512_permutex2var_ps(a, avx512_index<avx512_deinterleave_index<2, 0>>(), b);
+                v1 = _mm512_permutex2var_ps(a, avx512_index<avx512_deinterleave_index<2, 1>>(), b);
+            }
+            SIMDEE_INL static void load(const scalar_t* ptr, T& v0, T& v1, T& v2) {
+                auto p = reinterpret_cast<const float*>(ptr);
+                __m512 a = _mm512_loadu_ps(p), b = _mm512_loadu_ps(p + 16);
+                __m512 c = _mm512_loadu_ps(p + 32);
+                v0 = permute3<avx512_deinterleave_index<3, 0>>(a, b, c);
+                v1 = permute3<avx512_deinterleave_index<3, 1>>(a, b, c);
+                v2 = permute3<avx512_deinterleave_index<3, 2>>(a, b, c);
+            }
+            SIMDEE_INL static void load(const scalar_t* ptr, T& v0, T& v1, T& v2, T& v3) {
+                auto p = reinterpret_cast<const float*>(ptr);
+                __m512 a = _mm512_loadu_ps(p), b = _mm512_loadu_ps(p + 16);
+                __m512 c = _mm512_loadu_ps(p + 32), d = _mm512_loadu_ps(p + 48);
+                v0 = permute4<avx512_deinterleave_index<4, 0>>(a, b, c, d);
+                v1 = permute4<avx512_deinterleave_index<4, 1>>(a, b, c, d);
+                v2 = permute4<avx512_deinterleave_index<4, 2>>(a, b, c, d);
+                v3 = permute4<avx512_deinterleave_index<4, 3>>(a, b, c, d);
+            }
+            SIMDEE_INL static void store(scalar_t* ptr, const T& v0, const T& v1) {
+                auto p = reinterpret_cast<float*>(ptr);
+                __m512 a = v0.data(), b = v1.data();
+                _mm512_storeu_ps(p, _mm512_permutex2var_ps(
+                                        a, avx512_index<avx512_interleave_index<2, 0>>(), b));
+                _mm512_storeu_ps(p + 16, _mm512_permutex2var_ps(
+                                             a, avx512_index<avx512_interleave_index<2, 1>>(), b));
+            }
+            SIMDEE_INL static void store(scalar_t* ptr, const T& v0, const T& v1, const T& v2) {
+                auto p = reinterpret_cast<float*>(ptr);
+                __m512 a = v0.data(), b = v1.data(), c = v2.data();
+                _mm512_storeu_ps(p, permute3<avx512_interleave_index<3, 0>>(a, b, c));
+                _mm512_storeu_ps(p + 16, permute3<avx512_interleave_index<3, 1>>(a, b, c));
+                _mm512_storeu_ps(p + 32, permute3<avx512_interleave_index<3, 2>>(a, b, c));
+            }
+            SIMDEE_INL static void store(scalar_t* ptr, const T& v0, const T& v1, const T& v2,
+                                         const T& v3) {
+                auto p = reinterpret_cast<float*>(ptr);
+                __m512 a = v0.data(), b = v1.data(), c = v2.data(), d = v3.data();
+                _mm512_storeu_ps(p, permute4<avx512_interleave_index<4, 0>>(a, b, c, d));
+                _mm512_storeu_ps(p + 16, permute4<avx512_interleave_index<4, 1>>(a, b, c, d));
+                _mm512_storeu_ps(p + 32, permute4<avx512_interleave_index<4, 2>>(a, b, c, d));
+                _mm512_storeu_ps(p + 48, permute4<avx512_interleave_index<4, 3>>(a, b, c, d));
+            }
+
+        private:
+            template <typename F>
+            SIMDEE_INL static __m512 permute3(__m512 a, __m512 b, __m512 c) {
+                __m512i idx = avx512_index<F>();
+                __m512 ab = _mm512_permutex2var_ps(a, idx, b);
+                return _mm512_mask_permutexvar_ps(ab, avx512_kmask(F::upper()), idx, c);
+            }
+            template <typename F>
+            SIMDEE_INL static __m512 permute4(__m512 a, __m512 b, __m512 c, __m512 d) {
+                __m512i idx = avx512_index<F>();
+                __m512 ab = _mm512_permutex2var_ps(a, idx, b);
+                __m512 cd = _mm512_permutex2var_ps(c, idx, d);
+                return _mm512_mask_mov_ps(ab, avx512_kmask(F::upper()), cd);
+            }
+        };
+
+        template <>
+        struct interleave<avx512f> : avx512_interleave<avx512f> {};
+
+        template <>
+        struct interleave<avx512u> : avx512_interleave<avx512u> {};
+
+        template <>
+        struct interleave<avx512s> : avx512_interleave<avx512s> {};
+
+        // transposes the 4x4 matrices in each 128-bit lane of a, b, c, d
+        SIMDEE_INL void avx512_transpose_lanes(__m512& a, __m512& b, __m512& c, __m512& d) {
+            __m512 ab_lo = _mm512_unpacklo_ps(a, b), cd_lo = _mm512_unpacklo_ps(c, d);
+            __m512 ab_hi = _mm512_unpackhi_ps(a, b), cd_hi = _mm512_unpackhi_ps(c, d);
+            a = _mm512_shuffle_ps(ab_lo, cd_lo, _MM_SHUFFLE(1, 0, 1, 0));
+            b = _mm512_shuffle_ps(ab_lo, cd_lo, _MM_SHUFFLE(3, 2, 3, 2));
+            c = _mm512_shuffle_ps(ab_hi, cd_hi, _MM_SHUFFLE(1, 0, 1, 0));
+            d = _mm512_shuffle_ps(ab_hi, cd_hi, _MM_SHUFFLE(3, 2, 3, 2));
+        }
+
+        // transposes the 4x4 matrix of 128-bit lanes in a, b, c, d
+        SIMDEE_INL void avx512_transpose_chunks(__m512& a, __m512& b, __m512& c, __m512& d) {
+            __m512 ab_lo = _mm512_shuffle_f32x4(a, b, _MM_SHUFFLE(1, 0, 1, 0));
+            __m512 ab_hi = _mm512_shuffle_f32x4(a, b, _MM_SHUFFLE(3, 2, 3, 2));
+            __m512 cd_lo = _mm512_shuffle_f32x4(c, d, _MM_SHUFFLE(1, 0, 1, 0));
+            __m512 cd_hi = _mm512_shuffle_f32x4(c, d, _MM_SHUFFLE(3, 2, 3, 2));
+            a = _mm512_shuffle_f32x4(ab_lo, cd_lo, _MM_SHUFFLE(2, 0, 2, 0));
+            b = _mm512_shuffle_f32x4(ab_lo, cd_lo, _MM_SHUFFLE(3, 1, 3, 1));
+            c = _mm512_shuffle_f32x4(ab_hi, cd_hi, _MM_SHUFFLE(2, 0, 2, 0));
+            d = _mm512_shuffle_f32x4(ab_hi, cd_hi, _MM_SHUFFLE(3, 1, 3, 1));
+        }
+
+        // the 16x16 matrix is transposed as 4x4 blocks within the lanes, then the lanes are
+        // transposed between the blocks
+        template <typename T>
+        struct avx512_transposition {
+            SIMDEE_INL static void apply(T* rows) {
+                __m512 m[16];
+                for (int i = 0; i < 16; ++i) m[i] = rows[i].data();
+                for (int g = 0; g < 16; g += 4) {
+                    avx512_transpose_lanes(m[g], m[g + 1], m[g + 2], m[g + 3]);
+                }
+                for (int k = 0; k < 4; ++k) {
+                    avx512_transpose_chunks(m[k], m[k + 4], m[k + 8], m[k + 12]);
+                    for (int l = 0; l < 4; ++l) rows[4 * l + k] = m[k + 4 * l];
+                }
+            }
+        };
+
+        template <>
+        struct transposition<avx512f> : avx512_transposition<avx512f> {};
+
+        template <>
+        struct transposition<avx512u> : avx512_transposition<avx512u> {};
+
+        template <>
+        struct transposition<avx512s> : avx512_transposition<avx512s> {};
+
+        // the 8x8 matrix is transposed as 2x2 blocks within the lanes, then as with 32-bit scalars
+        template <typename T>
+        struct avx512_64_transposition {
+            SIMDEE_INL static void apply(T* rows) {
+                __m512 lo[4], hi[4];
+                for (int p = 0; p < 4; ++p) {
+                    __m512d a = rows[2 * p].data(), b = rows[2 * p + 1].data();
+                    lo[p] = _mm512_castpd_ps(_mm512_unpacklo_pd(a, b));
+                    hi[p] = _mm512_castpd_ps(_mm512_unpackhi_pd(a, b));
+                }
+                avx512_transpose_chunks(lo[0], lo[1], lo[2], lo[3]);
+                avx512_transpose_chunks(hi[0], hi[1], hi[2], hi[3]);
+                for (int l = 0; l < 4; ++l) {
+                    rows[2 * l] = _mm512_castps_pd(lo[l]);
+                    rows[2 * l + 1] = _mm512_castps_pd(hi[l]);
+                }
+            }
+        };
+
+        template <>
+        struct transposition<avx512d> : avx512_64_transposition<avx512d> {};
+
+        template <>
+        struct transposition<avx512u64> : avx512_64_transposition<avx512u64> {};
+
+        template <>
+        struct transposition<avx512s64> : avx512_64_transposition<avx512s64> {};
+
+    } // namespace impl
+
+    // stream compaction; the compressed vector is stored as a whole, which is faster than the
+    // masked store of vcompressps on most implementations
+    namespace impl {
+
+        template <typename T>
+        struct avx512_compression {
+            using scalar_t = typename simd_vector_traits<T>::scalar_t;
+            using vec_b = typename simd_vector_traits<T>::vec_b;
+
+            SIMDEE_INL static std::size_t compress_store(scalar_t* ptr, const T& v,
+                                                         const vec_b& pred) {
+                _mm512_storeu_ps(reinterpret_cast<float*>(ptr),
+                                 _mm512_maskz_compress_ps(pred.data(), v.data()));
+                return detail::popcount(pred.data());
+            }
+            SIMDEE_INL static T expand_load(const scalar_t* ptr, const vec_b& pred) {
+                return _mm512_maskz_expandloadu_ps(pred.data(), ptr);
+            }
+        };
+
+        template <>
+        struct compression<avx512f> : avx512_compression<avx512f> {};
+
+        template <>
+        struct compression<avx512u> : avx512_compression<avx512u> {};
+
+        template <>
+        struct compression<avx512s> : avx512_compression<avx512s> {};
+
+        template <typename T>
+        struct avx512_64_compression {
+            using scalar_t = typename simd_vector_traits<T>::scalar_t;
+            using vec_b = typename simd_vector_traits<T>::vec_b;
+
+            SIMDEE_INL static std::size_t compress_store(scalar_t* ptr, const T& v,
+                                                         const vec_b& pred) {
+                _mm512_storeu_pd(reinterpret_cast<double*>(ptr),
+                                 _mm512_maskz_compress_pd(pred.data(), v.data()));
+                return detail::popcount(pred.data());
+            }
+            SIMDEE_INL static T expand_load(const scalar_t* ptr, const vec_b& pred) {
+                return _mm512_maskz_expandloadu_pd(pred.data(), ptr);
+            }
+        };
+
+        template <>
+        struct compression<avx512d> : avx512_64_compression<avx512d> {};
+
+        template <>
+        struct compression<avx512u64> : avx512_64_compression<avx512u64> {};
+
+        template <>
+        struct compression<avx512s64> : avx512_64_compression<avx512s64> {};
+
+    } // namespace impl
+
+    // shuffles and permutes; shuffles within the 128-bit lanes and blends take an immediate or a
+    // mask, the rest is a single vpermps or vpermt2ps with an index vector
+    namespace impl {
+
+        // the lanes of L as a vector of 64-bit indices
+        template <typename L>
+        SIMDEE_INL __m512i avx512_index64() {
+            return _mm512_set_epi64(L::lane(7), L::lane(6), L::lane(5), L::lane(4), L::lane(3),
+                                    L::lane(2), L::lane(1), L::lane(0));
+        }
+
+        template <typename T>
+        struct avx512_shuffling {
+            using vec_s = typename simd_vector_traits<T>::vec_s;
+
+            template <int... Idx>
+            SIMDEE_INL static T apply(const T& v) {
+                using L = lane_list<Idx...>;
+                constexpr int imm = L::imm(2, 4, 0, 4);
+                __m512 x = v.data();
+                if (L::blend(16)) return v;
+                if (L::within(4, 16) && L::repeats(4, 16)) return _mm512_permute_ps(x, imm);
+                return _mm512_permutexvar_ps(avx512_index<L>(), x);
+            }
+            template <int... Idx>
+            SIMDEE_INL static T apply(const T& a, const T& b) {
+                using L = lane_list<Idx...>;
+                constexpr int imm = L::imm(2, 4, 0, 4);
+                __m512 x = a.data(), y = b.data();
+                if (L::from(0, 16, 0, 16)) return apply<Idx...>(a);
+                if (L::from(1, 16, 0, 16)) return apply<(Idx & 15)...>(b);
+                if (L::blend(16)) return _mm512_mask_blend_ps(__mmask16(L::upper(16)), x, y);
+                // in each 128-bit lane, two scalars of one vector followed by two of the other one
+                if (L::within(4, 16) && L::repeats(4, 16)) {
+                    if (L::from(0, 16, 0, 2) && L::from(1, 16, 2, 4)) {
+                        return _mm512_shuffle_ps(x, y, imm);
+                    }
+                    if (L::from(1, 16, 0, 2) && L::from(0, 16, 2, 4)) {
+                        return _mm512_shuffle_ps(y, x, imm);
+                    }
+                }
+                return _mm512_permutex2var_ps(x, avx512_index<L>(), y);
+            }
+            SIMDEE_INL static T permute(const T& v, const vec_s& idx) {
+                return _mm512_permutexvar_ps(_mm512_castps_si512(idx.data()), v.data());
+            }
+        };
+
+        template <>
+        struct shuffling<avx512f> : avx512_shuffling<avx512f> {};
+
+        template <>
+        struct shuffling<avx512u> : avx512_shuffling<avx512u> {};
+
+        template <>
+        struct shuffling<avx512s> : avx512_shuffling<avx512s> {};
+
+        template <typename T>
+        struct avx512_64_shuffling {
+            using vec_s = typename simd_vector_traits<T>::vec_s;
+
+            template <int... Idx>
+            SIMDEE_INL static T apply(const T& v) {
+                using L = lane_list<Idx...>;
+                constexpr int imm = L::imm(1, 2, 0, 8);
+                constexpr int quads = L::imm(2, 4, 0, 4);
+                __m512d x = v.data();
+                if (L::blend(8)) return v;
+                if (L::within(2, 8)) return _mm512_permute_pd(x, imm);
+                if (L::within(4, 8) && L::repeats(4, 8)) return _mm512_permutex_pd(x, quads);
+                return _mm512_permutexvar_pd(avx512_index64<L>(), x);
+            }
+            template <int... Idx>
+            SIMDEE_INL static T apply(const T& a, const T& b) {
+                using L = lane_list<Idx...>;
+                constexpr int imm = L::imm(1, 2, 0, 8);
+                __m512d x = a.data(), y = b.data();
+                if (L::from(0, 8, 0, 8)) return apply<Idx...>(a);
+                if (L::from(1, 8, 0, 8)) return apply<(Idx & 7)...>(b);
+                if (L::blend(8)) return _mm512_mask_blend_pd(__mmask8(L::upper(8)), x, y);
+                // in each 128-bit lane, a scalar of one vector followed by a scalar of the other
+                if (L::within(2, 8)) {
+                    if (L::from(0, 8, 0, 8, 2) && L::from(1, 8, 1, 8, 2)) {
+                        return _mm512_shuffle_pd(x, y, imm);
+                    }
+                    if (L::from(1, 8, 0, 8, 2) && L::from(0, 8, 1, 8, 2)) {
+                        return _mm512_shuffle_pd(y, x, imm);
+                    }
+                }
+                return _mm512_permutex2var_pd(x, avx512_index64<L>(), y);
+            }
+            SIMDEE_INL static T permute(const T& v, const vec_s& idx) {
+                return _mm512_permutexvar_pd(_mm512_castpd_si512(idx.data()), v.data());
+            }
+        };
+
+        template <>
+        struct shuffling<avx512d> : avx512_64_shuffling<avx512d> {};
+
+        template <>
+        struct shuffling<avx512u64> : avx512_64_shuffling<avx512u64> {};
+
+        template <>
+        struct shuffling<avx512s64> : avx512_64_shuffling<avx512s64> {};
+
+    } // namespace impl
+
+    // horizontal operations; the upper 256-bit half is folded onto the lower one, which continues as
+    // an AVX vector
+    namespace impl {
+
+        SIMDEE_INL __m256 avx512_lower(const __m512& v) { return _mm512_castps512_ps256(v); }
+        SIMDEE_INL __m256 avx512_upper(const __m512& v) { return _mm512_extractf32x8_ps(v, 1); }
+        SIMDEE_INL __m256d avx512_lower(const __m512d& v) { return _mm512_castpd512_pd256(v); }
+        SIMDEE_INL __m256d avx512_upper(const __m512d& v) { return _mm512_extractf64x4_pd(v, 1); }
+
+        template <typename T, typename Half>
+        struct avx512_horizontal {
+            using scalar_t = typename simd_vector_traits<T>::scalar_t;
+
+            template <typename Op_t>
+            SIMDEE_INL static scalar_t apply(const T& v, Op_t f) {
+                Half x = f(Half(avx512_lower(v.data())), Half(avx512_upper(v.data())));
+                return horizontal<Half>::apply(x, f);
+            }
+        };
+
+        template <>
+        struct horizontal<avx512f> : avx512_horizontal<avx512f, avxf> {};
+
+        template <>
+        struct horizontal<avx512u> : avx512_horizontal<avx512u, avxu> {};
+
+        template <>
+        struct horizontal<avx512s> : avx512_horizontal<avx512s, avxs> {};
+
+        template <>
+        struct horizontal<avx512d> : avx512_horizontal<avx512d, avxd> {};
+
+        template <>
+        struct horizontal<avx512u64> : avx512_horizontal<avx512u64, avxu64> {};
+
+        template <>
+        struct horizontal<avx512s64> : avx512_horizontal<avx512s64, avxs64> {};
+
+    } // namespace impl
+
+    // prefix sums; valignd and valignq shift across the whole vector
+    namespace impl {
+
+        // v shifted up by Lanes scalars, zeros shifted in
+        template <int Lanes>
+        SIMDEE_INL __m512 avx512_shift_up(const __m512& v) {
+            constexpr int count = 16 - Lanes;
+            return _mm512_castsi512_ps(
+                _mm512_alignr_epi32(_mm512_castps_si512(v), _mm512_setzero_si512(), count));
+        }
+        template <int Lanes>
+        SIMDEE_INL __m512d avx512_shift_up(const __m512d& v) {
+            constexpr int count = 8 - Lanes;
+            return _mm512_castsi512_pd(
+                _mm512_alignr_epi64(_mm512_castpd_si512(v), _mm512_setzero_si512(), count));
+        }
+
+        template <typename T>
+        struct avx512_scanning {
+            SIMDEE_INL static T inclusive(const T& v) {
+                T x = v + T(avx512_shift_up<1>(v.data()));
+                x = x + T(avx512_shift_up<2>(x.data()));
+                x = x + T(avx512_shift_up<4>(x.data()));
+                return x + T(avx512_shift_up<8>(x.data()));
+            }
+            SIMDEE_INL static T exclusive(const T& v) {
+                return inclusive(T(avx512_shift_up<1>(v.data())));
+            }
+        };
+
+        template <typename T>
+        struct avx512_64_scanning {
+            SIMDEE_INL static T inclusive(const T& v) {
+                T x = v + T(avx512_shift_up<1>(v.data()));
+                x = x + T(avx512_shift_up<2>(x.data()));
+                return x + T(avx512_shift_up<4>(x.data()));
+            }
+            SIMDEE_INL static T exclusive(const T& v) {
+                return inclusive(T(avx512_shift_up<1>(v.data())));
+            }
+        };
+
+        template <>
+        struct scanning<avx512f> : avx512_scanning<avx512f> {};
+
+        template <>
+        struct scanning<avx512u> : avx512_scanning<avx512u> {};
+
+        template <>
+        struct scanning<avx512s> : avx512_scanning<avx512s> {};
+
+        template <>
+        struct scanning<avx512d> : avx512_64_scanning<avx512d> {};
+
+        template <>
+        struct scanning<avx512u64> : avx512_64_scanning<avx512u64> {};
+
+        template <>
+        struct scanning<avx512s64> : avx512_64_scanning<avx512s64> {};
+
+    } // namespace impl
+
+    // fused multiply-add
+    namespace impl {
+
+        template <>
+        struct fused<avx512f> {
+            using native = std::true_type;
+
+            SIMDEE_INL static avx512f fma(const avx512f& a, const avx512f& b, const avx512f& c) {
+                return _mm512_fmadd_ps(a.data(), b.data(), c.data());
+            }
+            SIMDEE_INL static avx512f fms(const avx512f& a, const avx512f& b, const avx512f& c) {
+                return _mm512_fmsub_ps(a.data(), b.data(), c.data());
+            }
+            SIMDEE_INL static avx512f fnma(const avx512f& a, const avx512f& b, const avx512f& c) {
+                return _mm512_fnmadd_ps(a.data(), b.data(), c.data());
+            }
+            SIMDEE_INL static avx512f fnms(const avx512f& a, const avx512f& b, const avx512f& c) {
+                return _mm512_fnmsub_ps(a.data(), b.data(), c.data());
+            }
+        };
+
+        template <>
+        struct fused<avx512d> {
+            using native = std::true_type;
+
+            SIMDEE_INL static avx512d fma(const avx512d& a, const avx512d& b, const avx512d& c) {
+                return _mm512_fmadd_pd(a.data(), b.data(), c.data());
+            }
+            SIMDEE_INL static avx512d fms(const avx512d& a, const avx512d& b, const avx512d& c) {
+                return _mm512_fmsub_pd(a.data(), b.data(), c.data());
+            }
+            SIMDEE_INL static avx512d fnma(const avx512d& a, const avx512d& b, const avx512d& c) {
+                return _mm512_fnmadd_pd(a.data(), b.data(), c.data());
+            }
+            SIMDEE_INL static avx512d fnms(const avx512d& a, const avx512d& b, const avx512d& c) {
+                return _mm512_fnmsub_pd(a.data(), b.data(), c.data());
+            }
+        };
+
+    } // namespace impl
+
+} // namespace sd
+
+#ifdef SIMDEE_AVX512_GATHER_DIAGNOSTIC_PUSHED
+#pragma GCC diagnostic pop
+#undef SIMDEE_AVX512_GATHER_DIAGNOSTIC_PUSHED
+#endif
+
+#ifdef SIMDEE_AVX512_DIAGNOSTIC_PUSHED
+#pragma GCC diagnostic pop
+#undef SIMDEE_AVX512_DIAGNOSTIC_PUSHED
+#endif
+
+#endif // SIMDEE_SIMD_TYPES_AVX512_HPP
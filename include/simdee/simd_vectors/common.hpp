@@ -10,9 +10,12 @@
 #include "../common/init.hpp"
 #include "../common/mask.hpp"
 #include "../common/storage.hpp"
+#include "../util/cache.hpp"
 #include "../util/inline.hpp"
 #include "../util/macros.hpp"
+#include <algorithm>
 #include <array>
+#include <cstddef>
 #include <type_traits>
 
 namespace sd {
@@ -22,6 +25,18 @@ namespace sd {
     template <typename T>
     struct simd_vector_traits;
 
+    namespace impl {
+        template <typename Traits, typename Enable = void>
+        struct simd_width
+            : std::integral_constant<std::size_t, sizeof(typename Traits::vector_t) /
+                                                      sizeof(typename Traits::scalar_t)> {};
+
+        // traits may override the width deduced from vector_t, e.g. for bit mask vectors
+        template <typename Traits>
+        struct simd_width<Traits, typename std::enable_if<(Traits::width > 0)>::type>
+            : std::integral_constant<std::size_t, Traits::width> {};
+    } // namespace impl
+
     template <typename Crtp>
     struct simd_base {
         using traits_t = simd_vector_traits<Crtp>;
@@ -34,7 +49,7 @@ namespace sd {
         using mask_t = typename traits_t::mask_t;
         using storage_t = typename traits_t::storage_t;
 
-        enum : std::size_t { width = sizeof(vector_t) / sizeof(scalar_t) };
+        enum : std::size_t { width = impl::simd_width<traits_t>::value };
 
         SIMDEE_INL Crtp& self() { return static_cast<Crtp&>(*this); }
 
@@ -44,8 +59,8 @@ namespace sd {
 
         SIMDEE_INL constexpr const Crtp& eval() const { return static_cast<const Crtp&>(*this); }
 
-        vector_t& data() { return mm; }
-        const vector_t& data() const { return mm; }
+        SIMDEE_INL vector_t& data() { return mm; }
+        SIMDEE_INL const vector_t& data() const { return mm; }
 
     protected:
         // data
@@ -100,6 +115,752 @@ namespace sd {
         return all(mask(l.self()));
     }
 
+    namespace impl {
+        // masked loads and stores through a temporary buffer, for targets without native support;
+        // memory outside of the selected scalars is never accessed, unselected lanes load as zero
+        template <typename T>
+        struct masked_emulation {
+            using scalar_t = typename simd_vector_traits<T>::scalar_t;
+            using storage_t = typename simd_vector_traits<T>::storage_t;
+            using vec_b = typename simd_vector_traits<T>::vec_b;
+
+            static SIMDEE_INL T load(const scalar_t* ptr, std::size_t count) {
+                storage_t buf;
+                buf.fill(scalar_t());
+                std::copy(ptr, ptr + std::min<std::size_t>(count, T::width), buf.begin());
+                return T(buf);
+            }
+            static SIMDEE_INL T load(const scalar_t* ptr, const vec_b& pred) {
+                storage_t buf;
+                typename vec_b::storage_t sel(pred);
+                for (std::size_t i = 0; i < T::width; ++i) buf[i] = sel[i] ? ptr[i] : scalar_t();
+                return T(buf);
+            }
+            static SIMDEE_INL void store(const T& v, scalar_t* ptr, std::size_t count) {
+                storage_t buf(v);
+                std::copy(buf.begin(), buf.begin() + std::min<std::size_t>(count, T::width), ptr);
+            }
+            static SIMDEE_INL void store(const T& v, scalar_t* ptr, const vec_b& pred) {
+                storage_t buf(v);
+                typename vec_b::storage_t sel(pred);
+                for (std::size_t i = 0; i < T::width; ++i) {
+                    if (sel[i]) ptr[i] = buf[i];
+                }
+            }
+        };
+
+        // gathers and scatters one scalar at a time, for targets without native support; scatters
+        // write the lanes in order, so the last of several lanes with equal indices is stored
+        template <typename T>
+        struct gather_emulation {
+            using scalar_t = typename simd_vector_traits<T>::scalar_t;
+            using storage_t = typename simd_vector_traits<T>::storage_t;
+            using vec_b = typename simd_vector_traits<T>::vec_b;
+            using vec_s = typename simd_vector_traits<T>::vec_s;
+
+            static SIMDEE_INL T gather(const scalar_t* base, const vec_s& idx) {
+                storage_t buf;
+                typename vec_s::storage_t at(idx);
+                for (std::size_t i = 0; i < T::width; ++i) buf[i] = base[at[i]];
+                return T(buf);
+            }
+            static SIMDEE_INL T gather(const scalar_t* base, const vec_s& idx, const vec_b& pred) {
+                storage_t buf;
+                typename vec_s::storage_t at(idx);
+                typename vec_b::storage_t sel(pred);
+                for (std::size_t i = 0; i < T::width; ++i) {
+                    buf[i] = sel[i] ? base[at[i]] : scalar_t();
+                }
+                return T(buf);
+            }
+            static SIMDEE_INL void scatter(const T& v, scalar_t* base, const vec_s& idx) {
+                storage_t buf(v);
+                typename vec_s::storage_t at(idx);
+                for (std::size_t i = 0; i < T::width; ++i) base[at[i]] = buf[i];
+            }
+            static SIMDEE_INL void scatter(const T& v, scalar_t* base, const vec_s& idx,
+                                           const vec_b& pred) {
+                storage_t buf(v);
+                typename vec_s::storage_t at(idx);
+                typename vec_b::storage_t sel(pred);
+                for (std::size_t i = 0; i < T::width; ++i) {
+                    if (sel[i]) base[at[i]] = buf[i];
+                }
+            }
+        };
+
+        // shifts by a different count in each lane, one scalar at a time, for targets without
+        // per-lane shift instructions; right shifts of signed scalars are arithmetic
+        template <typename T>
+        struct shift_emulation {
+            using scalar_t = typename simd_vector_traits<T>::scalar_t;
+            using storage_t = typename simd_vector_traits<T>::storage_t;
+            using uint_t = select_uint_t<sizeof(scalar_t)>;
+
+            static SIMDEE_INL T shl(const T& l, const T& r) {
+                storage_t buf(l), by(r);
+                for (std::size_t i = 0; i < T::width; ++i) {
+                    buf[i] = scalar_t(uint_t(buf[i]) << by[i]);
+                }
+                return T(buf);
+            }
+            static SIMDEE_INL T shr(const T& l, const T& r) {
+                storage_t buf(l), by(r);
+                for (std::size_t i = 0; i < T::width; ++i) buf[i] = scalar_t(buf[i] >> by[i]);
+                return T(buf);
+            }
+        };
+
+        // the vector related to Simd_t that holds scalars of type Scalar_t
+        template <typename Simd_t, typename Scalar_t>
+        struct related_vector {
+            using traits_t = simd_vector_traits<Simd_t>;
+            template <typename T>
+            using holds = std::is_same<typename simd_vector_traits<T>::scalar_t, Scalar_t>;
+
+            using type = typename std::conditional<
+                holds<typename traits_t::vec_f>::value, typename traits_t::vec_f,
+                typename std::conditional<
+                    holds<typename traits_t::vec_u>::value, typename traits_t::vec_u,
+                    typename std::conditional<holds<typename traits_t::vec_s>::value,
+                                              typename traits_t::vec_s,
+                                              typename traits_t::vec_b>::type>::type>::type;
+            static_assert(holds<type>::value, "no related vector holds the scalar type");
+        };
+
+        template <typename Idx_t, typename Scalar_t>
+        struct gather_result : related_vector<Idx_t, Scalar_t> {
+            static_assert(std::is_same<Idx_t, typename simd_vector_traits<Idx_t>::vec_s>::value,
+                          "gather indices must be a signed integer vector");
+        };
+
+        template <typename Pred_t, typename Scalar_t>
+        struct expand_result : related_vector<Pred_t, Scalar_t> {
+            static_assert(std::is_same<Pred_t, typename simd_vector_traits<Pred_t>::vec_b>::value,
+                          "expand_load() predicate must be a bool vector");
+        };
+
+        // loads and stores of N interleaved vectors, where ptr[i * N + j] is the i-th scalar of the
+        // j-th vector; specialized by backends that can shuffle, this fallback copies one scalar at
+        // a time through temporary buffers
+        template <typename T>
+        struct interleave {
+            using scalar_t = typename simd_vector_traits<T>::scalar_t;
+            using storage_t = typename simd_vector_traits<T>::storage_t;
+
+            static SIMDEE_INL void load(const scalar_t* ptr, T& v0, T& v1) {
+                load_strided<2>(ptr + 0, v0);
+                load_strided<2>(ptr + 1, v1);
+            }
+            static SIMDEE_INL void load(const scalar_t* ptr, T& v0, T& v1, T& v2) {
+                load_strided<3>(ptr + 0, v0);
+                load_strided<3>(ptr + 1, v1);
+                load_strided<3>(ptr + 2, v2);
+            }
+            static SIMDEE_INL void load(const scalar_t* ptr, T& v0, T& v1, T& v2, T& v3) {
+                load_strided<4>(ptr + 0, v0);
+                load_strided<4>(ptr + 1, v1);
+                load_strided<4>(ptr + 2, v2);
+                load_strided<4>(ptr + 3, v3);
+            }
+            static SIMDEE_INL void store(scalar_t* ptr, const T& v0, const T& v1) {
+                store_strided<2>(ptr + 0, v0);
+                store_strided<2>(ptr + 1, v1);
+            }
+            static SIMDEE_INL void store(scalar_t* ptr, const T& v0, const T& v1, const T& v2) {
+                store_strided<3>(ptr + 0, v0);
+                store_strided<3>(ptr + 1, v1);
+                store_strided<3>(ptr + 2, v2);
+            }
+            static SIMDEE_INL void store(scalar_t* ptr, const T& v0, const T& v1, const T& v2,
+                                         const T& v3) {
+                store_strided<4>(ptr + 0, v0);
+                store_strided<4>(ptr + 1, v1);
+                store_strided<4>(ptr + 2, v2);
+                store_strided<4>(ptr + 3, v3);
+            }
+
+        private:
+            template <std::size_t Stride>
+            static SIMDEE_INL void load_strided(const scalar_t* ptr, T& v) {
+                storage_t buf;
+                for (std::size_t i = 0; i < T::width; ++i) buf[i] = ptr[i * Stride];
+                v = T(buf);
+            }
+            template <std::size_t Stride>
+            static SIMDEE_INL void store_strided(scalar_t* ptr, const T& v) {
+                storage_t buf(v);
+                for (std::size_t i = 0; i < T::width; ++i) ptr[i * Stride] = buf[i];
+            }
+        };
+
+        // in-place transposition of the width x width matrix whose rows are rows[0], rows[1], ...;
+        // specialized by backends that can shuffle, this fallback goes through a temporary matrix
+        template <typename T>
+        struct transposition {
+            using storage_t = typename simd_vector_traits<T>::storage_t;
+
+            static SIMDEE_INL void apply(T* rows) {
+                storage_t buf[T::width];
+                for (std::size_t i = 0; i < T::width; ++i) buf[i] = rows[i];
+                for (std::size_t i = 0; i < T::width; ++i) {
+                    storage_t col;
+                    for (std::size_t j = 0; j < T::width; ++j) col[j] = buf[j][i];
+                    rows[i] = T(col);
+                }
+            }
+        };
+
+        // stream compaction: compress_store() stores the scalars selected by pred to ptr[0],
+        // ptr[1], ... and returns their number, expand_load() is the inverse; specialized by
+        // backends that can permute, this fallback goes one scalar at a time through temporary
+        // buffers, without branches on pred
+        template <typename T>
+        struct compression {
+            using scalar_t = typename simd_vector_traits<T>::scalar_t;
+            using storage_t = typename simd_vector_traits<T>::storage_t;
+            using vec_b = typename simd_vector_traits<T>::vec_b;
+
+            static SIMDEE_INL std::size_t compress_store(scalar_t* ptr, const T& v,
+                                                         const vec_b& pred) {
+                storage_t buf(v);
+                typename vec_b::storage_t sel(pred);
+                std::size_t count = 0;
+                for (std::size_t i = 0; i < T::width; ++i) {
+                    ptr[count] = buf[i];
+                    count += sel[i] ? 1U : 0U;
+                }
+                return count;
+            }
+            static SIMDEE_INL T expand_load(const scalar_t* ptr, const vec_b& pred) {
+                storage_t buf;
+                typename vec_b::storage_t sel(pred);
+                std::size_t count = 0;
+                for (std::size_t i = 0; i < T::width; ++i) {
+                    buf[i] = sel[i] ? ptr[count] : scalar_t();
+                    count += sel[i] ? 1U : 0U;
+                }
+                return T(buf);
+            }
+        };
+
+        // the i-th of the lane indices that follow i
+        constexpr int lane_at(int) { return 0; }
+        template <typename... Rest>
+        constexpr int lane_at(int i, int first, Rest... rest) {
+            return i == 0 ? first : lane_at(i - 1, rest...);
+        }
+
+        // the lane indices of a shuffle known at compile time: the i-th scalar of the result is
+        // taken from the lane Idx[i]; when shuffling two vectors of width w, lanes w to 2 * w - 1
+        // belong to the second one. Backends choose the instructions by the queries below, which
+        // are all constant expressions
+        template <int... Idx>
+        struct lane_list {
+            enum : int { size = sizeof...(Idx) };
+
+            static constexpr int lane(int i) { return lane_at(i, Idx...); }
+
+            // all lanes are in [0, limit)
+            static constexpr bool below(int limit, int i = 0) {
+                return i == size || (lane(i) >= 0 && lane(i) < limit && below(limit, i + 1));
+            }
+            // the i-th scalar is taken from the i-th lane of either vector (of width w)
+            static constexpr bool blend(int w, int i = 0) {
+                return i == size || (lane(i) % w == i && blend(w, i + 1));
+            }
+            // all lanes are equal
+            static constexpr bool splat(int i = 0) {
+                return i == size || (lane(i) == lane(0) && splat(i + 1));
+            }
+            // the scalars first, first + step, ... up to last are taken from the vector src
+            static constexpr bool from(int src, int w, int first, int last, int step = 1) {
+                return first >= last ||
+                       (lane(first) / w == src && from(src, w, first + step, last, step));
+            }
+            // each scalar is taken from the block of n lanes that it is in
+            static constexpr bool within(int n, int w, int i = 0) {
+                return i == size || ((lane(i) % w) / n == i / n && within(n, w, i + 1));
+            }
+            // each block of n scalars is shuffled like the first one
+            static constexpr bool repeats(int n, int w, int i = 0) {
+                return i == size || (lane(i) % n == lane(i % n) % n &&
+                                     lane(i) / w == lane(i % n) / w && repeats(n, w, i + 1));
+            }
+            // whole blocks of n lanes are moved
+            static constexpr bool blocks(int n, int i = 0) {
+                return i == size || (lane(i) % n == i % n &&
+                                     lane(i) / n == lane(i - i % n) / n && blocks(n, i + 1));
+            }
+            // the scalars are consecutive lanes, wrapping around at lane mod
+            static constexpr bool consecutive(int mod, int i = 0) {
+                return i == size || (lane(i) == (lane(0) + i) % mod && consecutive(mod, i + 1));
+            }
+            // the lanes first to first + count - 1, modulo mod, packed into fields of bits bits
+            static constexpr int imm(int bits, int mod, int first, int count) {
+                return count == 0
+                           ? 0
+                           : (lane(first) % mod) | imm(bits, mod, first + 1, count - 1) << bits;
+            }
+            // the bits of the scalars taken from the second vector (of width w)
+            static constexpr int upper(int w, int i = 0) {
+                return i == size ? 0 : (lane(i) >= w ? 1 << i : 0) | upper(w, i + 1);
+            }
+            // the bits of the scalars taken from another block of n lanes than the one they are in
+            static constexpr int crossing(int n, int w, int i = 0) {
+                return i == size ? 0
+                                 : ((lane(i) % w) / n != i / n ? 1 << i : 0) |
+                                       crossing(n, w, i + 1);
+            }
+        };
+
+        // lane_list<0, 1, ..., N - 1>
+        template <int N, int... Idx>
+        struct iota_lanes : iota_lanes<N - 1, N - 1, Idx...> {};
+        template <int... Idx>
+        struct iota_lanes<0, Idx...> {
+            using type = lane_list<Idx...>;
+        };
+
+        // shuffles and permutes through temporary buffers, for targets without suitable
+        // instructions
+        template <typename T>
+        struct shuffle_emulation {
+            using storage_t = typename simd_vector_traits<T>::storage_t;
+            using vec_s = typename simd_vector_traits<T>::vec_s;
+
+            template <int... Idx>
+            static SIMDEE_INL T apply(const T& v) {
+                const int lanes[] = {Idx...};
+                const storage_t buf(v);
+                storage_t res;
+                for (std::size_t i = 0; i < T::width; ++i) res[i] = buf[std::size_t(lanes[i])];
+                return T(res);
+            }
+            template <int... Idx>
+            static SIMDEE_INL T apply(const T& a, const T& b) {
+                const int lanes[] = {Idx...};
+                const storage_t buf[2] = {storage_t(a), storage_t(b)};
+                storage_t res;
+                for (std::size_t i = 0; i < T::width; ++i) {
+                    auto at = std::size_t(lanes[i]);
+                    res[i] = buf[at / T::width][at % T::width];
+                }
+                return T(res);
+            }
+            static SIMDEE_INL T permute(const T& v, const vec_s& idx) {
+                const storage_t buf(v);
+                typename vec_s::storage_t at(idx);
+                storage_t res;
+                for (std::size_t i = 0; i < T::width; ++i) res[i] = buf[std::size_t(at[i])];
+                return T(res);
+            }
+        };
+
+        // shuffles with lanes known at compile time and permutes with lanes known at run time;
+        // specialized by backends, which pick the cheapest instructions for the given lanes
+        template <typename T>
+        struct shuffling : shuffle_emulation<T> {};
+
+        template <typename T>
+        struct scan_emulation {
+            using storage_t = typename simd_vector_traits<T>::storage_t;
+            using scalar_t = typename simd_vector_traits<T>::scalar_t;
+
+            static SIMDEE_INL T inclusive(const T& v) {
+                storage_t buf(v);
+                for (std::size_t i = 1; i < T::width; ++i) buf[i] = scalar_t(buf[i - 1] + buf[i]);
+                return T(buf);
+            }
+            static SIMDEE_INL T exclusive(const T& v) {
+                storage_t buf(v);
+                scalar_t sum = scalar_t(0);
+                for (std::size_t i = 0; i < T::width; ++i) {
+                    scalar_t next = scalar_t(sum + buf[i]);
+                    buf[i] = sum;
+                    sum = next;
+                }
+                return T(buf);
+            }
+        };
+
+        // prefix sums within a vector; specialized by backends, which add the vector shifted by 1,
+        // 2, 4, ... lanes to itself
+        template <typename T>
+        struct scanning : scan_emulation<T> {};
+
+        // a window of Width scalars starting at (16 - count) selects the first count lanes
+        template <typename Scalar_t>
+        SIMDEE_INL const Scalar_t* lane_mask_table() {
+            static const Scalar_t table[32] = {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                                               -1, -1, -1, -1, -1, 0,  0,  0,  0,  0,  0,
+                                               0,  0,  0,  0,  0,  0,  0,  0,  0,  0};
+            return table;
+        }
+
+        // the first count lanes (of Width) set to all ones, the rest to zero
+        template <std::size_t Width, typename Scalar_t>
+        SIMDEE_INL const Scalar_t* lane_mask(std::size_t count) {
+            return lane_mask_table<Scalar_t>() + 16 - std::min<std::size_t>(count, Width);
+        }
+
+        // the number of set bits in a 4-bit value, without relying on a popcount instruction
+        SIMDEE_INL uint32_t popcount4(uint32_t bits) {
+            return uint32_t(0x4332322132212110ULL >> (4 * bits)) & 0xfU;
+        }
+
+        // byte shuffle controls (pshufb, tbl) for four 32-bit lanes, four words per row; row sel
+        // moves the lanes selected by the bits of sel to the front, the remaining lanes are zeroed
+        SIMDEE_INL const uint32_t* compress4_table() {
+            alignas(16) static const uint32_t table[64] = {
+                0x80808080, 0x80808080, 0x80808080, 0x80808080, // ....
+                0x03020100, 0x80808080, 0x80808080, 0x80808080, // 0...
+                0x07060504, 0x80808080, 0x80808080, 0x80808080, // .1..
+                0x03020100, 0x07060504, 0x80808080, 0x80808080, // 01..
+                0x0b0a0908, 0x80808080, 0x80808080, 0x80808080, // ..2.
+                0x03020100, 0x0b0a0908, 0x80808080, 0x80808080, // 0.2.
+                0x07060504, 0x0b0a0908, 0x80808080, 0x80808080, // .12.
+                0x03020100, 0x07060504, 0x0b0a0908, 0x80808080, // 012.
+                0x0f0e0d0c, 0x80808080, 0x80808080, 0x80808080, // ...3
+                0x03020100, 0x0f0e0d0c, 0x80808080, 0x80808080, // 0..3
+                0x07060504, 0x0f0e0d0c, 0x80808080, 0x80808080, // .1.3
+                0x03020100, 0x07060504, 0x0f0e0d0c, 0x80808080, // 01.3
+                0x0b0a0908, 0x0f0e0d0c, 0x80808080, 0x80808080, // ..23
+                0x03020100, 0x0b0a0908, 0x0f0e0d0c, 0x80808080, // 0.23
+                0x07060504, 0x0b0a0908, 0x0f0e0d0c, 0x80808080, // .123
+                0x03020100, 0x07060504, 0x0b0a0908, 0x0f0e0d0c, // 0123
+            };
+            return table;
+        }
+
+        // the inverse of compress4_table(): row sel moves the front lanes to the lanes selected by
+        // the bits of sel, the remaining lanes are zeroed
+        SIMDEE_INL const uint32_t* expand4_table() {
+            alignas(16) static const uint32_t table[64] = {
+                0x80808080, 0x80808080, 0x80808080, 0x80808080, // ....
+                0x03020100, 0x80808080, 0x80808080, 0x80808080, // 0...
+                0x80808080, 0x03020100, 0x80808080, 0x80808080, // .1..
+                0x03020100, 0x07060504, 0x80808080, 0x80808080, // 01..
+                0x80808080, 0x80808080, 0x03020100, 0x80808080, // ..2.
+                0x03020100, 0x80808080, 0x07060504, 0x80808080, // 0.2.
+                0x80808080, 0x03020100, 0x07060504, 0x80808080, // .12.
+                0x03020100, 0x07060504, 0x0b0a0908, 0x80808080, // 012.
+                0x80808080, 0x80808080, 0x80808080, 0x03020100, // ...3
+                0x03020100, 0x80808080, 0x80808080, 0x07060504, // 0..3
+                0x80808080, 0x03020100, 0x80808080, 0x07060504, // .1.3
+                0x03020100, 0x07060504, 0x80808080, 0x0b0a0908, // 01.3
+                0x80808080, 0x80808080, 0x03020100, 0x07060504, // ..23
+                0x03020100, 0x80808080, 0x07060504, 0x0b0a0908, // 0.23
+                0x80808080, 0x03020100, 0x07060504, 0x0b0a0908, // .123
+                0x03020100, 0x07060504, 0x0b0a0908, 0x0f0e0d0c, // 0123
+            };
+            return table;
+        }
+    }
+
+    namespace impl {
+        // fused multiply-add, specialized by backends that support it natively; this fallback
+        // rounds the product and the sum separately
+        template <typename T>
+        struct fused {
+            using native = std::false_type; // true if the product is not rounded
+
+            static SIMDEE_INL T fma(const T& a, const T& b, const T& c) { return a * b + c; }
+            static SIMDEE_INL T fms(const T& a, const T& b, const T& c) { return a * b - c; }
+            static SIMDEE_INL T fnma(const T& a, const T& b, const T& c) { return c - a * b; }
+            static SIMDEE_INL T fnms(const T& a, const T& b, const T& c) { return -(a * b) - c; }
+        };
+    }
+
+    // loads base[idx[i]] into the i-th scalar of the result
+    template <typename Scalar_t, typename Idx_t>
+    SIMDEE_INL typename impl::gather_result<Idx_t, Scalar_t>::type
+    gather(const Scalar_t* base, const simd_base<Idx_t>& idx) {
+        typename impl::gather_result<Idx_t, Scalar_t>::type res;
+        res.gather(base, idx.self());
+        return res;
+    }
+
+    // loads base[idx[i]] into the scalars selected by pred, sets the rest to zero
+    template <typename Scalar_t, typename Idx_t>
+    SIMDEE_INL typename impl::gather_result<Idx_t, Scalar_t>::type
+    gather(const Scalar_t* base, const simd_base<Idx_t>& idx,
+           const typename simd_base<Idx_t>::vec_b& pred) {
+        typename impl::gather_result<Idx_t, Scalar_t>::type res;
+        res.gather(base, idx.self(), pred);
+        return res;
+    }
+
+    // stores the i-th scalar of values to base[idx[i]]
+    template <typename Simd_t>
+    SIMDEE_INL void scatter(typename simd_base<Simd_t>::scalar_t* base,
+                            const typename simd_base<Simd_t>::vec_s& idx,
+                            const simd_base<Simd_t>& values) {
+        values.self().scatter(base, idx);
+    }
+
+    // stores the scalars of values selected by pred to base[idx[i]]
+    template <typename Simd_t>
+    SIMDEE_INL void scatter(typename simd_base<Simd_t>::scalar_t* base,
+                            const typename simd_base<Simd_t>::vec_s& idx,
+                            const simd_base<Simd_t>& values,
+                            const typename simd_base<Simd_t>::vec_b& pred) {
+        values.self().scatter(base, idx, pred);
+    }
+
+    // loads N vectors from N * width interleaved scalars, e.g. v0 = {x0, x1, ...}, v1 = {y0, ...}
+    // from ptr = {x0, y0, x1, y1, ...}
+    template <std::size_t N, typename Simd_t>
+    SIMDEE_INL void load_interleaved(const typename simd_base<Simd_t>::scalar_t* ptr,
+                                     simd_base<Simd_t>& v0, simd_base<Simd_t>& v1) {
+        static_assert(N == 2, "load_interleaved<N>() takes N vectors");
+        impl::interleave<Simd_t>::load(ptr, v0.self(), v1.self());
+    }
+    template <std::size_t N, typename Simd_t>
+    SIMDEE_INL void load_interleaved(const typename simd_base<Simd_t>::scalar_t* ptr,
+                                     simd_base<Simd_t>& v0, simd_base<Simd_t>& v1,
+                                     simd_base<Simd_t>& v2) {
+        static_assert(N == 3, "load_interleaved<N>() takes N vectors");
+        impl::interleave<Simd_t>::load(ptr, v0.self(), v1.self(), v2.self());
+    }
+    template <std::size_t N, typename Simd_t>
+    SIMDEE_INL void load_interleaved(const typename simd_base<Simd_t>::scalar_t* ptr,
+                                     simd_base<Simd_t>& v0, simd_base<Simd_t>& v1,
+                                     simd_base<Simd_t>& v2, simd_base<Simd_t>& v3) {
+        static_assert(N == 4, "load_interleaved<N>() takes N vectors");
+        impl::interleave<Simd_t>::load(ptr, v0.self(), v1.self(), v2.self(), v3.self());
+    }
+
+    // stores N vectors to N * width interleaved scalars, the inverse of load_interleaved()
+    template <std::size_t N, typename Simd_t>
+    SIMDEE_INL void store_interleaved(typename simd_base<Simd_t>::scalar_t* ptr,
+                                      const simd_base<Simd_t>& v0, const simd_base<Simd_t>& v1) {
+        static_assert(N == 2, "store_interleaved<N>() takes N vectors");
+        impl::interleave<Simd_t>::store(ptr, v0.self(), v1.self());
+    }
+    template <std::size_t N, typename Simd_t>
+    SIMDEE_INL void store_interleaved(typename simd_base<Simd_t>::scalar_t* ptr,
+                                      const simd_base<Simd_t>& v0, const simd_base<Simd_t>& v1,
+                                      const simd_base<Simd_t>& v2) {
+        static_assert(N == 3, "store_interleaved<N>() takes N vectors");
+        impl::interleave<Simd_t>::store(ptr, v0.self(), v1.self(), v2.self());
+    }
+    template <std::size_t N, typename Simd_t>
+    SIMDEE_INL void store_interleaved(typename simd_base<Simd_t>::scalar_t* ptr,
+                                      const simd_base<Simd_t>& v0, const simd_base<Simd_t>& v1,
+                                      const simd_base<Simd_t>& v2, const simd_base<Simd_t>& v3) {
+        static_assert(N == 4, "store_interleaved<N>() takes N vectors");
+        impl::interleave<Simd_t>::store(ptr, v0.self(), v1.self(), v2.self(), v3.self());
+    }
+
+    // stores the scalars of values selected by pred to ptr[0], ptr[1], ... and returns their
+    // number; the scalars that follow, up to ptr[width - 1], may be overwritten
+    template <typename Simd_t>
+    SIMDEE_INL std::size_t compress_store(typename simd_base<Simd_t>::scalar_t* ptr,
+                                          const simd_base<Simd_t>& values,
+                                          const typename simd_base<Simd_t>::vec_b& pred) {
+        return impl::compression<Simd_t>::compress_store(ptr, values.self(), pred);
+    }
+
+    // loads ptr[0], ptr[1], ... into the scalars selected by pred, sets the rest to zero; the
+    // inverse of compress_store(), which may read up to ptr[width - 1]
+    template <typename Scalar_t, typename Pred_t>
+    SIMDEE_INL typename impl::expand_result<Pred_t, Scalar_t>::type
+    expand_load(const Scalar_t* ptr, const simd_base<Pred_t>& pred) {
+        using result_t = typename impl::expand_result<Pred_t, Scalar_t>::type;
+        return impl::compression<result_t>::expand_load(ptr, pred.self());
+    }
+
+    // the scalars of v rearranged at compile time, the i-th scalar of the result is v[Idx[i]];
+    // e.g. shuffle<3, 2, 1, 0>(v) reverses a vector of width 4
+    template <int... Idx, typename Simd_t>
+    SIMDEE_INL Simd_t shuffle(const simd_base<Simd_t>& v) {
+        static_assert(sizeof...(Idx) == Simd_t::width, "shuffle() takes width lanes");
+        static_assert(impl::lane_list<Idx...>::below(int(Simd_t::width)),
+                      "shuffle() lanes must be less than width");
+        return impl::shuffling<Simd_t>::template apply<Idx...>(v.self());
+    }
+
+    // as above, the lanes width to 2 * width - 1 are those of b; e.g. shuffle<0, 4, 1, 5>(a, b)
+    // interleaves the first halves of a and b of width 4
+    template <int... Idx, typename Simd_t>
+    SIMDEE_INL Simd_t shuffle(const simd_base<Simd_t>& a, const simd_base<Simd_t>& b) {
+        static_assert(sizeof...(Idx) == Simd_t::width, "shuffle() takes width lanes");
+        static_assert(impl::lane_list<Idx...>::below(2 * int(Simd_t::width)),
+                      "shuffle() lanes must be less than 2 * width");
+        return impl::shuffling<Simd_t>::template apply<Idx...>(a.self(), b.self());
+    }
+
+    // the scalars of v rearranged at run time, the i-th scalar of the result is v[idx[i]]; each
+    // idx[i] must be in [0, width)
+    template <typename Simd_t>
+    SIMDEE_INL Simd_t permute(const simd_base<Simd_t>& v,
+                              const typename simd_base<Simd_t>::vec_s& idx) {
+        return impl::shuffling<Simd_t>::permute(v.self(), idx);
+    }
+
+    // inclusive prefix sum, the i-th scalar of the result is v[0] + v[1] + ... + v[i]
+    template <typename Simd_t>
+    SIMDEE_INL Simd_t inclusive_scan(const simd_base<Simd_t>& v) {
+        return impl::scanning<Simd_t>::inclusive(v.self());
+    }
+
+    // exclusive prefix sum, the i-th scalar of the result is v[0] + v[1] + ... + v[i - 1]
+    template <typename Simd_t>
+    SIMDEE_INL Simd_t exclusive_scan(const simd_base<Simd_t>& v) {
+        return impl::scanning<Simd_t>::exclusive(v.self());
+    }
+
+    // transposes the width x width matrix whose rows are v0, v1, ..., in place
+    template <typename Simd_t>
+    SIMDEE_INL void transpose(simd_base<Simd_t>& v0, simd_base<Simd_t>& v1) {
+        static_assert(Simd_t::width == 2, "transpose() takes width vectors");
+        Simd_t rows[2] = {v0.self(), v1.self()};
+        impl::transposition<Simd_t>::apply(rows);
+        v0.self() = rows[0], v1.self() = rows[1];
+    }
+    template <typename Simd_t>
+    SIMDEE_INL void transpose(simd_base<Simd_t>& v0, simd_base<Simd_t>& v1,
+                              simd_base<Simd_t>& v2, simd_base<Simd_t>& v3) {
+        static_assert(Simd_t::width == 4, "transpose() takes width vectors");
+        Simd_t rows[4] = {v0.self(), v1.self(), v2.self(), v3.self()};
+        impl::transposition<Simd_t>::apply(rows);
+        v0.self() = rows[0], v1.self() = rows[1], v2.self() = rows[2], v3.self() = rows[3];
+    }
+    template <typename Simd_t>
+    SIMDEE_INL void transpose(simd_base<Simd_t>& v0, simd_base<Simd_t>& v1,
+                              simd_base<Simd_t>& v2, simd_base<Simd_t>& v3,
+                              simd_base<Simd_t>& v4, simd_base<Simd_t>& v5,
+                              simd_base<Simd_t>& v6, simd_base<Simd_t>& v7) {
+        static_assert(Simd_t::width == 8, "transpose() takes width vectors");
+        Simd_t rows[8] = {v0.self(), v1.self(), v2.self(), v3.self(),
+                          v4.self(), v5.self(), v6.self(), v7.self()};
+        impl::transposition<Simd_t>::apply(rows);
+        v0.self() = rows[0], v1.self() = rows[1], v2.self() = rows[2], v3.self() = rows[3];
+        v4.self() = rows[4], v5.self() = rows[5], v6.self() = rows[6], v7.self() = rows[7];
+    }
+    template <typename Simd_t>
+    SIMDEE_INL void transpose(simd_base<Simd_t>& v0, simd_base<Simd_t>& v1,
+                              simd_base<Simd_t>& v2, simd_base<Simd_t>& v3,
+                              simd_base<Simd_t>& v4, simd_base<Simd_t>& v5,
+                              simd_base<Simd_t>& v6, simd_base<Simd_t>& v7,
+                              simd_base<Simd_t>& v8, simd_base<Simd_t>& v9,
+                              simd_base<Simd_t>& v10, simd_base<Simd_t>& v11,
+                              simd_base<Simd_t>& v12, simd_base<Simd_t>& v13,
+                              simd_base<Simd_t>& v14, simd_base<Simd_t>& v15) {
+        static_assert(Simd_t::width == 16, "transpose() takes width vectors");
+        Simd_t rows[16] = {v0.self(),  v1.self(),  v2.self(),  v3.self(),
+                           v4.self(),  v5.self(),  v6.self(),  v7.self(),
+                           v8.self(),  v9.self(),  v10.self(), v11.self(),
+                           v12.self(), v13.self(), v14.self(), v15.self()};
+        impl::transposition<Simd_t>::apply(rows);
+        v0.self() = rows[0], v1.self() = rows[1], v2.self() = rows[2], v3.self() = rows[3];
+        v4.self() = rows[4], v5.self() = rows[5], v6.self() = rows[6], v7.self() = rows[7];
+        v8.self() = rows[8], v9.self() = rows[9], v10.self() = rows[10];
+        v11.self() = rows[11], v12.self() = rows[12], v13.self() = rows[13];
+        v14.self() = rows[14], v15.self() = rows[15];
+    }
+
+    // a * b + c
+    template <typename Simd_t>
+    SIMDEE_INL Simd_t fma(const simd_base<Simd_t>& a, const simd_base<Simd_t>& b,
+                          const simd_base<Simd_t>& c) {
+        return impl::fused<Simd_t>::fma(a.self(), b.self(), c.self());
+    }
+    // a * b - c
+    template <typename Simd_t>
+    SIMDEE_INL Simd_t fms(const simd_base<Simd_t>& a, const simd_base<Simd_t>& b,
+                          const simd_base<Simd_t>& c) {
+        return impl::fused<Simd_t>::fms(a.self(), b.self(), c.self());
+    }
+    // -(a * b) + c
+    template <typename Simd_t>
+    SIMDEE_INL Simd_t fnma(const simd_base<Simd_t>& a, const simd_base<Simd_t>& b,
+                           const simd_base<Simd_t>& c) {
+        return impl::fused<Simd_t>::fnma(a.self(), b.self(), c.self());
+    }
+    // -(a * b) - c
+    template <typename Simd_t>
+    SIMDEE_INL Simd_t fnms(const simd_base<Simd_t>& a, const simd_base<Simd_t>& b,
+                           const simd_base<Simd_t>& c) {
+        return impl::fused<Simd_t>::fnms(a.self(), b.self(), c.self());
+    }
+
+    // accuracy tiers of rcp() and rsqrt()
+    enum class accuracy {
+        estimate, // same as rcp(x), rsqrt(x); maximum relative error 1.5*2^-12
+        newton,   // estimate refined by one Newton-Raphson step; maximum relative error 2^-21
+        full,     // computed with division and sqrt(); within 1 ulp, rcp() correctly rounded
+    };
+
+    namespace impl {
+        template <accuracy A>
+        using accuracy_tag = std::integral_constant<accuracy, A>;
+
+        // Newton-Raphson refinement steps, specialized by backends that have dedicated instructions
+        template <typename T>
+        struct newton {
+            using scalar_t = typename simd_vector_traits<T>::scalar_t;
+
+            // refines r ~ 1 / x
+            static SIMDEE_INL T rcp(const T& x, const T& r) {
+                T e = fnma(x, r, T(scalar_t(1)));
+                return fma(r, e, r);
+            }
+
+            // refines r ~ 1 / sqrt(x)
+            static SIMDEE_INL T rsqrt(const T& x, const T& r) {
+                const T half(scalar_t(0.5));
+                T e = fnma((half * x) * r, r, half);
+                return fma(r, e, r);
+            }
+        };
+
+        template <typename T>
+        SIMDEE_INL T rcp_tier(const T& x, accuracy_tag<accuracy::estimate>) {
+            return rcp(x);
+        }
+        template <typename T>
+        SIMDEE_INL T rcp_tier(const T& x, accuracy_tag<accuracy::newton>) {
+            T r = rcp(x);
+            T res = newton<T>::rcp(x, r);
+            return cond(res == res, res, r); // zero, infinity
+        }
+        template <typename T>
+        SIMDEE_INL T rcp_tier(const T& x, accuracy_tag<accuracy::full>) {
+            using scalar_t = typename simd_vector_traits<T>::scalar_t;
+            return T(scalar_t(1)) / x;
+        }
+
+        template <typename T>
+        SIMDEE_INL T rsqrt_tier(const T& x, accuracy_tag<accuracy::estimate>) {
+            return rsqrt(x);
+        }
+        template <typename T>
+        SIMDEE_INL T rsqrt_tier(const T& x, accuracy_tag<accuracy::newton>) {
+            T r = rsqrt(x);
+            T res = newton<T>::rsqrt(x, r);
+            return cond(res == res, res, r); // zero, infinity
+        }
+        template <typename T>
+        SIMDEE_INL T rsqrt_tier(const T& x, accuracy_tag<accuracy::full>) {
+            using scalar_t = typename simd_vector_traits<T>::scalar_t;
+            return T(scalar_t(1)) / sqrt(x);
+        }
+    }
+
+    // reciprocal with selectable accuracy, e.g. sd::rcp<sd::accuracy::newton>(x)
+    template <accuracy A, typename Simd_t>
+    SIMDEE_INL Simd_t rcp(const simd_base<Simd_t>& l) {
+        return impl::rcp_tier(l.self(), impl::accuracy_tag<A>{});
+    }
+
+    // reciprocal square root with selectable accuracy, e.g. sd::rsqrt<sd::accuracy::newton>(x)
+    template <accuracy A, typename Simd_t>
+    SIMDEE_INL Simd_t rsqrt(const simd_base<Simd_t>& l) {
+        return impl::rsqrt_tier(l.self(), impl::accuracy_tag<A>{});
+    }
+
     struct op_add {
         template <typename L, typename R>
         SIMDEE_INL auto operator()(const L& l, const R& r) -> decltype(l + r) {
@@ -154,6 +915,50 @@ namespace sd {
             return l || r;
         }
     };
+
+    // horizontal operations returning a scalar
+    namespace impl {
+        template <typename T>
+        struct horizontal {
+            using scalar_t = typename simd_vector_traits<T>::scalar_t;
+
+            template <typename Op_t>
+            SIMDEE_INL static scalar_t apply(const T& v, Op_t f) {
+                return first_scalar(reduce(v, f));
+            }
+        };
+    }
+
+    // sum of all scalars, the order of the additions is unspecified
+    template <typename Simd_t>
+    SIMDEE_INL typename simd_base<Simd_t>::scalar_t hsum(const simd_base<Simd_t>& v) {
+        return impl::horizontal<Simd_t>::apply(v.self(), op_add{});
+    }
+
+    // product of all scalars, the order of the multiplications is unspecified
+    template <typename Simd_t>
+    SIMDEE_INL typename simd_base<Simd_t>::scalar_t hprod(const simd_base<Simd_t>& v) {
+        return impl::horizontal<Simd_t>::apply(v.self(), op_mul{});
+    }
+
+    // minimum of all scalars
+    template <typename Simd_t>
+    SIMDEE_INL typename simd_base<Simd_t>::scalar_t hmin(const simd_base<Simd_t>& v) {
+        return impl::horizontal<Simd_t>::apply(v.self(), op_min{});
+    }
+
+    // maximum of all scalars
+    template <typename Simd_t>
+    SIMDEE_INL typename simd_base<Simd_t>::scalar_t hmax(const simd_base<Simd_t>& v) {
+        return impl::horizontal<Simd_t>::apply(v.self(), op_max{});
+    }
+
+    // dot product, sum of the products of the corresponding scalars
+    template <typename Simd_t>
+    SIMDEE_INL typename simd_base<Simd_t>::scalar_t dot(const simd_base<Simd_t>& a,
+                                                        const simd_base<Simd_t>& b) {
+        return hsum(Simd_t(a.self() * b.self()));
+    }
 }
 
 #endif // SIMDEE_SIMD_TYPES_COMMON_HPP
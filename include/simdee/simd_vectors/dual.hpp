@@ -21,6 +21,15 @@ namespace sd {
         using dual_mask_t = impl::mask<((Mask_t::all_bits + 1) * (Mask_t::all_bits + 1)) - 1>;
     }
 
+    namespace detail {
+        // the number of true scalars in pred; mask() is found by ADL only outside of sd::impl,
+        // where the name refers to impl::mask
+        template <typename Bool_t>
+        SIMDEE_INL uint32_t count_true(const Bool_t& pred) {
+            return popcount(mask(pred).value);
+        }
+    }
+
     template <typename T, typename Enable = void>
     struct dual;
 
@@ -89,6 +98,24 @@ namespace sd {
         }
     };
 
+    template <typename Crtp>
+    struct dual_base_base<Crtp, 16> : simd_base<Crtp> {
+    protected:
+        using T = typename simd_base<Crtp>::vector_t::l_t;
+        using simd_base<Crtp>::mm;
+
+    public:
+        using scalar_t = typename simd_base<Crtp>::scalar_t;
+        SIMDEE_TRIVIAL_TYPE(dual_base_base)
+        SIMDEE_INL dual_base_base(scalar_t v0, scalar_t v1, scalar_t v2, scalar_t v3, scalar_t v4,
+                                  scalar_t v5, scalar_t v6, scalar_t v7, scalar_t v8, scalar_t v9,
+                                  scalar_t v10, scalar_t v11, scalar_t v12, scalar_t v13,
+                                  scalar_t v14, scalar_t v15) {
+            mm.l = T(v0, v1, v2, v3, v4, v5, v6, v7);
+            mm.r = T(v8, v9, v10, v11, v12, v13, v14, v15);
+        }
+    };
+
     template <typename Crtp>
     struct dual_base : dual_base_base<Crtp, simd_base<Crtp>::width> {
     protected:
@@ -99,6 +126,8 @@ namespace sd {
         using vector_t = typename simd_base<Crtp>::vector_t;
         using scalar_t = typename simd_base<Crtp>::scalar_t;
         using storage_t = typename simd_base<Crtp>::storage_t;
+        using vec_b = typename simd_base<Crtp>::vec_b;
+        using vec_s = typename simd_base<Crtp>::vec_s;
         using simd_base<Crtp>::width;
         using simd_base<Crtp>::self;
         using dual_base_base<Crtp, width>::dual_base_base;
@@ -109,6 +138,7 @@ namespace sd {
         SIMDEE_BASE_CTOR(dual_base, scalar_t, mm.l = r; mm.r = r)
         SIMDEE_BASE_CTOR_TPL(dual_base, expr::aligned<T>, aligned_load(r.ptr))
         SIMDEE_BASE_CTOR_TPL(dual_base, expr::unaligned<T>, unaligned_load(r.ptr))
+        SIMDEE_BASE_CTOR_TPL2(dual_base, expr::masked, masked_load(r.ptr, r.sel))
         SIMDEE_BASE_CTOR_TPL(dual_base, expr::init<T>, mm.l = r; mm.r = r)
         SIMDEE_BASE_CTOR(dual_base, storage_t, aligned_load(r.data()))
 
@@ -122,6 +152,11 @@ namespace sd {
             mm.r.aligned_store(r + T::width);
         }
 
+        SIMDEE_INL void stream_store(scalar_t* r) const {
+            mm.l.stream_store(r);
+            mm.r.stream_store(r + T::width);
+        }
+
         SIMDEE_INL void unaligned_load(const scalar_t* r) {
             mm.l.unaligned_load(r);
             mm.r.unaligned_load(r + T::width);
@@ -132,6 +167,46 @@ namespace sd {
             mm.r.unaligned_store(r + T::width);
         }
 
+        SIMDEE_INL void masked_load(const scalar_t* r, std::size_t count) {
+            mm.l.masked_load(r, count);
+            mm.r.masked_load(r + T::width, count > T::width ? count - T::width : 0);
+        }
+
+        SIMDEE_INL void masked_load(const scalar_t* r, const vec_b& pred) {
+            mm.l.masked_load(r, pred.data().l);
+            mm.r.masked_load(r + T::width, pred.data().r);
+        }
+
+        SIMDEE_INL void masked_store(scalar_t* r, std::size_t count) const {
+            mm.l.masked_store(r, count);
+            mm.r.masked_store(r + T::width, count > T::width ? count - T::width : 0);
+        }
+
+        SIMDEE_INL void masked_store(scalar_t* r, const vec_b& pred) const {
+            mm.l.masked_store(r, pred.data().l);
+            mm.r.masked_store(r + T::width, pred.data().r);
+        }
+
+        SIMDEE_INL void gather(const scalar_t* r, const vec_s& idx) {
+            mm.l.gather(r, idx.data().l);
+            mm.r.gather(r, idx.data().r);
+        }
+
+        SIMDEE_INL void gather(const scalar_t* r, const vec_s& idx, const vec_b& pred) {
+            mm.l.gather(r, idx.data().l, pred.data().l);
+            mm.r.gather(r, idx.data().r, pred.data().r);
+        }
+
+        SIMDEE_INL void scatter(scalar_t* r, const vec_s& idx) const {
+            mm.l.scatter(r, idx.data().l);
+            mm.r.scatter(r, idx.data().r);
+        }
+
+        SIMDEE_INL void scatter(scalar_t* r, const vec_s& idx, const vec_b& pred) const {
+            mm.l.scatter(r, idx.data().l, pred.data().l);
+            mm.r.scatter(r, idx.data().r, pred.data().r);
+        }
+
         template <unsigned int Lane>
         const Crtp broadcast() {
             static_assert(Lane < width, "");
@@ -284,6 +359,22 @@ namespace sd {
         SIMDEE_BINOP(vec_u, vec_u, operator*, (vector_t{l.mm.l * r.mm.l, l.mm.r* r.mm.r}))
         SIMDEE_BINOP(vec_u, vec_u, min, (vector_t{min(l.mm.l, r.mm.l), min(l.mm.r, r.mm.r)}))
         SIMDEE_BINOP(vec_u, vec_u, max, (vector_t{max(l.mm.l, r.mm.l), max(l.mm.r, r.mm.r)}))
+        SIMDEE_BINOP(vec_u, vec_u, mulhi, (vector_t{mulhi(l.mm.l, r.mm.l), mulhi(l.mm.r, r.mm.r)}))
+
+        SIMDEE_INL friend const vec_u operator<<(const vec_u& l, int r) {
+            return vector_t{l.mm.l << r, l.mm.r << r};
+        }
+        SIMDEE_INL friend const vec_u operator>>(const vec_u& l, int r) {
+            return vector_t{l.mm.l >> r, l.mm.r >> r};
+        }
+        SIMDEE_BINOP(vec_u, vec_u, operator<<, (vector_t{l.mm.l << r.mm.l, l.mm.r << r.mm.r}))
+        SIMDEE_BINOP(vec_u, vec_u, operator>>, (vector_t{l.mm.l >> r.mm.l, l.mm.r >> r.mm.r}))
+        SIMDEE_INL friend const vec_u rotl(const vec_u& l, int r) {
+            return vector_t{rotl(l.mm.l, r), rotl(l.mm.r, r)};
+        }
+        SIMDEE_INL friend const vec_u rotr(const vec_u& l, int r) {
+            return vector_t{rotr(l.mm.l, r), rotr(l.mm.r, r)};
+        }
 #endif
 
         SIMDEE_INL friend const vec_u cond(const vec_b& pred, const vec_u& if_true,
@@ -343,6 +434,16 @@ namespace sd {
         SIMDEE_BINOP(vec_s, vec_s, min, (vector_t{min(l.mm.l, r.mm.l), min(l.mm.r, r.mm.r)}))
         SIMDEE_BINOP(vec_s, vec_s, max, (vector_t{max(l.mm.l, r.mm.l), max(l.mm.r, r.mm.r)}))
         SIMDEE_UNOP(vec_s, vec_s, abs, (vector_t{abs(l.mm.l), abs(l.mm.r)}))
+        SIMDEE_BINOP(vec_s, vec_s, mulhi, (vector_t{mulhi(l.mm.l, r.mm.l), mulhi(l.mm.r, r.mm.r)}))
+
+        SIMDEE_INL friend const vec_s operator<<(const vec_s& l, int r) {
+            return vector_t{l.mm.l << r, l.mm.r << r};
+        }
+        SIMDEE_INL friend const vec_s operator>>(const vec_s& l, int r) {
+            return vector_t{l.mm.l >> r, l.mm.r >> r};
+        }
+        SIMDEE_BINOP(vec_s, vec_s, operator<<, (vector_t{l.mm.l << r.mm.l, l.mm.r << r.mm.r}))
+        SIMDEE_BINOP(vec_s, vec_s, operator>>, (vector_t{l.mm.l >> r.mm.l, l.mm.r >> r.mm.r}))
 #endif
 
         SIMDEE_INL friend const vec_s cond(const vec_b& pred, const vec_s& if_true,
@@ -353,6 +454,223 @@ namespace sd {
             };
         }
     };
+
+#if SIMDEE_NEED_INT
+    namespace impl {
+        template <typename T>
+        using wide_product_t = typename std::decay<decltype(
+            mul_wide_lo(std::declval<const T&>(), std::declval<const T&>()))>::type;
+    } // namespace impl
+
+    // the full products of the lower and of the upper half of the scalars, available where the
+    // halves provide them
+    template <typename T>
+    SIMDEE_INL const dual<impl::wide_product_t<T>> mul_wide_lo(const dual<T>& l, const dual<T>& r) {
+        return impl::pair<impl::wide_product_t<T>>{mul_wide_lo(l.data().l, r.data().l),
+                                                   mul_wide_hi(l.data().l, r.data().l)};
+    }
+    template <typename T>
+    SIMDEE_INL const dual<impl::wide_product_t<T>> mul_wide_hi(const dual<T>& l, const dual<T>& r) {
+        return impl::pair<impl::wide_product_t<T>>{mul_wide_lo(l.data().r, r.data().r),
+                                                   mul_wide_hi(l.data().r, r.data().r)};
+    }
+#endif
+
+    namespace impl {
+        template <typename T>
+        struct fused<dual<T>> {
+            using native = typename fused<T>::native;
+
+            SIMDEE_INL static dual<T> fma(const dual<T>& a, const dual<T>& b, const dual<T>& c) {
+                return pair<T>{fused<T>::fma(a.data().l, b.data().l, c.data().l),
+                               fused<T>::fma(a.data().r, b.data().r, c.data().r)};
+            }
+            SIMDEE_INL static dual<T> fms(const dual<T>& a, const dual<T>& b, const dual<T>& c) {
+                return pair<T>{fused<T>::fms(a.data().l, b.data().l, c.data().l),
+                               fused<T>::fms(a.data().r, b.data().r, c.data().r)};
+            }
+            SIMDEE_INL static dual<T> fnma(const dual<T>& a, const dual<T>& b, const dual<T>& c) {
+                return pair<T>{fused<T>::fnma(a.data().l, b.data().l, c.data().l),
+                               fused<T>::fnma(a.data().r, b.data().r, c.data().r)};
+            }
+            SIMDEE_INL static dual<T> fnms(const dual<T>& a, const dual<T>& b, const dual<T>& c) {
+                return pair<T>{fused<T>::fnms(a.data().l, b.data().l, c.data().l),
+                               fused<T>::fnms(a.data().r, b.data().r, c.data().r)};
+            }
+        };
+
+        template <typename T>
+        struct interleave<dual<T>> {
+            using scalar_t = typename simd_vector_traits<T>::scalar_t;
+            static constexpr std::size_t half = T::width;
+
+            SIMDEE_INL static void load(const scalar_t* ptr, dual<T>& v0, dual<T>& v1) {
+                interleave<T>::load(ptr, v0.data().l, v1.data().l);
+                interleave<T>::load(ptr + 2 * half, v0.data().r, v1.data().r);
+            }
+            SIMDEE_INL static void load(const scalar_t* ptr, dual<T>& v0, dual<T>& v1,
+                                        dual<T>& v2) {
+                interleave<T>::load(ptr, v0.data().l, v1.data().l, v2.data().l);
+                interleave<T>::load(ptr + 3 * half, v0.data().r, v1.data().r, v2.data().r);
+            }
+            SIMDEE_INL static void load(const scalar_t* ptr, dual<T>& v0, dual<T>& v1,
+                                        dual<T>& v2, dual<T>& v3) {
+                interleave<T>::load(ptr, v0.data().l, v1.data().l, v2.data().l, v3.data().l);
+                interleave<T>::load(ptr + 4 * half, v0.data().r, v1.data().r, v2.data().r,
+                                    v3.data().r);
+            }
+            SIMDEE_INL static void store(scalar_t* ptr, const dual<T>& v0, const dual<T>& v1) {
+                interleave<T>::store(ptr, v0.data().l, v1.data().l);
+                interleave<T>::store(ptr + 2 * half, v0.data().r, v1.data().r);
+            }
+            SIMDEE_INL static void store(scalar_t* ptr, const dual<T>& v0, const dual<T>& v1,
+                                         const dual<T>& v2) {
+                interleave<T>::store(ptr, v0.data().l, v1.data().l, v2.data().l);
+                interleave<T>::store(ptr + 3 * half, v0.data().r, v1.data().r, v2.data().r);
+            }
+            SIMDEE_INL static void store(scalar_t* ptr, const dual<T>& v0, const dual<T>& v1,
+                                         const dual<T>& v2, const dual<T>& v3) {
+                interleave<T>::store(ptr, v0.data().l, v1.data().l, v2.data().l, v3.data().l);
+                interleave<T>::store(ptr + 4 * half, v0.data().r, v1.data().r, v2.data().r,
+                                     v3.data().r);
+            }
+        };
+
+        // the rows of [A B; C D] are transposed as [A' C'; B' D']
+        template <typename T>
+        struct transposition<dual<T>> {
+            static constexpr std::size_t half = T::width;
+
+            SIMDEE_INL static void apply(dual<T>* rows) {
+                T a[half], b[half], c[half], d[half];
+                for (std::size_t i = 0; i < half; ++i) {
+                    a[i] = rows[i].data().l;
+                    b[i] = rows[i].data().r;
+                    c[i] = rows[half + i].data().l;
+                    d[i] = rows[half + i].data().r;
+                }
+                transposition<T>::apply(a);
+                transposition<T>::apply(b);
+                transposition<T>::apply(c);
+                transposition<T>::apply(d);
+                for (std::size_t i = 0; i < half; ++i) {
+                    rows[i] = pair<T>{a[i], c[i]};
+                    rows[half + i] = pair<T>{b[i], d[i]};
+                }
+            }
+        };
+
+        // the right half is compressed to (expanded from) where the left half ends
+        template <typename T>
+        struct compression<dual<T>> {
+            using scalar_t = typename simd_vector_traits<T>::scalar_t;
+            using vec_b = typename simd_vector_traits<dual<T>>::vec_b;
+
+            SIMDEE_INL static std::size_t compress_store(scalar_t* ptr, const dual<T>& v,
+                                                         const vec_b& pred) {
+                std::size_t count =
+                    compression<T>::compress_store(ptr, v.data().l, pred.data().l);
+                return count + compression<T>::compress_store(ptr + count, v.data().r,
+                                                              pred.data().r);
+            }
+            SIMDEE_INL static dual<T> expand_load(const scalar_t* ptr, const vec_b& pred) {
+                std::size_t count = detail::count_true(pred.data().l);
+                return pair<T>{compression<T>::expand_load(ptr, pred.data().l),
+                               compression<T>::expand_load(ptr + count, pred.data().r)};
+            }
+        };
+
+        // each half of the result is a two-vector shuffle of the halves of the source; of two
+        // sources, the lanes taken from either one are shuffled separately and then blended
+        template <typename T>
+        struct shuffling<dual<T>> {
+            enum : int { half = int(T::width), width = 2 * int(T::width) };
+            using vec_s = typename simd_vector_traits<dual<T>>::vec_s;
+            using half_lanes = typename iota_lanes<half>::type;
+
+            template <int... Idx>
+            SIMDEE_INL static dual<T> apply(const dual<T>& v) {
+                return split<lane_list<Idx...>>(v.data().l, v.data().r, half_lanes());
+            }
+            template <int... Idx>
+            SIMDEE_INL static dual<T> apply(const dual<T>& a, const dual<T>& b) {
+                return blend<lane_list<Idx...>>(apply<(Idx % width)...>(a),
+                                                apply<(Idx % width)...>(b), half_lanes());
+            }
+            SIMDEE_INL static dual<T> permute(const dual<T>& v, const vec_s& idx) {
+#if SIMDEE_NEED_INT
+                return pair<T>{permute_half(v, idx.data().l), permute_half(v, idx.data().r)};
+#else
+                return shuffle_emulation<dual<T>>::permute(v, idx);
+#endif
+            }
+
+        private:
+            template <typename L, int... I>
+            SIMDEE_INL static dual<T> split(const T& l, const T& r, lane_list<I...>) {
+                return pair<T>{shuffling<T>::template apply<L::lane(I)...>(l, r),
+                               shuffling<T>::template apply<L::lane(I + half)...>(l, r)};
+            }
+            template <typename L, int... I>
+            SIMDEE_INL static dual<T> blend(const dual<T>& a, const dual<T>& b, lane_list<I...>) {
+                return pair<T>{
+                    shuffling<T>::template apply<(I + (L::lane(I) < width ? 0 : half))...>(
+                        a.data().l, b.data().l),
+                    shuffling<T>::template apply<(I + (L::lane(I + half) < width ? 0 : half))...>(
+                        a.data().r, b.data().r)};
+            }
+#if SIMDEE_NEED_INT
+            using half_idx_t = typename simd_vector_traits<T>::vec_s;
+
+            SIMDEE_INL static T permute_half(const dual<T>& v, const half_idx_t& idx) {
+                half_idx_t at = idx & half_idx_t(half - 1);
+                return cond(idx > half_idx_t(half - 1), shuffling<T>::permute(v.data().r, at),
+                            shuffling<T>::permute(v.data().l, at));
+            }
+#endif
+        };
+
+        template <typename T>
+        struct horizontal<dual<T>> {
+            using scalar_t = typename simd_vector_traits<T>::scalar_t;
+
+            // the halves are combined first, so only one of them is reduced
+            template <typename Op_t>
+            SIMDEE_INL static scalar_t apply(const dual<T>& v, Op_t f) {
+                return horizontal<T>::apply(T(f(v.data().l, v.data().r)), f);
+            }
+        };
+
+        template <typename T>
+        struct scanning<dual<T>> {
+            enum : int { half = int(T::width) };
+
+            // the upper half continues from the last scalar of the scanned lower half
+            SIMDEE_INL static dual<T> inclusive(const dual<T>& v) {
+                T l = scanning<T>::inclusive(v.data().l);
+                return pair<T>{l, scanning<T>::inclusive(v.data().r) + last(l)};
+            }
+            SIMDEE_INL static dual<T> exclusive(const dual<T>& v) {
+                T l = scanning<T>::exclusive(v.data().l);
+                return pair<T>{l, scanning<T>::exclusive(v.data().r) + last(T(l + v.data().l))};
+            }
+
+        private:
+            SIMDEE_INL static T last(T v) { return v.template broadcast<half - 1>(); }
+        };
+
+        template <typename T>
+        struct newton<dual<T>> {
+            SIMDEE_INL static dual<T> rcp(const dual<T>& x, const dual<T>& r) {
+                return pair<T>{newton<T>::rcp(x.data().l, r.data().l),
+                               newton<T>::rcp(x.data().r, r.data().r)};
+            }
+            SIMDEE_INL static dual<T> rsqrt(const dual<T>& x, const dual<T>& r) {
+                return pair<T>{newton<T>::rsqrt(x.data().l, r.data().l),
+                               newton<T>::rsqrt(x.data().r, r.data().r)};
+            }
+        };
+    }
 }
 
 #endif // SIMDEE_SIMD_TYPES_DUAL_HPP
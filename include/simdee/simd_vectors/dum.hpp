@@ -54,6 +54,8 @@ namespace sd {
         using vector_t = typename simd_base<Crtp>::vector_t;
         using scalar_t = typename simd_base<Crtp>::scalar_t;
         using storage_t = typename simd_base<Crtp>::storage_t;
+        using vec_b = typename simd_base<Crtp>::vec_b;
+        using vec_s = typename simd_base<Crtp>::vec_s;
         using simd_base<Crtp>::width;
         using simd_base<Crtp>::self;
 
@@ -61,13 +63,39 @@ namespace sd {
         SIMDEE_BASE_CTOR(dum_base, scalar_t, mm = r)
         SIMDEE_BASE_CTOR_TPL(dum_base, expr::aligned<T>, aligned_load(r.ptr))
         SIMDEE_BASE_CTOR_TPL(dum_base, expr::unaligned<T>, unaligned_load(r.ptr))
+        SIMDEE_BASE_CTOR_TPL2(dum_base, expr::masked, masked_load(r.ptr, r.sel))
         SIMDEE_BASE_CTOR_TPL(dum_base, expr::init<T>, *this = r.template to<scalar_t>())
         SIMDEE_BASE_CTOR(dum_base, storage_t, aligned_load(r.data()))
 
         SIMDEE_INL void aligned_load(const scalar_t* r) { mm = *r; }
         SIMDEE_INL void aligned_store(scalar_t* r) const { *r = mm; }
+        SIMDEE_INL void stream_store(scalar_t* r) const { *r = mm; }
         SIMDEE_INL void unaligned_load(const scalar_t* r) { mm = *r; }
         SIMDEE_INL void unaligned_store(scalar_t* r) const { *r = mm; }
+        SIMDEE_INL void masked_load(const scalar_t* r, std::size_t count) {
+            self() = impl::masked_emulation<Crtp>::load(r, count);
+        }
+        SIMDEE_INL void masked_load(const scalar_t* r, const vec_b& pred) {
+            self() = impl::masked_emulation<Crtp>::load(r, pred);
+        }
+        SIMDEE_INL void masked_store(scalar_t* r, std::size_t count) const {
+            impl::masked_emulation<Crtp>::store(self(), r, count);
+        }
+        SIMDEE_INL void masked_store(scalar_t* r, const vec_b& pred) const {
+            impl::masked_emulation<Crtp>::store(self(), r, pred);
+        }
+        SIMDEE_INL void gather(const scalar_t* r, const vec_s& idx) {
+            self() = impl::gather_emulation<Crtp>::gather(r, idx);
+        }
+        SIMDEE_INL void gather(const scalar_t* r, const vec_s& idx, const vec_b& pred) {
+            self() = impl::gather_emulation<Crtp>::gather(r, idx, pred);
+        }
+        SIMDEE_INL void scatter(scalar_t* r, const vec_s& idx) const {
+            impl::gather_emulation<Crtp>::scatter(self(), r, idx);
+        }
+        SIMDEE_INL void scatter(scalar_t* r, const vec_s& idx, const vec_b& pred) const {
+            impl::gather_emulation<Crtp>::scatter(self(), r, idx, pred);
+        }
 
         template <unsigned int Lane>
         SIMDEE_INL const Crtp broadcast() {
@@ -149,6 +177,18 @@ namespace sd {
         SIMDEE_BINOP(dumu, dumu, operator*, l.mm * r.mm)
         SIMDEE_BINOP(dumu, dumu, min, std::min(l.mm, r.mm))
         SIMDEE_BINOP(dumu, dumu, max, std::max(l.mm, r.mm))
+        SIMDEE_BINOP(dumu, dumu, mulhi, scalar_t((uint64_t(l.mm) * r.mm) >> 32))
+
+        SIMDEE_INL friend const dumu operator<<(const dumu& l, int r) { return l.mm << r; }
+        SIMDEE_INL friend const dumu operator>>(const dumu& l, int r) { return l.mm >> r; }
+        SIMDEE_BINOP(dumu, dumu, operator<<, l.mm << r.mm)
+        SIMDEE_BINOP(dumu, dumu, operator>>, l.mm >> r.mm)
+        SIMDEE_INL friend const dumu rotl(const dumu& l, int r) {
+            return (l.mm << r) | (l.mm >> ((32 - r) & 31));
+        }
+        SIMDEE_INL friend const dumu rotr(const dumu& l, int r) {
+            return (l.mm >> r) | (l.mm << ((32 - r) & 31));
+        }
 #endif
     };
 
@@ -183,6 +223,15 @@ namespace sd {
         SIMDEE_BINOP(dums, dums, min, std::min(l.mm, r.mm))
         SIMDEE_BINOP(dums, dums, max, std::max(l.mm, r.mm))
         SIMDEE_UNOP(dums, dums, abs, std::abs(l.mm))
+        SIMDEE_BINOP(dums, dums, mulhi, scalar_t((int64_t(l.mm) * r.mm) >> 32))
+
+        // the left shifts are done on unsigned scalars, where shifting out set bits is defined
+        SIMDEE_INL friend const dums operator<<(const dums& l, int r) {
+            return scalar_t(uint32_t(l.mm) << r);
+        }
+        SIMDEE_INL friend const dums operator>>(const dums& l, int r) { return l.mm >> r; }
+        SIMDEE_BINOP(dums, dums, operator<<, scalar_t(uint32_t(l.mm) << r.mm))
+        SIMDEE_BINOP(dums, dums, operator>>, l.mm >> r.mm)
 #endif
     };
 
@@ -204,6 +253,199 @@ namespace sd {
     SIMDEE_INL const dums cond(const dumb& pred, const dums& if_true, const dums& if_false) {
         return first_scalar(pred) ? if_true : if_false;
     }
+
+    //
+    // 64-bit scalars
+    //
+
+    struct dumb64;
+    struct dumd;
+    struct dumu64;
+    struct dums64;
+
+    template <>
+    struct is_simd_vector<dumb64> : std::integral_constant<bool, true> {};
+    template <>
+    struct is_simd_vector<dumd> : std::integral_constant<bool, true> {};
+    template <>
+    struct is_simd_vector<dumu64> : std::integral_constant<bool, true> {};
+    template <>
+    struct is_simd_vector<dums64> : std::integral_constant<bool, true> {};
+
+    template <typename Simd_t, typename Vector_t>
+    struct dum64_traits {
+        using simd_t = Simd_t;
+        using vector_t = Vector_t;
+        using scalar_t = Vector_t;
+        using vec_b = dumb64;
+        using vec_f = dumd;
+        using vec_u = dumu64;
+        using vec_s = dums64;
+        using mask_t = impl::mask<1U>;
+        using storage_t = impl::storage<simd_t, scalar_t, alignof(vector_t)>;
+    };
+
+    template <>
+    struct simd_vector_traits<dumb64> : dum64_traits<dumb64, bool64_t> {};
+    template <>
+    struct simd_vector_traits<dumd> : dum64_traits<dumd, double> {};
+    template <>
+    struct simd_vector_traits<dumu64> : dum64_traits<dumu64, uint64_t> {};
+    template <>
+    struct simd_vector_traits<dums64> : dum64_traits<dums64, int64_t> {};
+
+    struct dumb64 : dum_base<dumb64> {
+        SIMDEE_TRIVIAL_TYPE(dumb64)
+
+        using dum_base::dum_base;
+
+        SIMDEE_UNOP(dumb64, mask_t, mask, mask_t(l.mm))
+        SIMDEE_UNOP(dumb64, scalar_t, first_scalar, l.mm)
+        SIMDEE_BINOP(dumb64, dumb64, operator==, dumb64::scalar_t(l.mm == r.mm))
+        SIMDEE_BINOP(dumb64, dumb64, operator!=, dumb64::scalar_t(l.mm != r.mm))
+        SIMDEE_BINOP(dumb64, dumb64, operator&&, first_scalar(l) && first_scalar(r))
+        SIMDEE_BINOP(dumb64, dumb64, operator||, first_scalar(l) || first_scalar(r))
+        SIMDEE_UNOP(dumb64, dumb64, operator!, !first_scalar(l))
+    };
+
+    struct dumd : dum_base<dumd> {
+        SIMDEE_TRIVIAL_TYPE(dumd)
+
+        using dum_base::dum_base;
+        SIMDEE_INL explicit dumd(const dums64&);
+
+        SIMDEE_UNOP(dumd, scalar_t, first_scalar, l.mm)
+        SIMDEE_BINOP(dumd, dumb64, operator<, dumb64::scalar_t(l.mm < r.mm))
+        SIMDEE_BINOP(dumd, dumb64, operator>, dumb64::scalar_t(l.mm > r.mm))
+        SIMDEE_BINOP(dumd, dumb64, operator<=, dumb64::scalar_t(l.mm <= r.mm))
+        SIMDEE_BINOP(dumd, dumb64, operator>=, dumb64::scalar_t(l.mm >= r.mm))
+        SIMDEE_BINOP(dumd, dumb64, operator==, dumb64::scalar_t(l.mm == r.mm))
+        SIMDEE_BINOP(dumd, dumb64, operator!=, dumb64::scalar_t(l.mm != r.mm))
+
+        SIMDEE_UNOP(dumd, dumd, operator-, - l.mm)
+        SIMDEE_BINOP(dumd, dumd, operator+, l.mm + r.mm)
+        SIMDEE_BINOP(dumd, dumd, operator-, l.mm - r.mm)
+        SIMDEE_BINOP(dumd, dumd, operator*, l.mm * r.mm)
+        SIMDEE_BINOP(dumd, dumd, operator/, l.mm / r.mm)
+
+        SIMDEE_BINOP(dumd, dumd, min, std::min(l.mm, r.mm))
+        SIMDEE_BINOP(dumd, dumd, max, std::max(l.mm, r.mm))
+        SIMDEE_UNOP(dumd, dumd, sqrt, std::sqrt(l.mm))
+        SIMDEE_UNOP(dumd, dumd, rsqrt, 1 / std::sqrt(l.mm))
+        SIMDEE_UNOP(dumd, dumd, rcp, 1 / l.mm)
+        SIMDEE_UNOP(dumd, dumd, abs, std::abs(l.mm))
+    };
+
+    struct dumu64 : dum_base<dumu64> {
+        SIMDEE_TRIVIAL_TYPE(dumu64)
+
+        using dum_base::dum_base;
+        SIMDEE_INL explicit dumu64(const dumb64&);
+        SIMDEE_INL explicit dumu64(const dums64&);
+
+        SIMDEE_UNOP(dumu64, scalar_t, first_scalar, l.mm)
+
+#if SIMDEE_NEED_INT
+        SIMDEE_BINOP(dumu64, dumb64, operator<, dumb64::scalar_t(l.mm < r.mm))
+        SIMDEE_BINOP(dumu64, dumb64, operator>, dumb64::scalar_t(l.mm > r.mm))
+        SIMDEE_BINOP(dumu64, dumb64, operator<=, dumb64::scalar_t(l.mm <= r.mm))
+        SIMDEE_BINOP(dumu64, dumb64, operator>=, dumb64::scalar_t(l.mm >= r.mm))
+        SIMDEE_BINOP(dumu64, dumb64, operator==, dumb64::scalar_t(l.mm == r.mm))
+        SIMDEE_BINOP(dumu64, dumb64, operator!=, dumb64::scalar_t(l.mm != r.mm))
+        SIMDEE_BINOP(dumu64, dumu64, operator&, l.mm & r.mm)
+        SIMDEE_BINOP(dumu64, dumu64, operator|, l.mm | r.mm)
+        SIMDEE_BINOP(dumu64, dumu64, operator^, l.mm ^ r.mm)
+        SIMDEE_UNOP(dumu64, dumu64, operator~, ~l.mm)
+        SIMDEE_UNOP(dumu64, dumu64, operator-, 0 - l.mm)
+        SIMDEE_BINOP(dumu64, dumu64, operator+, l.mm + r.mm)
+        SIMDEE_BINOP(dumu64, dumu64, operator-, l.mm - r.mm)
+        SIMDEE_BINOP(dumu64, dumu64, operator*, l.mm * r.mm)
+        SIMDEE_BINOP(dumu64, dumu64, min, std::min(l.mm, r.mm))
+        SIMDEE_BINOP(dumu64, dumu64, max, std::max(l.mm, r.mm))
+#endif
+    };
+
+    struct dums64 : dum_base<dums64> {
+        SIMDEE_TRIVIAL_TYPE(dums64)
+
+        using dum_base::dum_base;
+
+        SIMDEE_INL explicit dums64(const dumd&);
+        SIMDEE_INL explicit dums64(const dumu64&);
+
+        SIMDEE_UNOP(dums64, scalar_t, first_scalar, l.mm)
+
+#if SIMDEE_NEED_INT
+        SIMDEE_BINOP(dums64, dumb64, operator<, dumb64::scalar_t(l.mm < r.mm))
+        SIMDEE_BINOP(dums64, dumb64, operator>, dumb64::scalar_t(l.mm > r.mm))
+        SIMDEE_BINOP(dums64, dumb64, operator<=, dumb64::scalar_t(l.mm <= r.mm))
+        SIMDEE_BINOP(dums64, dumb64, operator>=, dumb64::scalar_t(l.mm >= r.mm))
+        SIMDEE_BINOP(dums64, dumb64, operator==, dumb64::scalar_t(l.mm == r.mm))
+        SIMDEE_BINOP(dums64, dumb64, operator!=, dumb64::scalar_t(l.mm != r.mm))
+
+        SIMDEE_BINOP(dums64, dums64, operator&, l.mm & r.mm)
+        SIMDEE_BINOP(dums64, dums64, operator|, l.mm | r.mm)
+        SIMDEE_BINOP(dums64, dums64, operator^, l.mm ^ r.mm)
+        SIMDEE_UNOP(dums64, dums64, operator~, ~l.mm)
+
+        SIMDEE_UNOP(dums64, dums64, operator-, - l.mm)
+        SIMDEE_BINOP(dums64, dums64, operator+, l.mm + r.mm)
+        SIMDEE_BINOP(dums64, dums64, operator-, l.mm - r.mm)
+        SIMDEE_BINOP(dums64, dums64, operator*, l.mm * r.mm)
+
+        SIMDEE_BINOP(dums64, dums64, min, std::min(l.mm, r.mm))
+        SIMDEE_BINOP(dums64, dums64, max, std::max(l.mm, r.mm))
+        SIMDEE_UNOP(dums64, dums64, abs, std::abs(l.mm))
+#endif
+    };
+
+    SIMDEE_INL dumd::dumd(const dums64& r) { mm = static_cast<scalar_t>(r.data()); }
+    SIMDEE_INL dums64::dums64(const dumd& r) { mm = static_cast<scalar_t>(r.data()); }
+    SIMDEE_INL dumu64::dumu64(const dumb64& r) { mm = static_cast<scalar_t>(r.data()); }
+    SIMDEE_INL dumu64::dumu64(const dums64& r) { mm = static_cast<scalar_t>(r.data()); }
+    SIMDEE_INL dums64::dums64(const dumu64& r) { mm = static_cast<scalar_t>(r.data()); }
+
+    SIMDEE_INL const dumb64 cond(const dumb64& pred, const dumb64& if_true, const dumb64& if_false) {
+        return first_scalar(pred) ? if_true : if_false;
+    }
+    SIMDEE_INL const dumd cond(const dumb64& pred, const dumd& if_true, const dumd& if_false) {
+        return first_scalar(pred) ? if_true : if_false;
+    }
+    SIMDEE_INL const dumu64 cond(const dumb64& pred, const dumu64& if_true, const dumu64& if_false) {
+        return first_scalar(pred) ? if_true : if_false;
+    }
+    SIMDEE_INL const dums64 cond(const dumb64& pred, const dums64& if_true, const dums64& if_false) {
+        return first_scalar(pred) ? if_true : if_false;
+    }
+
+#if SIMDEE_FMA
+    // fused multiply-add; std::fma() is only fast if the target has it in hardware
+    namespace impl {
+        template <typename T>
+        struct dum_fused {
+            using native = std::true_type;
+
+            SIMDEE_INL static T fma(const T& a, const T& b, const T& c) {
+                return std::fma(a.data(), b.data(), c.data());
+            }
+            SIMDEE_INL static T fms(const T& a, const T& b, const T& c) {
+                return std::fma(a.data(), b.data(), -c.data());
+            }
+            SIMDEE_INL static T fnma(const T& a, const T& b, const T& c) {
+                return std::fma(-a.data(), b.data(), c.data());
+            }
+            SIMDEE_INL static T fnms(const T& a, const T& b, const T& c) {
+                return std::fma(-a.data(), b.data(), -c.data());
+            }
+        };
+
+        template <>
+        struct fused<dumf> : dum_fused<dumf> {};
+
+        template <>
+        struct fused<dumd> : dum_fused<dumd> {};
+    } // namespace impl
+#endif
 }
 
 #endif // SIMDEE_SIMD_TYPES_DUM_HPP
@@ -28,6 +28,97 @@ namespace sd {
         SIMDEE_INL void neon_store(const float32x4_t& vec, float* ptr) { vst1q_f32(ptr, vec); }
         SIMDEE_INL void neon_store(const uint32x4_t& vec, uint32_t* ptr) { vst1q_u32(ptr, vec); }
         SIMDEE_INL void neon_store(const int32x4_t& vec, int32_t* ptr) { vst1q_s32(ptr, vec); }
+
+        // structure loads and stores, which (de)interleave 2, 3 or 4 vectors
+        SIMDEE_INL uint32x4x2_t neon_load2(const bool32_t* ptr) {
+            return vld2q_u32(reinterpret_cast<const uint32_t*>(ptr));
+        }
+        SIMDEE_INL float32x4x2_t neon_load2(const float* ptr) { return vld2q_f32(ptr); }
+        SIMDEE_INL uint32x4x2_t neon_load2(const uint32_t* ptr) { return vld2q_u32(ptr); }
+        SIMDEE_INL int32x4x2_t neon_load2(const int32_t* ptr) { return vld2q_s32(ptr); }
+        SIMDEE_INL uint32x4x3_t neon_load3(const bool32_t* ptr) {
+            return vld3q_u32(reinterpret_cast<const uint32_t*>(ptr));
+        }
+        SIMDEE_INL float32x4x3_t neon_load3(const float* ptr) { return vld3q_f32(ptr); }
+        SIMDEE_INL uint32x4x3_t neon_load3(const uint32_t* ptr) { return vld3q_u32(ptr); }
+        SIMDEE_INL int32x4x3_t neon_load3(const int32_t* ptr) { return vld3q_s32(ptr); }
+        SIMDEE_INL uint32x4x4_t neon_load4(const bool32_t* ptr) {
+            return vld4q_u32(reinterpret_cast<const uint32_t*>(ptr));
+        }
+        SIMDEE_INL float32x4x4_t neon_load4(const float* ptr) { return vld4q_f32(ptr); }
+        SIMDEE_INL uint32x4x4_t neon_load4(const uint32_t* ptr) { return vld4q_u32(ptr); }
+        SIMDEE_INL int32x4x4_t neon_load4(const int32_t* ptr) { return vld4q_s32(ptr); }
+        SIMDEE_INL void neon_store2(bool32_t* ptr, const uint32x4x2_t& vecs) {
+            vst2q_u32(reinterpret_cast<uint32_t*>(ptr), vecs);
+        }
+        SIMDEE_INL void neon_store2(float* ptr, const float32x4x2_t& vecs) { vst2q_f32(ptr, vecs); }
+        SIMDEE_INL void neon_store2(uint32_t* ptr, const uint32x4x2_t& vecs) {
+            vst2q_u32(ptr, vecs);
+        }
+        SIMDEE_INL void neon_store2(int32_t* ptr, const int32x4x2_t& vecs) { vst2q_s32(ptr, vecs); }
+        SIMDEE_INL void neon_store3(bool32_t* ptr, const uint32x4x3_t& vecs) {
+            vst3q_u32(reinterpret_cast<uint32_t*>(ptr), vecs);
+        }
+        SIMDEE_INL void neon_store3(float* ptr, const float32x4x3_t& vecs) { vst3q_f32(ptr, vecs); }
+        SIMDEE_INL void neon_store3(uint32_t* ptr, const uint32x4x3_t& vecs) {
+            vst3q_u32(ptr, vecs);
+        }
+        SIMDEE_INL void neon_store3(int32_t* ptr, const int32x4x3_t& vecs) { vst3q_s32(ptr, vecs); }
+        SIMDEE_INL void neon_store4(bool32_t* ptr, const uint32x4x4_t& vecs) {
+            vst4q_u32(reinterpret_cast<uint32_t*>(ptr), vecs);
+        }
+        SIMDEE_INL void neon_store4(float* ptr, const float32x4x4_t& vecs) { vst4q_f32(ptr, vecs); }
+        SIMDEE_INL void neon_store4(uint32_t* ptr, const uint32x4x4_t& vecs) {
+            vst4q_u32(ptr, vecs);
+        }
+        SIMDEE_INL void neon_store4(int32_t* ptr, const int32x4x4_t& vecs) { vst4q_s32(ptr, vecs); }
+
+        // bit casts to and from uint32x4_t
+        SIMDEE_INL uint32x4_t neon_to_u32(const uint32x4_t& vec) { return vec; }
+        SIMDEE_INL uint32x4_t neon_to_u32(const float32x4_t& vec) {
+            return vreinterpretq_u32_f32(vec);
+        }
+        SIMDEE_INL uint32x4_t neon_to_u32(const int32x4_t& vec) {
+            return vreinterpretq_u32_s32(vec);
+        }
+        SIMDEE_INL void neon_from_u32(const uint32x4_t& vec, uint32x4_t& res) { res = vec; }
+        SIMDEE_INL void neon_from_u32(const uint32x4_t& vec, float32x4_t& res) {
+            res = vreinterpretq_f32_u32(vec);
+        }
+        SIMDEE_INL void neon_from_u32(const uint32x4_t& vec, int32x4_t& res) {
+            res = vreinterpretq_s32_u32(vec);
+        }
+
+        // gathers the lowest bit of each lane into a 4-bit value
+#if SIMDEE_ARM64
+        SIMDEE_INL uint32_t neon_movemask(const uint32x4_t& vec) {
+            uint32x4_t temp = {0x1, 0x2, 0x4, 0x8};
+            temp = vandq_u32(temp, vec);
+            temp = vpaddq_u32(temp, temp);
+            temp = vpaddq_u32(temp, temp);
+            return vgetq_lane_u32(temp, 0);
+        }
+#else
+        SIMDEE_INL uint32_t neon_movemask(const uint32x4_t& vec) {
+            uint32x4_t temp = {0x1, 0x2, 0x4, 0x8};
+            temp = vandq_u32(temp, vec);
+            uint32x2_t temp2 = vadd_u32(vget_low_u32(temp), vget_high_u32(temp));
+            temp2 = vadd_u32(temp2, vrev64_u32(temp2));
+            return vget_lane_u32(temp2, 0);
+        }
+#endif
+
+        // the upper halves of the 64-bit products
+        SIMDEE_INL uint32x4_t neon_mulhi(const uint32x4_t& l, const uint32x4_t& r) {
+            uint64x2_t lo = vmull_u32(vget_low_u32(l), vget_low_u32(r));
+            uint64x2_t hi = vmull_u32(vget_high_u32(l), vget_high_u32(r));
+            return vcombine_u32(vshrn_n_u64(lo, 32), vshrn_n_u64(hi, 32));
+        }
+        SIMDEE_INL int32x4_t neon_mulhi(const int32x4_t& l, const int32x4_t& r) {
+            int64x2_t lo = vmull_s32(vget_low_s32(l), vget_low_s32(r));
+            int64x2_t hi = vmull_s32(vget_high_s32(l), vget_high_s32(r));
+            return vcombine_s32(vshrn_n_s64(lo, 32), vshrn_n_s64(hi, 32));
+        }
     } // namespace impl
 
     struct neonb;
@@ -88,6 +179,8 @@ namespace sd {
         using vector_t = typename simd_base<Crtp>::vector_t;
         using scalar_t = typename simd_base<Crtp>::scalar_t;
         using storage_t = typename simd_base<Crtp>::storage_t;
+        using vec_b = typename simd_base<Crtp>::vec_b;
+        using vec_s = typename simd_base<Crtp>::vec_s;
         using simd_base<Crtp>::width;
         using simd_base<Crtp>::self;
 
@@ -95,12 +188,39 @@ namespace sd {
         SIMDEE_BASE_CTOR(neon_base, vector_t, mm = r)
         SIMDEE_BASE_CTOR_TPL(neon_base, expr::aligned<T>, aligned_load(r.ptr))
         SIMDEE_BASE_CTOR_TPL(neon_base, expr::unaligned<T>, unaligned_load(r.ptr))
+        SIMDEE_BASE_CTOR_TPL2(neon_base, expr::masked, masked_load(r.ptr, r.sel))
         SIMDEE_BASE_CTOR(neon_base, storage_t, aligned_load(r.data()))
 
         SIMDEE_INL void aligned_load(const scalar_t* r) { mm = impl::neon_load(r); }
         SIMDEE_INL void aligned_store(scalar_t* r) const { impl::neon_store(mm, r); }
+        // NEON has no non-temporal store intrinsic
+        SIMDEE_INL void stream_store(scalar_t* r) const { impl::neon_store(mm, r); }
         SIMDEE_INL void unaligned_load(const scalar_t* r) { mm = impl::neon_load(r); }
         SIMDEE_INL void unaligned_store(scalar_t* r) const { impl::neon_store(mm, r); }
+        SIMDEE_INL void masked_load(const scalar_t* r, std::size_t count) {
+            self() = impl::masked_emulation<Crtp>::load(r, count);
+        }
+        SIMDEE_INL void masked_load(const scalar_t* r, const vec_b& pred) {
+            self() = impl::masked_emulation<Crtp>::load(r, pred);
+        }
+        SIMDEE_INL void masked_store(scalar_t* r, std::size_t count) const {
+            impl::masked_emulation<Crtp>::store(self(), r, count);
+        }
+        SIMDEE_INL void masked_store(scalar_t* r, const vec_b& pred) const {
+            impl::masked_emulation<Crtp>::store(self(), r, pred);
+        }
+        SIMDEE_INL void gather(const scalar_t* r, const vec_s& idx) {
+            self() = impl::gather_emulation<Crtp>::gather(r, idx);
+        }
+        SIMDEE_INL void gather(const scalar_t* r, const vec_s& idx, const vec_b& pred) {
+            self() = impl::gather_emulation<Crtp>::gather(r, idx, pred);
+        }
+        SIMDEE_INL void scatter(scalar_t* r, const vec_s& idx) const {
+            impl::gather_emulation<Crtp>::scatter(self(), r, idx);
+        }
+        SIMDEE_INL void scatter(scalar_t* r, const vec_s& idx, const vec_b& pred) const {
+            impl::gather_emulation<Crtp>::scatter(self(), r, idx, pred);
+        }
     };
 
 // clang-format off
@@ -187,23 +307,7 @@ SIMDEE_INL const CLASS CLASS::broadcast<3>() {
         SIMDEE_BINOP(neonb, neonb, operator||, vorrq_u32(l.mm, r.mm))
         SIMDEE_UNOP(neonb, not_neonb, operator!, not_neonb(l))
 
-#if SIMDEE_ARM64
-        friend const mask_t mask(const neonb& l) {
-            uint32x4_t temp = {0x1, 0x2, 0x4, 0x8};
-            temp = vandq_u32(temp, l.mm);
-            temp = vpaddq_u32(temp, temp);
-            temp = vpaddq_u32(temp, temp);
-            return mask_t(vgetq_lane_u32(temp, 0));
-        }
-#else
-        friend const mask_t mask(const neonb& l) {
-            uint32x4_t temp = {0x1, 0x2, 0x4, 0x8};
-            temp = vandq_u32(temp, l.mm);
-            uint32x2_t temp2 = vadd_u32(vget_low_u32(temp), vget_high_u32(temp));
-            temp2 = vadd_u32(temp2, vrev64_u32(temp2));
-            return mask_t(vget_lane_u32(temp2, 0));
-        }
-#endif
+        friend const mask_t mask(const neonb& l) { return mask_t(impl::neon_movemask(l.mm)); }
     };
 
     struct neonf final : neon_base<neonf> {
@@ -292,6 +396,24 @@ SIMDEE_INL const CLASS CLASS::broadcast<3>() {
         SIMDEE_BINOP(neonu, neonu, operator*, vmulq_u32(l.mm, r.mm))
         SIMDEE_BINOP(neonu, neonu, min, vminq_u32(l.mm, r.mm))
         SIMDEE_BINOP(neonu, neonu, max, vmaxq_u32(l.mm, r.mm))
+        SIMDEE_BINOP(neonu, neonu, mulhi, impl::neon_mulhi(l.mm, r.mm))
+
+        // vshl shifts to the right by negative counts
+        SIMDEE_INL friend const neonu operator<<(const neonu& l, int r) {
+            return vshlq_u32(l.mm, vdupq_n_s32(r));
+        }
+        SIMDEE_INL friend const neonu operator>>(const neonu& l, int r) {
+            return vshlq_u32(l.mm, vdupq_n_s32(-r));
+        }
+        SIMDEE_BINOP(neonu, neonu, operator<<, vshlq_u32(l.mm, vreinterpretq_s32_u32(r.mm)))
+        SIMDEE_BINOP(neonu, neonu, operator>>,
+                     vshlq_u32(l.mm, vnegq_s32(vreinterpretq_s32_u32(r.mm))))
+        SIMDEE_INL friend const neonu rotl(const neonu& l, int r) {
+            return (l << r) | (l >> ((32 - r) & 31));
+        }
+        SIMDEE_INL friend const neonu rotr(const neonu& l, int r) {
+            return (l >> r) | (l << ((32 - r) & 31));
+        }
 #endif
     };
 
@@ -319,6 +441,16 @@ SIMDEE_INL const CLASS CLASS::broadcast<3>() {
         SIMDEE_BINOP(neons, neons, min, vminq_s32(l.mm, r.mm))
         SIMDEE_BINOP(neons, neons, max, vmaxq_s32(l.mm, r.mm))
         SIMDEE_UNOP(neons, neons, abs, vabsq_s32(l.mm))
+        SIMDEE_BINOP(neons, neons, mulhi, impl::neon_mulhi(l.mm, r.mm))
+
+        SIMDEE_INL friend const neons operator<<(const neons& l, int r) {
+            return vshlq_s32(l.mm, vdupq_n_s32(r));
+        }
+        SIMDEE_INL friend const neons operator>>(const neons& l, int r) {
+            return vshlq_s32(l.mm, vdupq_n_s32(-r));
+        }
+        SIMDEE_BINOP(neons, neons, operator<<, vshlq_s32(l.mm, r.mm))
+        SIMDEE_BINOP(neons, neons, operator>>, vshlq_s32(l.mm, vnegq_s32(r.mm)))
 #endif
     };
 
@@ -382,6 +514,713 @@ SIMDEE_INL const CLASS CLASS::broadcast<3>() {
 
     } // namespace impl
 
+    // interleaved loads and stores, transposition
+    namespace impl {
+
+        template <typename T>
+        struct neon_interleave {
+            using scalar_t = typename simd_vector_traits<T>::scalar_t;
+
+            SIMDEE_INL static void load(const scalar_t* ptr, T& v0, T& v1) {
+                auto r = neon_load2(ptr);
+                v0 = r.val[0];
+                v1 = r.val[1];
+            }
+            SIMDEE_INL static void load(const scalar_t* ptr, T& v0, T& v1, T& v2) {
+                auto r = neon_load3(ptr);
+                v0 = r.val[0];
+                v1 = r.val[1];
+                v2 = r.val[2];
+            }
+            SIMDEE_INL static void load(const scalar_t* ptr, T& v0, T& v1, T& v2, T& v3) {
+                auto r = neon_load4(ptr);
+                v0 = r.val[0];
+                v1 = r.val[1];
+                v2 = r.val[2];
+                v3 = r.val[3];
+            }
+            SIMDEE_INL static void store(scalar_t* ptr, const T& v0, const T& v1) {
+                decltype(neon_load2(ptr)) r = {{v0.data(), v1.data()}};
+                neon_store2(ptr, r);
+            }
+            SIMDEE_INL static void store(scalar_t* ptr, const T& v0, const T& v1, const T& v2) {
+                decltype(neon_load3(ptr)) r = {{v0.data(), v1.data(), v2.data()}};
+                neon_store3(ptr, r);
+            }
+            SIMDEE_INL static void store(scalar_t* ptr, const T& v0, const T& v1, const T& v2,
+                                         const T& v3) {
+                decltype(neon_load4(ptr)) r = {{v0.data(), v1.data(), v2.data(), v3.data()}};
+                neon_store4(ptr, r);
+            }
+        };
+
+        template <>
+        struct interleave<neonb> : neon_interleave<neonb> {};
+
+        template <>
+        struct interleave<neonf> : neon_interleave<neonf> {};
+
+        template <>
+        struct interleave<neonu> : neon_interleave<neonu> {};
+
+        template <>
+        struct interleave<neons> : neon_interleave<neons> {};
+
+        template <typename T>
+        struct neon_transposition {
+            SIMDEE_INL static void apply(T* rows) {
+                uint32x4x2_t ab =
+                    vtrnq_u32(neon_to_u32(rows[0].data()), neon_to_u32(rows[1].data()));
+                uint32x4x2_t cd =
+                    vtrnq_u32(neon_to_u32(rows[2].data()), neon_to_u32(rows[3].data()));
+                neon_from_u32(vcombine_u32(vget_low_u32(ab.val[0]), vget_low_u32(cd.val[0])),
+                              rows[0].data());
+                neon_from_u32(vcombine_u32(vget_low_u32(ab.val[1]), vget_low_u32(cd.val[1])),
+                              rows[1].data());
+                neon_from_u32(vcombine_u32(vget_high_u32(ab.val[0]), vget_high_u32(cd.val[0])),
+                              rows[2].data());
+                neon_from_u32(vcombine_u32(vget_high_u32(ab.val[1]), vget_high_u32(cd.val[1])),
+                              rows[3].data());
+            }
+        };
+
+        template <>
+        struct transposition<neonb> : neon_transposition<neonb> {};
+
+        template <>
+        struct transposition<neonf> : neon_transposition<neonf> {};
+
+        template <>
+        struct transposition<neonu> : neon_transposition<neonu> {};
+
+        template <>
+        struct transposition<neons> : neon_transposition<neons> {};
+
+    } // namespace impl
+
+    // stream compaction
+    namespace impl {
+
+        // the bytes of vec selected by ctrl, zero where ctrl is out of range
+        SIMDEE_INL uint32x4_t neon_lookup(const uint32x4_t& vec, const uint8x16_t& ctrl) {
+            uint8x16_t bytes = vreinterpretq_u8_u32(vec);
+#if SIMDEE_ARM64
+            return vreinterpretq_u32_u8(vqtbl1q_u8(bytes, ctrl));
+#else
+            uint8x8x2_t table = {{vget_low_u8(bytes), vget_high_u8(bytes)}};
+            uint8x8_t lo = vtbl2_u8(table, vget_low_u8(ctrl));
+            uint8x8_t hi = vtbl2_u8(table, vget_high_u8(ctrl));
+            return vreinterpretq_u32_u8(vcombine_u8(lo, hi));
+#endif
+        }
+
+        // shuffles the bytes of vec according to four words of a compress4_table() or
+        // expand4_table() row
+        SIMDEE_INL uint32x4_t neon_shuffle_bytes(const uint32x4_t& vec, const uint32_t* row) {
+            return neon_lookup(vec, vreinterpretq_u8_u32(vld1q_u32(row)));
+        }
+
+        template <typename T>
+        struct neon_compression {
+            using scalar_t = typename simd_vector_traits<T>::scalar_t;
+            using vec_b = typename simd_vector_traits<T>::vec_b;
+
+            SIMDEE_INL static std::size_t compress_store(scalar_t* ptr, const T& v,
+                                                         const vec_b& pred) {
+                uint32_t sel = neon_movemask(pred.data());
+                uint32x4_t src = neon_to_u32(v.data());
+                vst1q_u32(reinterpret_cast<uint32_t*>(ptr),
+                          neon_shuffle_bytes(src, compress4_table() + 4 * sel));
+                return popcount4(sel);
+            }
+            SIMDEE_INL static T expand_load(const scalar_t* ptr, const vec_b& pred) {
+                uint32_t sel = neon_movemask(pred.data());
+                uint32x4_t src = vld1q_u32(reinterpret_cast<const uint32_t*>(ptr));
+                T res;
+                neon_from_u32(neon_shuffle_bytes(src, expand4_table() + 4 * sel), res.data());
+                return res;
+            }
+        };
+
+        template <>
+        struct compression<neonb> : neon_compression<neonb> {};
+
+        template <>
+        struct compression<neonf> : neon_compression<neonf> {};
+
+        template <>
+        struct compression<neonu> : neon_compression<neonu> {};
+
+        template <>
+        struct compression<neons> : neon_compression<neons> {};
+
+    } // namespace impl
+
+    // shuffles and permutes; special cases map to single instructions, the rest is a byte table
+    // lookup
+    namespace impl {
+
+        // the bytes of a and b (as bytes 16 to 31) selected by ctrl
+        SIMDEE_INL uint32x4_t neon_lookup(const uint32x4_t& a, const uint32x4_t& b,
+                                          const uint8x16_t& ctrl) {
+            uint8x16_t a_bytes = vreinterpretq_u8_u32(a), b_bytes = vreinterpretq_u8_u32(b);
+#if SIMDEE_ARM64
+            uint8x16x2_t table = {{a_bytes, b_bytes}};
+            return vreinterpretq_u32_u8(vqtbl2q_u8(table, ctrl));
+#else
+            uint8x8x4_t table = {{vget_low_u8(a_bytes), vget_high_u8(a_bytes),
+                                  vget_low_u8(b_bytes), vget_high_u8(b_bytes)}};
+            uint8x8_t lo = vtbl4_u8(table, vget_low_u8(ctrl));
+            uint8x8_t hi = vtbl4_u8(table, vget_high_u8(ctrl));
+            return vreinterpretq_u32_u8(vcombine_u8(lo, hi));
+#endif
+        }
+
+        // the byte lookup control word that moves the 32-bit lane k
+        constexpr uint32_t neon_lane_bytes(int k) {
+            return uint32_t(k) * 0x04040404U + 0x03020100U;
+        }
+
+        template <typename L>
+        SIMDEE_INL uint8x16_t neon_byte_index() {
+            const uint32_t words[4] = {neon_lane_bytes(L::lane(0)), neon_lane_bytes(L::lane(1)),
+                                       neon_lane_bytes(L::lane(2)), neon_lane_bytes(L::lane(3))};
+            return vreinterpretq_u8_u32(vld1q_u32(words));
+        }
+
+        template <typename T>
+        struct neon_shuffling {
+            using vec_s = typename simd_vector_traits<T>::vec_s;
+
+            template <int... Idx>
+            SIMDEE_INL static T apply(const T& v) {
+                T res;
+                neon_from_u32(shuffle1<Idx...>(neon_to_u32(v.data())), res.data());
+                return res;
+            }
+            template <int... Idx>
+            SIMDEE_INL static T apply(const T& a, const T& b) {
+                T res;
+                neon_from_u32(shuffle2<Idx...>(neon_to_u32(a.data()), neon_to_u32(b.data())),
+                              res.data());
+                return res;
+            }
+            SIMDEE_INL static T permute(const T& v, const vec_s& idx) {
+                // the bytes 4 * idx[i] to 4 * idx[i] + 3 are moved to the i-th lane
+                uint32x4_t at = vmlaq_n_u32(vdupq_n_u32(0x03020100U), neon_to_u32(idx.data()),
+                                            0x04040404U);
+                T res;
+                neon_from_u32(neon_lookup(neon_to_u32(v.data()), vreinterpretq_u8_u32(at)),
+                              res.data());
+                return res;
+            }
+
+        private:
+            template <int... Idx>
+            SIMDEE_INL static uint32x4_t shuffle1(const uint32x4_t& x) {
+                using L = lane_list<Idx...>;
+                constexpr int first = L::lane(0) & 3;
+                constexpr int odd = first & 1;
+                if (L::blend(4)) return x;
+                if (std::is_same<L, lane_list<1, 0, 3, 2>>::value) return vrev64q_u32(x);
+                if (L::splat()) {
+                    return vdupq_lane_u32(first < 2 ? vget_low_u32(x) : vget_high_u32(x), odd);
+                }
+                if (L::consecutive(4)) return vextq_u32(x, x, first);
+                return neon_lookup(x, neon_byte_index<L>());
+            }
+            template <int... Idx>
+            SIMDEE_INL static uint32x4_t shuffle2(const uint32x4_t& x, const uint32x4_t& y) {
+                using L = lane_list<Idx...>;
+                constexpr int first = L::lane(0) & 3;
+                if (L::from(0, 4, 0, 4)) return shuffle1<Idx...>(x);
+                if (L::from(1, 4, 0, 4)) return shuffle1<(Idx & 3)...>(y);
+                if (L::consecutive(8)) {
+                    return L::lane(0) < 4 ? vextq_u32(x, y, first) : vextq_u32(y, x, first);
+                }
+                if (std::is_same<L, lane_list<0, 4, 1, 5>>::value) return vzipq_u32(x, y).val[0];
+                if (std::is_same<L, lane_list<2, 6, 3, 7>>::value) return vzipq_u32(x, y).val[1];
+                if (std::is_same<L, lane_list<0, 2, 4, 6>>::value) return vuzpq_u32(x, y).val[0];
+                if (std::is_same<L, lane_list<1, 3, 5, 7>>::value) return vuzpq_u32(x, y).val[1];
+                if (std::is_same<L, lane_list<0, 4, 2, 6>>::value) return vtrnq_u32(x, y).val[0];
+                if (std::is_same<L, lane_list<1, 5, 3, 7>>::value) return vtrnq_u32(x, y).val[1];
+                if (L::blocks(2)) {
+                    return vcombine_u32(half(x, y, L::lane(0) / 2), half(x, y, L::lane(2) / 2));
+                }
+                if (L::blend(4)) {
+                    const uint32_t sel[4] = {L::lane(0) < 4 ? 0U : ~0U, L::lane(1) < 4 ? 0U : ~0U,
+                                             L::lane(2) < 4 ? 0U : ~0U, L::lane(3) < 4 ? 0U : ~0U};
+                    return vbslq_u32(vld1q_u32(sel), y, x);
+                }
+                return neon_lookup(x, y, neon_byte_index<L>());
+            }
+            // the k-th of the 64-bit halves of x and y
+            SIMDEE_INL static uint32x2_t half(const uint32x4_t& x, const uint32x4_t& y, int k) {
+                const uint32x4_t& v = k < 2 ? x : y;
+                return k % 2 == 0 ? vget_low_u32(v) : vget_high_u32(v);
+            }
+        };
+
+        template <>
+        struct shuffling<neonb> : neon_shuffling<neonb> {};
+
+        template <>
+        struct shuffling<neonf> : neon_shuffling<neonf> {};
+
+        template <>
+        struct shuffling<neonu> : neon_shuffling<neonu> {};
+
+        template <>
+        struct shuffling<neons> : neon_shuffling<neons> {};
+
+    } // namespace impl
+
+    // horizontal operations; AArch64 reduces across the vector in a single instruction, ARMv7 folds
+    // the halves and then the pairs
+    // clang-format off
+#if SIMDEE_ARM64
+//////////////////////////////////////////////////////////////////////////////////////////////////////////
+#define SIMDEE_NEON_HORIZONTAL( CLASS, SUFFIX )                                                          \
+SIMDEE_INL static CLASS::scalar_t apply(const CLASS & v, op_add) {                                       \
+    return vaddvq_ ## SUFFIX (v.data());                                                                 \
+}                                                                                                        \
+                                                                                                         \
+SIMDEE_INL static CLASS::scalar_t apply(const CLASS & v, op_min) {                                       \
+    return vminvq_ ## SUFFIX (v.data());                                                                 \
+}                                                                                                        \
+                                                                                                         \
+SIMDEE_INL static CLASS::scalar_t apply(const CLASS & v, op_max) {                                       \
+    return vmaxvq_ ## SUFFIX (v.data());                                                                 \
+}
+//////////////////////////////////////////////////////////////////////////////////////////////////////////
+#else
+//////////////////////////////////////////////////////////////////////////////////////////////////////////
+#define SIMDEE_NEON_HORIZONTAL( CLASS, SUFFIX )                                                          \
+SIMDEE_INL static CLASS::scalar_t apply(const CLASS & v, op_add) {                                       \
+    auto x = vadd_ ## SUFFIX (vget_low_ ## SUFFIX (v.data()), vget_high_ ## SUFFIX (v.data()));          \
+    return vget_lane_ ## SUFFIX (vpadd_ ## SUFFIX (x, x), 0);                                            \
+}                                                                                                        \
+                                                                                                         \
+SIMDEE_INL static CLASS::scalar_t apply(const CLASS & v, op_min) {                                       \
+    auto x = vmin_ ## SUFFIX (vget_low_ ## SUFFIX (v.data()), vget_high_ ## SUFFIX (v.data()));          \
+    return vget_lane_ ## SUFFIX (vpmin_ ## SUFFIX (x, x), 0);                                            \
+}                                                                                                        \
+                                                                                                         \
+SIMDEE_INL static CLASS::scalar_t apply(const CLASS & v, op_max) {                                       \
+    auto x = vmax_ ## SUFFIX (vget_low_ ## SUFFIX (v.data()), vget_high_ ## SUFFIX (v.data()));          \
+    return vget_lane_ ## SUFFIX (vpmax_ ## SUFFIX (x, x), 0);                                            \
+}
+//////////////////////////////////////////////////////////////////////////////////////////////////////////
+#endif
+    // clang-format on
+
+    namespace impl {
+
+        template <typename T>
+        struct neon_horizontal {
+            using scalar_t = typename simd_vector_traits<T>::scalar_t;
+
+            template <typename Op_t>
+            SIMDEE_INL static scalar_t apply(const T& v, Op_t f) {
+                return first_scalar(reduce(v, f));
+            }
+        };
+
+        template <>
+        struct horizontal<neonf> : neon_horizontal<neonf> {
+            using neon_horizontal::apply;
+            SIMDEE_NEON_HORIZONTAL(neonf, f32)
+        };
+
+        template <>
+        struct horizontal<neonu> : neon_horizontal<neonu> {
+            using neon_horizontal::apply;
+            SIMDEE_NEON_HORIZONTAL(neonu, u32)
+        };
+
+        template <>
+        struct horizontal<neons> : neon_horizontal<neons> {
+            using neon_horizontal::apply;
+            SIMDEE_NEON_HORIZONTAL(neons, s32)
+        };
+
+    } // namespace impl
+
+    // prefix sums
+    namespace impl {
+
+        // v shifted up by Lanes, zeros shifted in
+        template <int Lanes, typename T>
+        SIMDEE_INL T neon_shift_up(const T& v) {
+            constexpr int count = 4 - Lanes;
+            T res;
+            neon_from_u32(vextq_u32(vdupq_n_u32(0), neon_to_u32(v.data()), count), res.data());
+            return res;
+        }
+
+        template <typename T>
+        struct neon_scanning {
+            SIMDEE_INL static T inclusive(const T& v) {
+                T x = v + neon_shift_up<1>(v);
+                return x + neon_shift_up<2>(x);
+            }
+            SIMDEE_INL static T exclusive(const T& v) { return inclusive(neon_shift_up<1>(v)); }
+        };
+
+        template <>
+        struct scanning<neonf> : neon_scanning<neonf> {};
+
+        template <>
+        struct scanning<neonu> : neon_scanning<neonu> {};
+
+        template <>
+        struct scanning<neons> : neon_scanning<neons> {};
+
+    } // namespace impl
+
+#if SIMDEE_ARM64
+
+    //
+    // 64-bit scalars
+    //
+
+    namespace impl {
+        SIMDEE_INL uint64x2_t neon_load(const bool64_t* ptr) {
+            return vld1q_u64(reinterpret_cast<const uint64_t*>(ptr));
+        }
+        SIMDEE_INL float64x2_t neon_load(const double* ptr) { return vld1q_f64(ptr); }
+        SIMDEE_INL uint64x2_t neon_load(const uint64_t* ptr) { return vld1q_u64(ptr); }
+        SIMDEE_INL int64x2_t neon_load(const int64_t* ptr) { return vld1q_s64(ptr); }
+        SIMDEE_INL void neon_store(const uint64x2_t& vec, bool64_t* ptr) {
+            vst1q_u64(reinterpret_cast<uint64_t*>(ptr), vec);
+        }
+        SIMDEE_INL void neon_store(const float64x2_t& vec, double* ptr) { vst1q_f64(ptr, vec); }
+        SIMDEE_INL void neon_store(const uint64x2_t& vec, uint64_t* ptr) { vst1q_u64(ptr, vec); }
+        SIMDEE_INL void neon_store(const int64x2_t& vec, int64_t* ptr) { vst1q_s64(ptr, vec); }
+
+        // there is no 64-bit variant of vmvnq
+        SIMDEE_INL uint64x2_t neon_mvn(const uint64x2_t& vec) {
+            return vreinterpretq_u64_u32(vmvnq_u32(vreinterpretq_u32_u64(vec)));
+        }
+        SIMDEE_INL int64x2_t neon_mvn(const int64x2_t& vec) {
+            return vreinterpretq_s64_u32(vmvnq_u32(vreinterpretq_u32_s64(vec)));
+        }
+    } // namespace impl
+
+    struct neonb64;
+    struct neond;
+    struct neonu64;
+    struct neons64;
+    using not_neonb64 = expr::deferred_lognot<neonb64>;
+    using not_neonu64 = expr::deferred_bitnot<neonu64>;
+    using not_neons64 = expr::deferred_bitnot<neons64>;
+
+    template <>
+    struct is_simd_vector<neonb64> : std::integral_constant<bool, true> {};
+    template <>
+    struct is_simd_vector<neond> : std::integral_constant<bool, true> {};
+    template <>
+    struct is_simd_vector<neonu64> : std::integral_constant<bool, true> {};
+    template <>
+    struct is_simd_vector<neons64> : std::integral_constant<bool, true> {};
+
+    template <typename Simd_t, typename Scalar_t>
+    struct neon64_traits {
+        using simd_t = Simd_t;
+        using scalar_t = Scalar_t;
+        using vec_b = neonb64;
+        using vec_f = neond;
+        using vec_u = neonu64;
+        using vec_s = neons64;
+        using mask_t = impl::mask<0x3U>;
+        using storage_t = impl::storage<simd_t, scalar_t, alignof(int64x2_t)>;
+    };
+
+    template <>
+    struct simd_vector_traits<neonb64> : neon64_traits<neonb64, bool64_t> {
+        using vector_t = uint64x2_t;
+    };
+
+    template <>
+    struct simd_vector_traits<neond> : neon64_traits<neond, double> {
+        using vector_t = float64x2_t;
+    };
+
+    template <>
+    struct simd_vector_traits<neonu64> : neon64_traits<neonu64, uint64_t> {
+        using vector_t = uint64x2_t;
+    };
+
+    template <>
+    struct simd_vector_traits<neons64> : neon64_traits<neons64, int64_t> {
+        using vector_t = int64x2_t;
+    };
+
+// clang-format off
+//////////////////////////////////////////////////////////////////////////////////////////////////////////
+#define SIMDEE_NEON64_COMMON( CLASS, SUFFIX, SCALAR_TYPE )                                               \
+using neon_base::neon_base;                                                                              \
+SIMDEE_TRIVIAL_TYPE( CLASS )                                                                             \
+SIMDEE_CTOR( CLASS , scalar_t, mm = vmovq_n_ ## SUFFIX ( SCALAR_TYPE (r)))                               \
+SIMDEE_CTOR_TPL( CLASS, expr::init<T>, mm = vmovq_n_ ## SUFFIX (r.template to< SCALAR_TYPE >()))         \
+SIMDEE_UNOP( CLASS, scalar_t, first_scalar, vgetq_lane_ ## SUFFIX (l.mm, 0))                             \
+                                                                                                         \
+SIMDEE_INL CLASS (scalar_t v0, scalar_t v1) {                                                            \
+    vector_t v = { SCALAR_TYPE (v0), SCALAR_TYPE (v1) };                                                 \
+    mm = v;                                                                                              \
+}                                                                                                        \
+                                                                                                         \
+template <typename Op_t>                                                                                 \
+friend const CLASS reduce(const CLASS & l, Op_t f) {                                                     \
+    return f(l, vextq_ ## SUFFIX (l.mm, l.mm, 1));                                                       \
+}                                                                                                        \
+                                                                                                         \
+template <unsigned int Lane>                                                                             \
+SIMDEE_INL const CLASS broadcast() {                                                                     \
+    static_assert(Lane < 2, "");                                                                         \
+    return vdupq_laneq_ ## SUFFIX (mm, Lane);                                                            \
+}                                                                                                        \
+//////////////////////////////////////////////////////////////////////////////////////////////////////////
+    // clang-format on
+
+    struct neonb64 final : neon_base<neonb64> {
+        SIMDEE_NEON64_COMMON(neonb64, u64, uint64_t)
+        SIMDEE_CTOR(neonb64, not_neonb64, mm = impl::neon_mvn(r.neg.mm))
+
+        SIMDEE_BINOP(neonb64, neonb64, operator==, vceqq_u64(l.mm, r.mm))
+        SIMDEE_BINOP(neonb64, neonb64, operator!=, veorq_u64(l.mm, r.mm))
+        SIMDEE_BINOP(neonb64, neonb64, operator&&, vandq_u64(l.mm, r.mm))
+        SIMDEE_BINOP(neonb64, neonb64, operator||, vorrq_u64(l.mm, r.mm))
+        SIMDEE_UNOP(neonb64, not_neonb64, operator!, not_neonb64(l))
+
+        friend const mask_t mask(const neonb64& l) {
+            uint64x2_t temp = {0x1, 0x2};
+            temp = vandq_u64(temp, l.mm);
+            return mask_t(uint32_t(vgetq_lane_u64(temp, 0) | vgetq_lane_u64(temp, 1)));
+        }
+    };
+
+    struct neond final : neon_base<neond> {
+        SIMDEE_NEON64_COMMON(neond, f64, double)
+        SIMDEE_INL explicit neond(const neons64&);
+
+        SIMDEE_BINOP(neond, neonb64, operator<, vcltq_f64(l.mm, r.mm))
+        SIMDEE_BINOP(neond, neonb64, operator>, vcgtq_f64(l.mm, r.mm))
+        SIMDEE_BINOP(neond, neonb64, operator<=, vcleq_f64(l.mm, r.mm))
+        SIMDEE_BINOP(neond, neonb64, operator>=, vcgeq_f64(l.mm, r.mm))
+        SIMDEE_BINOP(neond, neonb64, operator==, vceqq_f64(l.mm, r.mm))
+        SIMDEE_BINOP(neond, neonb64, operator!=, impl::neon_mvn(vceqq_f64(l.mm, r.mm)))
+
+        SIMDEE_UNOP(neond, neond, operator-, vnegq_f64(l.mm))
+        SIMDEE_BINOP(neond, neond, operator+, vaddq_f64(l.mm, r.mm))
+        SIMDEE_BINOP(neond, neond, operator-, vsubq_f64(l.mm, r.mm))
+        SIMDEE_BINOP(neond, neond, operator*, vmulq_f64(l.mm, r.mm))
+        SIMDEE_BINOP(neond, neond, operator/, vdivq_f64(l.mm, r.mm))
+
+        SIMDEE_BINOP(neond, neond, min, vminq_f64(l.mm, r.mm))
+        SIMDEE_BINOP(neond, neond, max, vmaxq_f64(l.mm, r.mm))
+        SIMDEE_UNOP(neond, neond, sqrt, vsqrtq_f64(l.mm))
+        // the estimates only carry 8 bits of precision; division is used instead
+        SIMDEE_UNOP(neond, neond, rsqrt, vdivq_f64(vmovq_n_f64(1.), vsqrtq_f64(l.mm)))
+        SIMDEE_UNOP(neond, neond, rcp, vdivq_f64(vmovq_n_f64(1.), l.mm))
+        SIMDEE_UNOP(neond, neond, abs, vabsq_f64(l.mm))
+
+        SIMDEE_INL friend const neond reduce(const neond& l, op_add) { return vpaddq_f64(l.mm, l.mm); }
+        SIMDEE_INL friend const neond reduce(const neond& l, op_min) { return vpminq_f64(l.mm, l.mm); }
+        SIMDEE_INL friend const neond reduce(const neond& l, op_max) { return vpmaxq_f64(l.mm, l.mm); }
+    };
+
+    struct neonu64 final : neon_base<neonu64> {
+        SIMDEE_NEON64_COMMON(neonu64, u64, uint64_t)
+        SIMDEE_INL explicit neonu64(const neonb64&);
+        SIMDEE_INL explicit neonu64(const neons64&);
+        SIMDEE_CTOR(neonu64, not_neonu64, mm = impl::neon_mvn(r.neg.mm))
+
+#if SIMDEE_NEED_INT
+        SIMDEE_BINOP(neonu64, neonb64, operator<, vcltq_u64(l.mm, r.mm))
+        SIMDEE_BINOP(neonu64, neonb64, operator>, vcgtq_u64(l.mm, r.mm))
+        SIMDEE_BINOP(neonu64, neonb64, operator<=, vcleq_u64(l.mm, r.mm))
+        SIMDEE_BINOP(neonu64, neonb64, operator>=, vcgeq_u64(l.mm, r.mm))
+        SIMDEE_BINOP(neonu64, neonb64, operator==, vceqq_u64(l.mm, r.mm))
+        SIMDEE_BINOP(neonu64, neonb64, operator!=, impl::neon_mvn(vceqq_u64(l.mm, r.mm)))
+        SIMDEE_BINOP(neonu64, neonu64, operator&, vandq_u64(l.mm, r.mm))
+        SIMDEE_BINOP(neonu64, neonu64, operator|, vorrq_u64(l.mm, r.mm))
+        SIMDEE_BINOP(neonu64, neonu64, operator^, veorq_u64(l.mm, r.mm))
+        SIMDEE_UNOP(neonu64, not_neonu64, operator~, not_neonu64(l))
+        SIMDEE_UNOP(neonu64, neonu64, operator-,
+                    vreinterpretq_u64_s64(vnegq_s64(vreinterpretq_s64_u64(l.mm))))
+        SIMDEE_BINOP(neonu64, neonu64, operator+, vaddq_u64(l.mm, r.mm))
+        SIMDEE_BINOP(neonu64, neonu64, operator-, vsubq_u64(l.mm, r.mm))
+        SIMDEE_BINOP(neonu64, neonu64, min, vbslq_u64(vcltq_u64(l.mm, r.mm), l.mm, r.mm))
+        SIMDEE_BINOP(neonu64, neonu64, max, vbslq_u64(vcgtq_u64(l.mm, r.mm), l.mm, r.mm))
+
+        // there is no vmulq_u64
+        SIMDEE_INL friend const neonu64 operator*(const neonu64& l, const neonu64& r) {
+            return neonu64(vgetq_lane_u64(l.mm, 0) * vgetq_lane_u64(r.mm, 0),
+                           vgetq_lane_u64(l.mm, 1) * vgetq_lane_u64(r.mm, 1));
+        }
+#endif
+    };
+
+    struct neons64 final : neon_base<neons64> {
+        SIMDEE_NEON64_COMMON(neons64, s64, int64_t)
+        SIMDEE_INL explicit neons64(const neond&);
+        SIMDEE_INL explicit neons64(const neonu64&);
+        SIMDEE_CTOR(neons64, not_neons64, mm = impl::neon_mvn(r.neg.mm))
+
+#if SIMDEE_NEED_INT
+        SIMDEE_BINOP(neons64, neonb64, operator<, vcltq_s64(l.mm, r.mm))
+        SIMDEE_BINOP(neons64, neonb64, operator>, vcgtq_s64(l.mm, r.mm))
+        SIMDEE_BINOP(neons64, neonb64, operator<=, vcleq_s64(l.mm, r.mm))
+        SIMDEE_BINOP(neons64, neonb64, operator>=, vcgeq_s64(l.mm, r.mm))
+        SIMDEE_BINOP(neons64, neonb64, operator==, vceqq_s64(l.mm, r.mm))
+        SIMDEE_BINOP(neons64, neonb64, operator!=, impl::neon_mvn(vceqq_s64(l.mm, r.mm)))
+        SIMDEE_BINOP(neons64, neons64, operator&, vandq_s64(l.mm, r.mm))
+        SIMDEE_BINOP(neons64, neons64, operator|, vorrq_s64(l.mm, r.mm))
+        SIMDEE_BINOP(neons64, neons64, operator^, veorq_s64(l.mm, r.mm))
+        SIMDEE_UNOP(neons64, not_neons64, operator~, not_neons64(l))
+        SIMDEE_UNOP(neons64, neons64, operator-, vnegq_s64(l.mm))
+        SIMDEE_BINOP(neons64, neons64, operator+, vaddq_s64(l.mm, r.mm))
+        SIMDEE_BINOP(neons64, neons64, operator-, vsubq_s64(l.mm, r.mm))
+        SIMDEE_BINOP(neons64, neons64, min, vbslq_s64(vcltq_s64(l.mm, r.mm), l.mm, r.mm))
+        SIMDEE_BINOP(neons64, neons64, max, vbslq_s64(vcgtq_s64(l.mm, r.mm), l.mm, r.mm))
+        SIMDEE_UNOP(neons64, neons64, abs, vabsq_s64(l.mm))
+
+        // there is no vmulq_s64
+        SIMDEE_INL friend const neons64 operator*(const neons64& l, const neons64& r) {
+            return neons64(vgetq_lane_s64(l.mm, 0) * vgetq_lane_s64(r.mm, 0),
+                           vgetq_lane_s64(l.mm, 1) * vgetq_lane_s64(r.mm, 1));
+        }
+#endif
+    };
+
+    SIMDEE_INL neond::neond(const neons64& r) { mm = vcvtq_f64_s64(r.data()); }
+    SIMDEE_INL neons64::neons64(const neond& r) { mm = vcvtq_s64_f64(r.data()); }
+    SIMDEE_INL neonu64::neonu64(const neonb64& r) { mm = r.data(); }
+    SIMDEE_INL neonu64::neonu64(const neons64& r) { mm = vreinterpretq_u64_s64(r.data()); }
+    SIMDEE_INL neons64::neons64(const neonu64& r) { mm = vreinterpretq_s64_u64(r.data()); }
+
+    SIMDEE_INL const neonb64 cond(const neonb64& pred, const neonb64& if_true,
+                                  const neonb64& if_false) {
+        return vbslq_u64(pred.data(), if_true.data(), if_false.data());
+    }
+
+    SIMDEE_INL const neond cond(const neonb64& pred, const neond& if_true, const neond& if_false) {
+        return vbslq_f64(pred.data(), if_true.data(), if_false.data());
+    }
+
+    SIMDEE_INL const neonu64 cond(const neonb64& pred, const neonu64& if_true,
+                                  const neonu64& if_false) {
+        return vbslq_u64(pred.data(), if_true.data(), if_false.data());
+    }
+
+    SIMDEE_INL const neons64 cond(const neonb64& pred, const neons64& if_true,
+                                  const neons64& if_false) {
+        return vbslq_s64(pred.data(), if_true.data(), if_false.data());
+    }
+
+#if SIMDEE_NEED_INT
+    // the full 64-bit products of the lower and of the upper half of the 32-bit scalars
+    SIMDEE_INL const neonu64 mul_wide_lo(const neonu& l, const neonu& r) {
+        return vmull_u32(vget_low_u32(l.data()), vget_low_u32(r.data()));
+    }
+    SIMDEE_INL const neonu64 mul_wide_hi(const neonu& l, const neonu& r) {
+        return vmull_high_u32(l.data(), r.data());
+    }
+    SIMDEE_INL const neons64 mul_wide_lo(const neons& l, const neons& r) {
+        return vmull_s32(vget_low_s32(l.data()), vget_low_s32(r.data()));
+    }
+    SIMDEE_INL const neons64 mul_wide_hi(const neons& l, const neons& r) {
+        return vmull_high_s32(l.data(), r.data());
+    }
+#endif
+
+    namespace impl {
+
+        template <typename T>
+        struct neonbu64_special_ops {
+            SIMDEE_INL static T andnot(const T& l, const T& r) {
+                return vbicq_u64(l.data(), r.data());
+            }
+            SIMDEE_INL static T ornot(const T& l, const T& r) {
+                return vornq_u64(l.data(), r.data());
+            }
+        };
+
+        template <>
+        struct special_ops<neonb64> : neonbu64_special_ops<neonb64> {};
+
+        template <>
+        struct special_ops<neonu64> : neonbu64_special_ops<neonu64> {};
+
+        template <>
+        struct special_ops<neons64> {
+            SIMDEE_INL static neons64 andnot(const neons64& l, const neons64& r) {
+                return vbicq_s64(l.data(), r.data());
+            }
+            SIMDEE_INL static neons64 ornot(const neons64& l, const neons64& r) {
+                return vornq_s64(l.data(), r.data());
+            }
+        };
+
+        template <>
+        struct fused<neond> {
+            using native = std::true_type;
+
+            SIMDEE_INL static neond fma(const neond& a, const neond& b, const neond& c) {
+                return vfmaq_f64(c.data(), a.data(), b.data());
+            }
+            SIMDEE_INL static neond fms(const neond& a, const neond& b, const neond& c) {
+                return vnegq_f64(vfmsq_f64(c.data(), a.data(), b.data()));
+            }
+            SIMDEE_INL static neond fnma(const neond& a, const neond& b, const neond& c) {
+                return vfmsq_f64(c.data(), a.data(), b.data());
+            }
+            SIMDEE_INL static neond fnms(const neond& a, const neond& b, const neond& c) {
+                return vnegq_f64(vfmaq_f64(c.data(), a.data(), b.data()));
+            }
+        };
+
+    } // namespace impl
+
+#endif // SIMDEE_ARM64
+
+    namespace impl {
+
+#if SIMDEE_ARM64 || defined(__ARM_FEATURE_FMA)
+        // fused multiply-add, available on AArch64 and on 32-bit ARM with VFPv4
+        template <>
+        struct fused<neonf> {
+            using native = std::true_type;
+
+            SIMDEE_INL static neonf fma(const neonf& a, const neonf& b, const neonf& c) {
+                return vfmaq_f32(c.data(), a.data(), b.data());
+            }
+            SIMDEE_INL static neonf fms(const neonf& a, const neonf& b, const neonf& c) {
+                return vnegq_f32(vfmsq_f32(c.data(), a.data(), b.data()));
+            }
+            SIMDEE_INL static neonf fnma(const neonf& a, const neonf& b, const neonf& c) {
+                return vfmsq_f32(c.data(), a.data(), b.data());
+            }
+            SIMDEE_INL static neonf fnms(const neonf& a, const neonf& b, const neonf& c) {
+                return vnegq_f32(vfmaq_f32(c.data(), a.data(), b.data()));
+            }
+        };
+#endif
+
+        // Newton-Raphson steps of rcp<accuracy::newton>() and rsqrt<accuracy::newton>()
+        template <>
+        struct newton<neonf> {
+            SIMDEE_INL static neonf rcp(const neonf& x, const neonf& r) {
+                return vmulq_f32(r.data(), vrecpsq_f32(x.data(), r.data()));
+            }
+            SIMDEE_INL static neonf rsqrt(const neonf& x, const neonf& r) {
+                return vmulq_f32(r.data(), vrsqrtsq_f32(vmulq_f32(x.data(), r.data()), r.data()));
+            }
+        };
+
+    } // namespace impl
+
 } // namespace sd
 
 #endif // SIMDEE_SIMD_TYPES_NEON_HPP
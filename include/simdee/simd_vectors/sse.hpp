@@ -20,6 +20,14 @@
 #include <smmintrin.h>
 #endif
 
+#if SIMDEE_SSE42
+#include <nmmintrin.h>
+#endif
+
+#if SIMDEE_AVX || SIMDEE_FMA
+#include <immintrin.h>
+#endif
+
 namespace sd {
     namespace impl {
 #if SIMDEE_SSE41
@@ -27,6 +35,11 @@ namespace sd {
             return _mm_blendv_ps(if_false, if_true, pred);
         }
         SIMDEE_INL __m128i sse_imul(__m128i l, __m128i r) { return _mm_mullo_epi32(l, r); }
+        SIMDEE_INL __m128i sse_mul_epi32(__m128i l, __m128i r) { return _mm_mul_epi32(l, r); }
+        // the upper halves of the 64-bit products of the even and of the odd lanes
+        SIMDEE_INL __m128i sse_merge_hi(__m128i even, __m128i odd) {
+            return _mm_blend_epi16(_mm_srli_epi64(even, 32), odd, 0xcc);
+        }
 #else
         SIMDEE_INL __m128 sse_cond(__m128 pred, __m128 if_true, __m128 if_false) {
             return _mm_or_ps(_mm_and_ps(pred, if_true), _mm_andnot_ps(pred, if_false));
@@ -38,7 +51,29 @@ namespace sd {
             prod_b = _mm_slli_epi64(prod_b, 32);
             return _mm_or_si128(prod_a, prod_b);
         }
+        // the unsigned products of the even lanes, less the lanes that are negative as signed
+        // scalars times the other factor, shifted to the upper half
+        SIMDEE_INL __m128i sse_mul_epi32(__m128i l, __m128i r) {
+            __m128i fix = _mm_add_epi32(_mm_and_si128(_mm_srai_epi32(l, 31), r),
+                                        _mm_and_si128(_mm_srai_epi32(r, 31), l));
+            return _mm_sub_epi64(_mm_mul_epu32(l, r), _mm_slli_epi64(fix, 32));
+        }
+        SIMDEE_INL __m128i sse_merge_hi(__m128i even, __m128i odd) {
+            return _mm_or_si128(_mm_srli_epi64(even, 32),
+                                _mm_and_si128(odd, _mm_setr_epi32(0, -1, 0, -1)));
+        }
 #endif
+        // the lower or the upper two lanes, each twice, so that they end up in the even lanes
+        SIMDEE_INL __m128i sse_dup_lo(__m128 x) { return _mm_castps_si128(_mm_unpacklo_ps(x, x)); }
+        SIMDEE_INL __m128i sse_dup_hi(__m128 x) { return _mm_castps_si128(_mm_unpackhi_ps(x, x)); }
+        SIMDEE_INL __m128i sse_mulhi_epu32(__m128i l, __m128i r) {
+            __m128i odd = _mm_mul_epu32(_mm_srli_epi64(l, 32), _mm_srli_epi64(r, 32));
+            return sse_merge_hi(_mm_mul_epu32(l, r), odd);
+        }
+        SIMDEE_INL __m128i sse_mulhi_epi32(__m128i l, __m128i r) {
+            __m128i odd = sse_mul_epi32(_mm_srli_epi64(l, 32), _mm_srli_epi64(r, 32));
+            return sse_merge_hi(sse_mul_epi32(l, r), odd);
+        }
     } // namespace impl
 
     struct sseb;
@@ -80,6 +115,15 @@ namespace sd {
     template <>
     struct simd_vector_traits<sses> : sse_traits<sses, int32_t> {};
 
+    namespace impl {
+        // the first count lanes set to all ones, as expected by maskload and maskstore
+        template <std::size_t Width, typename Scalar_t>
+        SIMDEE_INL __m128i sse_lane_mask(std::size_t count) {
+            return _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(lane_mask<Width, Scalar_t>(count)));
+        }
+    } // namespace impl
+
     template <typename Crtp>
     struct sse_base : simd_base<Crtp> {
     protected:
@@ -90,6 +134,8 @@ namespace sd {
         using vector_t = typename simd_base<Crtp>::vector_t;
         using scalar_t = typename simd_base<Crtp>::scalar_t;
         using storage_t = typename simd_base<Crtp>::storage_t;
+        using vec_b = typename simd_base<Crtp>::vec_b;
+        using vec_s = typename simd_base<Crtp>::vec_s;
         using simd_base<Crtp>::width;
         using simd_base<Crtp>::self;
 
@@ -100,6 +146,7 @@ namespace sd {
         SIMDEE_BASE_CTOR_FLAG(sse_base, expr::zero, mm = _mm_setzero_ps())
         SIMDEE_BASE_CTOR_TPL(sse_base, expr::aligned<T>, aligned_load(r.ptr))
         SIMDEE_BASE_CTOR_TPL(sse_base, expr::unaligned<T>, unaligned_load(r.ptr))
+        SIMDEE_BASE_CTOR_TPL2(sse_base, expr::masked, masked_load(r.ptr, r.sel))
         SIMDEE_BASE_CTOR_TPL(sse_base, expr::init<T>, *this = r.template to<scalar_t>())
         SIMDEE_BASE_CTOR(sse_base, storage_t, aligned_load(r.data()))
 
@@ -115,12 +162,69 @@ namespace sd {
         SIMDEE_INL void aligned_store(scalar_t* r) const {
             _mm_store_ps(reinterpret_cast<float*>(r), mm);
         }
+        SIMDEE_INL void stream_store(scalar_t* r) const {
+            _mm_stream_ps(reinterpret_cast<float*>(r), mm);
+        }
         SIMDEE_INL void unaligned_load(const scalar_t* r) {
             mm = _mm_loadu_ps(reinterpret_cast<const float*>(r));
         }
         SIMDEE_INL void unaligned_store(scalar_t* r) const {
             _mm_storeu_ps(reinterpret_cast<float*>(r), mm);
         }
+#if SIMDEE_AVX
+        SIMDEE_INL void masked_load(const scalar_t* r, std::size_t count) {
+            mm = _mm_maskload_ps(reinterpret_cast<const float*>(r),
+                                 impl::sse_lane_mask<4, int32_t>(count));
+        }
+        SIMDEE_INL void masked_load(const scalar_t* r, const vec_b& pred) {
+            mm = _mm_maskload_ps(reinterpret_cast<const float*>(r), _mm_castps_si128(pred.data()));
+        }
+        SIMDEE_INL void masked_store(scalar_t* r, std::size_t count) const {
+            _mm_maskstore_ps(reinterpret_cast<float*>(r),
+                             impl::sse_lane_mask<4, int32_t>(count), mm);
+        }
+        SIMDEE_INL void masked_store(scalar_t* r, const vec_b& pred) const {
+            _mm_maskstore_ps(reinterpret_cast<float*>(r), _mm_castps_si128(pred.data()), mm);
+        }
+#else
+        SIMDEE_INL void masked_load(const scalar_t* r, std::size_t count) {
+            self() = impl::masked_emulation<Crtp>::load(r, count);
+        }
+        SIMDEE_INL void masked_load(const scalar_t* r, const vec_b& pred) {
+            self() = impl::masked_emulation<Crtp>::load(r, pred);
+        }
+        SIMDEE_INL void masked_store(scalar_t* r, std::size_t count) const {
+            impl::masked_emulation<Crtp>::store(self(), r, count);
+        }
+        SIMDEE_INL void masked_store(scalar_t* r, const vec_b& pred) const {
+            impl::masked_emulation<Crtp>::store(self(), r, pred);
+        }
+#endif
+
+#if SIMDEE_AVX2
+        SIMDEE_INL void gather(const scalar_t* r, const vec_s& idx) {
+            auto base = reinterpret_cast<const float*>(r);
+            mm = _mm_i32gather_ps(base, _mm_castps_si128(idx.data()), 4);
+        }
+        SIMDEE_INL void gather(const scalar_t* r, const vec_s& idx, const vec_b& pred) {
+            auto base = reinterpret_cast<const float*>(r);
+            auto at = _mm_castps_si128(idx.data());
+            mm = _mm_mask_i32gather_ps(_mm_setzero_ps(), base, at, pred.data(), 4);
+        }
+#else
+        SIMDEE_INL void gather(const scalar_t* r, const vec_s& idx) {
+            self() = impl::gather_emulation<Crtp>::gather(r, idx);
+        }
+        SIMDEE_INL void gather(const scalar_t* r, const vec_s& idx, const vec_b& pred) {
+            self() = impl::gather_emulation<Crtp>::gather(r, idx, pred);
+        }
+#endif
+        SIMDEE_INL void scatter(scalar_t* r, const vec_s& idx) const {
+            impl::gather_emulation<Crtp>::scatter(self(), r, idx);
+        }
+        SIMDEE_INL void scatter(scalar_t* r, const vec_s& idx, const vec_b& pred) const {
+            impl::gather_emulation<Crtp>::scatter(self(), r, idx, pred);
+        }
 
         template <unsigned int Lane>
         SIMDEE_INL const Crtp broadcast() {
@@ -245,6 +349,36 @@ namespace sd {
         SIMDEE_BINOP(sseu, sseu, operator+, _mm_add_epi32(l.mmi(), r.mmi()))
         SIMDEE_BINOP(sseu, sseu, operator-, _mm_sub_epi32(l.mmi(), r.mmi()))
         SIMDEE_BINOP(sseu, sseu, operator*, impl::sse_imul(l.mmi(), r.mmi()))
+        SIMDEE_BINOP(sseu, sseu, mulhi, impl::sse_mulhi_epu32(l.mmi(), r.mmi()))
+
+        SIMDEE_INL friend const sseu operator<<(const sseu& l, int r) {
+            return _mm_sll_epi32(l.mmi(), _mm_cvtsi32_si128(r));
+        }
+        SIMDEE_INL friend const sseu operator>>(const sseu& l, int r) {
+            return _mm_srl_epi32(l.mmi(), _mm_cvtsi32_si128(r));
+        }
+#if SIMDEE_AVX2
+        SIMDEE_BINOP(sseu, sseu, operator<<, _mm_sllv_epi32(l.mmi(), r.mmi()))
+        SIMDEE_BINOP(sseu, sseu, operator>>, _mm_srlv_epi32(l.mmi(), r.mmi()))
+#else
+        SIMDEE_BINOP(sseu, sseu, operator<<, impl::shift_emulation<sseu>::shl(l, r))
+        SIMDEE_BINOP(sseu, sseu, operator>>, impl::shift_emulation<sseu>::shr(l, r))
+#endif
+#if SIMDEE_AVX512
+        SIMDEE_INL friend const sseu rotl(const sseu& l, int r) {
+            return _mm_rolv_epi32(l.mmi(), _mm_set1_epi32(r));
+        }
+        SIMDEE_INL friend const sseu rotr(const sseu& l, int r) {
+            return _mm_rorv_epi32(l.mmi(), _mm_set1_epi32(r));
+        }
+#else
+        SIMDEE_INL friend const sseu rotl(const sseu& l, int r) {
+            return (l << r) | (l >> ((32 - r) & 31));
+        }
+        SIMDEE_INL friend const sseu rotr(const sseu& l, int r) {
+            return (l >> r) | (l << ((32 - r) & 31));
+        }
+#endif
 #endif
     };
 
@@ -279,6 +413,21 @@ namespace sd {
         SIMDEE_BINOP(sses, sses, operator+, _mm_add_epi32(l.mmi(), r.mmi()))
         SIMDEE_BINOP(sses, sses, operator-, _mm_sub_epi32(l.mmi(), r.mmi()))
         SIMDEE_BINOP(sses, sses, operator*, impl::sse_imul(l.mmi(), r.mmi()))
+        SIMDEE_BINOP(sses, sses, mulhi, impl::sse_mulhi_epi32(l.mmi(), r.mmi()))
+
+        SIMDEE_INL friend const sses operator<<(const sses& l, int r) {
+            return _mm_sll_epi32(l.mmi(), _mm_cvtsi32_si128(r));
+        }
+        SIMDEE_INL friend const sses operator>>(const sses& l, int r) {
+            return _mm_sra_epi32(l.mmi(), _mm_cvtsi32_si128(r));
+        }
+#if SIMDEE_AVX2
+        SIMDEE_BINOP(sses, sses, operator<<, _mm_sllv_epi32(l.mmi(), r.mmi()))
+        SIMDEE_BINOP(sses, sses, operator>>, _mm_srav_epi32(l.mmi(), r.mmi()))
+#else
+        SIMDEE_BINOP(sses, sses, operator<<, impl::shift_emulation<sses>::shl(l, r))
+        SIMDEE_BINOP(sses, sses, operator>>, impl::shift_emulation<sses>::shr(l, r))
+#endif
 
 #if SIMDEE_SSE41
         SIMDEE_BINOP(sses, sses, min, _mm_min_epi32(l.mmi(), r.mmi()))
@@ -347,6 +496,1376 @@ namespace sd {
 
     } // namespace impl
 
+    //
+    // 64-bit scalars
+    //
+
+    namespace impl {
+#if SIMDEE_SSE41
+        SIMDEE_INL __m128d sse_cond(__m128d pred, __m128d if_true, __m128d if_false) {
+            return _mm_blendv_pd(if_false, if_true, pred);
+        }
+        SIMDEE_INL __m128i sse_cmpeq_epi64(__m128i l, __m128i r) { return _mm_cmpeq_epi64(l, r); }
+#else
+        SIMDEE_INL __m128d sse_cond(__m128d pred, __m128d if_true, __m128d if_false) {
+            return _mm_or_pd(_mm_and_pd(pred, if_true), _mm_andnot_pd(pred, if_false));
+        }
+        SIMDEE_INL __m128i sse_cmpeq_epi64(__m128i l, __m128i r) {
+            __m128i eq32 = _mm_cmpeq_epi32(l, r);
+            return _mm_and_si128(eq32, _mm_shuffle_epi32(eq32, _MM_SHUFFLE(2, 3, 0, 1)));
+        }
+#endif
+
+#if SIMDEE_SSE42
+        SIMDEE_INL __m128i sse_cmpgt_epi64(__m128i l, __m128i r) { return _mm_cmpgt_epi64(l, r); }
+#else
+        // high halves decide unless they are equal, then the borrow of r - l decides
+        SIMDEE_INL __m128i sse_cmpgt_epi64(__m128i l, __m128i r) {
+            __m128i res = _mm_and_si128(_mm_cmpeq_epi32(l, r), _mm_sub_epi64(r, l));
+            res = _mm_or_si128(res, _mm_cmpgt_epi32(l, r));
+            return _mm_shuffle_epi32(res, _MM_SHUFFLE(3, 3, 1, 1));
+        }
+#endif
+
+        SIMDEE_INL __m128i sse_cmpgt_epu64(__m128i l, __m128i r) {
+            __m128i bias = _mm_set1_epi64x(INT64_MIN);
+            return sse_cmpgt_epi64(_mm_xor_si128(l, bias), _mm_xor_si128(r, bias));
+        }
+
+#if SIMDEE_AVX512
+        SIMDEE_INL __m128i sse_imul64(__m128i l, __m128i r) { return _mm_mullo_epi64(l, r); }
+        SIMDEE_INL __m128d sse_cvtepi64_pd(__m128i r) { return _mm_cvtepi64_pd(r); }
+        SIMDEE_INL __m128i sse_cvttpd_epi64(__m128d r) { return _mm_cvttpd_epi64(r); }
+#else
+        SIMDEE_INL __m128i sse_imul64(__m128i l, __m128i r) {
+            __m128i lo = _mm_mul_epu32(l, r);
+            __m128i cross = _mm_add_epi64(_mm_mul_epu32(_mm_srli_epi64(l, 32), r),
+                                          _mm_mul_epu32(l, _mm_srli_epi64(r, 32)));
+            return _mm_add_epi64(lo, _mm_slli_epi64(cross, 32));
+        }
+
+        // the top 16 bits are added to the exponent of 3*2^67, the low 48 bits are placed into the
+        // mantissa of 2^52; the subtraction and the addition are then exact save for one rounding
+        SIMDEE_INL __m128d sse_cvtepi64_pd(__m128i r) {
+            __m128i hi = _mm_and_si128(_mm_srai_epi32(r, 16), _mm_setr_epi32(0, -1, 0, -1));
+            hi = _mm_add_epi64(hi, _mm_castpd_si128(_mm_set1_pd(442721857769029238784.)));
+            __m128i lo = _mm_and_si128(r, _mm_set1_epi64x(0x0000ffffffffffffLL));
+            lo = _mm_or_si128(lo, _mm_castpd_si128(_mm_set1_pd(4503599627370496.)));
+            __m128d res = _mm_sub_pd(_mm_castsi128_pd(hi), _mm_set1_pd(442726361368656609280.));
+            return _mm_add_pd(res, _mm_castsi128_pd(lo));
+        }
+
+        // SSE2 has no packed double-to-int64 conversion
+        SIMDEE_INL __m128i sse_cvttpd_epi64(__m128d r) {
+            return _mm_set_epi64x(int64_t(_mm_cvtsd_f64(_mm_unpackhi_pd(r, r))),
+                                  int64_t(_mm_cvtsd_f64(r)));
+        }
+#endif
+    } // namespace impl
+
+    struct sseb64;
+    struct ssed;
+    struct sseu64;
+    struct sses64;
+    using not_sseb64 = expr::deferred_lognot<sseb64>;
+    using not_sseu64 = expr::deferred_bitnot<sseu64>;
+    using not_sses64 = expr::deferred_bitnot<sses64>;
+
+    template <>
+    struct is_simd_vector<sseb64> : std::integral_constant<bool, true> {};
+    template <>
+    struct is_simd_vector<ssed> : std::integral_constant<bool, true> {};
+    template <>
+    struct is_simd_vector<sseu64> : std::integral_constant<bool, true> {};
+    template <>
+    struct is_simd_vector<sses64> : std::integral_constant<bool, true> {};
+
+    template <typename Simd_t, typename Scalar_t>
+    struct sse64_traits {
+        using simd_t = Simd_t;
+        using vector_t = __m128d;
+        using scalar_t = Scalar_t;
+        using vec_b = sseb64;
+        using vec_f = ssed;
+        using vec_u = sseu64;
+        using vec_s = sses64;
+        using mask_t = impl::mask<0x3U>;
+        using storage_t = impl::storage<simd_t, scalar_t, alignof(vector_t)>;
+    };
+
+    template <>
+    struct simd_vector_traits<sseb64> : sse64_traits<sseb64, bool64_t> {};
+    template <>
+    struct simd_vector_traits<ssed> : sse64_traits<ssed, double> {};
+    template <>
+    struct simd_vector_traits<sseu64> : sse64_traits<sseu64, uint64_t> {};
+    template <>
+    struct simd_vector_traits<sses64> : sse64_traits<sses64, int64_t> {};
+
+    template <typename Crtp>
+    struct sse64_base : simd_base<Crtp> {
+    protected:
+        using simd_base<Crtp>::mm;
+        SIMDEE_INL __m128i mmi() const { return _mm_castpd_si128(mm); }
+
+    public:
+        using vector_t = typename simd_base<Crtp>::vector_t;
+        using scalar_t = typename simd_base<Crtp>::scalar_t;
+        using storage_t = typename simd_base<Crtp>::storage_t;
+        using vec_b = typename simd_base<Crtp>::vec_b;
+        using vec_s = typename simd_base<Crtp>::vec_s;
+        using simd_base<Crtp>::width;
+        using simd_base<Crtp>::self;
+
+        SIMDEE_TRIVIAL_TYPE(sse64_base)
+
+        SIMDEE_BASE_CTOR(sse64_base, vector_t, mm = r)
+        SIMDEE_BASE_CTOR(sse64_base, scalar_t, mm = _mm_set1_pd(reinterpret_cast<const double&>(r)))
+        SIMDEE_BASE_CTOR_FLAG(sse64_base, expr::zero, mm = _mm_setzero_pd())
+        SIMDEE_BASE_CTOR_TPL(sse64_base, expr::aligned<T>, aligned_load(r.ptr))
+        SIMDEE_BASE_CTOR_TPL(sse64_base, expr::unaligned<T>, unaligned_load(r.ptr))
+        SIMDEE_BASE_CTOR_TPL2(sse64_base, expr::masked, masked_load(r.ptr, r.sel))
+        SIMDEE_BASE_CTOR_TPL(sse64_base, expr::init<T>, *this = r.template to<scalar_t>())
+        SIMDEE_BASE_CTOR(sse64_base, storage_t, aligned_load(r.data()))
+
+        SIMDEE_INL sse64_base(const expr::all_bits& r) { operator=(r); }
+        SIMDEE_INL sse64_base& operator=(const expr::all_bits&) {
+            mm = _mm_castsi128_pd(_mm_cmpeq_epi32(_mm_castpd_si128(mm), _mm_castpd_si128(mm)));
+            return self();
+        }
+
+        SIMDEE_INL void aligned_load(const scalar_t* r) {
+            mm = _mm_load_pd(reinterpret_cast<const double*>(r));
+        }
+        SIMDEE_INL void aligned_store(scalar_t* r) const {
+            _mm_store_pd(reinterpret_cast<double*>(r), mm);
+        }
+        SIMDEE_INL void stream_store(scalar_t* r) const {
+            _mm_stream_pd(reinterpret_cast<double*>(r), mm);
+        }
+        SIMDEE_INL void unaligned_load(const scalar_t* r) {
+            mm = _mm_loadu_pd(reinterpret_cast<const double*>(r));
+        }
+        SIMDEE_INL void unaligned_store(scalar_t* r) const {
+            _mm_storeu_pd(reinterpret_cast<double*>(r), mm);
+        }
+#if SIMDEE_AVX
+        SIMDEE_INL void masked_load(const scalar_t* r, std::size_t count) {
+            mm = _mm_maskload_pd(reinterpret_cast<const double*>(r),
+                                 impl::sse_lane_mask<2, int64_t>(count));
+        }
+        SIMDEE_INL void masked_load(const scalar_t* r, const vec_b& pred) {
+            mm = _mm_maskload_pd(reinterpret_cast<const double*>(r), _mm_castpd_si128(pred.data()));
+        }
+        SIMDEE_INL void masked_store(scalar_t* r, std::size_t count) const {
+            _mm_maskstore_pd(reinterpret_cast<double*>(r),
+                             impl::sse_lane_mask<2, int64_t>(count), mm);
+        }
+        SIMDEE_INL void masked_store(scalar_t* r, const vec_b& pred) const {
+            _mm_maskstore_pd(reinterpret_cast<double*>(r), _mm_castpd_si128(pred.data()), mm);
+        }
+#else
+        SIMDEE_INL void masked_load(const scalar_t* r, std::size_t count) {
+            self() = impl::masked_emulation<Crtp>::load(r, count);
+        }
+        SIMDEE_INL void masked_load(const scalar_t* r, const vec_b& pred) {
+            self() = impl::masked_emulation<Crtp>::load(r, pred);
+        }
+        SIMDEE_INL void masked_store(scalar_t* r, std::size_t count) const {
+            impl::masked_emulation<Crtp>::store(self(), r, count);
+        }
+        SIMDEE_INL void masked_store(scalar_t* r, const vec_b& pred) const {
+            impl::masked_emulation<Crtp>::store(self(), r, pred);
+        }
+#endif
+
+#if SIMDEE_AVX2
+        SIMDEE_INL void gather(const scalar_t* r, const vec_s& idx) {
+            auto base = reinterpret_cast<const double*>(r);
+            mm = _mm_i64gather_pd(base, _mm_castpd_si128(idx.data()), 8);
+        }
+        SIMDEE_INL void gather(const scalar_t* r, const vec_s& idx, const vec_b& pred) {
+            auto base = reinterpret_cast<const double*>(r);
+            auto at = _mm_castpd_si128(idx.data());
+            mm = _mm_mask_i64gather_pd(_mm_setzero_pd(), base, at, pred.data(), 8);
+        }
+#else
+        SIMDEE_INL void gather(const scalar_t* r, const vec_s& idx) {
+            self() = impl::gather_emulation<Crtp>::gather(r, idx);
+        }
+        SIMDEE_INL void gather(const scalar_t* r, const vec_s& idx, const vec_b& pred) {
+            self() = impl::gather_emulation<Crtp>::gather(r, idx, pred);
+        }
+#endif
+        SIMDEE_INL void scatter(scalar_t* r, const vec_s& idx) const {
+            impl::gather_emulation<Crtp>::scatter(self(), r, idx);
+        }
+        SIMDEE_INL void scatter(scalar_t* r, const vec_s& idx, const vec_b& pred) const {
+            impl::gather_emulation<Crtp>::scatter(self(), r, idx, pred);
+        }
+
+        template <unsigned int Lane>
+        SIMDEE_INL const Crtp broadcast() {
+            static_assert(Lane < 2, "");
+            return _mm_shuffle_pd(mm, mm, _MM_SHUFFLE2(Lane, Lane));
+        }
+
+        template <typename Op_t>
+        friend const Crtp reduce(const Crtp& l, Op_t f) {
+            return f(l, _mm_shuffle_pd(l.mm, l.mm, _MM_SHUFFLE2(0, 1)));
+        }
+    };
+
+    struct sseb64 : sse64_base<sseb64> {
+        SIMDEE_TRIVIAL_TYPE(sseb64)
+
+        using sse64_base::sse64_base;
+        SIMDEE_INL sseb64(bool64_t v0, bool64_t v1) {
+            mm = _mm_castsi128_pd(_mm_set_epi64x(int64_t(v1), int64_t(v0)));
+        }
+        SIMDEE_CTOR(sseb64, __m128i, mm = _mm_castsi128_pd(r))
+        SIMDEE_CTOR(sseb64, not_sseb64,
+                    mm = _mm_xor_pd(r.neg.mm,
+                                    _mm_castsi128_pd(_mm_cmpeq_epi32(_mm_castpd_si128(r.neg.mm),
+                                                                     _mm_castpd_si128(r.neg.mm)))))
+
+        SIMDEE_UNOP(sseb64, mask_t, mask, mask_t(cast_u(_mm_movemask_pd(l.mm))))
+        SIMDEE_UNOP(sseb64, scalar_t, first_scalar, dirty::as_b(_mm_cvtsd_f64(l.mm)))
+
+        // boolean lanes are either all zeros or all ones, so 32-bit comparison suffices
+        SIMDEE_BINOP(sseb64, sseb64, operator==, _mm_cmpeq_epi32(l.mmi(), r.mmi()))
+        SIMDEE_BINOP(sseb64, sseb64, operator!=, _mm_xor_pd(l.mm, r.mm))
+        SIMDEE_BINOP(sseb64, sseb64, operator&&, _mm_and_pd(l.mm, r.mm))
+        SIMDEE_BINOP(sseb64, sseb64, operator||, _mm_or_pd(l.mm, r.mm))
+        SIMDEE_UNOP(sseb64, not_sseb64, operator!, not_sseb64(l))
+    };
+
+    struct ssed : sse64_base<ssed> {
+        SIMDEE_TRIVIAL_TYPE(ssed)
+
+        using sse64_base::sse64_base;
+        SIMDEE_INL explicit ssed(const sses64&);
+        SIMDEE_INL ssed(double v0, double v1) { mm = _mm_setr_pd(v0, v1); }
+
+        SIMDEE_UNOP(ssed, scalar_t, first_scalar, _mm_cvtsd_f64(l.mm))
+
+        SIMDEE_BINOP(ssed, sseb64, operator<, _mm_cmplt_pd(l.mm, r.mm))
+        SIMDEE_BINOP(ssed, sseb64, operator>, _mm_cmpgt_pd(l.mm, r.mm))
+        SIMDEE_BINOP(ssed, sseb64, operator<=, _mm_cmple_pd(l.mm, r.mm))
+        SIMDEE_BINOP(ssed, sseb64, operator>=, _mm_cmpge_pd(l.mm, r.mm))
+        SIMDEE_BINOP(ssed, sseb64, operator==, _mm_cmpeq_pd(l.mm, r.mm))
+        SIMDEE_BINOP(ssed, sseb64, operator!=, _mm_cmpneq_pd(l.mm, r.mm))
+
+        SIMDEE_UNOP(ssed, ssed, operator-, _mm_xor_pd(l.mm, ssed(sign_bit()).mm))
+        SIMDEE_BINOP(ssed, ssed, operator+, _mm_add_pd(l.mm, r.mm))
+        SIMDEE_BINOP(ssed, ssed, operator-, _mm_sub_pd(l.mm, r.mm))
+        SIMDEE_BINOP(ssed, ssed, operator*, _mm_mul_pd(l.mm, r.mm))
+        SIMDEE_BINOP(ssed, ssed, operator/, _mm_div_pd(l.mm, r.mm))
+
+        SIMDEE_BINOP(ssed, ssed, min, _mm_min_pd(l.mm, r.mm))
+        SIMDEE_BINOP(ssed, ssed, max, _mm_max_pd(l.mm, r.mm))
+        SIMDEE_UNOP(ssed, ssed, sqrt, _mm_sqrt_pd(l.mm))
+        // there are no approximate double-precision instructions; division is used instead
+        SIMDEE_UNOP(ssed, ssed, rsqrt, _mm_div_pd(_mm_set1_pd(1.), _mm_sqrt_pd(l.mm)))
+        SIMDEE_UNOP(ssed, ssed, rcp, _mm_div_pd(_mm_set1_pd(1.), l.mm))
+        SIMDEE_UNOP(ssed, ssed, abs, _mm_and_pd(l.mm, ssed(abs_mask()).mm))
+    };
+
+    struct sseu64 : sse64_base<sseu64> {
+        SIMDEE_TRIVIAL_TYPE(sseu64)
+
+        using sse64_base::sse64_base;
+        SIMDEE_INL explicit sseu64(const sseb64&);
+        SIMDEE_INL explicit sseu64(const sses64&);
+        SIMDEE_INL sseu64(uint64_t v0, uint64_t v1) {
+            mm = _mm_castsi128_pd(_mm_set_epi64x(int64_t(v1), int64_t(v0)));
+        }
+        SIMDEE_CTOR(sseu64, __m128i, mm = _mm_castsi128_pd(r))
+        SIMDEE_CTOR(sseu64, not_sseu64, mm = _mm_xor_pd(r.neg.mm, sseu64(all_bits()).mm))
+
+        SIMDEE_UNOP(sseu64, scalar_t, first_scalar, dirty::as_u(_mm_cvtsd_f64(l.mm)))
+
+#if SIMDEE_NEED_INT
+        SIMDEE_BINOP(sseu64, sseb64, operator<, impl::sse_cmpgt_epu64(r.mmi(), l.mmi()))
+        SIMDEE_BINOP(sseu64, sseb64, operator>, impl::sse_cmpgt_epu64(l.mmi(), r.mmi()))
+        SIMDEE_BINOP(sseu64, not_sseb64, operator<=,
+                     not_sseb64(impl::sse_cmpgt_epu64(l.mmi(), r.mmi())))
+        SIMDEE_BINOP(sseu64, not_sseb64, operator>=,
+                     not_sseb64(impl::sse_cmpgt_epu64(r.mmi(), l.mmi())))
+        SIMDEE_BINOP(sseu64, sseb64, operator==, impl::sse_cmpeq_epi64(l.mmi(), r.mmi()))
+        SIMDEE_BINOP(sseu64, not_sseb64, operator!=,
+                     not_sseb64(impl::sse_cmpeq_epi64(l.mmi(), r.mmi())))
+        SIMDEE_BINOP(sseu64, sseu64, operator&, _mm_and_pd(l.mm, r.mm))
+        SIMDEE_BINOP(sseu64, sseu64, operator|, _mm_or_pd(l.mm, r.mm))
+        SIMDEE_BINOP(sseu64, sseu64, operator^, _mm_xor_pd(l.mm, r.mm))
+        SIMDEE_UNOP(sseu64, not_sseu64, operator~, not_sseu64(l))
+        SIMDEE_UNOP(sseu64, sseu64, operator-, _mm_sub_epi64(_mm_setzero_si128(), l.mmi()))
+        SIMDEE_BINOP(sseu64, sseu64, operator+, _mm_add_epi64(l.mmi(), r.mmi()))
+        SIMDEE_BINOP(sseu64, sseu64, operator-, _mm_sub_epi64(l.mmi(), r.mmi()))
+        SIMDEE_BINOP(sseu64, sseu64, operator*, impl::sse_imul64(l.mmi(), r.mmi()))
+
+#if SIMDEE_AVX512
+        SIMDEE_BINOP(sseu64, sseu64, min, _mm_min_epu64(l.mmi(), r.mmi()))
+        SIMDEE_BINOP(sseu64, sseu64, max, _mm_max_epu64(l.mmi(), r.mmi()))
+#else
+        SIMDEE_INL friend const sseu64 min(const sseu64& l, const sseu64& r) {
+            return impl::sse_cond((r > l).data(), l.mm, r.mm);
+        }
+        SIMDEE_INL friend const sseu64 max(const sseu64& l, const sseu64& r) {
+            return impl::sse_cond((l > r).data(), l.mm, r.mm);
+        }
+#endif
+#endif
+    };
+
+    struct sses64 : sse64_base<sses64> {
+        SIMDEE_TRIVIAL_TYPE(sses64)
+
+        using sse64_base::sse64_base;
+        SIMDEE_INL explicit sses64(const ssed&);
+        SIMDEE_INL explicit sses64(const sseu64&);
+        SIMDEE_INL sses64(int64_t v0, int64_t v1) {
+            mm = _mm_castsi128_pd(_mm_set_epi64x(v1, v0));
+        }
+        SIMDEE_CTOR(sses64, __m128i, mm = _mm_castsi128_pd(r))
+        SIMDEE_CTOR(sses64, not_sses64, mm = _mm_xor_pd(r.neg.mm, sses64(all_bits()).mm))
+
+        SIMDEE_UNOP(sses64, scalar_t, first_scalar, dirty::as_s(_mm_cvtsd_f64(l.mm)))
+
+#if SIMDEE_NEED_INT
+        SIMDEE_BINOP(sses64, sseb64, operator<, impl::sse_cmpgt_epi64(r.mmi(), l.mmi()))
+        SIMDEE_BINOP(sses64, sseb64, operator>, impl::sse_cmpgt_epi64(l.mmi(), r.mmi()))
+        SIMDEE_BINOP(sses64, not_sseb64, operator<=,
+                     not_sseb64(impl::sse_cmpgt_epi64(l.mmi(), r.mmi())))
+        SIMDEE_BINOP(sses64, not_sseb64, operator>=,
+                     not_sseb64(impl::sse_cmpgt_epi64(r.mmi(), l.mmi())))
+        SIMDEE_BINOP(sses64, sseb64, operator==, impl::sse_cmpeq_epi64(l.mmi(), r.mmi()))
+        SIMDEE_BINOP(sses64, not_sseb64, operator!=,
+                     not_sseb64(impl::sse_cmpeq_epi64(l.mmi(), r.mmi())))
+
+        SIMDEE_BINOP(sses64, sses64, operator&, _mm_and_pd(l.mm, r.mm))
+        SIMDEE_BINOP(sses64, sses64, operator|, _mm_or_pd(l.mm, r.mm))
+        SIMDEE_BINOP(sses64, sses64, operator^, _mm_xor_pd(l.mm, r.mm))
+        SIMDEE_UNOP(sses64, not_sses64, operator~, not_sses64(l))
+
+        SIMDEE_UNOP(sses64, sses64, operator-, _mm_sub_epi64(_mm_setzero_si128(), l.mmi()))
+        SIMDEE_BINOP(sses64, sses64, operator+, _mm_add_epi64(l.mmi(), r.mmi()))
+        SIMDEE_BINOP(sses64, sses64, operator-, _mm_sub_epi64(l.mmi(), r.mmi()))
+        SIMDEE_BINOP(sses64, sses64, operator*, impl::sse_imul64(l.mmi(), r.mmi()))
+
+#if SIMDEE_AVX512
+        SIMDEE_BINOP(sses64, sses64, min, _mm_min_epi64(l.mmi(), r.mmi()))
+        SIMDEE_BINOP(sses64, sses64, max, _mm_max_epi64(l.mmi(), r.mmi()))
+        SIMDEE_UNOP(sses64, sses64, abs, _mm_abs_epi64(l.mmi()))
+#else
+        SIMDEE_INL friend const sses64 min(const sses64& l, const sses64& r) {
+            return impl::sse_cond((r > l).data(), l.mm, r.mm);
+        }
+        SIMDEE_INL friend const sses64 max(const sses64& l, const sses64& r) {
+            return impl::sse_cond((l > r).data(), l.mm, r.mm);
+        }
+        SIMDEE_INL friend const sses64 abs(const sses64& l) {
+            __m128i sign = impl::sse_cmpgt_epi64(_mm_setzero_si128(), l.mmi());
+            return _mm_sub_epi64(_mm_xor_si128(l.mmi(), sign), sign);
+        }
+#endif
+#endif
+    };
+
+    SIMDEE_INL ssed::ssed(const sses64& r) {
+        mm = impl::sse_cvtepi64_pd(_mm_castpd_si128(r.data()));
+    }
+    SIMDEE_INL sses64::sses64(const ssed& r) {
+        mm = _mm_castsi128_pd(impl::sse_cvttpd_epi64(r.data()));
+    }
+    SIMDEE_INL sseu64::sseu64(const sseb64& r) { mm = r.data(); }
+    SIMDEE_INL sseu64::sseu64(const sses64& r) { mm = r.data(); }
+    SIMDEE_INL sses64::sses64(const sseu64& r) { mm = r.data(); }
+
+    SIMDEE_INL const sseb64 cond(const sseb64& pred, const sseb64& if_true,
+                                 const sseb64& if_false) {
+        return impl::sse_cond(pred.data(), if_true.data(), if_false.data());
+    }
+
+    SIMDEE_INL const ssed cond(const sseb64& pred, const ssed& if_true, const ssed& if_false) {
+        return impl::sse_cond(pred.data(), if_true.data(), if_false.data());
+    }
+
+    SIMDEE_INL const sseu64 cond(const sseb64& pred, const sseu64& if_true,
+                                 const sseu64& if_false) {
+        return impl::sse_cond(pred.data(), if_true.data(), if_false.data());
+    }
+
+    SIMDEE_INL const sses64 cond(const sseb64& pred, const sses64& if_true,
+                                 const sses64& if_false) {
+        return impl::sse_cond(pred.data(), if_true.data(), if_false.data());
+    }
+
+#if SIMDEE_NEED_INT
+    // the full 64-bit products of the lower and of the upper half of the 32-bit scalars
+    SIMDEE_INL const sseu64 mul_wide_lo(const sseu& l, const sseu& r) {
+        return _mm_mul_epu32(impl::sse_dup_lo(l.data()), impl::sse_dup_lo(r.data()));
+    }
+    SIMDEE_INL const sseu64 mul_wide_hi(const sseu& l, const sseu& r) {
+        return _mm_mul_epu32(impl::sse_dup_hi(l.data()), impl::sse_dup_hi(r.data()));
+    }
+    SIMDEE_INL const sses64 mul_wide_lo(const sses& l, const sses& r) {
+        return impl::sse_mul_epi32(impl::sse_dup_lo(l.data()), impl::sse_dup_lo(r.data()));
+    }
+    SIMDEE_INL const sses64 mul_wide_hi(const sses& l, const sses& r) {
+        return impl::sse_mul_epi32(impl::sse_dup_hi(l.data()), impl::sse_dup_hi(r.data()));
+    }
+#endif
+
+    namespace impl {
+
+        template <typename T, typename NotT>
+        struct sse64_special_ops {
+            SIMDEE_INL static T andnot(const T& l, const T& r) {
+                return _mm_andnot_pd(r.data(), l.data());
+            }
+            SIMDEE_INL static NotT ornot(const T& l, const T& r) { return NotT(andnot(r, l)); }
+        };
+
+        template <>
+        struct special_ops<sseb64> : sse64_special_ops<sseb64, not_sseb64> {};
+
+        template <>
+        struct special_ops<sseu64> : sse64_special_ops<sseu64, not_sseu64> {};
+
+        template <>
+        struct special_ops<sses64> : sse64_special_ops<sses64, not_sses64> {};
+
+    } // namespace impl
+
+    //
+    // 8-bit and 16-bit scalars
+    //
+
+    namespace impl {
+#if SIMDEE_SSE41
+        SIMDEE_INL __m128i sse_cond(__m128i pred, __m128i if_true, __m128i if_false) {
+            return _mm_blendv_epi8(if_false, if_true, pred);
+        }
+#else
+        SIMDEE_INL __m128i sse_cond(__m128i pred, __m128i if_true, __m128i if_false) {
+            return _mm_or_si128(_mm_and_si128(pred, if_true), _mm_andnot_si128(pred, if_false));
+        }
+#endif
+
+        SIMDEE_INL __m128i sse_not(__m128i v) { return _mm_xor_si128(v, _mm_set1_epi32(-1)); }
+
+        // v rotated down by Bytes, the lowest bytes move to the top
+        template <int Bytes>
+        SIMDEE_INL __m128i sse_rotate_down(__m128i v) {
+            return _mm_or_si128(_mm_srli_si128(v, Bytes), _mm_slli_si128(v, 16 - Bytes));
+        }
+
+        // unsigned comparison by the means of a signed one
+        SIMDEE_INL __m128i sse_cmpgt_epu8(__m128i l, __m128i r) {
+            const __m128i bias = _mm_set1_epi8(-0x80);
+            return _mm_cmpgt_epi8(_mm_xor_si128(l, bias), _mm_xor_si128(r, bias));
+        }
+        SIMDEE_INL __m128i sse_cmpgt_epu16(__m128i l, __m128i r) {
+            const __m128i bias = _mm_set1_epi16(-0x8000);
+            return _mm_cmpgt_epi16(_mm_xor_si128(l, bias), _mm_xor_si128(r, bias));
+        }
+
+        // the signed average, rounded up, by the means of the unsigned one
+        SIMDEE_INL __m128i sse_avg_epi8(__m128i l, __m128i r) {
+            const __m128i bias = _mm_set1_epi8(-0x80);
+            return _mm_xor_si128(_mm_avg_epu8(_mm_xor_si128(l, bias), _mm_xor_si128(r, bias)),
+                                 bias);
+        }
+        SIMDEE_INL __m128i sse_avg_epi16(__m128i l, __m128i r) {
+            const __m128i bias = _mm_set1_epi16(-0x8000);
+            return _mm_xor_si128(_mm_avg_epu16(_mm_xor_si128(l, bias), _mm_xor_si128(r, bias)),
+                                 bias);
+        }
+
+        // operations that only depend on the size of the scalars
+        template <std::size_t Size>
+        struct sse_narrow;
+
+        template <>
+        struct sse_narrow<1> {
+            SIMDEE_INL static __m128i set1(uint8_t v) { return _mm_set1_epi8(char(v)); }
+            SIMDEE_INL static __m128i cmpeq(__m128i l, __m128i r) { return _mm_cmpeq_epi8(l, r); }
+            SIMDEE_INL static __m128i add(__m128i l, __m128i r) { return _mm_add_epi8(l, r); }
+            SIMDEE_INL static __m128i sub(__m128i l, __m128i r) { return _mm_sub_epi8(l, r); }
+        };
+
+        template <>
+        struct sse_narrow<2> {
+            SIMDEE_INL static __m128i set1(uint16_t v) { return _mm_set1_epi16(short(v)); }
+            SIMDEE_INL static __m128i cmpeq(__m128i l, __m128i r) { return _mm_cmpeq_epi16(l, r); }
+            SIMDEE_INL static __m128i add(__m128i l, __m128i r) { return _mm_add_epi16(l, r); }
+            SIMDEE_INL static __m128i sub(__m128i l, __m128i r) { return _mm_sub_epi16(l, r); }
+        };
+    } // namespace impl
+
+    struct sseb8;
+    struct sseu8;
+    struct sses8;
+    struct sseb16;
+    struct sseu16;
+    struct sses16;
+
+    template <>
+    struct is_simd_vector<sseb8> : std::integral_constant<bool, true> {};
+    template <>
+    struct is_simd_vector<sseu8> : std::integral_constant<bool, true> {};
+    template <>
+    struct is_simd_vector<sses8> : std::integral_constant<bool, true> {};
+    template <>
+    struct is_simd_vector<sseb16> : std::integral_constant<bool, true> {};
+    template <>
+    struct is_simd_vector<sseu16> : std::integral_constant<bool, true> {};
+    template <>
+    struct is_simd_vector<sses16> : std::integral_constant<bool, true> {};
+
+    template <typename Simd_t, typename Scalar_t>
+    struct sse8_traits {
+        using simd_t = Simd_t;
+        using vector_t = __m128i;
+        using scalar_t = Scalar_t;
+        using vec_b = sseb8;
+        using vec_f = void; // there are no 8-bit floating-point scalars
+        using vec_u = sseu8;
+        using vec_s = sses8;
+        using mask_t = impl::mask<0xffffU>;
+        using storage_t = impl::storage<simd_t, scalar_t, alignof(vector_t)>;
+    };
+
+    template <typename Simd_t, typename Scalar_t>
+    struct sse16_traits {
+        using simd_t = Simd_t;
+        using vector_t = __m128i;
+        using scalar_t = Scalar_t;
+        using vec_b = sseb16;
+        using vec_f = void; // there are no 16-bit floating-point scalars
+        using vec_u = sseu16;
+        using vec_s = sses16;
+        using mask_t = impl::mask<0xffU>;
+        using storage_t = impl::storage<simd_t, scalar_t, alignof(vector_t)>;
+    };
+
+    template <>
+    struct simd_vector_traits<sseb8> : sse8_traits<sseb8, bool8_t> {};
+    template <>
+    struct simd_vector_traits<sseu8> : sse8_traits<sseu8, uint8_t> {};
+    template <>
+    struct simd_vector_traits<sses8> : sse8_traits<sses8, int8_t> {};
+    template <>
+    struct simd_vector_traits<sseb16> : sse16_traits<sseb16, bool16_t> {};
+    template <>
+    struct simd_vector_traits<sseu16> : sse16_traits<sseu16, uint16_t> {};
+    template <>
+    struct simd_vector_traits<sses16> : sse16_traits<sses16, int16_t> {};
+
+    template <typename Crtp>
+    struct sse_narrow_base : simd_base<Crtp> {
+    protected:
+        using simd_base<Crtp>::mm;
+        using ops = impl::sse_narrow<sizeof(typename simd_base<Crtp>::scalar_t)>;
+
+    public:
+        using vector_t = typename simd_base<Crtp>::vector_t;
+        using scalar_t = typename simd_base<Crtp>::scalar_t;
+        using storage_t = typename simd_base<Crtp>::storage_t;
+        using vec_b = typename simd_base<Crtp>::vec_b;
+        using simd_base<Crtp>::width;
+        using simd_base<Crtp>::self;
+
+        SIMDEE_TRIVIAL_TYPE(sse_narrow_base)
+
+        SIMDEE_BASE_CTOR(sse_narrow_base, vector_t, mm = r)
+        SIMDEE_BASE_CTOR(sse_narrow_base, scalar_t, mm = ops::set1(dirty::as_u(r)))
+        SIMDEE_BASE_CTOR_FLAG(sse_narrow_base, expr::zero, mm = _mm_setzero_si128())
+        SIMDEE_BASE_CTOR_FLAG(sse_narrow_base, expr::all_bits, mm = _mm_set1_epi32(-1))
+        SIMDEE_BASE_CTOR_TPL(sse_narrow_base, expr::aligned<T>, aligned_load(r.ptr))
+        SIMDEE_BASE_CTOR_TPL(sse_narrow_base, expr::unaligned<T>, unaligned_load(r.ptr))
+        SIMDEE_BASE_CTOR_TPL2(sse_narrow_base, expr::masked, masked_load(r.ptr, r.sel))
+        SIMDEE_BASE_CTOR_TPL(sse_narrow_base, expr::init<T>, *this = r.template to<scalar_t>())
+        SIMDEE_BASE_CTOR(sse_narrow_base, storage_t, aligned_load(r.data()))
+
+        SIMDEE_INL void aligned_load(const scalar_t* r) {
+            mm = _mm_load_si128(reinterpret_cast<const __m128i*>(r));
+        }
+        SIMDEE_INL void aligned_store(scalar_t* r) const {
+            _mm_store_si128(reinterpret_cast<__m128i*>(r), mm);
+        }
+        SIMDEE_INL void stream_store(scalar_t* r) const {
+            _mm_stream_si128(reinterpret_cast<__m128i*>(r), mm);
+        }
+        SIMDEE_INL void unaligned_load(const scalar_t* r) {
+            mm = _mm_loadu_si128(reinterpret_cast<const __m128i*>(r));
+        }
+        SIMDEE_INL void unaligned_store(scalar_t* r) const {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(r), mm);
+        }
+        SIMDEE_INL void masked_load(const scalar_t* r, std::size_t count) {
+            self() = impl::masked_emulation<Crtp>::load(r, count);
+        }
+        SIMDEE_INL void masked_load(const scalar_t* r, const vec_b& pred) {
+            self() = impl::masked_emulation<Crtp>::load(r, pred);
+        }
+        SIMDEE_INL void masked_store(scalar_t* r, std::size_t count) const {
+            impl::masked_emulation<Crtp>::store(self(), r, count);
+        }
+        SIMDEE_INL void masked_store(scalar_t* r, const vec_b& pred) const {
+            impl::masked_emulation<Crtp>::store(self(), r, pred);
+        }
+
+        template <unsigned int Lane>
+        SIMDEE_INL const Crtp broadcast() {
+            static_assert(Lane < width, "");
+            return Crtp(storage_t(self())[Lane]);
+        }
+
+        template <typename Op_t>
+        friend const Crtp reduce(const Crtp& l, Op_t f) {
+            Crtp tmp = f(l, Crtp(impl::sse_rotate_down<8>(l.mm)));
+            tmp = f(tmp, Crtp(impl::sse_rotate_down<4>(tmp.mm)));
+            tmp = f(tmp, Crtp(impl::sse_rotate_down<2>(tmp.mm)));
+            if (width == 8) return tmp;
+            return f(tmp, Crtp(impl::sse_rotate_down<1>(tmp.mm)));
+        }
+    };
+
+    struct sseb8 : sse_narrow_base<sseb8> {
+        SIMDEE_TRIVIAL_TYPE(sseb8)
+
+        using sse_narrow_base::sse_narrow_base;
+
+        SIMDEE_UNOP(sseb8, mask_t, mask, mask_t(cast_u(_mm_movemask_epi8(l.mm))))
+        SIMDEE_UNOP(sseb8, scalar_t, first_scalar, scalar_t(uint8_t(_mm_cvtsi128_si32(l.mm))))
+
+        SIMDEE_BINOP(sseb8, sseb8, operator==, _mm_cmpeq_epi8(l.mm, r.mm))
+        SIMDEE_BINOP(sseb8, sseb8, operator!=, _mm_xor_si128(l.mm, r.mm))
+        SIMDEE_BINOP(sseb8, sseb8, operator&&, _mm_and_si128(l.mm, r.mm))
+        SIMDEE_BINOP(sseb8, sseb8, operator||, _mm_or_si128(l.mm, r.mm))
+        SIMDEE_UNOP(sseb8, sseb8, operator!, impl::sse_not(l.mm))
+    };
+
+    struct sseu8 : sse_narrow_base<sseu8> {
+        SIMDEE_TRIVIAL_TYPE(sseu8)
+
+        using sse_narrow_base::sse_narrow_base;
+        SIMDEE_INL explicit sseu8(const sseb8&);
+        SIMDEE_INL explicit sseu8(const sses8&);
+
+        SIMDEE_UNOP(sseu8, scalar_t, first_scalar, scalar_t(_mm_cvtsi128_si32(l.mm)))
+
+#if SIMDEE_NEED_INT
+        SIMDEE_BINOP(sseu8, sseb8, operator<, impl::sse_cmpgt_epu8(r.mm, l.mm))
+        SIMDEE_BINOP(sseu8, sseb8, operator>, impl::sse_cmpgt_epu8(l.mm, r.mm))
+        SIMDEE_BINOP(sseu8, sseb8, operator<=, _mm_cmpeq_epi8(_mm_max_epu8(l.mm, r.mm), r.mm))
+        SIMDEE_BINOP(sseu8, sseb8, operator>=, _mm_cmpeq_epi8(_mm_max_epu8(l.mm, r.mm), l.mm))
+        SIMDEE_BINOP(sseu8, sseb8, operator==, _mm_cmpeq_epi8(l.mm, r.mm))
+        SIMDEE_BINOP(sseu8, sseb8, operator!=, impl::sse_not(_mm_cmpeq_epi8(l.mm, r.mm)))
+
+        SIMDEE_BINOP(sseu8, sseu8, operator&, _mm_and_si128(l.mm, r.mm))
+        SIMDEE_BINOP(sseu8, sseu8, operator|, _mm_or_si128(l.mm, r.mm))
+        SIMDEE_BINOP(sseu8, sseu8, operator^, _mm_xor_si128(l.mm, r.mm))
+        SIMDEE_UNOP(sseu8, sseu8, operator~, impl::sse_not(l.mm))
+
+        SIMDEE_UNOP(sseu8, sseu8, operator-, _mm_sub_epi8(_mm_setzero_si128(), l.mm))
+        SIMDEE_BINOP(sseu8, sseu8, operator+, _mm_add_epi8(l.mm, r.mm))
+        SIMDEE_BINOP(sseu8, sseu8, operator-, _mm_sub_epi8(l.mm, r.mm))
+        SIMDEE_BINOP(sseu8, sseu8, add_sat, _mm_adds_epu8(l.mm, r.mm))
+        SIMDEE_BINOP(sseu8, sseu8, sub_sat, _mm_subs_epu8(l.mm, r.mm))
+        SIMDEE_BINOP(sseu8, sseu8, avg, _mm_avg_epu8(l.mm, r.mm))
+        SIMDEE_BINOP(sseu8, sseu8, min, _mm_min_epu8(l.mm, r.mm))
+        SIMDEE_BINOP(sseu8, sseu8, max, _mm_max_epu8(l.mm, r.mm))
+#endif
+    };
+
+    struct sses8 : sse_narrow_base<sses8> {
+        SIMDEE_TRIVIAL_TYPE(sses8)
+
+        using sse_narrow_base::sse_narrow_base;
+        SIMDEE_INL explicit sses8(const sseu8&);
+
+        SIMDEE_UNOP(sses8, scalar_t, first_scalar, scalar_t(_mm_cvtsi128_si32(l.mm)))
+
+#if SIMDEE_NEED_INT
+        SIMDEE_BINOP(sses8, sseb8, operator<, _mm_cmplt_epi8(l.mm, r.mm))
+        SIMDEE_BINOP(sses8, sseb8, operator>, _mm_cmpgt_epi8(l.mm, r.mm))
+        SIMDEE_BINOP(sses8, sseb8, operator<=, impl::sse_not(_mm_cmpgt_epi8(l.mm, r.mm)))
+        SIMDEE_BINOP(sses8, sseb8, operator>=, impl::sse_not(_mm_cmplt_epi8(l.mm, r.mm)))
+        SIMDEE_BINOP(sses8, sseb8, operator==, _mm_cmpeq_epi8(l.mm, r.mm))
+        SIMDEE_BINOP(sses8, sseb8, operator!=, impl::sse_not(_mm_cmpeq_epi8(l.mm, r.mm)))
+
+        SIMDEE_BINOP(sses8, sses8, operator&, _mm_and_si128(l.mm, r.mm))
+        SIMDEE_BINOP(sses8, sses8, operator|, _mm_or_si128(l.mm, r.mm))
+        SIMDEE_BINOP(sses8, sses8, operator^, _mm_xor_si128(l.mm, r.mm))
+        SIMDEE_UNOP(sses8, sses8, operator~, impl::sse_not(l.mm))
+
+        SIMDEE_UNOP(sses8, sses8, operator-, _mm_sub_epi8(_mm_setzero_si128(), l.mm))
+        SIMDEE_BINOP(sses8, sses8, operator+, _mm_add_epi8(l.mm, r.mm))
+        SIMDEE_BINOP(sses8, sses8, operator-, _mm_sub_epi8(l.mm, r.mm))
+        SIMDEE_BINOP(sses8, sses8, add_sat, _mm_adds_epi8(l.mm, r.mm))
+        SIMDEE_BINOP(sses8, sses8, sub_sat, _mm_subs_epi8(l.mm, r.mm))
+        SIMDEE_BINOP(sses8, sses8, avg, impl::sse_avg_epi8(l.mm, r.mm))
+
+#if SIMDEE_SSE41
+        SIMDEE_BINOP(sses8, sses8, min, _mm_min_epi8(l.mm, r.mm))
+        SIMDEE_BINOP(sses8, sses8, max, _mm_max_epi8(l.mm, r.mm))
+#else
+        SIMDEE_BINOP(sses8, sses8, min, impl::sse_cond(_mm_cmpgt_epi8(r.mm, l.mm), l.mm, r.mm))
+        SIMDEE_BINOP(sses8, sses8, max, impl::sse_cond(_mm_cmpgt_epi8(l.mm, r.mm), l.mm, r.mm))
+#endif
+
+#if SIMDEE_SSSE3
+        SIMDEE_UNOP(sses8, sses8, abs, _mm_abs_epi8(l.mm))
+#else
+        SIMDEE_UNOP(sses8, sses8, abs, max(l, -l))
+#endif
+#endif
+    };
+
+    struct sseb16 : sse_narrow_base<sseb16> {
+        SIMDEE_TRIVIAL_TYPE(sseb16)
+
+        using sse_narrow_base::sse_narrow_base;
+
+        SIMDEE_UNOP(sseb16, mask_t, mask,
+                    mask_t(cast_u(_mm_movemask_epi8(_mm_packs_epi16(l.mm, _mm_setzero_si128())))))
+        SIMDEE_UNOP(sseb16, scalar_t, first_scalar, scalar_t(uint16_t(_mm_cvtsi128_si32(l.mm))))
+
+        SIMDEE_BINOP(sseb16, sseb16, operator==, _mm_cmpeq_epi16(l.mm, r.mm))
+        SIMDEE_BINOP(sseb16, sseb16, operator!=, _mm_xor_si128(l.mm, r.mm))
+        SIMDEE_BINOP(sseb16, sseb16, operator&&, _mm_and_si128(l.mm, r.mm))
+        SIMDEE_BINOP(sseb16, sseb16, operator||, _mm_or_si128(l.mm, r.mm))
+        SIMDEE_UNOP(sseb16, sseb16, operator!, impl::sse_not(l.mm))
+    };
+
+    struct sseu16 : sse_narrow_base<sseu16> {
+        SIMDEE_TRIVIAL_TYPE(sseu16)
+
+        using sse_narrow_base::sse_narrow_base;
+        SIMDEE_INL explicit sseu16(const sseb16&);
+        SIMDEE_INL explicit sseu16(const sses16&);
+
+        SIMDEE_UNOP(sseu16, scalar_t, first_scalar, scalar_t(_mm_cvtsi128_si32(l.mm)))
+
+#if SIMDEE_NEED_INT
+        SIMDEE_BINOP(sseu16, sseb16, operator<, impl::sse_cmpgt_epu16(r.mm, l.mm))
+        SIMDEE_BINOP(sseu16, sseb16, operator>, impl::sse_cmpgt_epu16(l.mm, r.mm))
+        SIMDEE_BINOP(sseu16, sseb16, operator<=,
+                     _mm_cmpeq_epi16(_mm_subs_epu16(l.mm, r.mm), _mm_setzero_si128()))
+        SIMDEE_BINOP(sseu16, sseb16, operator>=,
+                     _mm_cmpeq_epi16(_mm_subs_epu16(r.mm, l.mm), _mm_setzero_si128()))
+        SIMDEE_BINOP(sseu16, sseb16, operator==, _mm_cmpeq_epi16(l.mm, r.mm))
+        SIMDEE_BINOP(sseu16, sseb16, operator!=, impl::sse_not(_mm_cmpeq_epi16(l.mm, r.mm)))
+
+        SIMDEE_BINOP(sseu16, sseu16, operator&, _mm_and_si128(l.mm, r.mm))
+        SIMDEE_BINOP(sseu16, sseu16, operator|, _mm_or_si128(l.mm, r.mm))
+        SIMDEE_BINOP(sseu16, sseu16, operator^, _mm_xor_si128(l.mm, r.mm))
+        SIMDEE_UNOP(sseu16, sseu16, operator~, impl::sse_not(l.mm))
+
+        SIMDEE_UNOP(sseu16, sseu16, operator-, _mm_sub_epi16(_mm_setzero_si128(), l.mm))
+        SIMDEE_BINOP(sseu16, sseu16, operator+, _mm_add_epi16(l.mm, r.mm))
+        SIMDEE_BINOP(sseu16, sseu16, operator-, _mm_sub_epi16(l.mm, r.mm))
+        SIMDEE_BINOP(sseu16, sseu16, operator*, _mm_mullo_epi16(l.mm, r.mm))
+        SIMDEE_BINOP(sseu16, sseu16, mulhi, _mm_mulhi_epu16(l.mm, r.mm))
+        SIMDEE_BINOP(sseu16, sseu16, add_sat, _mm_adds_epu16(l.mm, r.mm))
+        SIMDEE_BINOP(sseu16, sseu16, sub_sat, _mm_subs_epu16(l.mm, r.mm))
+        SIMDEE_BINOP(sseu16, sseu16, avg, _mm_avg_epu16(l.mm, r.mm))
+
+#if SIMDEE_SSE41
+        SIMDEE_BINOP(sseu16, sseu16, min, _mm_min_epu16(l.mm, r.mm))
+        SIMDEE_BINOP(sseu16, sseu16, max, _mm_max_epu16(l.mm, r.mm))
+#else
+        SIMDEE_BINOP(sseu16, sseu16, min, _mm_sub_epi16(l.mm, _mm_subs_epu16(l.mm, r.mm)))
+        SIMDEE_BINOP(sseu16, sseu16, max, _mm_add_epi16(r.mm, _mm_subs_epu16(l.mm, r.mm)))
+#endif
+#endif
+    };
+
+    struct sses16 : sse_narrow_base<sses16> {
+        SIMDEE_TRIVIAL_TYPE(sses16)
+
+        using sse_narrow_base::sse_narrow_base;
+        SIMDEE_INL explicit sses16(const sseu16&);
+
+        SIMDEE_UNOP(sses16, scalar_t, first_scalar, scalar_t(_mm_cvtsi128_si32(l.mm)))
+
+#if SIMDEE_NEED_INT
+        SIMDEE_BINOP(sses16, sseb16, operator<, _mm_cmplt_epi16(l.mm, r.mm))
+        SIMDEE_BINOP(sses16, sseb16, operator>, _mm_cmpgt_epi16(l.mm, r.mm))
+        SIMDEE_BINOP(sses16, sseb16, operator<=, impl::sse_not(_mm_cmpgt_epi16(l.mm, r.mm)))
+        SIMDEE_BINOP(sses16, sseb16, operator>=, impl::sse_not(_mm_cmplt_epi16(l.mm, r.mm)))
+        SIMDEE_BINOP(sses16, sseb16, operator==, _mm_cmpeq_epi16(l.mm, r.mm))
+        SIMDEE_BINOP(sses16, sseb16, operator!=, impl::sse_not(_mm_cmpeq_epi16(l.mm, r.mm)))
+
+        SIMDEE_BINOP(sses16, sses16, operator&, _mm_and_si128(l.mm, r.mm))
+        SIMDEE_BINOP(sses16, sses16, operator|, _mm_or_si128(l.mm, r.mm))
+        SIMDEE_BINOP(sses16, sses16, operator^, _mm_xor_si128(l.mm, r.mm))
+        SIMDEE_UNOP(sses16, sses16, operator~, impl::sse_not(l.mm))
+
+        SIMDEE_UNOP(sses16, sses16, operator-, _mm_sub_epi16(_mm_setzero_si128(), l.mm))
+        SIMDEE_BINOP(sses16, sses16, operator+, _mm_add_epi16(l.mm, r.mm))
+        SIMDEE_BINOP(sses16, sses16, operator-, _mm_sub_epi16(l.mm, r.mm))
+        SIMDEE_BINOP(sses16, sses16, operator*, _mm_mullo_epi16(l.mm, r.mm))
+        SIMDEE_BINOP(sses16, sses16, mulhi, _mm_mulhi_epi16(l.mm, r.mm))
+        SIMDEE_BINOP(sses16, sses16, add_sat, _mm_adds_epi16(l.mm, r.mm))
+        SIMDEE_BINOP(sses16, sses16, sub_sat, _mm_subs_epi16(l.mm, r.mm))
+        SIMDEE_BINOP(sses16, sses16, avg, impl::sse_avg_epi16(l.mm, r.mm))
+        SIMDEE_BINOP(sses16, sses16, min, _mm_min_epi16(l.mm, r.mm))
+        SIMDEE_BINOP(sses16, sses16, max, _mm_max_epi16(l.mm, r.mm))
+
+#if SIMDEE_SSSE3
+        SIMDEE_UNOP(sses16, sses16, abs, _mm_abs_epi16(l.mm))
+#else
+        SIMDEE_UNOP(sses16, sses16, abs, max(l, -l))
+#endif
+#endif
+    };
+
+    SIMDEE_INL sseu8::sseu8(const sseb8& r) { mm = r.data(); }
+    SIMDEE_INL sseu8::sseu8(const sses8& r) { mm = r.data(); }
+    SIMDEE_INL sses8::sses8(const sseu8& r) { mm = r.data(); }
+    SIMDEE_INL sseu16::sseu16(const sseb16& r) { mm = r.data(); }
+    SIMDEE_INL sseu16::sseu16(const sses16& r) { mm = r.data(); }
+    SIMDEE_INL sses16::sses16(const sseu16& r) { mm = r.data(); }
+
+    SIMDEE_INL const sseb8 cond(const sseb8& pred, const sseb8& if_true, const sseb8& if_false) {
+        return impl::sse_cond(pred.data(), if_true.data(), if_false.data());
+    }
+
+    SIMDEE_INL const sseu8 cond(const sseb8& pred, const sseu8& if_true, const sseu8& if_false) {
+        return impl::sse_cond(pred.data(), if_true.data(), if_false.data());
+    }
+
+    SIMDEE_INL const sses8 cond(const sseb8& pred, const sses8& if_true, const sses8& if_false) {
+        return impl::sse_cond(pred.data(), if_true.data(), if_false.data());
+    }
+
+    SIMDEE_INL const sseb16 cond(const sseb16& pred, const sseb16& if_true,
+                                 const sseb16& if_false) {
+        return impl::sse_cond(pred.data(), if_true.data(), if_false.data());
+    }
+
+    SIMDEE_INL const sseu16 cond(const sseb16& pred, const sseu16& if_true,
+                                 const sseu16& if_false) {
+        return impl::sse_cond(pred.data(), if_true.data(), if_false.data());
+    }
+
+    SIMDEE_INL const sses16 cond(const sseb16& pred, const sses16& if_true,
+                                 const sses16& if_false) {
+        return impl::sse_cond(pred.data(), if_true.data(), if_false.data());
+    }
+
+#if SIMDEE_NEED_INT
+    // the lower and the upper half of the scalars, zero- or sign-extended to twice the size
+    SIMDEE_INL const sseu16 widen_lo(const sseu8& v) {
+        return _mm_unpacklo_epi8(v.data(), _mm_setzero_si128());
+    }
+    SIMDEE_INL const sseu16 widen_hi(const sseu8& v) {
+        return _mm_unpackhi_epi8(v.data(), _mm_setzero_si128());
+    }
+    SIMDEE_INL const sses16 widen_lo(const sses8& v) {
+        return _mm_srai_epi16(_mm_unpacklo_epi8(v.data(), v.data()), 8);
+    }
+    SIMDEE_INL const sses16 widen_hi(const sses8& v) {
+        return _mm_srai_epi16(_mm_unpackhi_epi8(v.data(), v.data()), 8);
+    }
+    SIMDEE_INL const sseu widen_lo(const sseu16& v) {
+        return _mm_unpacklo_epi16(v.data(), _mm_setzero_si128());
+    }
+    SIMDEE_INL const sseu widen_hi(const sseu16& v) {
+        return _mm_unpackhi_epi16(v.data(), _mm_setzero_si128());
+    }
+    SIMDEE_INL const sses widen_lo(const sses16& v) {
+        return _mm_srai_epi32(_mm_unpacklo_epi16(v.data(), v.data()), 16);
+    }
+    SIMDEE_INL const sses widen_hi(const sses16& v) {
+        return _mm_srai_epi32(_mm_unpackhi_epi16(v.data(), v.data()), 16);
+    }
+
+    // the scalars of lo followed by those of hi, saturated to half the size
+    SIMDEE_INL const sseu8 narrow(const sseu16& lo, const sseu16& hi) {
+        // packus treats its input as signed
+        const sseu16 top(uint16_t(0xff));
+        return _mm_packus_epi16(min(lo, top).data(), min(hi, top).data());
+    }
+    SIMDEE_INL const sses8 narrow(const sses16& lo, const sses16& hi) {
+        return _mm_packs_epi16(lo.data(), hi.data());
+    }
+    SIMDEE_INL const sseu16 narrow(const sseu& lo, const sseu& hi) {
+        const sseu top(0xffffU);
+        const __m128i l = _mm_castps_si128(min(lo, top).data());
+        const __m128i h = _mm_castps_si128(min(hi, top).data());
+#if SIMDEE_SSE41
+        return _mm_packus_epi32(l, h);
+#else
+        // move the range to that of int16_t, pack without saturating and move it back
+        const __m128i bias = _mm_set1_epi32(0x8000);
+        const __m128i res = _mm_packs_epi32(_mm_sub_epi32(l, bias), _mm_sub_epi32(h, bias));
+        return _mm_xor_si128(res, _mm_set1_epi16(-0x8000));
+#endif
+    }
+    SIMDEE_INL const sses16 narrow(const sses& lo, const sses& hi) {
+        return _mm_packs_epi32(_mm_castps_si128(lo.data()), _mm_castps_si128(hi.data()));
+    }
+#endif
+
+    // interleaved loads and stores, transposition
+    namespace impl {
+
+        // transposes the 4x4 matrix with rows a, b, c, d
+        SIMDEE_INL void sse_transpose(__m128& a, __m128& b, __m128& c, __m128& d) {
+            __m128 ab_lo = _mm_unpacklo_ps(a, b), cd_lo = _mm_unpacklo_ps(c, d);
+            __m128 ab_hi = _mm_unpackhi_ps(a, b), cd_hi = _mm_unpackhi_ps(c, d);
+            a = _mm_movelh_ps(ab_lo, cd_lo);
+            b = _mm_movehl_ps(cd_lo, ab_lo);
+            c = _mm_movelh_ps(ab_hi, cd_hi);
+            d = _mm_movehl_ps(cd_hi, ab_hi);
+        }
+
+        template <typename T>
+        struct sse_interleave {
+            using scalar_t = typename simd_vector_traits<T>::scalar_t;
+
+            SIMDEE_INL static void load(const scalar_t* ptr, T& v0, T& v1) {
+                auto p = reinterpret_cast<const float*>(ptr);
+                __m128 a = _mm_loadu_ps(p), b = _mm_loadu_ps(p + 4);
+                v0 = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+                v1 = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+            }
+            SIMDEE_INL static void load(const scalar_t* ptr, T& v0, T& v1, T& v2) {
+                auto p = reinterpret_cast<const float*>(ptr);
+                __m128 a = _mm_loadu_ps(p), b = _mm_loadu_ps(p + 4), c = _mm_loadu_ps(p + 8);
+                __m128 b2c1 = _mm_shuffle_ps(b, c, _MM_SHUFFLE(0, 1, 0, 2));
+                __m128 a1b0 = _mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1));
+                __m128 b3c2 = _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3));
+                __m128 a2b1 = _mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2));
+                __m128 c0c3 = _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0));
+                v0 = _mm_shuffle_ps(a, b2c1, _MM_SHUFFLE(2, 0, 3, 0));
+                v1 = _mm_shuffle_ps(a1b0, b3c2, _MM_SHUFFLE(2, 0, 2, 0));
+                v2 = _mm_shuffle_ps(a2b1, c0c3, _MM_SHUFFLE(2, 0, 2, 0));
+            }
+            SIMDEE_INL static void load(const scalar_t* ptr, T& v0, T& v1, T& v2, T& v3) {
+                auto p = reinterpret_cast<const float*>(ptr);
+                __m128 a = _mm_loadu_ps(p), b = _mm_loadu_ps(p + 4);
+                __m128 c = _mm_loadu_ps(p + 8), d = _mm_loadu_ps(p + 12);
+                sse_transpose(a, b, c, d);
+                v0 = a;
+                v1 = b;
+                v2 = c;
+                v3 = d;
+            }
+            SIMDEE_INL static void store(scalar_t* ptr, const T& v0, const T& v1) {
+                auto p = reinterpret_cast<float*>(ptr);
+                _mm_storeu_ps(p, _mm_unpacklo_ps(v0.data(), v1.data()));
+                _mm_storeu_ps(p + 4, _mm_unpackhi_ps(v0.data(), v1.data()));
+            }
+            SIMDEE_INL static void store(scalar_t* ptr, const T& v0, const T& v1, const T& v2) {
+                auto p = reinterpret_cast<float*>(ptr);
+                __m128 x = v0.data(), y = v1.data(), z = v2.data();
+                __m128 x0y0x1y1 = _mm_unpacklo_ps(x, y);
+                __m128 z0x1 = _mm_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0));
+                __m128 y1z1 = _mm_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1));
+                __m128 x2y2 = _mm_shuffle_ps(x, y, _MM_SHUFFLE(2, 2, 2, 2));
+                __m128 z2x3 = _mm_shuffle_ps(z, x, _MM_SHUFFLE(3, 3, 2, 2));
+                __m128 y2z2y3z3 = _mm_unpackhi_ps(y, z);
+                _mm_storeu_ps(p, _mm_shuffle_ps(x0y0x1y1, z0x1, _MM_SHUFFLE(2, 0, 1, 0)));
+                _mm_storeu_ps(p + 4, _mm_shuffle_ps(y1z1, x2y2, _MM_SHUFFLE(2, 0, 2, 0)));
+                _mm_storeu_ps(p + 8, _mm_shuffle_ps(z2x3, y2z2y3z3, _MM_SHUFFLE(3, 2, 2, 0)));
+            }
+            SIMDEE_INL static void store(scalar_t* ptr, const T& v0, const T& v1, const T& v2,
+                                         const T& v3) {
+                auto p = reinterpret_cast<float*>(ptr);
+                __m128 a = v0.data(), b = v1.data(), c = v2.data(), d = v3.data();
+                sse_transpose(a, b, c, d);
+                _mm_storeu_ps(p, a);
+                _mm_storeu_ps(p + 4, b);
+                _mm_storeu_ps(p + 8, c);
+                _mm_storeu_ps(p + 12, d);
+            }
+        };
+
+        template <>
+        struct interleave<sseb> : sse_interleave<sseb> {};
+
+        template <>
+        struct interleave<ssef> : sse_interleave<ssef> {};
+
+        template <>
+        struct interleave<sseu> : sse_interleave<sseu> {};
+
+        template <>
+        struct interleave<sses> : sse_interleave<sses> {};
+
+        template <typename T>
+        struct sse_transposition {
+            SIMDEE_INL static void apply(T* rows) {
+                sse_transpose(rows[0].data(), rows[1].data(), rows[2].data(), rows[3].data());
+            }
+        };
+
+        template <>
+        struct transposition<sseb> : sse_transposition<sseb> {};
+
+        template <>
+        struct transposition<ssef> : sse_transposition<ssef> {};
+
+        template <>
+        struct transposition<sseu> : sse_transposition<sseu> {};
+
+        template <>
+        struct transposition<sses> : sse_transposition<sses> {};
+
+        template <typename T>
+        struct sse64_transposition {
+            SIMDEE_INL static void apply(T* rows) {
+                __m128d a = rows[0].data(), b = rows[1].data();
+                rows[0] = _mm_unpacklo_pd(a, b);
+                rows[1] = _mm_unpackhi_pd(a, b);
+            }
+        };
+
+        template <>
+        struct transposition<sseb64> : sse64_transposition<sseb64> {};
+
+        template <>
+        struct transposition<ssed> : sse64_transposition<ssed> {};
+
+        template <>
+        struct transposition<sseu64> : sse64_transposition<sseu64> {};
+
+        template <>
+        struct transposition<sses64> : sse64_transposition<sses64> {};
+
+    } // namespace impl
+
+#if SIMDEE_AVX512 || SIMDEE_SSSE3
+    // stream compaction
+    namespace impl {
+
+        SIMDEE_INL __m128 sse_as_ps(__m128 vec) { return vec; }
+        SIMDEE_INL __m128 sse_as_ps(__m128d vec) { return _mm_castpd_ps(vec); }
+        SIMDEE_INL void sse_from_ps(__m128 vec, __m128& res) { res = vec; }
+        SIMDEE_INL void sse_from_ps(__m128 vec, __m128d& res) { res = _mm_castps_pd(vec); }
+
+#if SIMDEE_AVX512
+        // stores the 32-bit lanes selected by the bits of sel to ptr[0], ptr[1], ...
+        SIMDEE_INL void sse_compress_store(float* ptr, __m128 vec, uint32_t sel) {
+            _mm_storeu_ps(ptr, _mm_maskz_compress_ps(__mmask8(sel), vec));
+        }
+        // loads ptr[0], ptr[1], ... into the 32-bit lanes selected by the bits of sel
+        SIMDEE_INL __m128 sse_expand_load(const float* ptr, uint32_t sel) {
+            return _mm_maskz_expandloadu_ps(__mmask8(sel), ptr);
+        }
+#else
+        SIMDEE_INL __m128 sse_shuffle_bytes(__m128 vec, const uint32_t* row) {
+            __m128i ctrl = _mm_load_si128(reinterpret_cast<const __m128i*>(row));
+            return _mm_castsi128_ps(_mm_shuffle_epi8(_mm_castps_si128(vec), ctrl));
+        }
+        SIMDEE_INL void sse_compress_store(float* ptr, __m128 vec, uint32_t sel) {
+            _mm_storeu_ps(ptr, sse_shuffle_bytes(vec, compress4_table() + 4 * sel));
+        }
+        SIMDEE_INL __m128 sse_expand_load(const float* ptr, uint32_t sel) {
+            return sse_shuffle_bytes(_mm_loadu_ps(ptr), expand4_table() + 4 * sel);
+        }
+#endif
+
+        // handles 64-bit scalars as pairs of 32-bit lanes
+        template <typename T>
+        struct sse_compression {
+            using scalar_t = typename simd_vector_traits<T>::scalar_t;
+            using vec_b = typename simd_vector_traits<T>::vec_b;
+            enum : uint32_t { lanes = 4 / T::width };
+
+            SIMDEE_INL static std::size_t compress_store(scalar_t* ptr, const T& v,
+                                                         const vec_b& pred) {
+                uint32_t sel = uint32_t(_mm_movemask_ps(sse_as_ps(pred.data())));
+                sse_compress_store(reinterpret_cast<float*>(ptr), sse_as_ps(v.data()), sel);
+                return popcount4(sel) / lanes;
+            }
+            SIMDEE_INL static T expand_load(const scalar_t* ptr, const vec_b& pred) {
+                uint32_t sel = uint32_t(_mm_movemask_ps(sse_as_ps(pred.data())));
+                T res;
+                sse_from_ps(sse_expand_load(reinterpret_cast<const float*>(ptr), sel), res.data());
+                return res;
+            }
+        };
+
+        template <>
+        struct compression<sseb> : sse_compression<sseb> {};
+
+        template <>
+        struct compression<ssef> : sse_compression<ssef> {};
+
+        template <>
+        struct compression<sseu> : sse_compression<sseu> {};
+
+        template <>
+        struct compression<sses> : sse_compression<sses> {};
+
+        template <>
+        struct compression<sseb64> : sse_compression<sseb64> {};
+
+        template <>
+        struct compression<ssed> : sse_compression<ssed> {};
+
+        template <>
+        struct compression<sseu64> : sse_compression<sseu64> {};
+
+        template <>
+        struct compression<sses64> : sse_compression<sses64> {};
+
+    } // namespace impl
+#endif
+
+    // shuffles and permutes
+    namespace impl {
+
+#if SIMDEE_SSE41
+        template <int Mask>
+        SIMDEE_INL __m128 sse_blend(__m128 a, __m128 b) {
+            return _mm_blend_ps(a, b, Mask);
+        }
+#else
+        template <int Mask>
+        SIMDEE_INL __m128 sse_blend(__m128 a, __m128 b) {
+            __m128 sel = _mm_castsi128_ps(_mm_setr_epi32(-(Mask & 1), -((Mask >> 1) & 1),
+                                                         -((Mask >> 2) & 1), -((Mask >> 3) & 1)));
+            return _mm_or_ps(_mm_and_ps(sel, b), _mm_andnot_ps(sel, a));
+        }
+#endif
+
+        template <typename T>
+        struct sse_shuffling {
+            using vec_s = typename simd_vector_traits<T>::vec_s;
+
+            template <int... Idx>
+            SIMDEE_INL static T apply(const T& v) {
+                using L = lane_list<Idx...>;
+                constexpr int imm = L::imm(2, 4, 0, 4);
+                if (L::blend(4)) return v;
+                return _mm_castsi128_ps(_mm_shuffle_epi32(_mm_castps_si128(v.data()), imm));
+            }
+            template <int... Idx>
+            SIMDEE_INL static T apply(const T& a, const T& b) {
+                using L = lane_list<Idx...>;
+                constexpr int imm = L::imm(2, 4, 0, 4);
+                constexpr int lo_imm = (L::lane(0) & 3) * 0x05 | (L::lane(1) & 3) * 0x50;
+                constexpr int hi_imm = (L::lane(2) & 3) * 0x05 | (L::lane(3) & 3) * 0x50;
+                __m128 x = a.data(), y = b.data();
+                if (L::from(0, 4, 0, 4)) return apply<Idx...>(a);
+                if (L::from(1, 4, 0, 4)) return apply<(Idx & 3)...>(b);
+                if (L::blend(4)) return sse_blend<L::upper(4)>(x, y);
+                if (std::is_same<L, lane_list<0, 4, 1, 5>>::value) return _mm_unpacklo_ps(x, y);
+                if (std::is_same<L, lane_list<4, 0, 5, 1>>::value) return _mm_unpacklo_ps(y, x);
+                if (std::is_same<L, lane_list<2, 6, 3, 7>>::value) return _mm_unpackhi_ps(x, y);
+                if (std::is_same<L, lane_list<6, 2, 7, 3>>::value) return _mm_unpackhi_ps(y, x);
+                // two scalars of one vector followed by two scalars of the other one
+                if (L::from(0, 4, 0, 2) && L::from(1, 4, 2, 4)) {
+                    return _mm_shuffle_ps(x, y, imm);
+                }
+                if (L::from(1, 4, 0, 2) && L::from(0, 4, 2, 4)) {
+                    return _mm_shuffle_ps(y, x, imm);
+                }
+                // otherwise each pair of scalars is shuffled out of its sources, then combined
+                __m128 lo = _mm_shuffle_ps(L::lane(0) < 4 ? x : y, L::lane(1) < 4 ? x : y, lo_imm);
+                __m128 hi = _mm_shuffle_ps(L::lane(2) < 4 ? x : y, L::lane(3) < 4 ? x : y, hi_imm);
+                return _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0));
+            }
+            SIMDEE_INL static T permute(const T& v, const vec_s& idx) {
+#if SIMDEE_AVX
+                return _mm_permutevar_ps(v.data(), _mm_castps_si128(idx.data()));
+#elif SIMDEE_SSSE3
+                // the bytes 4 * idx[i] to 4 * idx[i] + 3 are moved to the i-th lane
+                __m128i at = _mm_slli_epi32(_mm_castps_si128(idx.data()), 2);
+                at = _mm_shuffle_epi8(at, _mm_setr_epi8(0, 0, 0, 0, 4, 4, 4, 4, 8, 8, 8, 8, 12, 12,
+                                                        12, 12));
+                at = _mm_add_epi8(at, _mm_set1_epi32(0x03020100));
+                return _mm_castsi128_ps(_mm_shuffle_epi8(_mm_castps_si128(v.data()), at));
+#else
+                return shuffle_emulation<T>::permute(v, idx);
+#endif
+            }
+        };
+
+        template <>
+        struct shuffling<sseb> : sse_shuffling<sseb> {};
+
+        template <>
+        struct shuffling<ssef> : sse_shuffling<ssef> {};
+
+        template <>
+        struct shuffling<sseu> : sse_shuffling<sseu> {};
+
+        template <>
+        struct shuffling<sses> : sse_shuffling<sses> {};
+
+        // shufpd takes the first scalar from one vector and the second one from another, so that
+        // any shuffle is a single instruction
+        template <typename T>
+        struct sse64_shuffling {
+            using vec_s = typename simd_vector_traits<T>::vec_s;
+
+            template <int... Idx>
+            SIMDEE_INL static T apply(const T& v) {
+                using L = lane_list<Idx...>;
+                constexpr int imm = L::imm(1, 2, 0, 2);
+                if (L::blend(2)) return v;
+                return _mm_shuffle_pd(v.data(), v.data(), imm);
+            }
+            template <int... Idx>
+            SIMDEE_INL static T apply(const T& a, const T& b) {
+                using L = lane_list<Idx...>;
+                constexpr int imm = L::imm(1, 2, 0, 2);
+                if (L::from(0, 2, 0, 2)) return apply<Idx...>(a);
+                if (L::from(1, 2, 0, 2)) return apply<(Idx & 1)...>(b);
+                return _mm_shuffle_pd(L::lane(0) < 2 ? a.data() : b.data(),
+                                      L::lane(1) < 2 ? a.data() : b.data(), imm);
+            }
+            SIMDEE_INL static T permute(const T& v, const vec_s& idx) {
+#if SIMDEE_AVX
+                // vpermilpd selects by the second bit of each index
+                __m128i at = _mm_slli_epi64(_mm_castpd_si128(idx.data()), 1);
+                return _mm_permutevar_pd(v.data(), at);
+#else
+                return shuffle_emulation<T>::permute(v, idx);
+#endif
+            }
+        };
+
+        template <>
+        struct shuffling<sseb64> : sse64_shuffling<sseb64> {};
+
+        template <>
+        struct shuffling<ssed> : sse64_shuffling<ssed> {};
+
+        template <>
+        struct shuffling<sseu64> : sse64_shuffling<sseu64> {};
+
+        template <>
+        struct shuffling<sses64> : sse64_shuffling<sses64> {};
+
+    } // namespace impl
+
+    // horizontal operations; floats are folded with float shuffles, which do not pay a bypass delay
+    // like the pshufd in reduce() does
+    namespace impl {
+
+        template <>
+        struct horizontal<ssef> {
+            template <typename Op_t>
+            SIMDEE_INL static float apply(const ssef& v, Op_t f) {
+                ssef x = f(v, ssef(_mm_movehl_ps(v.data(), v.data())));
+                x = f(x, ssef(_mm_shuffle_ps(x.data(), x.data(), _MM_SHUFFLE(1, 1, 1, 1))));
+                return first_scalar(x);
+            }
+        };
+
+        template <>
+        struct horizontal<ssed> {
+            template <typename Op_t>
+            SIMDEE_INL static double apply(const ssed& v, Op_t f) {
+                return first_scalar(f(v, ssed(_mm_unpackhi_pd(v.data(), v.data()))));
+            }
+        };
+
+    } // namespace impl
+
+    // prefix sums
+    namespace impl {
+
+        // v shifted up by Bytes, zeros shifted in
+        template <int Bytes>
+        SIMDEE_INL __m128 sse_shift_up(const __m128& v) {
+            return _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(v), Bytes));
+        }
+        template <int Bytes>
+        SIMDEE_INL __m128d sse_shift_up(const __m128d& v) {
+            return _mm_castsi128_pd(_mm_slli_si128(_mm_castpd_si128(v), Bytes));
+        }
+
+        template <typename T>
+        struct sse_scanning {
+            SIMDEE_INL static T inclusive(const T& v) {
+                T x = v + T(sse_shift_up<4>(v.data()));
+                return x + T(sse_shift_up<8>(x.data()));
+            }
+            SIMDEE_INL static T exclusive(const T& v) {
+                return inclusive(T(sse_shift_up<4>(v.data())));
+            }
+        };
+
+        template <typename T>
+        struct sse64_scanning {
+            SIMDEE_INL static T inclusive(const T& v) { return v + T(sse_shift_up<8>(v.data())); }
+            SIMDEE_INL static T exclusive(const T& v) { return T(sse_shift_up<8>(v.data())); }
+        };
+
+        template <>
+        struct scanning<ssef> : sse_scanning<ssef> {};
+
+        template <>
+        struct scanning<sseu> : sse_scanning<sseu> {};
+
+        template <>
+        struct scanning<sses> : sse_scanning<sses> {};
+
+        template <>
+        struct scanning<ssed> : sse64_scanning<ssed> {};
+
+        template <>
+        struct scanning<sseu64> : sse64_scanning<sseu64> {};
+
+        template <>
+        struct scanning<sses64> : sse64_scanning<sses64> {};
+
+    } // namespace impl
+
+#if SIMDEE_FMA
+    // fused multiply-add
+    namespace impl {
+
+        template <>
+        struct fused<ssef> {
+            using native = std::true_type;
+
+            SIMDEE_INL static ssef fma(const ssef& a, const ssef& b, const ssef& c) {
+                return _mm_fmadd_ps(a.data(), b.data(), c.data());
+            }
+            SIMDEE_INL static ssef fms(const ssef& a, const ssef& b, const ssef& c) {
+                return _mm_fmsub_ps(a.data(), b.data(), c.data());
+            }
+            SIMDEE_INL static ssef fnma(const ssef& a, const ssef& b, const ssef& c) {
+                return _mm_fnmadd_ps(a.data(), b.data(), c.data());
+            }
+            SIMDEE_INL static ssef fnms(const ssef& a, const ssef& b, const ssef& c) {
+                return _mm_fnmsub_ps(a.data(), b.data(), c.data());
+            }
+        };
+
+        template <>
+        struct fused<ssed> {
+            using native = std::true_type;
+
+            SIMDEE_INL static ssed fma(const ssed& a, const ssed& b, const ssed& c) {
+                return _mm_fmadd_pd(a.data(), b.data(), c.data());
+            }
+            SIMDEE_INL static ssed fms(const ssed& a, const ssed& b, const ssed& c) {
+                return _mm_fmsub_pd(a.data(), b.data(), c.data());
+            }
+            SIMDEE_INL static ssed fnma(const ssed& a, const ssed& b, const ssed& c) {
+                return _mm_fnmadd_pd(a.data(), b.data(), c.data());
+            }
+            SIMDEE_INL static ssed fnms(const ssed& a, const ssed& b, const ssed& c) {
+                return _mm_fnmsub_pd(a.data(), b.data(), c.data());
+            }
+        };
+
+    } // namespace impl
+#endif
+
 } // namespace sd
 
 #endif // SIMDEE_SIMD_TYPES_SSE_HPP
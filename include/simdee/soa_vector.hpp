@@ -0,0 +1,140 @@
+// This file is a part of Simdee, see homepage at http://github.com/hrabalik/simdee
+// This file is distributed under the MIT license.
+
+#ifndef SIMDEE_SOA_VECTOR_HPP
+#define SIMDEE_SOA_VECTOR_HPP
+
+#include "simd_vectors/common.hpp"
+#include "util/allocator.hpp"
+
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace sd {
+
+    // A sequence of records with the scalar fields Fields..., stored in blocks of Simd_t::width
+    // records. Within a block, each field occupies one aligned vector, so that it can be loaded
+    // directly into the related vector of Simd_t (an array of structures of arrays). The scalars
+    // past size() in the last block are zero.
+    template <typename Simd_t, typename... Fields>
+    class soa_vector {
+    public:
+        enum : std::size_t { width = Simd_t::width, fields = sizeof...(Fields) };
+
+        template <std::size_t Field>
+        using scalar_t = typename std::tuple_element<Field, std::tuple<Fields...>>::type;
+
+        template <std::size_t Field>
+        using vec_t = typename impl::related_vector<Simd_t, scalar_t<Field>>::type;
+
+        struct block {
+            template <std::size_t Field>
+            SIMDEE_INL storage<vec_t<Field>>& get() {
+                return std::get<Field>(data);
+            }
+            template <std::size_t Field>
+            SIMDEE_INL const storage<vec_t<Field>>& get() const {
+                return std::get<Field>(data);
+            }
+
+            // data
+            std::tuple<storage<typename impl::related_vector<Simd_t, Fields>::type>...> data;
+        };
+
+        using blocks_t = std::vector<block, allocator<block>>;
+
+        soa_vector() = default;
+        explicit soa_vector(std::size_t n) { resize(n); }
+
+        SIMDEE_INL std::size_t size() const { return count; }
+        SIMDEE_INL bool empty() const { return count == 0; }
+        SIMDEE_INL std::size_t capacity() const { return data.capacity() * width; }
+        SIMDEE_INL std::size_t num_blocks() const { return data.size(); }
+
+        // number of records in the b-th block
+        SIMDEE_INL std::size_t block_size(std::size_t b) const {
+            std::size_t first = b * width;
+            return count - first < width ? count - first : std::size_t(width);
+        }
+
+        SIMDEE_INL block& block_at(std::size_t b) { return data[b]; }
+        SIMDEE_INL const block& block_at(std::size_t b) const { return data[b]; }
+        SIMDEE_INL blocks_t& blocks() { return data; }
+        SIMDEE_INL const blocks_t& blocks() const { return data; }
+
+        template <std::size_t Field>
+        SIMDEE_INL vec_t<Field> load(std::size_t b) const {
+            return vec_t<Field>(data[b].template get<Field>());
+        }
+
+        template <std::size_t Field>
+        SIMDEE_INL void store(std::size_t b, const vec_t<Field>& v) {
+            data[b].template get<Field>() = v;
+        }
+
+        template <std::size_t Field>
+        SIMDEE_INL scalar_t<Field>& get(std::size_t i) {
+            return data[i / width].template get<Field>()[i % width];
+        }
+        template <std::size_t Field>
+        SIMDEE_INL const scalar_t<Field>& get(std::size_t i) const {
+            return data[i / width].template get<Field>()[i % width];
+        }
+
+        void reserve(std::size_t n) { data.reserve((n + width - 1) / width); }
+
+        void clear() {
+            data.clear();
+            count = 0;
+        }
+
+        void resize(std::size_t n) {
+            std::size_t old_count = count;
+            data.resize((n + width - 1) / width);
+            count = n;
+            if (n < old_count) zero_tail();
+        }
+
+        void push_back(const Fields&... values) {
+            if (count % width == 0) data.emplace_back();
+            set<0>(data.back(), count % width, values...);
+            ++count;
+        }
+
+        void pop_back() {
+            --count;
+            if (count % width == 0) {
+                data.pop_back();
+            } else {
+                set<0>(data.back(), count % width, Fields()...);
+            }
+        }
+
+    private:
+        template <std::size_t Field>
+        static SIMDEE_INL void set(block&, std::size_t) {}
+
+        template <std::size_t Field, typename T, typename... Rest>
+        static SIMDEE_INL void set(block& blk, std::size_t lane, const T& value,
+                                   const Rest&... rest) {
+            blk.template get<Field>()[lane] = value;
+            set<Field + 1>(blk, lane, rest...);
+        }
+
+        void zero_tail() {
+            if (count % width == 0) return;
+            for (std::size_t lane = count % width; lane < width; ++lane) {
+                set<0>(data.back(), lane, Fields()...);
+            }
+        }
+
+        // data
+        blocks_t data;
+        std::size_t count = 0;
+    };
+
+} // namespace sd
+
+#endif // SIMDEE_SOA_VECTOR_HPP
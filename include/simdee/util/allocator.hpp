@@ -10,14 +10,35 @@
 #include <cstdlib>
 #include <exception>
 #include <memory>
+#include <new>
 #include <type_traits>
 
+#if defined(_WIN32)
+#include <malloc.h>
+#elif defined(__linux__)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
 namespace sd {
 
+    // the size of a small page and of a transparent huge page on common platforms
+    constexpr std::size_t page_size = std::size_t(4) << 10;
+    constexpr std::size_t huge_page_size = std::size_t(2) << 20;
+
     namespace detail {
 
         inline constexpr bool is_pow2(std::size_t x) { return x && (x & (x - 1)) == 0; }
 
+        inline constexpr std::size_t max_size(std::size_t a, std::size_t b) {
+            return a < b ? b : a;
+        }
+
+        inline constexpr std::size_t round_up(std::size_t x, std::size_t multiple) {
+            return (x + multiple - 1) / multiple * multiple;
+        }
+
         template <typename T, std::size_t Align = alignof(T),
                   bool Switch = (Align > alignof(std::max_align_t))>
         struct alloc;
@@ -33,57 +54,123 @@ namespace sd {
         template <typename T, std::size_t Align>
         struct alloc<T, Align, true> {
             static_assert(detail::is_pow2(Align), "alignment must be a power of 2");
-            static_assert(Align <= 128, "alignment is too large");
             static_assert(Align > alignof(std::max_align_t),
                           "alignment is too small -- use malloc");
 
             SIMDEE_INL static T* malloc(std::size_t bytes) noexcept {
-                auto orig = uintptr_t(std::malloc(bytes + Align));
-                if (orig == 0) return nullptr;
-                auto aligned = (orig + Align) & ~(Align - 1);
-                auto offset = uint8_t(aligned - orig);
-                (reinterpret_cast<uint8_t*>(aligned))[-1] = offset;
-                return reinterpret_cast<T*>(aligned);
+#if defined(_WIN32)
+                return static_cast<T*>(_aligned_malloc(bytes, Align));
+#else
+                void* ptr = nullptr;
+                if (posix_memalign(&ptr, Align, bytes) != 0) return nullptr;
+                return static_cast<T*>(ptr);
+#endif
             }
 
             SIMDEE_INL static void free(T* aligned) noexcept {
-                if (aligned == nullptr) return;
-                auto offset = (reinterpret_cast<uint8_t*>(aligned))[-1];
-                auto orig = uintptr_t(aligned) - offset;
-                std::free(reinterpret_cast<void*>(orig));
+#if defined(_WIN32)
+                _aligned_free(aligned);
+#else
+                std::free(aligned);
+#endif
             }
         };
 
+        // asks the kernel to back [ptr, ptr + bytes) with transparent huge pages; ptr must be
+        // aligned to page_size; a no-op where unsupported
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+        inline void advise_huge_pages(void* ptr, std::size_t bytes) noexcept {
+            madvise(ptr, bytes, MADV_HUGEPAGE);
+        }
+#else
+        inline void advise_huge_pages(void*, std::size_t) noexcept {}
+#endif
+
+        // binds the pages of [ptr, ptr + bytes) to a NUMA node (before they are first touched);
+        // ptr must be aligned to page_size; returns false where unsupported or on failure
+#if defined(__linux__) && defined(SYS_mbind)
+        inline bool bind_to_node(void* ptr, std::size_t bytes, unsigned node) noexcept {
+            const int mpol_bind = 2; // MPOL_BIND from <numaif.h>, which is part of libnuma
+            const unsigned long bits = 8 * sizeof(unsigned long);
+            if (node >= bits) return false;
+            const unsigned long nodemask = 1UL << node;
+            return syscall(SYS_mbind, ptr, bytes, mpol_bind, &nodemask, bits + 1, 0) == 0;
+        }
+#else
+        inline bool bind_to_node(void*, std::size_t, unsigned) noexcept { return false; }
+#endif
+
     } // namespace detail
 
-    template <typename T>
+    // Memory policies, the second template argument of sd::allocator. A policy gives the minimum
+    // alignment of the allocated blocks (the alignment of the type is respected regardless) and
+    // prepares each new block before it is handed out. The sizes of blocks are rounded up to a
+    // multiple of the alignment, so that a page-aligned block covers whole pages.
+
+    // blocks aligned to Align bytes, any power of two
+    template <std::size_t Align>
+    struct aligned_memory {
+        enum : std::size_t { alignment = Align };
+        static void prepare(void*, std::size_t) noexcept {}
+    };
+
+    // blocks aligned to huge_page_size, backed by transparent huge pages where the OS supports
+    // them; reduces TLB misses when large arrays are accessed
+    struct huge_page_memory {
+        enum : std::size_t { alignment = huge_page_size };
+        static void prepare(void* ptr, std::size_t bytes) noexcept {
+            detail::advise_huge_pages(ptr, bytes);
+        }
+    };
+
+    // blocks whose pages reside on the NUMA node Node, on top of the policy Base; the binding is
+    // a best-effort hint, ignored where unsupported
+    template <unsigned Node, typename Base = aligned_memory<page_size>>
+    struct numa_memory {
+        enum : std::size_t { alignment = detail::max_size(Base::alignment, page_size) };
+        static void prepare(void* ptr, std::size_t bytes) noexcept {
+            Base::prepare(ptr, bytes);
+            detail::bind_to_node(ptr, bytes, Node);
+        }
+    };
+
+    template <typename T, typename Policy = aligned_memory<1>>
     class allocator {
     public:
         using value_type = T;
+        using policy = Policy;
+        enum : std::size_t { alignment = detail::max_size(Policy::alignment, alignof(T)) };
+
+        template <typename S>
+        struct rebind {
+            using other = allocator<S, Policy>;
+        };
 
         allocator() = default;
 
         template <typename S>
-        allocator(const allocator<S>&) {}
+        allocator(const allocator<S, Policy>&) {}
 
         SIMDEE_INL T* allocate(std::size_t count) const {
-            T* res = detail::alloc<T>::malloc(sizeof(T) * count);
+            const std::size_t bytes = detail::round_up(sizeof(T) * count, alignment);
+            T* res = detail::alloc<T, alignment>::malloc(bytes);
             if (!res) { throw std::bad_alloc{}; }
+            Policy::prepare(res, bytes);
             return res;
         }
 
         SIMDEE_INL void deallocate(T* ptr, std::size_t) const noexcept {
-            detail::alloc<T>::free(ptr);
+            detail::alloc<T, alignment>::free(ptr);
         }
     };
 
-    template <typename T, typename U>
-    inline bool operator==(const allocator<T>&, const allocator<U>&) {
-        return true;
+    template <typename T, typename U, typename P, typename Q>
+    inline bool operator==(const allocator<T, P>&, const allocator<U, Q>&) {
+        return std::is_same<P, Q>::value;
     }
-    template <typename T, typename U>
-    inline bool operator!=(const allocator<T>&, const allocator<U>&) {
-        return false;
+    template <typename T, typename U, typename P, typename Q>
+    inline bool operator!=(const allocator<T, P>&, const allocator<U, Q>&) {
+        return !std::is_same<P, Q>::value;
     }
 
     template <typename T>
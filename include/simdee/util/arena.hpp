@@ -0,0 +1,171 @@
+// This file is a part of Simdee, see homepage at http://github.com/hrabalik/simdee
+// This file is distributed under the MIT license.
+
+#ifndef SIMDEE_UTIL_ARENA_HPP
+#define SIMDEE_UTIL_ARENA_HPP
+
+#include "allocator.hpp"
+#include "inline.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+namespace sd {
+
+    // A region of memory that hands out aligned blocks by bumping a pointer. Blocks are not freed
+    // one by one; reset() makes the whole region available again in constant time. When a block
+    // does not fit, a further region of at least twice the size is allocated and chained; regions
+    // are kept until the arena is destroyed, so that after a reset() they are reused in order.
+    class arena {
+    public:
+        // alignment of blocks unless specified otherwise; suits storage_t of all vector types
+        enum : std::size_t { default_alignment = 64, default_capacity = std::size_t(1) << 20 };
+
+        explicit arena(std::size_t capacity = default_capacity) {
+            m_first = m_current = new_region(capacity);
+            m_top = m_current->begin();
+        }
+
+        ~arena() {
+            region* r = m_first;
+            while (r != nullptr) {
+                region* next = r->next;
+                detail::alloc<region, page_size>::free(r);
+                r = next;
+            }
+        }
+
+        arena(const arena&) = delete;
+        arena& operator=(const arena&) = delete;
+
+        // a block of bytes aligned to align, a power of two no larger than page_size
+        SIMDEE_INL void* allocate(std::size_t bytes, std::size_t align = default_alignment) {
+            char* ptr = align_up(m_top, align);
+            if (bytes > std::size_t(m_current->end - ptr)) return allocate_slow(bytes, align);
+            m_top = ptr + bytes;
+            return ptr;
+        }
+
+        // releases the block if it is the most recent one, otherwise does nothing
+        SIMDEE_INL void deallocate(void* ptr, std::size_t bytes) noexcept {
+            if (static_cast<char*>(ptr) + bytes == m_top) m_top = static_cast<char*>(ptr);
+        }
+
+        // makes all memory available again; all blocks handed out so far become invalid
+        SIMDEE_INL void reset() noexcept {
+            m_current = m_first;
+            m_top = m_current->begin();
+        }
+
+        // the total size of the regions
+        std::size_t capacity() const noexcept {
+            std::size_t res = 0;
+            for (region* r = m_first; r != nullptr; r = r->next) res += r->size();
+            return res;
+        }
+
+        // the number of bytes handed out since the last reset(), including padding
+        std::size_t used() const noexcept {
+            std::size_t res = 0;
+            for (region* r = m_first; r != m_current; r = r->next) res += r->size();
+            return res + std::size_t(m_top - m_current->begin());
+        }
+
+        // an arena of default_capacity per thread, created on first use
+        static arena& local() {
+            static thread_local arena instance;
+            return instance;
+        }
+
+    private:
+        // the header of a region, followed by its memory
+        struct region {
+            region* next;
+            char* end;
+
+            char* begin() { return reinterpret_cast<char*>(this) + page_size; }
+            std::size_t size() const {
+                return std::size_t(end - reinterpret_cast<const char*>(this)) - page_size;
+            }
+        };
+
+        static char* align_up(char* ptr, std::size_t align) {
+            const std::uintptr_t value = reinterpret_cast<std::uintptr_t>(ptr);
+            return ptr + ((align - value % align) % align);
+        }
+
+        // the header occupies a page of its own, so that the memory is page-aligned
+        static region* new_region(std::size_t capacity) {
+            capacity = detail::round_up(capacity == 0 ? 1 : capacity, page_size);
+            region* r = detail::alloc<region, page_size>::malloc(page_size + capacity);
+            if (r == nullptr) throw std::bad_alloc{};
+            r->next = nullptr;
+            r->end = reinterpret_cast<char*>(r) + page_size + capacity;
+            return r;
+        }
+
+        void* allocate_slow(std::size_t bytes, std::size_t align) {
+            // move on to the next region that fits, or chain a new one after the last region
+            for (;;) {
+                if (m_current->next == nullptr) {
+                    std::size_t size = 2 * m_current->size();
+                    if (size < bytes) size = bytes;
+                    m_current->next = new_region(size);
+                }
+                m_current = m_current->next;
+                m_top = m_current->begin();
+                char* ptr = align_up(m_top, align);
+                if (bytes <= std::size_t(m_current->end - ptr)) {
+                    m_top = ptr + bytes;
+                    return ptr;
+                }
+            }
+        }
+
+        region* m_first;
+        region* m_current;
+        char* m_top;
+    };
+
+    // An allocator for standard containers that takes memory from an arena, aligned to
+    // arena::default_alignment (or to the alignment of T if larger). Deallocation only releases the
+    // most recent block (see arena::deallocate()); the rest is released by arena::reset(). The
+    // default-constructed allocator uses the arena of the current thread (arena::local()).
+    template <typename T>
+    class arena_allocator {
+    public:
+        using value_type = T;
+        enum : std::size_t { alignment = detail::max_size(arena::default_alignment, alignof(T)) };
+
+        arena_allocator() : m_arena(&arena::local()) {}
+        explicit arena_allocator(arena& a) : m_arena(&a) {}
+
+        template <typename S>
+        arena_allocator(const arena_allocator<S>& other) : m_arena(&other.get_arena()) {}
+
+        SIMDEE_INL T* allocate(std::size_t count) const {
+            return static_cast<T*>(m_arena->allocate(sizeof(T) * count, alignment));
+        }
+
+        SIMDEE_INL void deallocate(T* ptr, std::size_t count) const noexcept {
+            m_arena->deallocate(ptr, sizeof(T) * count);
+        }
+
+        arena& get_arena() const { return *m_arena; }
+
+    private:
+        arena* m_arena;
+    };
+
+    template <typename T, typename U>
+    inline bool operator==(const arena_allocator<T>& l, const arena_allocator<U>& r) {
+        return &l.get_arena() == &r.get_arena();
+    }
+    template <typename T, typename U>
+    inline bool operator!=(const arena_allocator<T>& l, const arena_allocator<U>& r) {
+        return &l.get_arena() != &r.get_arena();
+    }
+
+} // namespace sd
+
+#endif // SIMDEE_UTIL_ARENA_HPP
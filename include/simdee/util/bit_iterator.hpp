@@ -16,6 +16,9 @@ namespace sd {
     namespace detail {
 
         SIMDEE_INL uint32_t lsb(uint32_t in) noexcept { return uint32_t(__builtin_ctz(in)); }
+        SIMDEE_INL uint32_t popcount(uint32_t in) noexcept {
+            return uint32_t(__builtin_popcount(in));
+        }
 
     } // namespace detail
 
@@ -34,6 +37,7 @@ namespace sd {
             _BitScanForward(&res, in);
             return uint32_t(res);
         }
+        SIMDEE_INL uint32_t popcount(uint32_t in) noexcept { return uint32_t(__popcnt(in)); }
 
     } // namespace detail
 
@@ -0,0 +1,49 @@
+// This file is a part of Simdee, see homepage at http://github.com/hrabalik/simdee
+// This file is distributed under the MIT license.
+
+#ifndef SIMDEE_UTIL_CACHE_HPP
+#define SIMDEE_UTIL_CACHE_HPP
+
+#include "../common/init.hpp"
+#include "inline.hpp"
+
+#if SIMDEE_SSE2
+#include <xmmintrin.h>
+#endif
+
+namespace sd {
+
+    // the cache level that a prefetched line is brought into, from the closest to the farthest;
+    // nta brings it close to the core while keeping it from displacing other data
+    enum class prefetch_hint { t0, t1, t2, nta };
+
+    // asks for the cache line that contains ptr to be loaded ahead of its use; never faults, so
+    // ptr may point past the end of an array
+    template <prefetch_hint Hint = prefetch_hint::t0>
+    SIMDEE_INL void prefetch(const void* ptr) {
+#if defined(__GNUC__) || defined(__clang__)
+        // the locality argument ranges from 3 for t0 down to 0 for nta
+        __builtin_prefetch(ptr, 0, 3 - static_cast<int>(Hint));
+#elif SIMDEE_SSE2
+        _mm_prefetch(static_cast<const char*>(ptr),
+                     Hint == prefetch_hint::t0
+                         ? _MM_HINT_T0
+                         : Hint == prefetch_hint::t1
+                               ? _MM_HINT_T1
+                               : Hint == prefetch_hint::t2 ? _MM_HINT_T2 : _MM_HINT_NTA);
+#else
+        (void)ptr;
+#endif
+    }
+
+    // orders the preceding streaming stores (see sd::streaming()) before any later store; needed
+    // before the data is handed over to another thread
+    SIMDEE_INL void stream_fence() {
+#if SIMDEE_SSE2
+        _mm_sfence();
+#endif
+    }
+
+} // namespace sd
+
+#endif // SIMDEE_UTIL_CACHE_HPP
@@ -0,0 +1,121 @@
+// This file is a part of Simdee, see homepage at http://github.com/hrabalik/simdee
+// This file is distributed under the MIT license.
+
+#ifndef SIMDEE_UTIL_CPUID_HPP
+#define SIMDEE_UTIL_CPUID_HPP
+
+#include <cstdint>
+
+#if defined(__amd64__) || defined(__amd64) || defined(__x86_64__) || defined(__x86_64) ||          \
+    defined(_M_X64) || defined(_M_AMD64) || defined(__i386__) || defined(_M_IX86)
+#define SIMDEE_X86 1
+#else
+#define SIMDEE_X86 0
+#endif
+
+#if SIMDEE_X86
+#if defined(_MSC_VER)
+#include <immintrin.h>
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace sd {
+
+    // instruction sets that can be targeted by runtime dispatch, ordered from the least capable
+    enum class isa : int {
+        none = 0, // no SIMD instruction set (or not an x86 CPU)
+        sse2,     // SSE2
+        avx,      // AVX
+        avx2,     // AVX2 and FMA3
+        avx512,   // AVX-512 F, CD, BW, DQ and VL, and FMA3
+    };
+
+    inline const char* isa_name(isa i) {
+        switch (i) {
+        case isa::sse2:
+            return "SSE2";
+        case isa::avx:
+            return "AVX";
+        case isa::avx2:
+            return "AVX2";
+        case isa::avx512:
+            return "AVX-512";
+        default:
+            return "none";
+        }
+    }
+
+    namespace impl {
+
+#if SIMDEE_X86
+        struct cpuid_regs {
+            uint32_t eax, ebx, ecx, edx;
+        };
+
+        inline cpuid_regs cpuid(uint32_t leaf, uint32_t subleaf = 0) {
+            cpuid_regs r;
+#if defined(_MSC_VER)
+            int regs[4];
+            __cpuidex(regs, int(leaf), int(subleaf));
+            r.eax = uint32_t(regs[0]);
+            r.ebx = uint32_t(regs[1]);
+            r.ecx = uint32_t(regs[2]);
+            r.edx = uint32_t(regs[3]);
+#else
+            __cpuid_count(leaf, subleaf, r.eax, r.ebx, r.ecx, r.edx);
+#endif
+            return r;
+        }
+
+        // reads XCR0, which tells which register states the OS saves on context switch
+        inline uint64_t xgetbv0() {
+#if defined(_MSC_VER)
+            return uint64_t(_xgetbv(0));
+#else
+            uint32_t eax, edx;
+            __asm__ __volatile__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+            return (uint64_t(edx) << 32) | eax;
+#endif
+        }
+
+        inline bool bit(uint32_t reg, int idx) { return ((reg >> idx) & 1U) != 0; }
+#endif
+
+    } // namespace impl
+
+    // queries the CPU (and the OS) for the most capable supported instruction set
+    inline isa detect_isa() {
+#if SIMDEE_X86
+        using impl::bit;
+        const uint32_t max_leaf = impl::cpuid(0).eax;
+        if (max_leaf < 1) return isa::none;
+
+        const impl::cpuid_regs leaf1 = impl::cpuid(1);
+        if (!bit(leaf1.edx, 26)) return isa::none;
+
+        const bool osxsave = bit(leaf1.ecx, 27);
+        const uint64_t xcr0 = osxsave ? impl::xgetbv0() : 0;
+        const bool os_ymm = (xcr0 & 0x06) == 0x06; // XMM, YMM
+        const bool os_zmm = (xcr0 & 0xe6) == 0xe6; // XMM, YMM, opmask, ZMM_Hi256, Hi16_ZMM
+        if (!os_ymm || !bit(leaf1.ecx, 28)) return isa::sse2;
+
+        if (max_leaf < 7) return isa::avx;
+        const impl::cpuid_regs leaf7 = impl::cpuid(7);
+        if (!bit(leaf7.ebx, 5) || !bit(leaf1.ecx, 12)) return isa::avx; // AVX2, FMA3
+
+        const bool avx512 = bit(leaf7.ebx, 16) && bit(leaf7.ebx, 17) && bit(leaf7.ebx, 28) &&
+                            bit(leaf7.ebx, 30) && bit(leaf7.ebx, 31);
+        if (!os_zmm || !avx512) return isa::avx2;
+
+        return isa::avx512;
+#else
+        return isa::none;
+#endif
+    }
+
+} // namespace sd
+
+#endif // SIMDEE_UTIL_CPUID_HPP
@@ -65,6 +65,22 @@ SIMDEE_INL CLASS & operator=(const ARGTYPE & r) {
                                                                                                          \
 //////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+//////////////////////////////////////////////////////////////////////////////////////////////////////////
+#define SIMDEE_CTOR_TPL2( CLASS, TEMPLATE, IMPL )                                                        \
+                                                                                                         \
+template <typename T, typename U>                                                                        \
+SIMDEE_INL CLASS (const TEMPLATE<T, U> & r) {                                                            \
+    IMPL ;                                                                                               \
+}                                                                                                        \
+                                                                                                         \
+template <typename T, typename U>                                                                        \
+SIMDEE_INL CLASS & operator=(const TEMPLATE<T, U> & r) {                                                 \
+    IMPL ;                                                                                               \
+    return *this;                                                                                        \
+}                                                                                                        \
+                                                                                                         \
+//////////////////////////////////////////////////////////////////////////////////////////////////////////
+
 //////////////////////////////////////////////////////////////////////////////////////////////////////////
 #define SIMDEE_BASE_CTOR( CLASS, ARGTYPE, IMPL )                                                         \
                                                                                                          \
@@ -109,6 +125,22 @@ SIMDEE_INL Crtp& operator=(const ARGTYPE & r) {
                                                                                                          \
 //////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+//////////////////////////////////////////////////////////////////////////////////////////////////////////
+#define SIMDEE_BASE_CTOR_TPL2( CLASS, TEMPLATE, IMPL )                                                   \
+                                                                                                         \
+template <typename T, typename U>                                                                        \
+SIMDEE_INL CLASS (const TEMPLATE<T, U> & r) {                                                            \
+    IMPL ;                                                                                               \
+}                                                                                                        \
+                                                                                                         \
+template <typename T, typename U>                                                                        \
+SIMDEE_INL Crtp& operator=(const TEMPLATE<T, U> & r) {                                                   \
+    IMPL ;                                                                                               \
+    return self();                                                                                       \
+}                                                                                                        \
+                                                                                                         \
+//////////////////////////////////////////////////////////////////////////////////////////////////////////
+
 //////////////////////////////////////////////////////////////////////////////////////////////////////////
 #define SIMDEE_UNOP( ARGTYPE, RESTYPE, NAME, IMPL )                                                      \
                                                                                                          \
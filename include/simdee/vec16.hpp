@@ -0,0 +1,38 @@
+// This file is a part of Simdee, see homepage at http://github.com/hrabalik/simdee
+// This file is distributed under the MIT license.
+
+#ifndef SIMDEE_VEC16_HPP
+#define SIMDEE_VEC16_HPP
+
+#include "common/init.hpp"
+
+//
+// AVX-512-accelerated vec16 implementation
+//
+#if SIMDEE_AVX512
+#include "simd_vectors/avx512.hpp"
+
+namespace sd {
+    using vec16b = avx512b;
+    using vec16f = avx512f;
+    using vec16u = avx512u;
+    using vec16s = avx512s;
+}
+
+//
+// Emulated vec16 implementation
+//
+#else
+#include "simd_vectors/dual.hpp"
+#include "vec8.hpp"
+
+namespace sd {
+    using vec16b = dual<vec8b>;
+    using vec16f = dual<vec8f>;
+    using vec16u = dual<vec8u>;
+    using vec16s = dual<vec8s>;
+}
+
+#endif
+
+#endif // SIMDEE_VEC16_HPP
@@ -0,0 +1,42 @@
+// This file is a part of Simdee, see homepage at http://github.com/hrabalik/simdee
+// This file is distributed under the MIT license.
+
+#ifndef SIMDEE_VEC2_HPP
+#define SIMDEE_VEC2_HPP
+
+#include "common/init.hpp"
+
+#if SIMDEE_SSE2
+#include "simd_vectors/sse.hpp"
+
+namespace sd {
+    using vec2b64 = sseb64;
+    using vec2d = ssed;
+    using vec2u64 = sseu64;
+    using vec2s64 = sses64;
+}
+
+#elif SIMDEE_NEON && SIMDEE_ARM64
+#include "simd_vectors/neon.hpp"
+
+namespace sd {
+    using vec2b64 = neonb64;
+    using vec2d = neond;
+    using vec2u64 = neonu64;
+    using vec2s64 = neons64;
+}
+
+#else
+#include "simd_vectors/dual.hpp"
+#include "simd_vectors/dum.hpp"
+
+namespace sd {
+    using vec2b64 = dual<dumb64>;
+    using vec2d = dual<dumd>;
+    using vec2u64 = dual<dumu64>;
+    using vec2s64 = dual<dums64>;
+}
+
+#endif
+
+#endif // SIMDEE_VEC2_HPP
@@ -48,4 +48,27 @@ namespace sd {
 
 #endif
 
+#if (!SIMDEE_NEED_INT && SIMDEE_AVX) || SIMDEE_AVX2
+#include "simd_vectors/avx.hpp"
+
+namespace sd {
+    using vec4b64 = avxb64;
+    using vec4d = avxd;
+    using vec4u64 = avxu64;
+    using vec4s64 = avxs64;
+}
+
+#else
+#include "simd_vectors/dual.hpp"
+#include "vec2.hpp"
+
+namespace sd {
+    using vec4b64 = dual<vec2b64>;
+    using vec4d = dual<vec2d>;
+    using vec4u64 = dual<vec2u64>;
+    using vec4s64 = dual<vec2s64>;
+}
+
+#endif
+
 #endif // SIMDEE_VEC4_HPP
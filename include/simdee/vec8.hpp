@@ -35,4 +35,27 @@ namespace sd {
 
 #endif
 
+#if SIMDEE_AVX512
+#include "simd_vectors/avx512.hpp"
+
+namespace sd {
+    using vec8b64 = avx512b64;
+    using vec8d = avx512d;
+    using vec8u64 = avx512u64;
+    using vec8s64 = avx512s64;
+}
+
+#else
+#include "simd_vectors/dual.hpp"
+#include "vec4.hpp"
+
+namespace sd {
+    using vec8b64 = dual<vec4b64>;
+    using vec8d = dual<vec4d>;
+    using vec8u64 = dual<vec4u64>;
+    using vec8s64 = dual<vec4s64>;
+}
+
+#endif
+
 #endif // SIMDEE_VEC8_HPP
@@ -0,0 +1,123 @@
+#include <catch2/catch.hpp>
+#include <simdee/algorithm.hpp>
+#include <simdee/simdee.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+namespace {
+    // a buffer with room for n scalars at every offset from the alignment of Simd_t
+    template <typename Simd_t>
+    struct buffer {
+        using scalar_t = typename Simd_t::scalar_t;
+
+        explicit buffer(std::size_t n) : data(n + 2 * Simd_t::width + alignof(Simd_t)) {}
+
+        scalar_t* at(std::size_t offset) {
+            scalar_t* ptr = data.data();
+            while (std::uintptr_t(ptr) % alignof(Simd_t) != 0) ++ptr;
+            return ptr + offset;
+        }
+
+        std::vector<scalar_t> data;
+    };
+
+    // small integer values keep the sums exact regardless of the order of the additions
+    template <typename Simd_t>
+    void test_algorithms() {
+        using scalar_t = typename Simd_t::scalar_t;
+        const std::size_t width = Simd_t::width;
+        for (std::size_t n = 0; n <= 4 * width + 3; ++n) {
+            for (std::size_t offset = 0; offset < width; ++offset) {
+                INFO("n = " << n << ", offset = " << offset);
+                buffer<Simd_t> in_buf(n), out_buf(n + 1);
+                scalar_t* in = in_buf.at(offset);
+                scalar_t* out = out_buf.at(width - 1 - offset);
+                for (std::size_t i = 0; i < n; ++i) in[i] = scalar_t(int((i * 5) % 11) - 3);
+                const scalar_t* first = in;
+                const scalar_t* last = in + n;
+
+                std::vector<scalar_t> expected(n);
+                std::transform(first, last, expected.begin(),
+                               [](scalar_t x) { return scalar_t(x + x + scalar_t(1)); });
+                out[n] = scalar_t(42);
+                REQUIRE(sd::transform<Simd_t>(first, last, out, [](const Simd_t& x) {
+                            return Simd_t(x + x + Simd_t(scalar_t(1)));
+                        }) == out + n);
+                REQUIRE(std::equal(expected.begin(), expected.end(), out));
+                REQUIRE(out[n] == scalar_t(42));
+
+                std::transform(first, last, first, expected.begin(),
+                               [](scalar_t x, scalar_t y) { return scalar_t(x - y * 2); });
+                REQUIRE(sd::transform<Simd_t>(first, last, first, out,
+                                              [](const Simd_t& x, const Simd_t& y) {
+                                                  return Simd_t(x - y - y);
+                                              }) == out + n);
+                REQUIRE(std::equal(expected.begin(), expected.end(), out));
+                REQUIRE(out[n] == scalar_t(42));
+
+                auto sum = std::accumulate(first, last, scalar_t(7),
+                                           [](scalar_t a, scalar_t x) { return a + x + x; });
+                REQUIRE(sd::transform_reduce<Simd_t>(
+                            first, last, scalar_t(7),
+                            [](const Simd_t& a, const Simd_t& b) { return Simd_t(a + b); },
+                            [](const Simd_t& x) { return Simd_t(x + x); }) == sum);
+                scalar_t largest(-100);
+                for (const scalar_t* it = first; it != last; ++it) largest = std::max(largest, *it);
+                REQUIRE(sd::transform_reduce<Simd_t>(
+                            first, last, scalar_t(-100),
+                            [](const Simd_t& a, const Simd_t& b) { return max(a, b); },
+                            [](const Simd_t& x) { return x; }) == largest);
+
+                for (int c = -4; c <= 8; c += 3) {
+                    const scalar_t s = scalar_t(c);
+                    auto is_gt = [s](const Simd_t& x) { return x > Simd_t(s); };
+                    auto is_eq = [s](const Simd_t& x) { return x == Simd_t(s); };
+                    auto gt = [s](scalar_t x) { return x > s; };
+                    auto eq = [s](scalar_t x) { return x == s; };
+                    REQUIRE(sd::count_if<Simd_t>(first, last, is_gt) ==
+                            std::size_t(std::count_if(first, last, gt)));
+                    REQUIRE(sd::find_if<Simd_t>(first, last, is_eq) ==
+                            std::find_if(first, last, eq));
+                    REQUIRE(sd::find_if_not<Simd_t>(first, last, is_gt) ==
+                            std::find_if_not(first, last, gt));
+                    REQUIRE(sd::any_of<Simd_t>(first, last, is_eq) ==
+                            std::any_of(first, last, eq));
+                    REQUIRE(sd::all_of<Simd_t>(first, last, is_gt) ==
+                            std::all_of(first, last, gt));
+                    REQUIRE(sd::none_of<Simd_t>(first, last, is_gt) ==
+                            std::none_of(first, last, gt));
+                }
+
+                auto minmax = std::minmax_element(first, last);
+                REQUIRE(sd::minmax_element<Simd_t>(first, last) == minmax);
+                for (std::size_t i = 0; i < n; ++i) in[i] = scalar_t(int(i % 3));
+                minmax = std::minmax_element(first, last);
+                REQUIRE(sd::minmax_element<Simd_t>(first, last) == minmax);
+                if (n != 0) in[n / 2] = scalar_t(-1);
+                if (n != 0) in[n / 3] = scalar_t(5);
+                minmax = std::minmax_element(first, last);
+                REQUIRE(sd::minmax_element<Simd_t>(first, last) == minmax);
+            }
+        }
+    }
+}
+
+TEST_CASE("algorithms over arrays", "[algorithm]") {
+    SECTION("vec4") {
+        test_algorithms<sd::vec4f>();
+        test_algorithms<sd::vec4s>();
+        test_algorithms<sd::vec4d>();
+    }
+    SECTION("vec8") {
+        test_algorithms<sd::vec8f>();
+        test_algorithms<sd::vec8s>();
+        test_algorithms<sd::vec8d>();
+    }
+    SECTION("vec16") {
+        test_algorithms<sd::vec16f>();
+        test_algorithms<sd::vec16s>();
+    }
+}
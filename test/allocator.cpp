@@ -41,6 +41,46 @@ TEST_CASE("allocator", "[allocator]") {
     }
 }
 
+TEST_CASE("allocator policies", "[allocator]") {
+    SECTION("alignment above 128 bytes") {
+        auto ptr = sd::detail::alloc<double, sd::page_size>::malloc(3 * sd::page_size);
+        REQUIRE(uintptr_t(ptr) % sd::page_size == 0);
+        ptr[3 * sd::page_size / sizeof(double) - 1] = 1.23;
+        sd::detail::alloc<double, sd::page_size>::free(ptr);
+    }
+    SECTION("aligned_memory") {
+        using alloc_t = sd::allocator<double, sd::aligned_memory<512>>;
+        REQUIRE(alloc_t::alignment == 512);
+        REQUIRE(sd::allocator<T, sd::aligned_memory<16>>::alignment == alignof(T));
+        std::vector<double, alloc_t> vec;
+        for (unsigned int i = 0; i < 1000; i++) {
+            vec.push_back(i);
+            REQUIRE(uintptr_t(vec.data()) % 512 == 0);
+        }
+        for (unsigned int i : {0u, 1u, 10u, 100u, 999u}) { REQUIRE(vec[i] == i); }
+    }
+    SECTION("huge_page_memory") {
+        std::vector<float, sd::allocator<float, sd::huge_page_memory>> vec(3 << 20, 1.f);
+        REQUIRE(uintptr_t(vec.data()) % sd::huge_page_size == 0);
+        REQUIRE(vec.back() == 1.f);
+    }
+    SECTION("numa_memory") {
+        using policy = sd::numa_memory<0, sd::huge_page_memory>;
+        REQUIRE(policy::alignment == sd::huge_page_size);
+        REQUIRE(sd::numa_memory<0>::alignment == sd::page_size);
+        std::vector<int, sd::allocator<int, sd::numa_memory<0>>> vec(10000, 7);
+        REQUIRE(uintptr_t(vec.data()) % sd::page_size == 0);
+        REQUIRE(vec[9999] == 7);
+    }
+    SECTION("rebind and equality") {
+        sd::allocator<T, sd::huge_page_memory> a;
+        sd::allocator<double, sd::huge_page_memory> b(a);
+        REQUIRE(a == b);
+        REQUIRE(a != sd::allocator<double>());
+        REQUIRE(sd::allocator<T>() == sd::allocator<double>());
+    }
+}
+
 TEST_CASE("deleter", "[allocator]") {
     SECTION("unique_ptr<T>") {
         auto obj = sd::detail::alloc<T>::malloc(sizeof(T));
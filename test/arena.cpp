@@ -0,0 +1,85 @@
+#include <catch2/catch.hpp>
+#include <simdee/simdee.hpp>
+#include <simdee/util/arena.hpp>
+#include <thread>
+#include <vector>
+
+TEST_CASE("arena", "[arena]") {
+    sd::arena a(sd::page_size);
+    REQUIRE(a.capacity() == sd::page_size);
+    REQUIRE(a.used() == 0);
+
+    SECTION("alignment") {
+        for (std::size_t align : {1U, 8U, 64U, 256U, 4096U}) {
+            a.allocate(3, 1);
+            void* ptr = a.allocate(5, align);
+            REQUIRE(uintptr_t(ptr) % align == 0);
+        }
+        REQUIRE(uintptr_t(a.allocate(1)) % sd::arena::default_alignment == 0);
+    }
+    SECTION("reset") {
+        void* first = a.allocate(100);
+        a.allocate(200);
+        REQUIRE(a.used() == 128 + 200);
+        a.reset();
+        REQUIRE(a.used() == 0);
+        REQUIRE(a.allocate(100) == first);
+    }
+    SECTION("growth") {
+        void* first = a.allocate(3000);
+        void* second = a.allocate(3000);
+        void* third = a.allocate(20000);
+        REQUIRE(a.capacity() == sd::page_size + 2 * sd::page_size + 20480);
+        static_cast<char*>(third)[19999] = 1;
+        a.reset();
+        REQUIRE(a.allocate(3000) == first);
+        REQUIRE(a.allocate(3000) == second);
+        REQUIRE(a.allocate(20000) == third);
+        REQUIRE(a.capacity() == sd::page_size + 2 * sd::page_size + 20480);
+    }
+    SECTION("deallocate the most recent block") {
+        void* first = a.allocate(100);
+        void* second = a.allocate(100);
+        a.deallocate(first, 100);
+        REQUIRE(a.used() == 128 + 100);
+        a.deallocate(second, 100);
+        REQUIRE(a.used() == 128);
+        REQUIRE(a.allocate(100) == second);
+    }
+}
+
+TEST_CASE("arena_allocator", "[arena]") {
+    sd::arena a;
+
+    SECTION("vector<float>") {
+        std::vector<float, sd::arena_allocator<float>> vec{sd::arena_allocator<float>(a)};
+        for (unsigned int i = 0; i < 1000; i++) {
+            vec.push_back(float(i));
+            REQUIRE(uintptr_t(vec.data()) % sd::arena::default_alignment == 0);
+        }
+        for (unsigned int i : {0u, 1u, 10u, 100u, 999u}) { REQUIRE(vec[i] == float(i)); }
+    }
+    SECTION("vector<storage_t>") {
+        using storage_t = sd::vec8f::storage_t;
+        sd::arena_allocator<storage_t> alloc(a);
+        std::vector<storage_t, sd::arena_allocator<storage_t>> vec(10, storage_t(), alloc);
+        sd::unaligned(&vec[9][0]) = sd::vec8f(2.f);
+        REQUIRE(vec[9][7] == 2.f);
+    }
+    SECTION("equality and rebind") {
+        sd::arena b;
+        sd::arena_allocator<float> fa(a);
+        sd::arena_allocator<double> da(fa);
+        REQUIRE(fa == da);
+        REQUIRE(fa != sd::arena_allocator<float>(b));
+        REQUIRE(&da.get_arena() == &a);
+    }
+    SECTION("thread-local arena") {
+        sd::arena_allocator<int> here;
+        REQUIRE(&here.get_arena() == &sd::arena::local());
+        sd::arena* there = nullptr;
+        std::thread t([&]() { there = &sd::arena_allocator<int>().get_arena(); });
+        t.join();
+        REQUIRE(there != &sd::arena::local());
+    }
+}
@@ -163,6 +163,13 @@ TEST_CASE("deferred_lognot methods", "[deferred_not]") {
             nba.unaligned_store(res_nba.data());
             REQUIRE((res_ba == res_nba));
         }
+        SECTION("streaming") {
+            B::storage_t res_ba{}, res_nba{};
+            ba.stream_store(res_ba.data());
+            nba.stream_store(res_nba.data());
+            sd::stream_fence();
+            REQUIRE((res_ba == res_nba));
+        }
     }
     SECTION("reduce") {
         auto res_ba = first_scalar(reduce(ba, [](B a, B b) { return a && b; }));
@@ -204,6 +211,13 @@ TEST_CASE("deferred_bitnot methods", "[deferred_not]") {
             nua.unaligned_store(res_nua.data());
             REQUIRE((res_ua == res_nua));
         }
+        SECTION("streaming") {
+            U::storage_t res_ua{}, res_nua{};
+            ua.stream_store(res_ua.data());
+            nua.stream_store(res_nua.data());
+            sd::stream_fence();
+            REQUIRE((res_ua == res_nua));
+        }
     }
     SECTION("reduce") {
         auto res_ua = first_scalar(reduce(ua, [](U a, U b) { return a ^ b; }));
@@ -0,0 +1,58 @@
+#include <catch2/catch.hpp>
+#include <simdee/dispatch.hpp>
+#include <stdexcept>
+#include <string>
+
+namespace {
+    int variant_none(int x) { return x; }
+    int variant_sse2(int x) { return x + 1; }
+    int variant_avx2(int x) { return x + 3; }
+    int variant_avx512(int x) { return x + 4; }
+} // namespace
+
+TEST_CASE("detect_isa", "[dispatch]") {
+    REQUIRE(sd::supported_isa() == sd::detect_isa());
+    // the test runner itself would not run if the CPU lacked the compiled-in instruction set
+    REQUIRE(int(sd::supported_isa()) >= int(sd::compiled_isa));
+    REQUIRE(std::string(sd::isa_name(sd::isa::avx2)) == "AVX2");
+}
+
+TEST_CASE("dispatcher", "[dispatch]") {
+    using fn = int(int);
+    std::initializer_list<sd::dispatch_entry<fn>> variants = {
+        {sd::isa::none, &variant_none},
+        {sd::isa::avx512, &variant_avx512},
+        {sd::isa::sse2, &variant_sse2},
+        {sd::isa::avx, nullptr},
+        {sd::isa::avx2, &variant_avx2},
+    };
+
+    SECTION("limit") {
+        sd::dispatcher<fn> d0(variants, sd::isa::none);
+        REQUIRE(d0.target() == sd::isa::none);
+        REQUIRE(d0(10) == 10);
+        sd::dispatcher<fn> d1(variants, sd::isa::sse2);
+        REQUIRE(d1.target() == sd::isa::sse2);
+        REQUIRE(d1(10) == 11);
+        sd::dispatcher<fn> d2(variants, sd::isa::avx);
+        REQUIRE(d2.target() == sd::isa::sse2);
+        REQUIRE(d2.get() == &variant_sse2);
+        sd::dispatcher<fn> d3(variants, sd::isa::avx2);
+        REQUIRE(d3.target() == sd::isa::avx2);
+        REQUIRE(d3(10) == 13);
+        sd::dispatcher<fn> d4(variants, sd::isa::avx512);
+        REQUIRE(d4.target() == sd::isa::avx512);
+        REQUIRE(d4(10) == 14);
+    }
+
+    SECTION("supported") {
+        sd::dispatcher<fn> d(variants);
+        REQUIRE(int(d.target()) <= int(sd::supported_isa()));
+        REQUIRE(d.target() != sd::isa::avx);
+    }
+
+    SECTION("no suitable variant") {
+        REQUIRE_THROWS_AS(sd::dispatcher<fn>({{sd::isa::avx512, &variant_avx512}}, sd::isa::avx2),
+                          std::runtime_error);
+    }
+}
@@ -0,0 +1,114 @@
+#include <catch2/catch.hpp>
+#include <simdee/divisor.hpp>
+#include <simdee/simd_vectors/dual.hpp>
+#include <simdee/simd_vectors/dum.hpp>
+#include <simdee/simdee.hpp>
+
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+    uint32_t next(uint32_t& state) {
+        state = state * 1664525U + 1013904223U;
+        return state ^ (state >> 15);
+    }
+
+    // small divisors, powers of two and their neighbours, extremes, and random values of all
+    // magnitudes
+    std::vector<uint32_t> divisors() {
+        std::vector<uint32_t> res = {1U, 3U, 5U, 6U, 7U, 10U, 641U, 0x7fffffffU, 0x80000001U,
+                                     0xfffffffeU, 0xffffffffU};
+        for (int i = 0; i < 32; ++i) {
+            res.push_back(1U << i);
+            res.push_back((1U << i) + 1U);
+            if (i > 1) res.push_back((1U << i) - 1U);
+        }
+        uint32_t state = 1;
+        for (int i = 0; i < 200; ++i) res.push_back((next(state) >> (i % 32)) | 1U);
+        return res;
+    }
+
+    std::vector<uint32_t> dividends() {
+        std::vector<uint32_t> res = {0U, 1U, 2U, 3U, 0x7fffffffU, 0x80000000U, 0x80000001U,
+                                     0xfffffffeU, 0xffffffffU};
+        uint32_t state = 2;
+        for (int i = 0; i < 256; ++i) res.push_back(next(state) >> (i % 32));
+        return res;
+    }
+
+    template <typename T>
+    void test_unsigned() {
+        const std::vector<uint32_t> in = dividends();
+        for (uint32_t d : divisors()) {
+            INFO("divisor " << d);
+            const sd::divisor<uint32_t> div(d);
+            REQUIRE(div.value() == d);
+            for (std::size_t i = 0; i + T::width <= in.size(); i += T::width) {
+                typename T::storage_t n;
+                for (std::size_t j = 0; j < T::width; ++j) n[j] = in[i + j];
+                const typename T::storage_t q(T(n) / div);
+                for (std::size_t j = 0; j < T::width; ++j) {
+                    INFO("dividend " << n[j]);
+                    REQUIRE(q[j] == n[j] / d);
+                    REQUIRE(n[j] / div == n[j] / d);
+                }
+            }
+        }
+    }
+
+    // the built-in operator overflows on INT32_MIN / -1, sd::divisor wraps around
+    int32_t reference(int32_t n, int32_t d) {
+        if (d == -1) return int32_t(0U - uint32_t(n));
+        return n / d;
+    }
+
+    template <typename T>
+    void test_signed() {
+        std::vector<int32_t> in;
+        for (uint32_t n : dividends()) in.push_back(int32_t(n));
+        std::vector<int32_t> divs = {std::numeric_limits<int32_t>::min()};
+        for (uint32_t d : divisors()) {
+            divs.push_back(int32_t(d));
+            divs.push_back(int32_t(0U - d));
+        }
+        for (int32_t d : divs) {
+            INFO("divisor " << d);
+            const sd::divisor<int32_t> div(d);
+            REQUIRE(div.value() == d);
+            for (std::size_t i = 0; i + T::width <= in.size(); i += T::width) {
+                typename T::storage_t n;
+                for (std::size_t j = 0; j < T::width; ++j) n[j] = in[i + j];
+                const typename T::storage_t q(T(n) / div);
+                for (std::size_t j = 0; j < T::width; ++j) {
+                    INFO("dividend " << n[j]);
+                    REQUIRE(q[j] == reference(n[j], d));
+                    REQUIRE(n[j] / div == reference(n[j], d));
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("divisor dumu", "[divisor]") { test_unsigned<sd::dumu>(); }
+TEST_CASE("divisor vec4u", "[divisor]") { test_unsigned<sd::vec4u>(); }
+TEST_CASE("divisor vec8u", "[divisor]") { test_unsigned<sd::vec8u>(); }
+TEST_CASE("divisor vec16u", "[divisor]") { test_unsigned<sd::vec16u>(); }
+TEST_CASE("divisor dual<dumu>", "[divisor]") { test_unsigned<sd::dual<sd::dumu>>(); }
+TEST_CASE("divisor dums", "[divisor]") { test_signed<sd::dums>(); }
+TEST_CASE("divisor vec4s", "[divisor]") { test_signed<sd::vec4s>(); }
+TEST_CASE("divisor vec8s", "[divisor]") { test_signed<sd::vec8s>(); }
+TEST_CASE("divisor vec16s", "[divisor]") { test_signed<sd::vec16s>(); }
+TEST_CASE("divisor dual<dums>", "[divisor]") { test_signed<sd::dual<sd::dums>>(); }
+
+TEST_CASE("divisor compound assignment and errors", "[divisor]") {
+    sd::vec4u u(100U);
+    u /= sd::divisor<uint32_t>(7U);
+    REQUIRE(all(u == sd::vec4u(14U)));
+    sd::vec4s s(-100);
+    s /= sd::divisor<int32_t>(7);
+    REQUIRE(all(s == sd::vec4s(-14)));
+    REQUIRE_THROWS_AS(sd::divisor<uint32_t>(0U), std::domain_error);
+    REQUIRE_THROWS_AS(sd::divisor<int32_t>(0), std::domain_error);
+}
@@ -0,0 +1,152 @@
+#include <catch2/catch.hpp>
+#include <simdee/math.hpp>
+#include <simdee/simd_vectors/dual.hpp>
+#include <simdee/simd_vectors/dum.hpp>
+#include <simdee/simdee.hpp>
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace {
+    const float inf = std::numeric_limits<float>::infinity();
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+
+    // error of value in units in the last place of the correctly rounded result
+    double ulp_error(float value, double gt) {
+        float gt_f = float(gt);
+        if (std::isnan(gt_f)) return std::isnan(value) ? 0 : inf;
+        if (std::isinf(gt_f) || std::isinf(value)) return value == gt_f ? 0 : inf;
+        int exp;
+        std::frexp(gt_f, &exp);
+        double ulp = std::ldexp(1., std::max(exp, -125) - 24);
+        return std::abs(double(value) - gt) / ulp;
+    }
+
+    std::vector<float> linspace(float lo, float hi, int n) {
+        std::vector<float> res;
+        for (int i = 0; i < n; ++i) res.push_back(lo + (hi - lo) * float(i) / float(n - 1));
+        return res;
+    }
+
+    std::vector<float> logspace(float lo_exp, float hi_exp, int n) {
+        std::vector<float> res;
+        for (float e : linspace(lo_exp, hi_exp, n)) res.push_back(float(std::exp2(double(e))));
+        return res;
+    }
+
+    double abs_error(float value, double gt) {
+        if (std::isnan(value) || std::isnan(gt)) {
+            return std::isnan(value) == std::isnan(gt) ? 0 : inf;
+        }
+        return std::abs(double(value) - gt);
+    }
+
+    // evaluates fn over the inputs (padded to the vector width) and returns the maximum error
+    template <typename T, typename Fn, typename Gt>
+    double max_error(std::vector<float> in, std::vector<float> in2, Fn fn, Gt gt,
+                     double (*error)(float, double) = ulp_error) {
+        while (in.size() % T::width != 0) {
+            in.push_back(in.back());
+            in2.push_back(in2.back());
+        }
+        std::vector<float> out(in.size());
+        for (std::size_t i = 0; i < in.size(); i += T::width) {
+            T x(sd::unaligned(&in[i]));
+            T y(sd::unaligned(&in2[i]));
+            fn(x, y).unaligned_store(&out[i]);
+        }
+        double res = 0;
+        for (std::size_t i = 0; i < in.size(); ++i) {
+            res = std::max(res, error(out[i], gt(double(in[i]), double(in2[i]))));
+        }
+        return res;
+    }
+
+    template <typename T>
+    void test_math() {
+        auto x_exp = linspace(-110.f, 95.f, 20001);
+        auto x_log = logspace(-149.f, 128.f, 20001);
+        auto x_trig = linspace(-3.14159265f, 3.14159265f, 20001);
+        auto x_trig_wide = linspace(-8192.f, 8192.f, 200001);
+        auto x_tanh = linspace(-20.f, 20.f, 20001);
+        auto x_pow = logspace(-20.f, 20.f, 201);
+        auto ones = std::vector<float>(x_trig_wide.size(), 1.f);
+
+        auto max_err = [&](const std::vector<float>& in, double (*gt)(double),
+                           T (*fn)(const sd::simd_base<T>&),
+                           double (*error)(float, double) = ulp_error) {
+            return max_error<T>(in, ones, [&](const T& x, const T&) { return fn(x); },
+                                [&](double x, double) { return gt(x); }, error);
+        };
+
+        REQUIRE(max_err(x_exp, std::exp, sd::math::exp<T>) <= 1);
+        REQUIRE(max_err(x_log, std::log, sd::math::log<T>) <= 1);
+        REQUIRE(max_err(x_trig, std::sin, sd::math::sin<T>) <= 2);
+        REQUIRE(max_err(x_trig, std::cos, sd::math::cos<T>) <= 2);
+        REQUIRE(max_err(x_trig_wide, std::sin, sd::math::sin<T>, abs_error) <= 1e-7);
+        REQUIRE(max_err(x_trig_wide, std::cos, sd::math::cos<T>, abs_error) <= 1e-7);
+        REQUIRE(max_err(x_tanh, std::tanh, sd::math::tanh<T>) <= 2);
+
+        std::vector<float> base, expo;
+        for (float b : x_pow) {
+            for (float e : linspace(-60.f, 60.f, 121)) {
+                base.push_back(b);
+                expo.push_back(e / 8.f);
+            }
+        }
+        auto pow_fn = [](const T& x, const T& y) { return sd::math::pow(x, y); };
+        auto pow_gt = [](double x, double y) { return std::pow(x, y); };
+        REQUIRE(max_error<T>(base, expo, pow_fn, pow_gt) <= 2);
+
+        // special values follow C99 Annex F
+        auto f_exp = [](float x) { return first_scalar(sd::math::exp(T(x))); };
+        auto f_log = [](float x) { return first_scalar(sd::math::log(T(x))); };
+        auto f_sin = [](float x) { return first_scalar(sd::math::sin(T(x))); };
+        auto f_cos = [](float x) { return first_scalar(sd::math::cos(T(x))); };
+        auto f_tanh = [](float x) { return first_scalar(sd::math::tanh(T(x))); };
+
+        REQUIRE(f_exp(-inf) == 0.f);
+        REQUIRE(f_exp(inf) == inf);
+        REQUIRE(f_exp(0.f) == 1.f);
+        REQUIRE(std::isnan(f_exp(nan)));
+        REQUIRE(f_log(0.f) == -inf);
+        REQUIRE(f_log(-0.f) == -inf);
+        REQUIRE(f_log(1.f) == 0.f);
+        REQUIRE(f_log(inf) == inf);
+        REQUIRE(std::isnan(f_log(-1.f)));
+        REQUIRE(std::isnan(f_log(nan)));
+        REQUIRE(std::signbit(f_sin(-0.f)));
+        REQUIRE(std::isnan(f_sin(inf)));
+        REQUIRE(std::isnan(f_cos(nan)));
+        REQUIRE(f_tanh(inf) == 1.f);
+        REQUIRE(f_tanh(-inf) == -1.f);
+
+        auto f_pow = [](float x, float y) {
+            return first_scalar(sd::math::pow(T(x), T(y)));
+        };
+        REQUIRE(f_pow(nan, 0.f) == 1.f);
+        REQUIRE(f_pow(1.f, nan) == 1.f);
+        REQUIRE(f_pow(-1.f, inf) == 1.f);
+        REQUIRE(f_pow(-2.f, 3.f) == -8.f);
+        REQUIRE(f_pow(-2.f, -2.f) == 0.25f);
+        REQUIRE(std::isnan(f_pow(-2.f, 0.5f)));
+        REQUIRE(f_pow(-0.f, 3.f) == 0.f);
+        REQUIRE(std::signbit(f_pow(-0.f, 3.f)));
+        REQUIRE(f_pow(-0.f, -1.f) == -inf);
+        REQUIRE(f_pow(0.f, -2.f) == inf);
+        REQUIRE(f_pow(-inf, 3.f) == -inf);
+        REQUIRE(f_pow(-inf, 0.5f) == inf);
+        REQUIRE(f_pow(0.5f, inf) == 0.f);
+        REQUIRE(f_pow(2.f, -inf) == 0.f);
+        REQUIRE(f_pow(2.f, 200.f) == inf);
+        REQUIRE(f_pow(-3.f, 1e10f) == inf);
+        REQUIRE(std::isnan(f_pow(nan, 1.f)));
+    }
+} // namespace
+
+TEST_CASE("math dumf", "[math]") { test_math<sd::dumf>(); }
+TEST_CASE("math vec4f", "[math]") { test_math<sd::vec4f>(); }
+TEST_CASE("math vec8f", "[math]") { test_math<sd::vec8f>(); }
+TEST_CASE("math vec16f", "[math]") { test_math<sd::vec16f>(); }
+TEST_CASE("math dual<dumf>", "[math]") { test_math<sd::dual<sd::dumf>>(); }
@@ -0,0 +1,252 @@
+#include <catch2/catch.hpp>
+#include <simdee/simdee.hpp>
+
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace {
+    // the sum of two scalars, halved and rounded towards negative infinity
+    int64_t floor_half(int64_t s) { return (s - (s < 0 ? 1 : 0)) / 2; }
+
+    template <typename Scalar_t>
+    Scalar_t saturate(int64_t v) {
+        using lim = std::numeric_limits<Scalar_t>;
+        if (v < int64_t(lim::min())) return lim::min();
+        if (v > int64_t(lim::max())) return lim::max();
+        return Scalar_t(v);
+    }
+
+    // lanes with both extremes of the range and a spread of values in between
+    template <typename V>
+    void fill(typename V::storage_t& a, typename V::storage_t& b) {
+        using scalar_t = typename V::scalar_t;
+        using lim = std::numeric_limits<scalar_t>;
+        for (std::size_t i = 0; i < V::width; ++i) {
+            a[i] = scalar_t(int64_t(i) * 37 + 5 + int64_t(lim::min()) / 3);
+            b[i] = scalar_t(int64_t(i) * -59 + 11);
+        }
+        a[0] = lim::min();
+        b[0] = lim::max();
+        a[1] = lim::max();
+        b[1] = lim::max();
+        a[2] = lim::min();
+        b[2] = lim::min();
+        b[3] = a[3];
+    }
+
+    template <typename V, typename Ref_t>
+    void check(const V& res, const typename V::storage_t& a, const typename V::storage_t& b,
+               Ref_t ref) {
+        using scalar_t = typename V::scalar_t;
+        const typename V::storage_t out(res);
+        for (std::size_t i = 0; i < V::width; ++i) {
+            INFO("lane " << i << ": " << int64_t(a[i]) << ", " << int64_t(b[i]));
+            REQUIRE(out[i] == scalar_t(ref(int64_t(a[i]), int64_t(b[i]))));
+        }
+    }
+
+    template <typename B>
+    void check_b(const B& res, const std::array<bool, B::width>& expected) {
+        const typename B::storage_t out(res);
+        for (std::size_t i = 0; i < B::width; ++i) {
+            INFO("lane " << i);
+            REQUIRE(bool(out[i]) == expected[i]);
+        }
+        typename B::mask_t m = mask(res);
+        for (std::size_t i = 0; i < B::width; ++i) REQUIRE(m[int(i)] == expected[i]);
+    }
+
+    template <typename V, typename Pred_t>
+    void check_cmp(const typename V::vec_b& res, const typename V::storage_t& a,
+                   const typename V::storage_t& b, Pred_t pred) {
+        std::array<bool, V::width> expected;
+        for (std::size_t i = 0; i < V::width; ++i) expected[i] = pred(a[i], b[i]);
+        check_b(res, expected);
+    }
+
+    template <typename V>
+    void test_signed_ops(std::true_type) {
+        typename V::storage_t a, b;
+        fill<V>(a, b);
+        check(abs(V(a)), a, b, [](int64_t x, int64_t) { return x < 0 ? -x : x; });
+    }
+
+    template <typename V>
+    void test_signed_ops(std::false_type) {}
+
+    template <typename V>
+    void test_mul_ops(std::true_type) {
+        typename V::storage_t a, b;
+        fill<V>(a, b);
+        const V va(a), vb(b);
+        check(va * vb, a, b, [](int64_t x, int64_t y) { return x * y; });
+        check(mulhi(va, vb), a, b, [](int64_t x, int64_t y) { return (x * y) >> 16; });
+    }
+
+    template <typename V>
+    void test_mul_ops(std::false_type) {}
+
+    template <typename V>
+    void test_arithmetic() {
+        using scalar_t = typename V::scalar_t;
+        typename V::storage_t a, b;
+        fill<V>(a, b);
+        const V va(a), vb(b);
+
+        check(va + vb, a, b, [](int64_t x, int64_t y) { return x + y; });
+        check(va - vb, a, b, [](int64_t x, int64_t y) { return x - y; });
+        check(-va, a, b, [](int64_t x, int64_t) { return -x; });
+        check(va & vb, a, b, [](int64_t x, int64_t y) { return x & y; });
+        check(va | vb, a, b, [](int64_t x, int64_t y) { return x | y; });
+        check(va ^ vb, a, b, [](int64_t x, int64_t y) { return x ^ y; });
+        check(~va, a, b, [](int64_t x, int64_t) { return ~x; });
+        check(min(va, vb), a, b, [](int64_t x, int64_t y) { return x < y ? x : y; });
+        check(max(va, vb), a, b, [](int64_t x, int64_t y) { return x < y ? y : x; });
+        check(add_sat(va, vb), a, b,
+              [](int64_t x, int64_t y) { return saturate<scalar_t>(x + y); });
+        check(sub_sat(va, vb), a, b,
+              [](int64_t x, int64_t y) { return saturate<scalar_t>(x - y); });
+        check(avg(va, vb), a, b, [](int64_t x, int64_t y) { return floor_half(x + y + 1); });
+
+        check_cmp<V>(va < vb, a, b, [](scalar_t x, scalar_t y) { return x < y; });
+        check_cmp<V>(va > vb, a, b, [](scalar_t x, scalar_t y) { return x > y; });
+        check_cmp<V>(va <= vb, a, b, [](scalar_t x, scalar_t y) { return x <= y; });
+        check_cmp<V>(va >= vb, a, b, [](scalar_t x, scalar_t y) { return x >= y; });
+        check_cmp<V>(va == vb, a, b, [](scalar_t x, scalar_t y) { return x == y; });
+        check_cmp<V>(va != vb, a, b, [](scalar_t x, scalar_t y) { return x != y; });
+
+        test_signed_ops<V>(std::is_signed<scalar_t>());
+        test_mul_ops<V>(std::integral_constant<bool, sizeof(scalar_t) == 2>());
+    }
+
+    template <typename V>
+    void test_memory() {
+        using scalar_t = typename V::scalar_t;
+        using vec_b = typename V::vec_b;
+        typename V::storage_t a, b;
+        fill<V>(a, b);
+        alignas(64) scalar_t storage[2 * V::width + 1];
+        scalar_t* const buf = storage;
+
+        const V va(a);
+        sd::aligned(buf) = va;
+        check(V(sd::aligned(buf)), a, b, [](int64_t x, int64_t) { return x; });
+        sd::unaligned(buf + 1) = va;
+        check(V(sd::unaligned(buf + 1)), a, b, [](int64_t x, int64_t) { return x; });
+        sd::streaming(buf + V::width) = V(b);
+        sd::stream_fence();
+        check(V(sd::aligned(buf + V::width)), a, b, [](int64_t, int64_t y) { return y; });
+
+        for (std::size_t i = 0; i < 2 * V::width + 1; ++i) buf[i] = scalar_t(7);
+        sd::masked(buf, V::width - 3) = va;
+        for (std::size_t i = 0; i < V::width; ++i) {
+            REQUIRE(buf[i] == (i < V::width - 3 ? a[i] : scalar_t(7)));
+        }
+        const typename V::storage_t loaded(V(sd::masked(buf, std::size_t(3))));
+        for (std::size_t i = 0; i < V::width; ++i) REQUIRE(loaded[i] == (i < 3 ? a[i] : 0));
+
+        std::array<bool, V::width> odd;
+        for (std::size_t i = 0; i < V::width; ++i) odd[i] = (i % 2) == 1;
+        typename vec_b::storage_t sel;
+        for (std::size_t i = 0; i < V::width; ++i) sel[i] = odd[i];
+        const V picked = cond(vec_b(sel), V(a), V(b));
+        const typename V::storage_t out(picked);
+        for (std::size_t i = 0; i < V::width; ++i) REQUIRE(out[i] == (odd[i] ? a[i] : b[i]));
+        check_b(vec_b(sel), odd);
+        REQUIRE(any(vec_b(sel)));
+        REQUIRE_FALSE(all(vec_b(sel)));
+        REQUIRE(all(vec_b(sd::all_bits())));
+        REQUIRE_FALSE(any(vec_b(sd::zero())));
+        REQUIRE(first_scalar(V(b)) == b[0]);
+        REQUIRE(first_scalar(V(a).template broadcast<5>()) == a[5]);
+    }
+
+    template <typename V>
+    void test_reduce() {
+        using scalar_t = typename V::scalar_t;
+        typename V::storage_t a, b;
+        fill<V>(a, b);
+        scalar_t lo = a[0], hi = a[0], sum = 0;
+        for (std::size_t i = 0; i < V::width; ++i) {
+            lo = a[i] < lo ? a[i] : lo;
+            hi = a[i] > hi ? a[i] : hi;
+            sum = scalar_t(sum + a[i]);
+        }
+        const V va(a);
+        REQUIRE(first_scalar(reduce(va, [](const V& l, const V& r) { return min(l, r); })) == lo);
+        REQUIRE(first_scalar(reduce(va, [](const V& l, const V& r) { return max(l, r); })) == hi);
+        REQUIRE(first_scalar(reduce(va, [](const V& l, const V& r) { return l + r; })) == sum);
+    }
+
+    // checks widen_lo(), widen_hi() and narrow() between V and its counterpart W with scalars of
+    // twice the size
+    template <typename V, typename W>
+    void test_widen_narrow() {
+        using scalar_t = typename V::scalar_t;
+        using wide_t = typename W::scalar_t;
+        typename V::storage_t a, b;
+        fill<V>(a, b);
+        const V va(a);
+
+        const typename W::storage_t lo(widen_lo(va)), hi(widen_hi(va));
+        for (std::size_t i = 0; i < W::width; ++i) {
+            REQUIRE(lo[i] == wide_t(a[i]));
+            REQUIRE(hi[i] == wide_t(a[W::width + i]));
+        }
+        check(narrow(W(lo), W(hi)), a, b, [](int64_t x, int64_t) { return x; });
+
+        typename W::storage_t wa, wb;
+        fill<W>(wa, wb);
+        const typename V::storage_t out(narrow(W(wa), W(wb)));
+        for (std::size_t i = 0; i < W::width; ++i) {
+            REQUIRE(out[i] == saturate<scalar_t>(int64_t(wa[i])));
+            REQUIRE(out[W::width + i] == saturate<scalar_t>(int64_t(wb[i])));
+        }
+    }
+
+    template <typename V>
+    void test_all() {
+        test_arithmetic<V>();
+        test_memory<V>();
+        test_reduce<V>();
+    }
+}
+
+#if SIMDEE_SSE2
+TEST_CASE("SSE 8-bit and 16-bit vectors", "[simd_vectors][narrow][sse]") {
+    REQUIRE(std::size_t(sd::sseu8::width) == 16);
+    REQUIRE(std::size_t(sd::sses16::width) == 8);
+    SECTION("arithmetic, memory, reduce") {
+        test_all<sd::sseu8>();
+        test_all<sd::sses8>();
+        test_all<sd::sseu16>();
+        test_all<sd::sses16>();
+    }
+    SECTION("widen and narrow") {
+        test_widen_narrow<sd::sseu8, sd::sseu16>();
+        test_widen_narrow<sd::sses8, sd::sses16>();
+        test_widen_narrow<sd::sseu16, sd::sseu>();
+        test_widen_narrow<sd::sses16, sd::sses>();
+    }
+}
+#endif
+
+#if SIMDEE_AVX2
+TEST_CASE("AVX 8-bit and 16-bit vectors", "[simd_vectors][narrow][avx]") {
+    REQUIRE(std::size_t(sd::avxu8::width) == 32);
+    REQUIRE(std::size_t(sd::avxs16::width) == 16);
+    SECTION("arithmetic, memory, reduce") {
+        test_all<sd::avxu8>();
+        test_all<sd::avxs8>();
+        test_all<sd::avxu16>();
+        test_all<sd::avxs16>();
+    }
+    SECTION("widen and narrow") {
+        test_widen_narrow<sd::avxu8, sd::avxu16>();
+        test_widen_narrow<sd::avxs8, sd::avxs16>();
+        test_widen_narrow<sd::avxu16, sd::avxu>();
+        test_widen_narrow<sd::avxs16, sd::avxs>();
+    }
+}
+#endif
@@ -0,0 +1,135 @@
+#include <catch2/catch.hpp>
+#include <simdee/parallel.hpp>
+#include <simdee/simdee.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+    // counts how many times each element of an array was handed out, checks chunk boundaries
+    void test_parallel_for(sd::thread_pool& pool, std::size_t n, std::size_t offset,
+                           std::size_t grain) {
+        INFO("threads = " << pool.size() << ", n = " << n << ", offset = " << offset
+                          << ", grain = " << grain);
+        std::vector<float> buf(n + 64);
+        float* first = buf.data();
+        while (std::uintptr_t(first) % 64 != 0) ++first;
+        first += offset;
+        float* last = first + n;
+
+        std::vector<std::atomic<int>> visits(n);
+        for (auto& v : visits) v = 0;
+        std::atomic<int> misaligned(0), too_small(0);
+        sd::parallel_for(pool, first, last, grain, [&](float* chunk_first, float* chunk_last) {
+            if (chunk_first != first && std::uintptr_t(chunk_first) % 64 != 0) ++misaligned;
+            if (chunk_last != last && std::size_t(chunk_last - chunk_first) < grain) ++too_small;
+            for (float* it = chunk_first; it != chunk_last; ++it) ++visits[std::size_t(it - first)];
+        });
+        REQUIRE(misaligned == 0);
+        REQUIRE(too_small == 0);
+        std::size_t wrong = 0;
+        for (auto& v : visits) wrong += v != 1 ? 1U : 0U;
+        REQUIRE(wrong == 0);
+    }
+
+    void test_parallel_reduce(sd::thread_pool& pool, std::size_t n, std::size_t grain) {
+        INFO("threads = " << pool.size() << ", n = " << n << ", grain = " << grain);
+        std::vector<int> in(n);
+        for (std::size_t i = 0; i < n; ++i) in[i] = int(i % 13) - 6;
+        long long expected = 0;
+        for (int x : in) expected += x;
+
+        const int* first = in.data();
+        const int* last = first + n;
+        long long sum = sd::parallel_reduce(
+            pool, first, last, grain, 0LL,
+            [](const int* f, const int* l) {
+                long long s = 0;
+                for (; f != l; ++f) s += *f;
+                return s;
+            },
+            [](long long a, long long b) { return a + b; });
+        REQUIRE(sum == expected);
+
+        // per-thread vector accumulators, reduced to a scalar at the end
+        using vec = sd::vec8s;
+        vec vsum = sd::parallel_reduce(
+            pool, first, last, grain, vec(0),
+            [](const int* f, const int* l) {
+                vec s(0);
+                for (; f + vec::width <= l; f += vec::width) s = s + vec(sd::unaligned(f));
+                if (f != l) s = s + vec(sd::masked(f, std::size_t(l - f)));
+                return s;
+            },
+            [](const vec& a, const vec& b) { return a + b; });
+        REQUIRE(hsum(vsum) == int(expected));
+    }
+}
+
+TEST_CASE("parallel_for and parallel_reduce", "[parallel]") {
+    for (std::size_t threads : {1U, 2U, 3U, 8U}) {
+        sd::thread_pool pool(threads);
+        REQUIRE(pool.size() == threads);
+        for (std::size_t n : {0U, 1U, 15U, 16U, 17U, 100U, 1000U, 12345U}) {
+            for (std::size_t offset : {0U, 1U, 7U}) {
+                test_parallel_for(pool, n, offset, 1);
+                test_parallel_for(pool, n, offset, 40);
+            }
+            test_parallel_reduce(pool, n, 1);
+            test_parallel_reduce(pool, n, 100);
+        }
+    }
+}
+
+TEST_CASE("thread_pool", "[parallel]") {
+    sd::thread_pool pool(4);
+
+    SECTION("run calls every thread once") {
+        std::vector<std::atomic<int>> calls(pool.size());
+        for (auto& c : calls) c = 0;
+        auto job = [&](std::size_t t) { ++calls[t]; };
+        for (int i = 0; i < 100; ++i) pool.run(job);
+        for (auto& c : calls) REQUIRE(c == 100);
+    }
+
+    SECTION("exceptions propagate to the caller") {
+        auto job = [](std::size_t t) {
+            if (t == 2) throw std::runtime_error("failure");
+        };
+        REQUIRE_THROWS_AS(pool.run(job), std::runtime_error);
+        std::atomic<int> calls(0);
+        auto count = [&](std::size_t) { ++calls; };
+        pool.run(count);
+        REQUIRE(calls == 4);
+    }
+
+    SECTION("first_touch") {
+        sd::allocator<float, sd::huge_page_memory> alloc;
+        const std::size_t n = 3 << 20;
+        float* ptr = alloc.allocate(n);
+        sd::first_touch(pool, ptr, ptr + n, 1 << 16);
+        std::size_t nonzero = 0;
+        for (std::size_t i = 0; i < n; ++i) nonzero += ptr[i] != 0.f ? 1U : 0U;
+        REQUIRE(nonzero == 0);
+        alloc.deallocate(ptr, n);
+    }
+
+    SECTION("default pool") {
+        REQUIRE(sd::default_thread_pool().size() == sd::thread_pool::default_size());
+        std::vector<float> v(1000, 1.f);
+        sd::parallel_for(v.data(), v.data() + v.size(), 16, [](float* f, float* l) {
+            for (; f != l; ++f) *f *= 2.f;
+        });
+        float sum = sd::parallel_reduce(
+            v.data(), v.data() + v.size(), 16, 0.f,
+            [](float* f, float* l) {
+                float s = 0.f;
+                for (; f != l; ++f) s += *f;
+                return s;
+            },
+            [](float a, float b) { return a + b; });
+        REQUIRE(sum == 2000.f);
+    }
+}
@@ -0,0 +1,126 @@
+#include <catch2/catch.hpp>
+#include <simdee/random.hpp>
+#include <simdee/simd_vectors/dual.hpp>
+#include <simdee/simd_vectors/dum.hpp>
+#include <simdee/simdee.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace {
+    // reference implementations of SplitMix64 and xoshiro128+ by D. Blackman and S. Vigna
+    struct reference {
+        uint32_t s[4];
+
+        explicit reference(uint64_t x) {
+            for (int i = 0; i < 2; ++i) {
+                uint64_t z = (x += 0x9e3779b97f4a7c15ULL);
+                z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+                z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+                z = z ^ (z >> 31);
+                s[2 * i] = uint32_t(z);
+                s[2 * i + 1] = uint32_t(z >> 32);
+            }
+        }
+
+        uint32_t operator()() {
+            const uint32_t result = s[0] + s[3];
+            const uint32_t t = s[1] << 9;
+            s[2] ^= s[0];
+            s[3] ^= s[1];
+            s[1] ^= s[2];
+            s[0] ^= s[3];
+            s[2] ^= t;
+            s[3] = (s[3] << 11) | (s[3] >> (32 - 11));
+            return result;
+        }
+    };
+
+    template <typename T>
+    void test_random() {
+        const int steps = 100;
+        sd::xoshiro128p<T> gen(42);
+        std::vector<std::vector<uint32_t>> lanes(T::width);
+        for (int k = 0; k < steps; ++k) {
+            const typename T::storage_t s(gen());
+            for (std::size_t i = 0; i < T::width; ++i) lanes[i].push_back(s[i]);
+        }
+
+        SECTION("lane 0 follows the reference") {
+            reference ref(42);
+            for (int k = 0; k < steps; ++k) REQUIRE(lanes[0][std::size_t(k)] == ref());
+        }
+
+        SECTION("lane i is lane 0 after i jumps") {
+            for (std::size_t i = 1; i < T::width; ++i) {
+                sd::xoshiro128p<sd::dumu> lane(42);
+                for (std::size_t j = 0; j < i; ++j) lane.jump();
+                for (int k = 0; k < steps; ++k) {
+                    REQUIRE(lanes[i][std::size_t(k)] == lane().data());
+                }
+            }
+        }
+
+        SECTION("jump continues after the last lane") {
+            sd::xoshiro128p<T> jumped(42);
+            jumped.jump();
+            sd::xoshiro128p<sd::dumu> lane(42);
+            for (std::size_t j = 0; j < T::width; ++j) lane.jump();
+            REQUIRE(typename T::storage_t(jumped())[0] == lane().data());
+        }
+
+        SECTION("seed restarts the sequence") {
+            gen.seed(42);
+            REQUIRE(typename T::storage_t(gen())[0] == lanes[0][0]);
+        }
+
+        SECTION("fill") {
+            const std::size_t n = 3 * T::width + 1;
+            std::vector<uint32_t> buf(n + 1, 0xdeadbeefU);
+            sd::xoshiro128p<T> filled(42);
+            filled.fill(buf.data(), n);
+            for (std::size_t i = 0; i < n; ++i) {
+                REQUIRE(buf[i] == lanes[i % T::width][i / T::width]);
+            }
+            REQUIRE(buf[n] == 0xdeadbeefU);
+        }
+
+        SECTION("uniform") {
+            std::vector<float> buf(100003);
+            gen.fill_uniform(buf.data(), buf.size());
+            double sum = 0;
+            for (float x : buf) {
+                REQUIRE(x >= 0.f);
+                REQUIRE(x < 1.f);
+                sum += double(x);
+            }
+            REQUIRE(sum / double(buf.size()) == Approx(0.5).margin(0.01));
+        }
+
+        SECTION("normal") {
+            std::vector<float> buf(100003);
+            gen.fill_normal(buf.data(), buf.size());
+            double sum = 0, sum_sq = 0;
+            std::size_t within_sigma = 0;
+            for (float x : buf) {
+                REQUIRE(x == x);
+                REQUIRE(x > -8.f);
+                REQUIRE(x < 8.f);
+                sum += double(x);
+                sum_sq += double(x) * double(x);
+                if (x > -1.f && x < 1.f) ++within_sigma;
+            }
+            const double mean = sum / double(buf.size());
+            REQUIRE(mean == Approx(0.).margin(0.02));
+            REQUIRE(sum_sq / double(buf.size()) - mean * mean == Approx(1.).margin(0.02));
+            REQUIRE(double(within_sigma) / double(buf.size()) == Approx(0.6827).margin(0.01));
+        }
+    }
+}
+
+TEST_CASE("random dumu", "[random]") { test_random<sd::dumu>(); }
+TEST_CASE("random vec4u", "[random]") { test_random<sd::vec4u>(); }
+TEST_CASE("random vec8u", "[random]") { test_random<sd::vec8u>(); }
+TEST_CASE("random vec16u", "[random]") { test_random<sd::vec16u>(); }
+TEST_CASE("random dual<dumu>", "[random]") { test_random<sd::dual<sd::dumu>>(); }
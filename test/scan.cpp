@@ -0,0 +1,52 @@
+#include <catch2/catch.hpp>
+#include <simdee/scan.hpp>
+#include <simdee/simdee.hpp>
+
+#include <numeric>
+#include <vector>
+
+namespace {
+    // integer values keep the float sums exact regardless of the order of the additions
+    template <typename Simd_t>
+    void test_scans() {
+        using scalar_t = typename Simd_t::scalar_t;
+        for (std::size_t n = 0; n <= 4 * Simd_t::width + 3; ++n) {
+            INFO("n = " << n);
+            std::vector<scalar_t> in(n), out(n + 1, scalar_t(42)), inclusive(n), exclusive(n);
+            for (std::size_t i = 0; i < n; ++i) in[i] = scalar_t(int(i % 7) - 2);
+            std::partial_sum(in.begin(), in.end(), inclusive.begin());
+            for (std::size_t i = 0; i < n; ++i) exclusive[i] = scalar_t(inclusive[i] - in[i] + 5);
+
+            const scalar_t* first = in.data();
+            const scalar_t* last = in.data() + n;
+            REQUIRE(sd::inclusive_scan<Simd_t>(first, last, out.data()) == out.data() + n);
+            REQUIRE(std::equal(inclusive.begin(), inclusive.end(), out.begin()));
+            REQUIRE(out[n] == scalar_t(42));
+
+            REQUIRE(sd::exclusive_scan<Simd_t>(first, last, out.data(), scalar_t(5)) ==
+                    out.data() + n);
+            REQUIRE(std::equal(exclusive.begin(), exclusive.end(), out.begin()));
+            REQUIRE(out[n] == scalar_t(42));
+
+            sd::inclusive_scan<Simd_t>(in.data(), in.data() + n, in.data());
+            REQUIRE(in == inclusive);
+        }
+    }
+}
+
+TEST_CASE("inclusive_scan and exclusive_scan over arrays", "[scan]") {
+    SECTION("vec4") {
+        test_scans<sd::vec4f>();
+        test_scans<sd::vec4s>();
+        test_scans<sd::vec4d>();
+    }
+    SECTION("vec8") {
+        test_scans<sd::vec8f>();
+        test_scans<sd::vec8u>();
+        test_scans<sd::vec8s64>();
+    }
+    SECTION("vec16") {
+        test_scans<sd::vec16f>();
+        test_scans<sd::vec16s>();
+    }
+}
@@ -6,8 +6,43 @@
 // SIMD_TEST_TAG -- catch tests tag(s) as a string
 // SIMD_WIDTH -- expected SIMD width
 //
+// following macros may be defined
+// SIMD_BOOL_IS_MASK -- non-zero if B is backed by a bit mask instead of a full-width vector
+// SIMD_SCALAR_BITS -- size of the scalar types in bits, 32 (default) or 64
+//
+
+#ifndef SIMD_BOOL_IS_MASK
+#define SIMD_BOOL_IS_MASK 0
+#endif
+
+#ifndef SIMD_SCALAR_BITS
+#define SIMD_SCALAR_BITS 32
+#endif
+
+#if SIMD_SCALAR_BITS == 64
+#define U_ALL_BITS 0xffffffffffffffffULL
+#define U_SIGN_BIT 0x8000000000000000ULL
+#define U_ABS_MASK 0x7fffffffffffffffULL
+#define F_LIT(X) X
+#else
+#define U_ALL_BITS 0xffffffffU
+#define U_SIGN_BIT 0x80000000U
+#define U_ABS_MASK 0x7fffffffU
+#define F_LIT(X) X##f
+#endif
+
+#if SIMD_BOOL_IS_MASK
+// a bit mask retains only the truth value of each scalar
+#define B_SIGN_BIT U_ALL_BITS
+#define B_ABS_MASK U_ALL_BITS
+#else
+#define B_SIGN_BIT U_SIGN_BIT
+#define B_ABS_MASK U_ABS_MASK
+#endif
 
+#include <algorithm>
 #include <numeric>
+#include <vector>
 
 #define VAL(TYPE) std::declval<TYPE>()
 
@@ -28,10 +63,10 @@ ASSERT(B::width == SIMD_WIDTH);
 ASSERT(F::width == SIMD_WIDTH);
 ASSERT(U::width == SIMD_WIDTH);
 ASSERT(S::width == SIMD_WIDTH);
-ASSERT((std::is_same<B::scalar_t, sd::bool32_t>::value));
-ASSERT((std::is_same<F::scalar_t, float>::value));
-ASSERT((std::is_same<U::scalar_t, uint32_t>::value));
-ASSERT((std::is_same<S::scalar_t, int32_t>::value));
+ASSERT((std::is_same<B::scalar_t, sd::select_bool_t<SIMD_SCALAR_BITS / 8>>::value));
+ASSERT((std::is_same<F::scalar_t, sd::select_float_t<SIMD_SCALAR_BITS / 8>>::value));
+ASSERT((std::is_same<U::scalar_t, sd::select_uint_t<SIMD_SCALAR_BITS / 8>>::value));
+ASSERT((std::is_same<S::scalar_t, sd::select_sint_t<SIMD_SCALAR_BITS / 8>>::value));
 ASSERT((std::is_same<B::mask_t, sd::impl::mask<((1 << SIMD_WIDTH) - 1)>>::value));
 ASSERT((std::is_same<B::storage_t, sd::storage<B>>::value));
 ASSERT((std::is_same<F::storage_t, sd::storage<F>>::value));
@@ -45,7 +80,9 @@ ASSERT(alignof(B) == alignof(B::vector_t));
 ASSERT(alignof(F) == alignof(F::vector_t));
 ASSERT(alignof(U) == alignof(U::vector_t));
 ASSERT(alignof(S) == alignof(S::vector_t));
+#if !SIMD_BOOL_IS_MASK
 ASSERT(sizeof(B::scalar_t) * B::width == sizeof(B));
+#endif
 ASSERT(sizeof(F::scalar_t) * F::width == sizeof(F));
 ASSERT(sizeof(U::scalar_t) * U::width == sizeof(U));
 ASSERT(sizeof(S::scalar_t) * S::width == sizeof(S));
@@ -73,6 +110,10 @@ ASSERT(HAS_METHOD(const B, aligned_store(VAL(B::scalar_t*)), void));
 ASSERT(HAS_METHOD(const F, aligned_store(VAL(F::scalar_t*)), void));
 ASSERT(HAS_METHOD(const U, aligned_store(VAL(U::scalar_t*)), void));
 ASSERT(HAS_METHOD(const S, aligned_store(VAL(S::scalar_t*)), void));
+ASSERT(HAS_METHOD(const B, stream_store(VAL(B::scalar_t*)), void));
+ASSERT(HAS_METHOD(const F, stream_store(VAL(F::scalar_t*)), void));
+ASSERT(HAS_METHOD(const U, stream_store(VAL(U::scalar_t*)), void));
+ASSERT(HAS_METHOD(const S, stream_store(VAL(S::scalar_t*)), void));
 ASSERT(HAS_METHOD(B, unaligned_load(VAL(B::scalar_t*)), void));
 ASSERT(HAS_METHOD(F, unaligned_load(VAL(F::scalar_t*)), void));
 ASSERT(HAS_METHOD(U, unaligned_load(VAL(U::scalar_t*)), void));
@@ -81,6 +122,10 @@ ASSERT(HAS_METHOD(const B, unaligned_store(VAL(B::scalar_t*)), void));
 ASSERT(HAS_METHOD(const F, unaligned_store(VAL(F::scalar_t*)), void));
 ASSERT(HAS_METHOD(const U, unaligned_store(VAL(U::scalar_t*)), void));
 ASSERT(HAS_METHOD(const S, unaligned_store(VAL(S::scalar_t*)), void));
+ASSERT(HAS_METHOD(F, masked_load(VAL(F::scalar_t*), VAL(std::size_t)), void));
+ASSERT(HAS_METHOD(F, masked_load(VAL(F::scalar_t*), VAL(const B&)), void));
+ASSERT(HAS_METHOD(const F, masked_store(VAL(F::scalar_t*), VAL(std::size_t)), void));
+ASSERT(HAS_METHOD(const F, masked_store(VAL(F::scalar_t*), VAL(const B&)), void));
 
 #if !defined(__clang__) && defined(__GNUC__) && __GNUC__ >= 6
 #pragma GCC diagnostic pop
@@ -114,12 +159,12 @@ TEST_CASE(SIMD_TYPE " explicit construction", SIMD_TEST_TAG) {
 
     SECTION("from scalar_t") {
         B tb(true);
-        F tf(1.2345678f);
+        F tf(F_LIT(1.2345678));
         U tu(123456789U);
         S ts(-123456789);
         tor(tb, tf, tu, ts);
         for (auto val : rb) REQUIRE(val == true);
-        for (auto val : rf) REQUIRE(val == 1.2345678f);
+        for (auto val : rf) REQUIRE(val == F_LIT(1.2345678));
         for (auto val : ru) REQUIRE(val == 123456789U);
         for (auto val : rs) REQUIRE(val == -123456789);
     }
@@ -206,10 +251,10 @@ TEST_CASE(SIMD_TYPE " explicit construction", SIMD_TEST_TAG) {
             U tu(sd::all_bits());
             S ts(sd::all_bits());
             tor(tb, tf, tu, ts);
-            for (auto val : rb) REQUIRE(sd::dirty::as_u(val) == 0xffffffff);
-            for (auto val : rf) REQUIRE(sd::dirty::as_u(val) == 0xffffffff);
-            for (auto val : ru) REQUIRE(sd::dirty::as_u(val) == 0xffffffff);
-            for (auto val : rs) REQUIRE(sd::dirty::as_u(val) == 0xffffffff);
+            for (auto val : rb) REQUIRE(sd::dirty::as_u(val) == U_ALL_BITS);
+            for (auto val : rf) REQUIRE(sd::dirty::as_u(val) == U_ALL_BITS);
+            for (auto val : ru) REQUIRE(sd::dirty::as_u(val) == U_ALL_BITS);
+            for (auto val : rs) REQUIRE(sd::dirty::as_u(val) == U_ALL_BITS);
         }
         {
             B tb(sd::sign_bit());
@@ -217,10 +262,10 @@ TEST_CASE(SIMD_TYPE " explicit construction", SIMD_TEST_TAG) {
             U tu(sd::sign_bit());
             S ts(sd::sign_bit());
             tor(tb, tf, tu, ts);
-            for (auto val : rb) REQUIRE(sd::dirty::as_u(val) == 0x80000000);
-            for (auto val : rf) REQUIRE(sd::dirty::as_u(val) == 0x80000000);
-            for (auto val : ru) REQUIRE(sd::dirty::as_u(val) == 0x80000000);
-            for (auto val : rs) REQUIRE(sd::dirty::as_u(val) == 0x80000000);
+            for (auto val : rb) REQUIRE(sd::dirty::as_u(val) == B_SIGN_BIT);
+            for (auto val : rf) REQUIRE(sd::dirty::as_u(val) == U_SIGN_BIT);
+            for (auto val : ru) REQUIRE(sd::dirty::as_u(val) == U_SIGN_BIT);
+            for (auto val : rs) REQUIRE(sd::dirty::as_u(val) == U_SIGN_BIT);
         }
         {
             B tb(sd::abs_mask());
@@ -228,10 +273,10 @@ TEST_CASE(SIMD_TYPE " explicit construction", SIMD_TEST_TAG) {
             U tu(sd::abs_mask());
             S ts(sd::abs_mask());
             tor(tb, tf, tu, ts);
-            for (auto val : rb) REQUIRE(sd::dirty::as_u(val) == 0x7fffffff);
-            for (auto val : rf) REQUIRE(sd::dirty::as_u(val) == 0x7fffffff);
-            for (auto val : ru) REQUIRE(sd::dirty::as_u(val) == 0x7fffffff);
-            for (auto val : rs) REQUIRE(sd::dirty::as_u(val) == 0x7fffffff);
+            for (auto val : rb) REQUIRE(sd::dirty::as_u(val) == B_ABS_MASK);
+            for (auto val : rf) REQUIRE(sd::dirty::as_u(val) == U_ABS_MASK);
+            for (auto val : ru) REQUIRE(sd::dirty::as_u(val) == U_ABS_MASK);
+            for (auto val : rs) REQUIRE(sd::dirty::as_u(val) == U_ABS_MASK);
         }
     }
 }
@@ -250,9 +295,9 @@ TEST_CASE(SIMD_TYPE " implicit construction", SIMD_TEST_TAG) {
     };
 
     SECTION("from scalar_t") {
-        implicit_test(B::scalar_t(true), 1.2345678f, 123456789U, -123456789);
+        implicit_test(B::scalar_t(true), F_LIT(1.2345678), 123456789U, -123456789);
         for (auto val : rb) REQUIRE(val == true);
-        for (auto val : rf) REQUIRE(val == 1.2345678f);
+        for (auto val : rf) REQUIRE(val == F_LIT(1.2345678));
         for (auto val : ru) REQUIRE(val == 123456789U);
         for (auto val : rs) REQUIRE(val == -123456789);
     }
@@ -292,20 +337,20 @@ TEST_CASE(SIMD_TYPE " implicit construction", SIMD_TEST_TAG) {
         for (auto val : ru) REQUIRE(sd::dirty::as_u(val) == 0x00000000);
         for (auto val : rs) REQUIRE(sd::dirty::as_u(val) == 0x00000000);
         implicit_test(sd::all_bits(), sd::all_bits(), sd::all_bits(), sd::all_bits());
-        for (auto val : rb) REQUIRE(sd::dirty::as_u(val) == 0xffffffff);
-        for (auto val : rf) REQUIRE(sd::dirty::as_u(val) == 0xffffffff);
-        for (auto val : ru) REQUIRE(sd::dirty::as_u(val) == 0xffffffff);
-        for (auto val : rs) REQUIRE(sd::dirty::as_u(val) == 0xffffffff);
+        for (auto val : rb) REQUIRE(sd::dirty::as_u(val) == U_ALL_BITS);
+        for (auto val : rf) REQUIRE(sd::dirty::as_u(val) == U_ALL_BITS);
+        for (auto val : ru) REQUIRE(sd::dirty::as_u(val) == U_ALL_BITS);
+        for (auto val : rs) REQUIRE(sd::dirty::as_u(val) == U_ALL_BITS);
         implicit_test(sd::sign_bit(), sd::sign_bit(), sd::sign_bit(), sd::sign_bit());
-        for (auto val : rb) REQUIRE(sd::dirty::as_u(val) == 0x80000000);
-        for (auto val : rf) REQUIRE(sd::dirty::as_u(val) == 0x80000000);
-        for (auto val : ru) REQUIRE(sd::dirty::as_u(val) == 0x80000000);
-        for (auto val : rs) REQUIRE(sd::dirty::as_u(val) == 0x80000000);
+        for (auto val : rb) REQUIRE(sd::dirty::as_u(val) == B_SIGN_BIT);
+        for (auto val : rf) REQUIRE(sd::dirty::as_u(val) == U_SIGN_BIT);
+        for (auto val : ru) REQUIRE(sd::dirty::as_u(val) == U_SIGN_BIT);
+        for (auto val : rs) REQUIRE(sd::dirty::as_u(val) == U_SIGN_BIT);
         implicit_test(sd::abs_mask(), sd::abs_mask(), sd::abs_mask(), sd::abs_mask());
-        for (auto val : rb) REQUIRE(sd::dirty::as_u(val) == 0x7fffffff);
-        for (auto val : rf) REQUIRE(sd::dirty::as_u(val) == 0x7fffffff);
-        for (auto val : ru) REQUIRE(sd::dirty::as_u(val) == 0x7fffffff);
-        for (auto val : rs) REQUIRE(sd::dirty::as_u(val) == 0x7fffffff);
+        for (auto val : rb) REQUIRE(sd::dirty::as_u(val) == B_ABS_MASK);
+        for (auto val : rf) REQUIRE(sd::dirty::as_u(val) == U_ABS_MASK);
+        for (auto val : ru) REQUIRE(sd::dirty::as_u(val) == U_ABS_MASK);
+        for (auto val : rs) REQUIRE(sd::dirty::as_u(val) == U_ABS_MASK);
     }
 }
 
@@ -329,12 +374,12 @@ TEST_CASE(SIMD_TYPE " assignment", SIMD_TEST_TAG) {
 
         SECTION("from scalar_t") {
             tb = B::scalar_t(true);
-            tf = 1.2345678f;
+            tf = F_LIT(1.2345678);
             tu = 123456789U;
             ts = -123456789;
             tor();
             for (auto val : rb) REQUIRE(val == true);
-            for (auto val : rf) REQUIRE(val == 1.2345678f);
+            for (auto val : rf) REQUIRE(val == F_LIT(1.2345678));
             for (auto val : ru) REQUIRE(val == 123456789U);
             for (auto val : rs) REQUIRE(val == -123456789);
         }
@@ -396,28 +441,28 @@ TEST_CASE(SIMD_TYPE " assignment", SIMD_TEST_TAG) {
             tu = sd::all_bits();
             ts = sd::all_bits();
             tor();
-            for (auto val : rb) REQUIRE(sd::dirty::as_u(val) == 0xffffffff);
-            for (auto val : rf) REQUIRE(sd::dirty::as_u(val) == 0xffffffff);
-            for (auto val : ru) REQUIRE(sd::dirty::as_u(val) == 0xffffffff);
-            for (auto val : rs) REQUIRE(sd::dirty::as_u(val) == 0xffffffff);
+            for (auto val : rb) REQUIRE(sd::dirty::as_u(val) == U_ALL_BITS);
+            for (auto val : rf) REQUIRE(sd::dirty::as_u(val) == U_ALL_BITS);
+            for (auto val : ru) REQUIRE(sd::dirty::as_u(val) == U_ALL_BITS);
+            for (auto val : rs) REQUIRE(sd::dirty::as_u(val) == U_ALL_BITS);
             tb = sd::sign_bit();
             tf = sd::sign_bit();
             tu = sd::sign_bit();
             ts = sd::sign_bit();
             tor();
-            for (auto val : rb) REQUIRE(sd::dirty::as_u(val) == 0x80000000);
-            for (auto val : rf) REQUIRE(sd::dirty::as_u(val) == 0x80000000);
-            for (auto val : ru) REQUIRE(sd::dirty::as_u(val) == 0x80000000);
-            for (auto val : rs) REQUIRE(sd::dirty::as_u(val) == 0x80000000);
+            for (auto val : rb) REQUIRE(sd::dirty::as_u(val) == B_SIGN_BIT);
+            for (auto val : rf) REQUIRE(sd::dirty::as_u(val) == U_SIGN_BIT);
+            for (auto val : ru) REQUIRE(sd::dirty::as_u(val) == U_SIGN_BIT);
+            for (auto val : rs) REQUIRE(sd::dirty::as_u(val) == U_SIGN_BIT);
             tb = sd::abs_mask();
             tf = sd::abs_mask();
             tu = sd::abs_mask();
             ts = sd::abs_mask();
             tor();
-            for (auto val : rb) REQUIRE(sd::dirty::as_u(val) == 0x7fffffff);
-            for (auto val : rf) REQUIRE(sd::dirty::as_u(val) == 0x7fffffff);
-            for (auto val : ru) REQUIRE(sd::dirty::as_u(val) == 0x7fffffff);
-            for (auto val : rs) REQUIRE(sd::dirty::as_u(val) == 0x7fffffff);
+            for (auto val : rb) REQUIRE(sd::dirty::as_u(val) == B_ABS_MASK);
+            for (auto val : rf) REQUIRE(sd::dirty::as_u(val) == U_ABS_MASK);
+            for (auto val : ru) REQUIRE(sd::dirty::as_u(val) == U_ABS_MASK);
+            for (auto val : rs) REQUIRE(sd::dirty::as_u(val) == U_ABS_MASK);
         }
     }
     SECTION("to...") {
@@ -446,6 +491,17 @@ TEST_CASE(SIMD_TYPE " assignment", SIMD_TEST_TAG) {
             REQUIRE(ru == bufAU);
             REQUIRE(rs == bufAS);
         }
+        SECTION("to streaming pointer") {
+            sd::streaming(rb.data()) = tb;
+            sd::streaming(rf.data()) = tf;
+            sd::streaming(ru.data()) = tu;
+            sd::streaming(rs.data()) = ts;
+            sd::stream_fence();
+            REQUIRE(rb == bufAB);
+            REQUIRE(rf == bufAF);
+            REQUIRE(ru == bufAU);
+            REQUIRE(rs == bufAS);
+        }
         SECTION("to storage_t") {
             rb = tb;
             rf = tf;
@@ -459,6 +515,382 @@ TEST_CASE(SIMD_TYPE " assignment", SIMD_TEST_TAG) {
     }
 }
 
+namespace {
+    // loads and stores the first count lanes, then the lanes selected by pred
+    template <typename T>
+    void test_masked(const typename T::storage_t& in, const typename T::storage_t& out,
+                     const typename T::storage_t& zero, const B::storage_t& pred) {
+        typename T::storage_t r;
+        for (std::size_t count = 0; count <= std::size_t(T::width) + 1; ++count) {
+            r = T(sd::masked(in.data(), count));
+            for (auto i = 0U; i < T::width; ++i) REQUIRE(r[i] == (i < count ? in[i] : zero[i]));
+            r = out;
+            sd::masked(r.data(), count) = T(in);
+            for (auto i = 0U; i < T::width; ++i) REQUIRE(r[i] == (i < count ? in[i] : out[i]));
+        }
+        const B vp(pred);
+        r = T(sd::masked(in.data(), vp));
+        for (auto i = 0U; i < T::width; ++i) REQUIRE(r[i] == (pred[i] ? in[i] : zero[i]));
+        r = out;
+        sd::masked(r.data(), vp) = T(in);
+        for (auto i = 0U; i < T::width; ++i) REQUIRE(r[i] == (pred[i] ? in[i] : out[i]));
+    }
+} // namespace
+
+TEST_CASE(SIMD_TYPE " masked load and store", SIMD_TEST_TAG) {
+    SECTION("bool") { test_masked<B>(bufAB, bufBB, bufZB, bufBB); }
+    SECTION("float") { test_masked<F>(bufAF, bufBF, bufZF, bufAB); }
+    SECTION("uint") { test_masked<U>(bufAU, bufBU, bufZU, bufAB); }
+    SECTION("sint") { test_masked<S>(bufAS, bufBS, bufZS, bufBB); }
+}
+
+namespace {
+    // gathers from and scatters to distinct positions on both sides of the base pointer
+    template <typename T>
+    void test_gather(typename T::scalar_t (*make)(int), const typename T::storage_t& in,
+                     const B::storage_t& pred) {
+        using scalar_t = typename T::scalar_t;
+        const std::size_t width = T::width;
+        std::vector<scalar_t> table(3 * width + 1);
+        for (std::size_t i = 0; i < table.size(); ++i) table[i] = make(int(i));
+        S::storage_t at;
+        for (auto i = 0U; i < width; ++i) {
+            at[i] = (i & 1) ? -S::scalar_t(i + 1) : S::scalar_t(2 * i);
+        }
+        const scalar_t* base = table.data() + width;
+        const S idx(at);
+        const B vp(pred);
+
+        typename T::storage_t r;
+        r = sd::gather(base, idx);
+        for (auto i = 0U; i < width; ++i) REQUIRE(r[i] == base[at[i]]);
+        r = sd::gather(base, idx, vp);
+        for (auto i = 0U; i < width; ++i) REQUIRE(r[i] == (pred[i] ? base[at[i]] : scalar_t()));
+
+        std::vector<scalar_t> out(table), expected(table);
+        for (auto i = 0U; i < width; ++i) (expected.data() + width)[at[i]] = in[i];
+        sd::scatter(out.data() + width, idx, T(in));
+        REQUIRE(out == expected);
+        out = expected = table;
+        for (auto i = 0U; i < width; ++i) {
+            if (pred[i]) (expected.data() + width)[at[i]] = in[i];
+        }
+        sd::scatter(out.data() + width, idx, T(in), vp);
+        REQUIRE(out == expected);
+    }
+} // namespace
+
+TEST_CASE(SIMD_TYPE " gather and scatter", SIMD_TEST_TAG) {
+    SECTION("bool") {
+        test_gather<B>([](int i) { return B::scalar_t(i % 3 == 0); }, bufBB, bufAB);
+    }
+    SECTION("float") {
+        test_gather<F>([](int i) { return F::scalar_t(i) + F_LIT(0.5); }, bufAF, bufAB);
+    }
+    SECTION("uint") {
+        test_gather<U>([](int i) { return U::scalar_t(i) * 7U; }, bufAU, bufBB);
+    }
+    SECTION("sint") {
+        test_gather<S>([](int i) -> S::scalar_t { return -i; }, bufAS, bufAB);
+    }
+}
+
+namespace {
+    // loads and stores 2, 3 and 4 interleaved vectors from and to an unaligned buffer
+    template <typename T>
+    void test_interleaved(typename T::scalar_t (*make)(int)) {
+        using scalar_t = typename T::scalar_t;
+        const std::size_t width = T::width;
+        std::vector<scalar_t> in(4 * width + 2);
+        for (std::size_t i = 0; i < in.size(); ++i) in[i] = make(int(i));
+        const scalar_t* src = in.data() + 1;
+        T v0, v1, v2, v3;
+        typename T::storage_t r0, r1, r2, r3;
+        auto stored = [&](std::size_t n, std::vector<scalar_t>& out) {
+            return std::equal(src, src + n * width, out.data() + 1) &&
+                   out[0] == scalar_t() && out[n * width + 1] == scalar_t();
+        };
+
+        sd::load_interleaved<2>(src, v0, v1);
+        r0 = v0, r1 = v1;
+        for (auto i = 0U; i < width; ++i) {
+            REQUIRE(r0[i] == src[2 * i]);
+            REQUIRE(r1[i] == src[2 * i + 1]);
+        }
+        std::vector<scalar_t> out2(2 * width + 2);
+        sd::store_interleaved<2>(out2.data() + 1, v0, v1);
+        REQUIRE(stored(2, out2));
+
+        sd::load_interleaved<3>(src, v0, v1, v2);
+        r0 = v0, r1 = v1, r2 = v2;
+        for (auto i = 0U; i < width; ++i) {
+            REQUIRE(r0[i] == src[3 * i]);
+            REQUIRE(r1[i] == src[3 * i + 1]);
+            REQUIRE(r2[i] == src[3 * i + 2]);
+        }
+        std::vector<scalar_t> out3(3 * width + 2);
+        sd::store_interleaved<3>(out3.data() + 1, v0, v1, v2);
+        REQUIRE(stored(3, out3));
+
+        sd::load_interleaved<4>(src, v0, v1, v2, v3);
+        r0 = v0, r1 = v1, r2 = v2, r3 = v3;
+        for (auto i = 0U; i < width; ++i) {
+            REQUIRE(r0[i] == src[4 * i]);
+            REQUIRE(r1[i] == src[4 * i + 1]);
+            REQUIRE(r2[i] == src[4 * i + 2]);
+            REQUIRE(r3[i] == src[4 * i + 3]);
+        }
+        std::vector<scalar_t> out4(4 * width + 2);
+        sd::store_interleaved<4>(out4.data() + 1, v0, v1, v2, v3);
+        REQUIRE(stored(4, out4));
+    }
+} // namespace
+
+TEST_CASE(SIMD_TYPE " interleaved load and store", SIMD_TEST_TAG) {
+    SECTION("bool") {
+        test_interleaved<B>([](int i) { return B::scalar_t((i * 7) % 5 < 2); });
+    }
+    SECTION("float") {
+        test_interleaved<F>([](int i) { return F::scalar_t(i) + F_LIT(0.5); });
+    }
+    SECTION("uint") {
+        test_interleaved<U>([](int i) { return U::scalar_t(i) * 7U + 1U; });
+    }
+    SECTION("sint") {
+        test_interleaved<S>([](int i) -> S::scalar_t { return -i - 1; });
+    }
+}
+
+namespace {
+    template <typename T>
+    void transpose_rows(T (&)[1]) {} // nothing to transpose
+    template <typename T>
+    void transpose_rows(T (&r)[2]) {
+        sd::transpose(r[0], r[1]);
+    }
+    template <typename T>
+    void transpose_rows(T (&r)[4]) {
+        sd::transpose(r[0], r[1], r[2], r[3]);
+    }
+    template <typename T>
+    void transpose_rows(T (&r)[8]) {
+        sd::transpose(r[0], r[1], r[2], r[3], r[4], r[5], r[6], r[7]);
+    }
+    template <typename T>
+    void transpose_rows(T (&r)[16]) {
+        sd::transpose(r[0], r[1], r[2], r[3], r[4], r[5], r[6], r[7], r[8], r[9], r[10], r[11],
+                      r[12], r[13], r[14], r[15]);
+    }
+
+    // the scalar make(i * width + j) moves from row i, column j to row j, column i
+    template <typename T>
+    void test_transpose(typename T::scalar_t (*make)(int)) {
+        const std::size_t width = T::width;
+        T rows[width];
+        typename T::storage_t buf;
+        for (auto i = 0U; i < width; ++i) {
+            for (auto j = 0U; j < width; ++j) buf[j] = make(int(i * width + j));
+            rows[i] = T(buf);
+        }
+        transpose_rows(rows);
+        for (auto i = 0U; i < width; ++i) {
+            buf = rows[i];
+            for (auto j = 0U; j < width; ++j) REQUIRE(buf[j] == make(int(j * width + i)));
+        }
+    }
+} // namespace
+
+TEST_CASE(SIMD_TYPE " transpose", SIMD_TEST_TAG) {
+    SECTION("bool") { test_transpose<B>([](int i) { return B::scalar_t((i * 7) % 5 < 2); }); }
+    SECTION("float") { test_transpose<F>([](int i) { return F::scalar_t(i) + F_LIT(0.5); }); }
+    SECTION("uint") { test_transpose<U>([](int i) { return U::scalar_t(i) * 7U + 1U; }); }
+    SECTION("sint") { test_transpose<S>([](int i) -> S::scalar_t { return -i - 1; }); }
+}
+
+namespace {
+    // compresses make(0), make(1), ... with up to 256 predicates and expands the result back
+    template <typename T>
+    void test_compress(typename T::scalar_t (*make)(int)) {
+        using scalar_t = typename T::scalar_t;
+        const std::size_t width = T::width;
+        typename T::storage_t in, r;
+        for (auto i = 0U; i < width; ++i) in[i] = make(int(i));
+
+        auto check = [&](uint32_t bits) {
+            B::storage_t sel;
+            typename T::storage_t expanded;
+            std::vector<scalar_t> compressed, out(width);
+            for (auto i = 0U; i < width; ++i) {
+                sel[i] = B::scalar_t(((bits >> i) & 1U) != 0);
+                expanded[i] = sel[i] ? in[i] : scalar_t();
+                if (sel[i]) compressed.push_back(in[i]);
+            }
+            const B pred(sel);
+            std::size_t count = sd::compress_store(out.data(), T(in), pred);
+            r = sd::expand_load(out.data(), pred);
+            INFO("predicate bits " << bits);
+            REQUIRE(count == compressed.size());
+            REQUIRE((std::equal(compressed.begin(), compressed.end(), out.begin()) &&
+                     r == expanded));
+        };
+
+        const uint32_t all = uint32_t((1ULL << width) - 1);
+        for (uint32_t i = 0; i < 256; ++i) check((i * 0x3b9U) & all);
+        check(all);
+    }
+} // namespace
+
+TEST_CASE(SIMD_TYPE " compress and expand", SIMD_TEST_TAG) {
+    SECTION("bool") { test_compress<B>([](int i) { return B::scalar_t(i % 3 != 1); }); }
+    SECTION("float") { test_compress<F>([](int i) { return F::scalar_t(i) + F_LIT(0.5); }); }
+    SECTION("uint") { test_compress<U>([](int i) { return U::scalar_t(i) * 7U + 1U; }); }
+    SECTION("sint") { test_compress<S>([](int i) -> S::scalar_t { return -i - 1; }); }
+}
+
+namespace {
+    // shuffle patterns: lane(i, w) is the lane that the i-th scalar is taken from, lanes w and
+    // higher belong to the second vector; the patterns hit the special cases of the backends
+    struct identity_lanes {
+        static constexpr int lane(int i, int) { return i; }
+    };
+    struct reverse_lanes {
+        static constexpr int lane(int i, int w) { return w - 1 - i; }
+    };
+    struct swap_pairs {
+        static constexpr int lane(int i, int w) { return (i ^ 1) % w; }
+    };
+    struct reverse_blocks_of_4 {
+        static constexpr int lane(int i, int w) { return w < 4 ? w - 1 - i : (i ^ 3); }
+    };
+    struct swap_halves {
+        static constexpr int lane(int i, int w) { return (i + w / 2) % w; }
+    };
+    struct rotate_lanes {
+        static constexpr int lane(int i, int w) { return (i + 1) % w; }
+    };
+    struct splat_last {
+        static constexpr int lane(int, int w) { return w - 1; }
+    };
+    struct duplicate_lanes {
+        static constexpr int lane(int i, int) { return i / 2; }
+    };
+    struct scramble_lanes {
+        static constexpr int lane(int i, int w) { return (i * 5 + 3) % w; }
+    };
+    struct second_vector {
+        static constexpr int lane(int i, int w) { return i + w; }
+    };
+    struct blend_odd {
+        static constexpr int lane(int i, int w) { return i + (i & 1) * w; }
+    };
+    struct blend_pairs {
+        static constexpr int lane(int i, int w) { return i + ((i >> 1) & 1) * w; }
+    };
+    struct interleave_lanes {
+        static constexpr int lane(int i, int w) { return i / 2 + (i & 1) * w; }
+    };
+    struct unpack_blocks_of_4 {
+        static constexpr int lane(int i, int w) { return (i & ~3) + (i & 3) / 2 + (i & 1) * w; }
+    };
+    struct shufps_blocks_of_4 {
+        static constexpr int lane(int i, int w) {
+            return (i & ~3) + ((i * 3 + 1) & 3) % w + ((i >> 1) & 1) * w;
+        }
+    };
+    struct even_lanes {
+        static constexpr int lane(int i, int) { return 2 * i; }
+    };
+    struct slide_lanes {
+        static constexpr int lane(int i, int) { return i + 1; }
+    };
+    struct scramble_two {
+        static constexpr int lane(int i, int w) { return (i * 7 + 5) % (2 * w); }
+    };
+
+    template <typename T, typename P, int... I>
+    void check_shuffle(const typename T::storage_t& a, const typename T::storage_t& b,
+                       sd::impl::lane_list<I...>, const char* name) {
+        const int w = int(T::width);
+        typename T::storage_t one, two, r1, r2;
+        for (int i = 0; i < w; ++i) {
+            int lane = P::lane(i, w) % (2 * w);
+            one[std::size_t(i)] = a[std::size_t(P::lane(i, w) % w)];
+            two[std::size_t(i)] = lane < w ? a[std::size_t(lane)] : b[std::size_t(lane - w)];
+        }
+        r1 = sd::shuffle<(P::lane(I, int(T::width)) % int(T::width))...>(T(a));
+        r2 = sd::shuffle<(P::lane(I, int(T::width)) % (2 * int(T::width)))...>(T(a), T(b));
+        INFO("pattern " << name);
+        REQUIRE(r1 == one);
+        REQUIRE(r2 == two);
+    }
+
+    // checks one- and two-vector shuffles with all patterns (taken modulo width or 2 * width),
+    // and permutes with a few index vectors
+    template <typename T>
+    void test_shuffle(const typename T::storage_t& a, const typename T::storage_t& b) {
+        using lanes = typename sd::impl::iota_lanes<int(T::width)>::type;
+        check_shuffle<T, identity_lanes>(a, b, lanes(), "identity_lanes");
+        check_shuffle<T, reverse_lanes>(a, b, lanes(), "reverse_lanes");
+        check_shuffle<T, swap_pairs>(a, b, lanes(), "swap_pairs");
+        check_shuffle<T, reverse_blocks_of_4>(a, b, lanes(), "reverse_blocks_of_4");
+        check_shuffle<T, swap_halves>(a, b, lanes(), "swap_halves");
+        check_shuffle<T, rotate_lanes>(a, b, lanes(), "rotate_lanes");
+        check_shuffle<T, splat_last>(a, b, lanes(), "splat_last");
+        check_shuffle<T, duplicate_lanes>(a, b, lanes(), "duplicate_lanes");
+        check_shuffle<T, scramble_lanes>(a, b, lanes(), "scramble_lanes");
+        check_shuffle<T, second_vector>(a, b, lanes(), "second_vector");
+        check_shuffle<T, blend_odd>(a, b, lanes(), "blend_odd");
+        check_shuffle<T, blend_pairs>(a, b, lanes(), "blend_pairs");
+        check_shuffle<T, interleave_lanes>(a, b, lanes(), "interleave_lanes");
+        check_shuffle<T, unpack_blocks_of_4>(a, b, lanes(), "unpack_blocks_of_4");
+        check_shuffle<T, shufps_blocks_of_4>(a, b, lanes(), "shufps_blocks_of_4");
+        check_shuffle<T, even_lanes>(a, b, lanes(), "even_lanes");
+        check_shuffle<T, slide_lanes>(a, b, lanes(), "slide_lanes");
+        check_shuffle<T, scramble_two>(a, b, lanes(), "scramble_two");
+
+        const std::size_t width = T::width;
+        for (std::size_t k = 0; k < 3; ++k) {
+            S::storage_t idx;
+            typename T::storage_t expected, r;
+            for (std::size_t i = 0; i < width; ++i) {
+                std::size_t lane = k == 0 ? width - 1 - i : k == 1 ? (i * 3 + 1) % width : i / 3;
+                idx[i] = S::scalar_t(lane);
+                expected[i] = a[lane];
+            }
+            r = sd::permute(T(a), S(idx));
+            INFO("permute " << k);
+            REQUIRE(r == expected);
+        }
+    }
+} // namespace
+
+TEST_CASE(SIMD_TYPE " shuffle and permute", SIMD_TEST_TAG) {
+    SECTION("bool") { test_shuffle<B>(bufAB, bufBB); }
+    SECTION("float") { test_shuffle<F>(bufAF, bufBF); }
+    SECTION("uint") { test_shuffle<U>(bufAU, bufBU); }
+    SECTION("sint") { test_shuffle<S>(bufAS, bufBS); }
+}
+
+namespace {
+    template <typename T, typename Buf>
+    void test_prefix_sums(const Buf& buf) {
+        using scalar_t = typename T::scalar_t;
+        typename T::storage_t inclusive(inclusive_scan(T(buf))), exclusive(exclusive_scan(T(buf)));
+        scalar_t sum = scalar_t(0);
+        for (std::size_t i = 0; i < T::width; ++i) {
+            REQUIRE(exclusive[i] == Approx(sum));
+            sum = scalar_t(sum + buf[i]);
+            REQUIRE(inclusive[i] == Approx(sum));
+        }
+    }
+}
+
+TEST_CASE(SIMD_TYPE " prefix sums", SIMD_TEST_TAG) {
+    SECTION("on floats") { test_prefix_sums<F>(bufAF); }
+    SECTION("on uints") { test_prefix_sums<U>(bufAU); }
+    SECTION("on sints") { test_prefix_sums<S>(bufAS); }
+}
+
 TEST_CASE(SIMD_TYPE " type conversion", SIMD_TEST_TAG) {
     SECTION("int to float") {
         F::storage_t expected, result;
@@ -622,23 +1054,94 @@ TEST_CASE(SIMD_TYPE " float arithmetic", SIMD_TEST_TAG) {
         r = rsqrt(abs(va));
         for (auto i = 0U; i < F::width; ++i) REQUIRE(r[i] == Approx(e[i]).epsilon(0.005));
     }
+    SECTION("reciprocal accuracy tiers") {
+        expect1([](scalar_t a) { return 1 / a; });
+        r = sd::rcp<sd::accuracy::estimate>(va);
+        for (auto i = 0U; i < F::width; ++i) REQUIRE(r[i] == Approx(e[i]).epsilon(0.005));
+        r = sd::rcp<sd::accuracy::newton>(va);
+        for (auto i = 0U; i < F::width; ++i) REQUIRE(r[i] == Approx(e[i]).epsilon(1e-6));
+        r = sd::rcp<sd::accuracy::full>(va);
+        REQUIRE(r == e);
+        const scalar_t inf = std::numeric_limits<scalar_t>::infinity();
+        REQUIRE(all(sd::rcp<sd::accuracy::newton>(F(F_LIT(0.0))) == F(inf)));
+        REQUIRE(all(sd::rcp<sd::accuracy::newton>(F(inf)) == F(F_LIT(0.0))));
+    }
+    SECTION("reciprocal square root accuracy tiers") {
+        expect1([](scalar_t a) { return 1 / std::sqrt(std::abs(a)); });
+        r = sd::rsqrt<sd::accuracy::estimate>(abs(va));
+        for (auto i = 0U; i < F::width; ++i) REQUIRE(r[i] == Approx(e[i]).epsilon(0.005));
+        r = sd::rsqrt<sd::accuracy::newton>(abs(va));
+        for (auto i = 0U; i < F::width; ++i) REQUIRE(r[i] == Approx(e[i]).epsilon(1e-6));
+        r = sd::rsqrt<sd::accuracy::full>(abs(va));
+        REQUIRE(r == e);
+        const scalar_t inf = std::numeric_limits<scalar_t>::infinity();
+        REQUIRE(all(sd::rsqrt<sd::accuracy::newton>(F(F_LIT(0.0))) == F(inf)));
+        REQUIRE(all(sd::rsqrt<sd::accuracy::newton>(F(inf)) == F(F_LIT(0.0))));
+    }
+    SECTION("fused multiply-add") {
+        F vc = vb - va;
+        F::storage_t c;
+        c = vc;
+        auto check = [&](scalar_t sign_ab, scalar_t sign_c) {
+            for (auto i = 0U; i < F::width; ++i) {
+                scalar_t expected = sign_ab * bufAF[i] * bufBF[i] + sign_c * c[i];
+                REQUIRE(r[i] == Approx(expected).margin(1e-5));
+            }
+        };
+        r = fma(va, vb, vc);
+        check(1, 1);
+        r = fms(va, vb, vc);
+        check(1, -1);
+        r = fnma(va, vb, vc);
+        check(-1, 1);
+        r = fnms(va, vb, vc);
+        check(-1, -1);
+#if SIMDEE_FMA
+        // (1 + h)^2 - (1 + 2h) == h^2 only if the product is not rounded
+        const int digits = std::numeric_limits<scalar_t>::digits;
+        const scalar_t h = std::ldexp(scalar_t(1), -(digits / 2 + 1));
+        const F one_h(1 + h);
+        REQUIRE(all(fms(one_h, one_h, F(1 + 2 * h)) == F(h * h)));
+        REQUIRE(all(fnma(one_h, one_h, F(1 + 2 * h)) == F(-(h * h))));
+#endif
+    }
     SECTION("rhs of compound can be implicitly constructed") {
         va = vb;
-        va += 1.23f;
-        vb = vb + 1.23f;
+        va += F_LIT(1.23);
+        vb = vb + F_LIT(1.23);
         REQUIRE(all(va == vb));
-        va -= 2.34f;
-        vb = vb - 2.34f;
+        va -= F_LIT(2.34);
+        vb = vb - F_LIT(2.34);
         REQUIRE(all(va == vb));
-        va *= 3.45f;
-        vb = vb * 3.45f;
+        va *= F_LIT(3.45);
+        vb = vb * F_LIT(3.45);
         REQUIRE(all(va == vb));
-        va /= 4.56f;
-        vb = vb / 4.56f;
+        va /= F_LIT(4.56);
+        vb = vb / F_LIT(4.56);
         REQUIRE(all(va == vb));
     }
 }
 
+#if SIMD_SCALAR_BITS == 32
+// only the types whose 64-bit counterparts exist provide mul_wide_lo() and mul_wide_hi()
+template <typename V>
+auto test_mul_wide(const typename V::storage_t& a, const typename V::storage_t& b, int)
+    -> decltype(void(mul_wide_lo(V(a), V(b)))) {
+    using wide_t = typename std::decay<decltype(mul_wide_lo(V(a), V(b)))>::type;
+    using wide_scalar_t = typename wide_t::scalar_t;
+    const std::size_t half = V::width / 2;
+    const typename wide_t::storage_t lo(mul_wide_lo(V(a), V(b)));
+    const typename wide_t::storage_t hi(mul_wide_hi(V(a), V(b)));
+    for (std::size_t i = 0; i < half; ++i) {
+        REQUIRE(lo[i] == wide_scalar_t(a[i]) * wide_scalar_t(b[i]));
+        REQUIRE(hi[i] == wide_scalar_t(a[half + i]) * wide_scalar_t(b[half + i]));
+    }
+}
+
+template <typename V>
+void test_mul_wide(const typename V::storage_t&, const typename V::storage_t&, long) {}
+#endif
+
 TEST_CASE(SIMD_TYPE " uint arithmetic", SIMD_TEST_TAG) {
     using scalar_t = U::scalar_t;
     U::storage_t r, e;
@@ -730,6 +1233,45 @@ TEST_CASE(SIMD_TYPE " uint arithmetic", SIMD_TEST_TAG) {
         r = max(va, vb);
         REQUIRE(r == e);
     }
+#if SIMD_SCALAR_BITS == 32
+    SECTION("shifts") {
+        for (int n : {0, 1, 13, 31}) {
+            std::transform(begin(bufAU), end(bufAU), begin(e), [n](scalar_t a) { return a << n; });
+            r = va << n;
+            REQUIRE(r == e);
+            std::transform(begin(bufAU), end(bufAU), begin(e), [n](scalar_t a) { return a >> n; });
+            r = va >> n;
+            REQUIRE(r == e);
+        }
+    }
+    SECTION("shifts by vector") {
+        const U count = vb & U(31U);
+        expect([](scalar_t a, scalar_t b) { return a << (b & 31); });
+        r = va << count;
+        REQUIRE(r == e);
+        expect([](scalar_t a, scalar_t b) { return a >> (b & 31); });
+        r = va >> count;
+        REQUIRE(r == e);
+    }
+    SECTION("rotates") {
+        for (int n : {0, 1, 13, 31}) {
+            std::transform(begin(bufAU), end(bufAU), begin(e),
+                           [n](scalar_t a) { return (a << n) | (a >> ((32 - n) & 31)); });
+            r = rotl(va, n);
+            REQUIRE(r == e);
+            std::transform(begin(bufAU), end(bufAU), begin(e),
+                           [n](scalar_t a) { return (a >> n) | (a << ((32 - n) & 31)); });
+            r = rotr(va, n);
+            REQUIRE(r == e);
+        }
+    }
+    SECTION("high multiply") {
+        expect([](scalar_t a, scalar_t b) { return scalar_t((uint64_t(a) * b) >> 32); });
+        r = mulhi(va, vb);
+        REQUIRE(r == e);
+        test_mul_wide<U>(bufAU, bufBU, 0);
+    }
+#endif
     SECTION("rhs of compound can be implicitly constructed") {
         va = vb;
         va &= 0xdeadbeefU;
@@ -840,6 +1382,34 @@ TEST_CASE(SIMD_TYPE " int arithmetic", SIMD_TEST_TAG) {
         r = abs(va);
         REQUIRE(r == e);
     }
+#if SIMD_SCALAR_BITS == 32
+    SECTION("shifts") {
+        for (int n : {0, 1, 13, 31}) {
+            std::transform(begin(bufAS), end(bufAS), begin(e),
+                           [n](scalar_t a) { return scalar_t(uint32_t(a) << n); });
+            r = va << n;
+            REQUIRE(r == e);
+            std::transform(begin(bufAS), end(bufAS), begin(e), [n](scalar_t a) { return a >> n; });
+            r = va >> n;
+            REQUIRE(r == e);
+        }
+    }
+    SECTION("shifts by vector") {
+        const S count = vb & S(31);
+        expect([](scalar_t a, scalar_t b) { return scalar_t(uint32_t(a) << (b & 31)); });
+        r = va << count;
+        REQUIRE(r == e);
+        expect([](scalar_t a, scalar_t b) { return a >> (b & 31); });
+        r = va >> count;
+        REQUIRE(r == e);
+    }
+    SECTION("high multiply") {
+        expect([](scalar_t a, scalar_t b) { return scalar_t((int64_t(a) * b) >> 32); });
+        r = mulhi(va, vb);
+        REQUIRE(r == e);
+        test_mul_wide<S>(bufAS, bufBS, 0);
+    }
+#endif
     SECTION("rhs of compound can be implicitly constructed") {
         va = vb;
         va += 123;
@@ -1098,6 +1668,7 @@ TEST_CASE(SIMD_TYPE " horizontal operations", SIMD_TEST_TAG) {
             e = std::accumulate(begin(bufAF), end(bufAF), -inf, max_);
             v = reduce(a, sd::op_max{});
             for (scalar_t vr : v) { REQUIRE(vr == e); }
+            REQUIRE(hmax(a) == e);
         }
         SECTION("min") {
             constexpr scalar_t inf = std::numeric_limits<scalar_t>::infinity();
@@ -1105,17 +1676,24 @@ TEST_CASE(SIMD_TYPE " horizontal operations", SIMD_TEST_TAG) {
             e = std::accumulate(begin(bufAF), end(bufAF), inf, min_);
             v = reduce(a, sd::op_min{});
             for (scalar_t vr : v) { REQUIRE(vr == e); }
+            REQUIRE(hmin(a) == e);
         }
         SECTION("sum") {
             e = std::accumulate(begin(bufAF), end(bufAF), scalar_t(0));
             v = reduce(a, sd::op_add{});
             for (scalar_t vr : v) { REQUIRE(vr == Approx(e)); }
+            REQUIRE(hsum(a) == Approx(e));
         }
         SECTION("product") {
             auto prod = std::multiplies<scalar_t>();
             e = std::accumulate(begin(bufAF), end(bufAF), scalar_t(1), prod);
             v = reduce(a, sd::op_mul{});
             for (scalar_t vr : v) { REQUIRE(vr == Approx(e)); }
+            REQUIRE(hprod(a) == Approx(e));
+        }
+        SECTION("dot") {
+            e = std::inner_product(begin(bufAF), end(bufAF), begin(bufBF), scalar_t(0));
+            REQUIRE(dot(a, F(bufBF)) == Approx(e));
         }
     }
     SECTION("on uints") {
@@ -1146,12 +1724,14 @@ TEST_CASE(SIMD_TYPE " horizontal operations", SIMD_TEST_TAG) {
             e = std::accumulate(begin(bufAU), end(bufAU), scalar_t(0));
             v = reduce(a, sd::op_add{});
             for (scalar_t vr : v) { REQUIRE(vr == Approx(e)); }
+            REQUIRE(hsum(a) == e);
         }
         SECTION("product") {
             auto prod = std::multiplies<scalar_t>();
             e = std::accumulate(begin(bufAU), end(bufAU), scalar_t(1), prod);
             v = reduce(a, sd::op_mul{});
             for (scalar_t vr : v) { REQUIRE(vr == Approx(e)); }
+            REQUIRE(hprod(a) == e);
         }
         SECTION("min") {
             constexpr scalar_t seed = std::numeric_limits<scalar_t>::max();
@@ -1159,6 +1739,7 @@ TEST_CASE(SIMD_TYPE " horizontal operations", SIMD_TEST_TAG) {
             e = std::accumulate(begin(bufAU), end(bufAU), seed, min_);
             v = reduce(a, sd::op_min{});
             for (scalar_t vr : v) { REQUIRE(vr == e); }
+            REQUIRE(hmin(a) == e);
         }
         SECTION("max") {
             constexpr scalar_t seed = std::numeric_limits<scalar_t>::min();
@@ -1166,6 +1747,7 @@ TEST_CASE(SIMD_TYPE " horizontal operations", SIMD_TEST_TAG) {
             e = std::accumulate(begin(bufAU), end(bufAU), seed, max_);
             v = reduce(a, sd::op_max{});
             for (scalar_t vr : v) { REQUIRE(vr == e); }
+            REQUIRE(hmax(a) == e);
         }
     }
 }
@@ -1201,7 +1783,7 @@ TEST_CASE(SIMD_TYPE " mask", SIMD_TEST_TAG) {
         auto expected = [](const B::storage_t& s) {
             B::mask_t res(0U);
             for (auto i = 0U; i < s.size(); ++i) {
-                if (sd::cast_u(s[i]) & (1U << 31)) { res |= B::mask_t(1U << i); }
+                if (sd::cast_u(s[i]) & U_SIGN_BIT) { res |= B::mask_t(1U << i); }
             }
             return res;
         };
@@ -1244,12 +1826,14 @@ TEST_CASE(SIMD_TYPE " broadcast", SIMD_TEST_TAG) {
     REQUIRE(all(s.broadcast<0>() == S(bufAS[0])));
 #endif
 
-#if SIMD_WIDTH >= 4
+#if SIMD_WIDTH >= 2
     REQUIRE(all(b.broadcast<1>() == B(bufAB[1])));
     REQUIRE(all(f.broadcast<1>() == F(bufAF[1])));
     REQUIRE(all(u.broadcast<1>() == U(bufAU[1])));
     REQUIRE(all(s.broadcast<1>() == S(bufAS[1])));
+#endif
 
+#if SIMD_WIDTH >= 4
     REQUIRE(all(b.broadcast<2>() == B(bufAB[2])));
     REQUIRE(all(f.broadcast<2>() == F(bufAF[2])));
     REQUIRE(all(u.broadcast<2>() == U(bufAU[2])));
@@ -1282,4 +1866,46 @@ TEST_CASE(SIMD_TYPE " broadcast", SIMD_TEST_TAG) {
     REQUIRE(all(u.broadcast<7>() == U(bufAU[7])));
     REQUIRE(all(s.broadcast<7>() == S(bufAS[7])));
 #endif
+
+#if SIMD_WIDTH >= 16
+    REQUIRE(all(b.broadcast<8>() == B(bufAB[8])));
+    REQUIRE(all(f.broadcast<8>() == F(bufAF[8])));
+    REQUIRE(all(u.broadcast<8>() == U(bufAU[8])));
+    REQUIRE(all(s.broadcast<8>() == S(bufAS[8])));
+
+    REQUIRE(all(b.broadcast<9>() == B(bufAB[9])));
+    REQUIRE(all(f.broadcast<9>() == F(bufAF[9])));
+    REQUIRE(all(u.broadcast<9>() == U(bufAU[9])));
+    REQUIRE(all(s.broadcast<9>() == S(bufAS[9])));
+
+    REQUIRE(all(b.broadcast<10>() == B(bufAB[10])));
+    REQUIRE(all(f.broadcast<10>() == F(bufAF[10])));
+    REQUIRE(all(u.broadcast<10>() == U(bufAU[10])));
+    REQUIRE(all(s.broadcast<10>() == S(bufAS[10])));
+
+    REQUIRE(all(b.broadcast<11>() == B(bufAB[11])));
+    REQUIRE(all(f.broadcast<11>() == F(bufAF[11])));
+    REQUIRE(all(u.broadcast<11>() == U(bufAU[11])));
+    REQUIRE(all(s.broadcast<11>() == S(bufAS[11])));
+
+    REQUIRE(all(b.broadcast<12>() == B(bufAB[12])));
+    REQUIRE(all(f.broadcast<12>() == F(bufAF[12])));
+    REQUIRE(all(u.broadcast<12>() == U(bufAU[12])));
+    REQUIRE(all(s.broadcast<12>() == S(bufAS[12])));
+
+    REQUIRE(all(b.broadcast<13>() == B(bufAB[13])));
+    REQUIRE(all(f.broadcast<13>() == F(bufAF[13])));
+    REQUIRE(all(u.broadcast<13>() == U(bufAU[13])));
+    REQUIRE(all(s.broadcast<13>() == S(bufAS[13])));
+
+    REQUIRE(all(b.broadcast<14>() == B(bufAB[14])));
+    REQUIRE(all(f.broadcast<14>() == F(bufAF[14])));
+    REQUIRE(all(u.broadcast<14>() == U(bufAU[14])));
+    REQUIRE(all(s.broadcast<14>() == S(bufAS[14])));
+
+    REQUIRE(all(b.broadcast<15>() == B(bufAB[15])));
+    REQUIRE(all(f.broadcast<15>() == F(bufAF[15])));
+    REQUIRE(all(u.broadcast<15>() == U(bufAU[15])));
+    REQUIRE(all(s.broadcast<15>() == S(bufAS[15])));
+#endif
 }
@@ -0,0 +1,35 @@
+#define SIMDEE_DATA_BUFAB                                                                          \
+    true, false, true, true, false, true, false, true, false, false, true, true, true, false,     \
+        false, false
+#define SIMDEE_DATA_BUFBB                                                                          \
+    false, true, false, true, true, false, false, false, false, false, false, true, false, true,  \
+        true, false
+#define SIMDEE_DATA_BUFZB                                                                          \
+    false, false, false, false, false, false, false, false, false, false, false, false, false,    \
+        false, false, false
+#define SIMDEE_DATA_BUFAF                                                                          \
+    -0.27787193f, +0.70154146f, -2.05181630f, +2.22944568f, -0.82358653f, -1.57705702f,            \
+        +0.50797465f, -0.59003456f, +1.05175128f, -1.84201806f, -0.86846905f, -0.12846368f,        \
+        +0.57711544f, +0.84359427f, -0.42921292f, +0.10767041f
+#define SIMDEE_DATA_BUFBF                                                                          \
+    -0.23645458f, +2.02369089f, -2.25835397f, +2.22944568f, +0.33756370f, -0.87587426f,            \
+        -1.66416447f, -0.59003456f, -1.58576424f, +0.46864393f, -0.25746426f, -0.12846368f,        \
+        +0.53928265f, +0.68583966f, -0.95776435f, +0.64024847f
+#define SIMDEE_DATA_BUFZF 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f
+#define SIMDEE_DATA_BUFAU                                                                          \
+    1753029375U, 1117080442U, 3817141237U, 3761735248U, 244284091U, 1874242234U, 3400252368U,      \
+        2648404707U, 3287293669U, 1097258600U, 47845886U, 2256590034U, 3947005528U, 632380555U,    \
+        1667872600U, 165718904U
+#define SIMDEE_DATA_BUFBU                                                                          \
+    1679702461U, 2102346647U, 480083363U, 3761735248U, 1213208312U, 2121108407U, 2718691794U,      \
+        3724041010U, 497696148U, 1863987032U, 3610013598U, 1020222046U, 3947005528U, 3762785307U,  \
+        965834188U, 792855515U
+#define SIMDEE_DATA_BUFZU 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U
+#define SIMDEE_DATA_BUFAS                                                                          \
+    -1712190449, -48692967, -214510247, 440646957, 471289320, 614985478, -2035465541, 248883859,   \
+        724833311, -802016071, -161619340, 1315582780, -1411040225, 906038400, -419223029,         \
+        -467398332
+#define SIMDEE_DATA_BUFBS                                                                          \
+    724135231, 56848532, 64122653, 440646957, -899302812, -2112882416, 77287484, 1066617619,       \
+        537088200, -802016071, 1784561707, 59085586, -1208329058, 345859443, -647116445, 919879802
+#define SIMDEE_DATA_BUFZS 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
@@ -0,0 +1,12 @@
+#define SIMDEE_DATA_BUFAB true
+#define SIMDEE_DATA_BUFBB false
+#define SIMDEE_DATA_BUFZB false
+#define SIMDEE_DATA_BUFAF -0.27787193187123456
+#define SIMDEE_DATA_BUFBF -0.23645458123456789
+#define SIMDEE_DATA_BUFZF 0.
+#define SIMDEE_DATA_BUFAU 17530293751234567890ULL
+#define SIMDEE_DATA_BUFBU 1679702461ULL
+#define SIMDEE_DATA_BUFZU 0ULL
+#define SIMDEE_DATA_BUFAS -4611686018427387903LL
+#define SIMDEE_DATA_BUFBS 2LL
+#define SIMDEE_DATA_BUFZS 0LL
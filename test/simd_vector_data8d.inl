@@ -0,0 +1,23 @@
+#define SIMDEE_DATA_BUFAB true, false, true, true, false, true, false, true
+#define SIMDEE_DATA_BUFBB false, true, false, true, true, false, false, false
+#define SIMDEE_DATA_BUFZB false, false, false, false, false, false, false, false
+#define SIMDEE_DATA_BUFAF                                                                          \
+    -0.27787193187123456, +0.70154146012345678, -2.05181630123456789, +2.22944568123456789,        \
+        -0.82358653123456789, -1.57705702123456789, +0.50797465123456789, -0.59003456123456789
+#define SIMDEE_DATA_BUFBF                                                                          \
+    -0.23645458123456789, +2.02369089123456789, -2.25835397123456789, +2.22944568123456789,        \
+        +0.33756370123456789, -0.87587426123456789, -1.66416447123456789, -0.59003456123456789
+#define SIMDEE_DATA_BUFZF 0., 0., 0., 0., 0., 0., 0., 0.
+#define SIMDEE_DATA_BUFAU                                                                          \
+    17530293751234567890ULL, 6442450944ULL, 3817141237ULL, 12345678901234567890ULL, 244284091ULL,  \
+        9223372036854775808ULL, 3400252368000ULL, 2648404707ULL
+#define SIMDEE_DATA_BUFBU                                                                          \
+    1679702461ULL, 6442450943ULL, 14800833630000000000ULL, 12345678901234567890ULL, 1213208312ULL, \
+        9223372036854775807ULL, 2718691794ULL, 18446744073709551615ULL
+#define SIMDEE_DATA_BUFZU 0ULL, 0ULL, 0ULL, 0ULL, 0ULL, 0ULL, 0ULL, 0ULL
+#define SIMDEE_DATA_BUFAS                                                                          \
+    -4611686018427387903LL, -5LL, -2145102471234567LL, 440646957LL, 4712893201LL,                  \
+        6149854780000001LL, -2035465541LL, 248883859LL
+#define SIMDEE_DATA_BUFBS                                                                          \
+    2LL, -3000000000LL, 641LL, 440646957LL, -899302812LL, -211LL, 772874841LL, 10666176190LL
+#define SIMDEE_DATA_BUFZS 0LL, 0LL, 0LL, 0LL, 0LL, 0LL, 0LL, 0LL
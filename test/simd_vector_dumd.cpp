@@ -0,0 +1,17 @@
+#include <catch2/catch.hpp>
+#include <simdee/simd_vectors/dum.hpp>
+#include <simdee/simdee.hpp>
+
+using B = sd::dumb64;
+using F = sd::dumd;
+using U = sd::dumu64;
+using S = sd::dums64;
+
+#define SIMD_TYPE "DUMD"
+#define SIMD_TEST_TAG "[simd_vectors][dumd]"
+#define SIMD_WIDTH 1
+#define SIMD_SCALAR_BITS 64
+
+#include "simd_vector_data1d.inl"
+
+#include "simd_vector.inl"
@@ -0,0 +1,16 @@
+#include <catch2/catch.hpp>
+#include <simdee/simdee.hpp>
+
+using B = sd::vec16b;
+using F = sd::vec16f;
+using U = sd::vec16u;
+using S = sd::vec16s;
+
+#define SIMD_TYPE "vec16"
+#define SIMD_TEST_TAG "[simd_vectors][vec16]"
+#define SIMD_WIDTH 16
+#define SIMD_BOOL_IS_MASK SIMDEE_AVX512
+
+#include "simd_vector_data16.inl"
+
+#include "simd_vector.inl"
@@ -0,0 +1,16 @@
+#include <catch2/catch.hpp>
+#include <simdee/simdee.hpp>
+
+using B = sd::vec2b64;
+using F = sd::vec2d;
+using U = sd::vec2u64;
+using S = sd::vec2s64;
+
+#define SIMD_TYPE "vec2d"
+#define SIMD_TEST_TAG "[simd_vectors][vec2d]"
+#define SIMD_WIDTH 2
+#define SIMD_SCALAR_BITS 64
+
+#include "simd_vector_data2d.inl"
+
+#include "simd_vector.inl"
@@ -0,0 +1,17 @@
+#include <catch2/catch.hpp>
+#include <simdee/simdee.hpp>
+
+using B = sd::vec8b64;
+using F = sd::vec8d;
+using U = sd::vec8u64;
+using S = sd::vec8s64;
+
+#define SIMD_TYPE "vec8d"
+#define SIMD_TEST_TAG "[simd_vectors][vec8d]"
+#define SIMD_WIDTH 8
+#define SIMD_SCALAR_BITS 64
+#define SIMD_BOOL_IS_MASK SIMDEE_AVX512
+
+#include "simd_vector_data8d.inl"
+
+#include "simd_vector.inl"
@@ -0,0 +1,102 @@
+#include <catch2/catch.hpp>
+#include <simdee/simdee.hpp>
+#include <simdee/soa_vector.hpp>
+
+#include <cstdint>
+
+namespace {
+    using vec = sd::vec8f;
+    enum field { x, y, id };
+    using points_t = sd::soa_vector<vec, float, float, vec::vec_s::scalar_t>;
+
+    points_t make_points(int count) {
+        points_t points;
+        for (int i = 0; i < count; ++i) points.push_back(float(i), float(-i), i * 10);
+        return points;
+    }
+
+    bool tail_is_zero(const points_t& points) {
+        for (std::size_t i = points.size(); i < points.num_blocks() * points_t::width; ++i) {
+            if (points.get<x>(i) != 0 || points.get<y>(i) != 0 || points.get<id>(i) != 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+TEST_CASE("soa_vector types", "[soa_vector]") {
+    REQUIRE(std::size_t(points_t::width) == std::size_t(vec::width));
+    REQUIRE(points_t::fields == 3);
+    REQUIRE((std::is_same<points_t::vec_t<x>, vec>::value));
+    REQUIRE((std::is_same<points_t::vec_t<id>, vec::vec_s>::value));
+    REQUIRE(alignof(points_t::block) == alignof(vec::storage_t));
+    REQUIRE(sizeof(points_t::block) == 3 * sizeof(vec::storage_t));
+}
+
+TEST_CASE("soa_vector push_back and element access", "[soa_vector]") {
+    auto points = make_points(19);
+    REQUIRE(points.size() == 19);
+    REQUIRE(points.num_blocks() == 3);
+    REQUIRE(points.block_size(0) == points_t::width);
+    REQUIRE(points.block_size(2) == 19 - 2 * points_t::width);
+    for (int i = 0; i < 19; ++i) {
+        REQUIRE(points.get<x>(std::size_t(i)) == float(i));
+        REQUIRE(points.get<y>(std::size_t(i)) == float(-i));
+        REQUIRE(points.get<id>(std::size_t(i)) == i * 10);
+    }
+    REQUIRE(tail_is_zero(points));
+    for (std::size_t b = 0; b < points.num_blocks(); ++b) {
+        auto data = points.block_at(b).get<x>().data();
+        REQUIRE(std::uintptr_t(data) % alignof(vec::storage_t) == 0);
+    }
+}
+
+TEST_CASE("soa_vector block loads and stores", "[soa_vector]") {
+    auto points = make_points(19);
+    for (std::size_t b = 0; b < points.num_blocks(); ++b) {
+        vec sum = points.load<x>(b) + points.load<y>(b);
+        REQUIRE(sd::all(sum == vec(0.f)));
+        points.store<y>(b, points.load<x>(b) * vec(2.f));
+        points.store<id>(b, points.load<id>(b) + vec::vec_s(1));
+    }
+    for (int i = 0; i < 19; ++i) {
+        REQUIRE(points.get<y>(std::size_t(i)) == float(2 * i));
+        REQUIRE(points.get<id>(std::size_t(i)) == i * 10 + 1);
+    }
+}
+
+TEST_CASE("soa_vector resize and pop_back", "[soa_vector]") {
+    SECTION("shrink zeroes the tail") {
+        auto points = make_points(19);
+        points.resize(10);
+        REQUIRE(points.size() == 10);
+        REQUIRE(points.num_blocks() == 2);
+        REQUIRE(tail_is_zero(points));
+        points.resize(24);
+        REQUIRE(points.num_blocks() == 3);
+        REQUIRE(points.get<x>(9) == 9.f);
+        REQUIRE(tail_is_zero(points));
+        REQUIRE(points.get<x>(23) == 0.f);
+    }
+    SECTION("pop_back") {
+        auto points = make_points(17);
+        points.pop_back();
+        REQUIRE(points.size() == 16);
+        REQUIRE(points.num_blocks() == 2);
+        points.pop_back();
+        REQUIRE(points.get<x>(14) == 14.f);
+        REQUIRE(tail_is_zero(points));
+    }
+    SECTION("clear and reserve") {
+        auto points = make_points(5);
+        points.clear();
+        REQUIRE(points.empty());
+        REQUIRE(points.num_blocks() == 0);
+        points.reserve(100);
+        REQUIRE(points.capacity() >= 100);
+        points_t sized(3);
+        REQUIRE(sized.size() == 3);
+        REQUIRE(tail_is_zero(sized));
+    }
+}